@@ -0,0 +1,652 @@
+/***************************************************************************
+*  Mdulo de implementao: ADJ  Adjacncia adaptvel ao grau
+*
+*  Arquivo gerado:              adjacencia.c
+*  Letras identificadoras:      ADJ
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*     1.1     rc       19/out/26   Retirada deixa vaga, com compactao adiada.
+*
+***************************************************************************/
+
+#include   <stdlib.h>
+#include   <string.h>
+
+#define ADJACENCIA_OWN
+#include "adjacencia.h"
+#undef ADJACENCIA_OWN
+
+/* Capacidade do primeiro vetor alocado */
+#define CAPACIDADE_INICIAL 8
+
+/* Marca de posio livre na tabela. As posies ocupadas guardam a
+   posio do elemento mais 1 */
+#define ENTRADA_LIVRE 0
+
+/* Marca temporria do elemento sendo movido por ADJ_Mover */
+#define ENTRADA_MOVENDO -1
+
+/* Valor das posies vagas deixadas por ADJ_Retirar nas representaes
+   alocadas. O endereo de marcaVaga nunca  um valor guardado */
+static char marcaVaga ;
+#define VAGA ((void*) &marcaVaga)
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+   static void ** Valores(const ADJ_tpAdjacencia *pAdjacencia);
+   static unsigned int * Chaves(const ADJ_tpAdjacencia *pAdjacencia);
+   static int * Tabela(const ADJ_tpAdjacencia *pAdjacencia);
+   static int NumPosicoes(const ADJ_tpAdjacencia *pAdjacencia);
+   static size_t TamanhoAlocacao(int capacidade);
+   static int Realocar(ADJ_tpAdjacencia *pAdjacencia, int capacidade);
+   static void Embutir(ADJ_tpAdjacencia *pAdjacencia);
+   static void Compactar(ADJ_tpAdjacencia *pAdjacencia);
+   static void InserirNaTabela(int *vtTabela, unsigned int mascara, unsigned int chave, int posicao);
+   static int * EntradaDaPosicao(const ADJ_tpAdjacencia *pAdjacencia, int posicao);
+   static void RemoverDaTabela(ADJ_tpAdjacencia *pAdjacencia, int *pEntrada);
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: ADJ Iniciar
+******/
+void ADJ_Iniciar(ADJ_tpAdjacencia *pAdjacencia)
+{
+   pAdjacencia->numElementos = 0;
+   pAdjacencia->capacidade = ADJ_NUM_EMBUTIDOS;
+}
+
+/***************************************************************************
+*  Funo: ADJ Esvaziar
+******/
+void ADJ_Esvaziar(ADJ_tpAdjacencia *pAdjacencia, void (*destruirValor)(void *pValor))
+{
+   void **vtValores = Valores(pAdjacencia);
+   int numPosicoes = NumPosicoes(pAdjacencia);
+   int i;
+
+   if (destruirValor != NULL)
+   {
+      for (i = 0; i < numPosicoes; i++)
+      {
+         if (vtValores[i] != VAGA)
+         {
+            destruirValor(vtValores[i]);
+         }
+      }
+   }
+
+   if (pAdjacencia->capacidade > ADJ_NUM_EMBUTIDOS)
+   {
+      free(pAdjacencia->dados.alocados.vtValores);
+   }
+
+   ADJ_Iniciar(pAdjacencia);
+}
+
+/***************************************************************************
+*  Funo: ADJ Acrescentar
+******/
+ADJ_tpCondRet ADJ_Acrescentar(ADJ_tpAdjacencia *pAdjacencia, void *pValor, unsigned int chave)
+{
+   int posicao = NumPosicoes(pAdjacencia);
+   int capacidade = pAdjacencia->capacidade;
+   int *vtTabela;
+
+   // Cheia, a alocao dobra, a no ser que metade seja de vagas, caso
+   // em que s  compactada numa alocao do mesmo tamanho
+   if (posicao == capacidade)
+   {
+      if (capacidade < CAPACIDADE_INICIAL)
+      {
+         capacidade = CAPACIDADE_INICIAL;
+      }
+      else if (pAdjacencia->numElementos > capacidade / 2)
+      {
+         capacidade *= 2;
+      }
+
+      if (!Realocar(pAdjacencia, capacidade))
+      {
+         return ADJ_CondRetFaltouMemoria;
+      }
+      posicao = NumPosicoes(pAdjacencia);
+   }
+
+   Valores(pAdjacencia)[posicao] = pValor;
+   Chaves(pAdjacencia)[posicao] = chave;
+
+   vtTabela = Tabela(pAdjacencia);
+   if (vtTabela != NULL)
+   {
+      InserirNaTabela(vtTabela, 2 * (unsigned int) pAdjacencia->capacidade - 1, chave, posicao);
+   }
+
+   pAdjacencia->numElementos++;
+   if (pAdjacencia->capacidade > ADJ_NUM_EMBUTIDOS)
+   {
+      pAdjacencia->dados.alocados.numPosicoes++;
+   }
+
+   return ADJ_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: ADJ Procurar
+******/
+int ADJ_Procurar(const ADJ_tpAdjacencia *pAdjacencia, unsigned int chave,
+                 int (*comparar)(void *pValor, void *pBuscado), void *pBuscado)
+{
+   void **vtValores = Valores(pAdjacencia);
+   const unsigned int *vtChaves = Chaves(pAdjacencia);
+   const int *vtTabela = Tabela(pAdjacencia);
+   unsigned int mascara, entrada;
+   int i;
+
+   if (vtTabela == NULL)
+   {
+      // As chaves so lidas em sequncia; os valores, s quando a
+      // chave coincide
+      for (i = 0; i < NumPosicoes(pAdjacencia); i++)
+      {
+         if (vtChaves[i] == chave && vtValores[i] != VAGA &&
+             comparar(vtValores[i], pBuscado) == 0)
+         {
+            return i;
+         }
+      }
+
+      return -1;
+   }
+
+   mascara = 2 * (unsigned int) pAdjacencia->capacidade - 1;
+   for (entrada = chave & mascara; vtTabela[entrada] != ENTRADA_LIVRE; entrada = (entrada + 1) & mascara)
+   {
+      i = vtTabela[entrada] - 1;
+      if (vtChaves[i] == chave && comparar(vtValores[i], pBuscado) == 0)
+      {
+         return i;
+      }
+   }
+
+   return -1;
+}
+
+/***************************************************************************
+*  Funo: ADJ Nmero de elementos
+******/
+int ADJ_NumElementos(const ADJ_tpAdjacencia *pAdjacencia)
+{
+   return pAdjacencia->numElementos;
+}
+
+/***************************************************************************
+*  Funo: ADJ Obter valor
+******/
+void * ADJ_ObterValor(const ADJ_tpAdjacencia *pAdjacencia, int posicao)
+{
+   return Valores(pAdjacencia)[posicao];
+}
+
+/***************************************************************************
+*  Funo: ADJ Retirar
+******/
+void ADJ_Retirar(ADJ_tpAdjacencia *pAdjacencia, int posicao)
+{
+   void **vtValores = Valores(pAdjacencia);
+   unsigned int *vtChaves = Chaves(pAdjacencia);
+   int numPosicoes;
+
+   // Os embutidos so poucos, e os seguintes simplesmente recuam
+   if (pAdjacencia->capacidade <= ADJ_NUM_EMBUTIDOS)
+   {
+      pAdjacencia->numElementos--;
+      memmove(vtValores + posicao, vtValores + posicao + 1,
+              (pAdjacencia->numElementos - posicao) * sizeof(void*));
+      memmove(vtChaves + posicao, vtChaves + posicao + 1,
+              (pAdjacencia->numElementos - posicao) * sizeof(unsigned int));
+      return;
+   }
+
+   // Nas alocadas a posio fica vaga, e nenhuma outra muda
+   if (Tabela(pAdjacencia) != NULL)
+   {
+      RemoverDaTabela(pAdjacencia, EntradaDaPosicao(pAdjacencia, posicao));
+   }
+   vtValores[posicao] = VAGA;
+   pAdjacencia->numElementos--;
+
+   numPosicoes = pAdjacencia->dados.alocados.numPosicoes;
+   while (numPosicoes > 0 && vtValores[numPosicoes - 1] == VAGA)
+   {
+      numPosicoes--;
+   }
+   pAdjacencia->dados.alocados.numPosicoes = numPosicoes;
+
+   if (pAdjacencia->numElementos <= ADJ_NUM_EMBUTIDOS)
+   {
+      Embutir(pAdjacencia);
+   }
+   else if (numPosicoes - pAdjacencia->numElementos > pAdjacencia->numElementos)
+   {
+      Compactar(pAdjacencia);
+   }
+}
+
+/***************************************************************************
+*  Funo: ADJ Mover
+******/
+void ADJ_Mover(ADJ_tpAdjacencia *pAdjacencia, int origem, int destino)
+{
+   void **vtValores = Valores(pAdjacencia);
+   unsigned int *vtChaves = Chaves(pAdjacencia);
+   void *pValor = vtValores[origem];
+   unsigned int chave = vtChaves[origem];
+   int *pEntradaOrigem, i;
+
+   if (destino >= origem)
+   {
+      return;
+   }
+
+   // Os que avanam so renumerados do ltimo para o primeiro; a entrada
+   // do movido fica marcada at o fim para no ser confundida com eles
+   if (Tabela(pAdjacencia) != NULL)
+   {
+      pEntradaOrigem = EntradaDaPosicao(pAdjacencia, origem);
+      *pEntradaOrigem = ENTRADA_MOVENDO;
+      for (i = origem - 1; i >= destino; i--)
+      {
+         if (vtValores[i] != VAGA)
+         {
+            *EntradaDaPosicao(pAdjacencia, i) = i + 2;
+         }
+      }
+      *pEntradaOrigem = destino + 1;
+   }
+
+   memmove(vtValores + destino + 1, vtValores + destino, (origem - destino) * sizeof(void*));
+   memmove(vtChaves + destino + 1, vtChaves + destino, (origem - destino) * sizeof(unsigned int));
+   vtValores[destino] = pValor;
+   vtChaves[destino] = chave;
+}
+
+/***************************************************************************
+*  Funo: ADJ Iniciar iterador
+******/
+void ADJ_IniciarIterador(const ADJ_tpAdjacencia *pAdjacencia, ADJ_tpIterador *pIterador)
+{
+   pIterador->pAdjacencia = pAdjacencia;
+   pIterador->proximo = 0;
+}
+
+/***************************************************************************
+*  Funo: ADJ Avanar iterador
+******/
+ADJ_tpCondRet ADJ_AvancarIterador(ADJ_tpIterador *pIterador, void **ppValor)
+{
+   void **vtValores = Valores(pIterador->pAdjacencia);
+   int numPosicoes = NumPosicoes(pIterador->pAdjacencia);
+
+   while (pIterador->proximo < numPosicoes && vtValores[pIterador->proximo] == VAGA)
+   {
+      pIterador->proximo++;
+   }
+
+   if (pIterador->proximo >= numPosicoes)
+   {
+      return ADJ_CondRetFimAdjacencia;
+   }
+
+   *ppValor = vtValores[pIterador->proximo++];
+
+   return ADJ_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: ADJ Posio do iterador
+******/
+int ADJ_PosicaoDoIterador(const ADJ_tpIterador *pIterador)
+{
+   return pIterador->proximo - 1;
+}
+
+/***************************************************************************
+*  Funo: ADJ Espao alocado
+******/
+size_t ADJ_EspacoAlocado(const ADJ_tpAdjacencia *pAdjacencia)
+{
+   if (pAdjacencia->capacidade <= ADJ_NUM_EMBUTIDOS)
+   {
+      return 0;
+   }
+
+   return TamanhoAlocacao(pAdjacencia->capacidade);
+}
+
+/*****  Cdigo das funes encapsuladas no mdulo  *****/
+
+/***********************************************************************
+*
+*  Funo: ADJ Valores
+*
+*  Descrio:
+*    Retorna o vetor de valores da representao atual.
+*
+***********************************************************************/
+void ** Valores(const ADJ_tpAdjacencia *pAdjacencia)
+{
+   if (pAdjacencia->capacidade <= ADJ_NUM_EMBUTIDOS)
+   {
+      return (void**) pAdjacencia->dados.embutidos.vtValores;
+   }
+
+   return pAdjacencia->dados.alocados.vtValores;
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Chaves
+*
+*  Descrio:
+*    Retorna o vetor de chaves, que nas representaes alocadas vem
+*    logo depois dos valores.
+*
+***********************************************************************/
+unsigned int * Chaves(const ADJ_tpAdjacencia *pAdjacencia)
+{
+   if (pAdjacencia->capacidade <= ADJ_NUM_EMBUTIDOS)
+   {
+      return (unsigned int*) pAdjacencia->dados.embutidos.vtChaves;
+   }
+
+   return (unsigned int*) (pAdjacencia->dados.alocados.vtValores + pAdjacencia->capacidade);
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Tabela
+*
+*  Descrio:
+*    Retorna a tabela de espalhamento, com 2 * capacidade entradas, que
+*    vem logo depois das chaves, ou NULL se a capacidade no passa de
+*    ADJ_LIMITE_LINEAR.
+*
+***********************************************************************/
+int * Tabela(const ADJ_tpAdjacencia *pAdjacencia)
+{
+   if (pAdjacencia->capacidade <= ADJ_LIMITE_LINEAR)
+   {
+      return NULL;
+   }
+
+   return (int*) (Chaves(pAdjacencia) + pAdjacencia->capacidade);
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Nmero de posies
+*
+*  Descrio:
+*    Retorna o limite das posies em uso, contando as vagas. Nos
+*    embutidos no h vagas.
+*
+***********************************************************************/
+int NumPosicoes(const ADJ_tpAdjacencia *pAdjacencia)
+{
+   if (pAdjacencia->capacidade <= ADJ_NUM_EMBUTIDOS)
+   {
+      return pAdjacencia->numElementos;
+   }
+
+   return pAdjacencia->dados.alocados.numPosicoes;
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Tamanho da alocao
+*
+*  Descrio:
+*    Retorna os bytes alocados para uma capacidade maior que
+*    ADJ_NUM_EMBUTIDOS.
+*
+***********************************************************************/
+size_t TamanhoAlocacao(int capacidade)
+{
+   size_t tamanho = (size_t) capacidade * (sizeof(void*) + sizeof(unsigned int));
+
+   if (capacidade > ADJ_LIMITE_LINEAR)
+   {
+      tamanho += 2 * (size_t) capacidade * sizeof(int);
+   }
+
+   return tamanho;
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Realocar
+*
+*  Descrio:
+*    Copia os elementos, em ordem e sem as vagas, para uma alocao com
+*    a capacidade dada, maior que ADJ_NUM_EMBUTIDOS e que a quantidade
+*    de elementos, e refaz a tabela se ela tiver. Retorna 0 se faltou
+*    memria, caso em que a adjacncia no  alterada.
+*
+***********************************************************************/
+int Realocar(ADJ_tpAdjacencia *pAdjacencia, int capacidade)
+{
+   void **vtNovos = (void**) malloc(TamanhoAlocacao(capacidade));
+   void **vtValores = Valores(pAdjacencia);
+   unsigned int *vtChaves = Chaves(pAdjacencia);
+   int numPosicoes = NumPosicoes(pAdjacencia);
+   unsigned int *vtNovasChaves;
+   int *vtTabela, i, j;
+
+   if (vtNovos == NULL)
+   {
+      return 0;
+   }
+
+   vtNovasChaves = (unsigned int*) (vtNovos + capacidade);
+   for (i = 0, j = 0; i < numPosicoes; i++)
+   {
+      if (vtValores[i] != VAGA)
+      {
+         vtNovos[j] = vtValores[i];
+         vtNovasChaves[j] = vtChaves[i];
+         j++;
+      }
+   }
+
+   if (capacidade > ADJ_LIMITE_LINEAR)
+   {
+      vtTabela = (int*) (vtNovasChaves + capacidade);
+      memset(vtTabela, 0, 2 * (size_t) capacidade * sizeof(int));
+      for (i = 0; i < pAdjacencia->numElementos; i++)
+      {
+         InserirNaTabela(vtTabela, 2 * (unsigned int) capacidade - 1, vtNovasChaves[i], i);
+      }
+   }
+
+   if (pAdjacencia->capacidade > ADJ_NUM_EMBUTIDOS)
+   {
+      free(pAdjacencia->dados.alocados.vtValores);
+   }
+
+   pAdjacencia->dados.alocados.vtValores = vtNovos;
+   pAdjacencia->dados.alocados.numPosicoes = pAdjacencia->numElementos;
+   pAdjacencia->capacidade = capacidade;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Embutir
+*
+*  Descrio:
+*    Traz os elementos, no mximo ADJ_NUM_EMBUTIDOS, de volta para
+*    dentro da adjacncia, sem as vagas, e libera a alocao.
+*
+***********************************************************************/
+void Embutir(ADJ_tpAdjacencia *pAdjacencia)
+{
+   void **vtAlocados = pAdjacencia->dados.alocados.vtValores;
+   unsigned int *vtChaves = Chaves(pAdjacencia);
+   int numPosicoes = pAdjacencia->dados.alocados.numPosicoes;
+   void *vtValores[ADJ_NUM_EMBUTIDOS];
+   unsigned int vtChavesEmbutidas[ADJ_NUM_EMBUTIDOS];
+   int i, j;
+
+   // Os embutidos ocupam o mesmo lugar que o ponteiro da alocao
+   for (i = 0, j = 0; i < numPosicoes; i++)
+   {
+      if (vtAlocados[i] != VAGA)
+      {
+         vtValores[j] = vtAlocados[i];
+         vtChavesEmbutidas[j] = vtChaves[i];
+         j++;
+      }
+   }
+
+   free(vtAlocados);
+   pAdjacencia->capacidade = ADJ_NUM_EMBUTIDOS;
+
+   for (i = 0; i < pAdjacencia->numElementos; i++)
+   {
+      pAdjacencia->dados.embutidos.vtValores[i] = vtValores[i];
+      pAdjacencia->dados.embutidos.vtChaves[i] = vtChavesEmbutidas[i];
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Compactar
+*
+*  Descrio:
+*    Recua os elementos sobre as vagas, mantendo a ordem, e refaz a
+*    tabela se ela tiver. Custa O(capacidade) e no aloca memria; como
+*    s  feita quando as vagas passam dos elementos, o custo se paga
+*    pelas retiradas que as deixaram.
+*
+***********************************************************************/
+void Compactar(ADJ_tpAdjacencia *pAdjacencia)
+{
+   void **vtValores = Valores(pAdjacencia);
+   unsigned int *vtChaves = Chaves(pAdjacencia);
+   int *vtTabela = Tabela(pAdjacencia);
+   int numPosicoes = pAdjacencia->dados.alocados.numPosicoes;
+   int i, j;
+
+   for (i = 0, j = 0; i < numPosicoes; i++)
+   {
+      if (vtValores[i] != VAGA)
+      {
+         vtValores[j] = vtValores[i];
+         vtChaves[j] = vtChaves[i];
+         j++;
+      }
+   }
+   pAdjacencia->dados.alocados.numPosicoes = j;
+
+   if (vtTabela != NULL)
+   {
+      memset(vtTabela, 0, 2 * (size_t) pAdjacencia->capacidade * sizeof(int));
+      for (i = 0; i < j; i++)
+      {
+         InserirNaTabela(vtTabela, 2 * (unsigned int) pAdjacencia->capacidade - 1, vtChaves[i], i);
+      }
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Inserir na tabela
+*
+*  Descrio:
+*    Grava a posio na primeira entrada livre a partir da indicada
+*    pelos bits baixos da chave.
+*
+***********************************************************************/
+void InserirNaTabela(int *vtTabela, unsigned int mascara, unsigned int chave, int posicao)
+{
+   unsigned int entrada = chave & mascara;
+
+   while (vtTabela[entrada] != ENTRADA_LIVRE)
+   {
+      entrada = (entrada + 1) & mascara;
+   }
+
+   vtTabela[entrada] = posicao + 1;
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Entrada da posio
+*
+*  Descrio:
+*    Retorna a entrada da tabela que guarda a posio dada, procurada a
+*    partir da chave do elemento dessa posio.
+*
+***********************************************************************/
+int * EntradaDaPosicao(const ADJ_tpAdjacencia *pAdjacencia, int posicao)
+{
+   int *vtTabela = Tabela(pAdjacencia);
+   unsigned int mascara = 2 * (unsigned int) pAdjacencia->capacidade - 1;
+   unsigned int entrada = Chaves(pAdjacencia)[posicao] & mascara;
+
+   while (vtTabela[entrada] != posicao + 1)
+   {
+      entrada = (entrada + 1) & mascara;
+   }
+
+   return vtTabela + entrada;
+}
+
+/***********************************************************************
+*
+*  Funo: ADJ Remover da tabela
+*
+*  Descrio:
+*    Libera a entrada e traz de volta as seguintes da mesma sequncia
+*    de sondagem que ficariam inalcanveis, como em CNJ, de forma que a
+*    tabela nunca precisa de marcas de remoo.
+*
+***********************************************************************/
+void RemoverDaTabela(ADJ_tpAdjacencia *pAdjacencia, int *pEntrada)
+{
+   int *vtTabela = Tabela(pAdjacencia);
+   const unsigned int *vtChaves = Chaves(pAdjacencia);
+   unsigned int mascara = 2 * (unsigned int) pAdjacencia->capacidade - 1;
+   unsigned int livre = (unsigned int) (pEntrada - vtTabela);
+   unsigned int atual = livre;
+   unsigned int ideal;
+
+   for (;;)
+   {
+      atual = (atual + 1) & mascara;
+      if (vtTabela[atual] == ENTRADA_LIVRE)
+      {
+         break;
+      }
+
+      // A entrada pode ocupar a livre se a sua posio ideal no estiver
+      // entre a livre (exclusive) e a atual (inclusive)
+      ideal = vtChaves[vtTabela[atual] - 1] & mascara;
+      if (((atual - ideal) & mascara) >= ((atual - livre) & mascara))
+      {
+         vtTabela[livre] = vtTabela[atual];
+         livre = atual;
+      }
+   }
+
+   vtTabela[livre] = ENTRADA_LIVRE;
+}
+
+/********** Fim do mdulo de implementao: ADJ  Adjacncia adaptvel ao grau **********/
@@ -0,0 +1,302 @@
+#if ! defined( ADJACENCIA_ )
+#define ADJACENCIA_
+/***************************************************************************
+*
+*  Mdulo de definio: ADJ  Adjacncia adaptvel ao grau
+*
+*  Arquivo gerado:              adjacencia.h
+*  Letras identificadoras:      ADJ
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*     1.1     rc       19/out/26   Retirada deixa vaga, com compactao adiada.
+*
+*  Descrio do mdulo
+*     Implementa uma sequncia de ponteiros, mantida na ordem em que foi
+*     montada, com busca por chave.  feita para guardar as arestas de
+*     um vrtice, em que a maioria dos vrtices tem poucas arestas e
+*     alguns tm muitas, e por isso muda de representao com o tamanho:
+*
+*     - at ADJ_NUM_EMBUTIDOS elementos, eles ficam dentro da prpria
+*       adjacncia, sem memria alocada;
+*     - acima disso, num vetor contguo que dobra quando enche, com as
+*       chaves num vetor  parte, percorrido sem ler os valores;
+*     - acima de ADJ_LIMITE_LINEAR elementos, o mesmo vetor, mais uma
+*       tabela de espalhamento com sondagem linear, com o dobro de
+*       posies, que leva da chave  posio do elemento, de forma que
+*       a busca custa O(1) em mdia.
+*
+*     As trs partes ficam numa s alocao. A adjacncia  guardada por
+*     valor na estrutura que a contm; os campos so de uso exclusivo do
+*     mdulo.
+*
+*     Fora dos embutidos, retirar um elemento deixa sua posio vaga,
+*     sem mexer nos demais, e as vagas s so eliminadas quando passam
+*     da quantidade de elementos, ou quando o vetor enche. As posies
+*     ocupadas, portanto, no so necessariamente contguas; o iterador
+*     pula as vagas.
+*
+*     Cada elemento tem uma chave de 32 bits, dada por quem o acrescenta,
+*     que deve ser um espalhamento com todos os bits bem misturados: os
+*     bits baixos escolhem a posio na tabela. Elementos diferentes
+*     podem ter a mesma chave; a busca confirma cada candidato pela
+*     funo de comparao.
+*
+***************************************************************************/
+
+#if defined( ADJACENCIA_OWN )
+   #define ADJACENCIA_EXT
+#else
+   #define ADJACENCIA_EXT extern
+#endif
+
+#include <stddef.h>
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/* Quantidade de elementos guardados dentro da prpria adjacncia */
+#define ADJ_NUM_EMBUTIDOS 2
+
+/* Quantidade de elementos acima da qual a busca usa a tabela */
+#define ADJ_LIMITE_LINEAR 32
+
+
+/***********************************************************************
+*
+*  Tipo de dados: ADJ Adjacncia
+*
+*  Descrio do tipo
+*     Guardada por valor e iniciada por ADJ_Iniciar. Enquanto capacidade
+*      ADJ_NUM_EMBUTIDOS os elementos esto em embutidos; seno, em
+*     alocados.vtValores, seguidos pelas chaves e, se a capacidade passa
+*     de ADJ_LIMITE_LINEAR, pela tabela.
+*
+***********************************************************************/
+
+   typedef struct {
+
+         int numElementos ;
+               /* Quantidade de elementos, sem contar as vagas */
+
+         int capacidade ;
+               /* Elementos que cabem sem realocar */
+
+         union {
+
+            struct {
+               void * vtValores[ ADJ_NUM_EMBUTIDOS ] ;
+               unsigned int vtChaves[ ADJ_NUM_EMBUTIDOS ] ;
+            } embutidos ;
+               /* Elementos guardados na prpria adjacncia */
+
+            struct {
+               void ** vtValores ;
+               int numPosicoes ;
+            } alocados ;
+               /* Incio da alocao das representaes maiores, e
+                  quantas posies dela esto em uso, contando as vagas */
+
+         } dados ;
+
+   } ADJ_tpAdjacencia ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: ADJ Iterador
+*
+*  Descrio do tipo
+*     Posio de um percurso da adjacncia. Os campos so de uso
+*     exclusivo do mdulo.
+*
+***********************************************************************/
+
+   typedef struct {
+
+         const ADJ_tpAdjacencia * pAdjacencia ;
+               /* Adjacncia percorrida */
+
+         int proximo ;
+               /* Posio do prximo elemento a ser entregue */
+
+   } ADJ_tpIterador ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: ADJ Condies de retorno
+*
+***********************************************************************/
+
+   typedef enum {
+
+         ADJ_CondRetOK ,
+               /* Concluiu corretamente */
+
+         ADJ_CondRetFimAdjacencia ,
+               /* O iterador j entregou todos os elementos */
+
+         ADJ_CondRetFaltouMemoria
+               /* Faltou memria */
+
+   } ADJ_tpCondRet ;
+
+
+/***********************************************************************
+*
+*  Funo: ADJ Iniciar
+*
+*  Descrio
+*     Deixa a adjacncia vazia, sem memria alocada. No deve ser usada
+*     numa adjacncia com elementos, que devem antes ser liberados por
+*     ADJ_Esvaziar.
+*
+***********************************************************************/
+   void ADJ_Iniciar(ADJ_tpAdjacencia *pAdjacencia);
+
+/***********************************************************************
+*
+*  Funo: ADJ Esvaziar
+*
+*  Descrio
+*     Chama destruirValor, se no NULL, para cada valor, libera a memria
+*     alocada e deixa a adjacncia vazia.
+*
+***********************************************************************/
+   void ADJ_Esvaziar(ADJ_tpAdjacencia *pAdjacencia, void (*destruirValor)(void *pValor));
+
+/***********************************************************************
+*
+*  Funo: ADJ Acrescentar
+*
+*  Descrio
+*     Acrescenta o valor no fim da adjacncia, com a chave dada.
+*
+*  Condies de retorno
+*     ADJ_CondRetOK
+*     ADJ_CondRetFaltouMemoria  - a adjacncia no foi alterada.
+*
+***********************************************************************/
+   ADJ_tpCondRet ADJ_Acrescentar(ADJ_tpAdjacencia *pAdjacencia, void *pValor, unsigned int chave);
+
+/***********************************************************************
+*
+*  Funo: ADJ Procurar
+*
+*  Descrio
+*     Retorna a posio, a partir de 0, de um elemento com a chave para
+*     o qual comparar retorna 0, ou -1 se no h nenhum. comparar recebe
+*     o valor do elemento e pBuscado, e s  chamada para os elementos
+*     com a chave dada. No altera a adjacncia.
+*
+***********************************************************************/
+   int ADJ_Procurar(const ADJ_tpAdjacencia *pAdjacencia, unsigned int chave,
+                    int (*comparar)(void *pValor, void *pBuscado), void *pBuscado);
+
+/***********************************************************************
+*
+*  Funo: ADJ Nmero de elementos
+*
+***********************************************************************/
+   int ADJ_NumElementos(const ADJ_tpAdjacencia *pAdjacencia);
+
+/***********************************************************************
+*
+*  Funo: ADJ Obter valor
+*
+*  Descrio
+*     Retorna o valor da posio dada, que deve estar ocupada: obtida
+*     por ADJ_Procurar ou ADJ_PosicaoDoIterador.
+*
+***********************************************************************/
+   void * ADJ_ObterValor(const ADJ_tpAdjacencia *pAdjacencia, int posicao);
+
+/***********************************************************************
+*
+*  Funo: ADJ Retirar
+*
+*  Descrio
+*     Retira o elemento da posio dada, sem destruir o valor, e deixa a
+*     posio vaga; os demais elementos no mudam de posio, a no ser
+*     quando as vagas passam da quantidade de elementos e so eliminadas,
+*     com os elementos recuando em ordem. Quando sobram ADJ_NUM_EMBUTIDOS
+*     elementos ou menos eles voltam para dentro da adjacncia, tambm
+*     em ordem. Custa O(1) amortizado e no aloca memria.
+*
+***********************************************************************/
+   void ADJ_Retirar(ADJ_tpAdjacencia *pAdjacencia, int posicao);
+
+/***********************************************************************
+*
+*  Funo: ADJ Mover
+*
+*  Descrio
+*     Leva o elemento da posio origem para a posio destino, menor ou
+*     igual, e avana uma posio os que estavam entre elas. Com destino
+*     0 o elemento passa a ser o primeiro; com destino origem - 1, troca
+*     de lugar com o anterior. Custa O(origem - destino) e no aloca
+*     memria.
+*
+***********************************************************************/
+   void ADJ_Mover(ADJ_tpAdjacencia *pAdjacencia, int origem, int destino);
+
+/***********************************************************************
+*
+*  Funo: ADJ Iniciar iterador
+*
+*  Descrio
+*     Posiciona o iterador no primeiro elemento. O iterador continua
+*     vlido enquanto nenhum elemento for retirado ou movido.
+*
+***********************************************************************/
+   void ADJ_IniciarIterador(const ADJ_tpAdjacencia *pAdjacencia, ADJ_tpIterador *pIterador);
+
+/***********************************************************************
+*
+*  Funo: ADJ Avanar iterador
+*
+*  Descrio
+*     Entrega o valor do elemento em que o iterador est e o avana para
+*     o seguinte.
+*
+*  Condies de retorno
+*     ADJ_CondRetOK
+*     ADJ_CondRetFimAdjacencia  - ppValor no  alterado.
+*
+***********************************************************************/
+   ADJ_tpCondRet ADJ_AvancarIterador(ADJ_tpIterador *pIterador, void **ppValor);
+
+/***********************************************************************
+*
+*  Funo: ADJ Posio do iterador
+*
+*  Descrio
+*     Retorna a posio do ltimo valor entregue pelo iterador, que deve
+*     ter entregue algum, para uso em ADJ_ObterValor, ADJ_Retirar ou
+*     ADJ_Mover.
+*
+***********************************************************************/
+   int ADJ_PosicaoDoIterador(const ADJ_tpIterador *pIterador);
+
+/***********************************************************************
+*
+*  Funo: ADJ Espao alocado
+*
+*  Descrio
+*     Retorna a quantidade de bytes alocados pela adjacncia, fora da
+*     prpria estrutura: 0 enquanto os elementos esto embutidos.
+*
+***********************************************************************/
+   size_t ADJ_EspacoAlocado(const ADJ_tpAdjacencia *pAdjacencia);
+
+/***********************************************************************/
+#undef ADJACENCIA_EXT
+
+/********** Fim do mdulo de definio: ADJ  Adjacncia adaptvel ao grau **********/
+
+#else
+#endif
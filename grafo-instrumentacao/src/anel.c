@@ -0,0 +1,193 @@
+/***************************************************************************
+*  Mdulo de implementao: ANL  Anel sem trava de um produtor e um consumidor
+*
+*  Arquivo gerado:              anel.c
+*  Letras identificadoras:      ANL
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+***************************************************************************/
+
+#include   <stdlib.h>
+#include   <string.h>
+
+#ifdef _WIN32
+   #include   <windows.h>
+#endif
+
+#define ANEL_OWN
+#include "anel.h"
+#undef ANEL_OWN
+
+/* Maior capacidade aceita, para que as contas de posies no transbordem */
+#define MAX_CAPACIDADE ( 1 << 30 )
+
+/* Tamanho de linha de cache presumido na separao dos contadores */
+#define TAM_LINHA_CACHE 64
+
+/* Leitura com ordem de aquisio e escrita com ordem de liberao de um
+   contador. Em Windows as funes Interlocked j so barreiras completas */
+#ifdef _WIN32
+   #define LER_ADQUIRINDO( pContador )   InterlockedCompareExchange( (pContador) , 0 , 0 )
+   #define GRAVAR_LIBERANDO( pContador , valor )   InterlockedExchange( (pContador) , (valor) )
+#else
+   #define LER_ADQUIRINDO( pContador )   __atomic_load_n( (pContador) , __ATOMIC_ACQUIRE )
+   #define GRAVAR_LIBERANDO( pContador , valor )   __atomic_store_n( (pContador) , (valor) , __ATOMIC_RELEASE )
+#endif
+
+/***********************************************************************
+*  Tipo de dados: ANL Anel
+***********************************************************************/
+
+typedef struct ANL_stAnel {
+
+   unsigned char *vtElementos;
+   /* Espao dos elementos, capacidade vezes tamElemento bytes */
+
+   size_t tamElemento;
+   /* Tamanho de cada elemento em bytes */
+
+   long mascara;
+   /* Capacidade - 1; a posio de um contador  contador & mascara */
+
+   char separacao1[TAM_LINHA_CACHE];
+   /* Mantm os contadores em linhas de cache diferentes das acima */
+
+   volatile long cabeca;
+   /* Quantidade de elementos j publicados. Escrito s pelo produtor.
+      As contas com os contadores so feitas sem sinal, para que dem a
+      volta sem transbordar */
+
+   char separacao2[TAM_LINHA_CACHE];
+   /* Evita que escritas de um lado invalidem a linha do outro */
+
+   volatile long cauda;
+   /* Quantidade de elementos j liberados. Escrito s pelo consumidor */
+
+} tpAnel;
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: ANL Criar anel
+******/
+ANL_tpCondRet ANL_CriarAnel(ANL_tppAnel *ppAnel, size_t tamElemento, int capacidade)
+{
+   tpAnel *pAnel;
+   long capacidadeReal = 1;
+
+   while (capacidadeReal < capacidade && capacidadeReal < MAX_CAPACIDADE)
+   {
+      capacidadeReal *= 2;
+   }
+
+   pAnel = (tpAnel*) malloc(sizeof(tpAnel));
+   if (pAnel == NULL)
+   {
+      return ANL_CondRetFaltouMemoria;
+   }
+
+   pAnel->vtElementos = (unsigned char*) malloc(capacidadeReal * tamElemento);
+   if (pAnel->vtElementos == NULL)
+   {
+      free(pAnel);
+      return ANL_CondRetFaltouMemoria;
+   }
+
+   memset(pAnel->vtElementos, 0, capacidadeReal * tamElemento);
+   pAnel->tamElemento = tamElemento;
+   pAnel->mascara = capacidadeReal - 1;
+   pAnel->cabeca = 0;
+   pAnel->cauda = 0;
+
+   *ppAnel = pAnel;
+
+   return ANL_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: ANL Destruir anel
+******/
+void ANL_DestruirAnel(ANL_tppAnel pAnel)
+{
+   if (pAnel == NULL)
+   {
+      return;
+   }
+
+   free(pAnel->vtElementos);
+   free(pAnel);
+}
+
+/***************************************************************************
+*  Funo: ANL Obter capacidade
+******/
+int ANL_ObterCapacidade(ANL_tppAnel pAnel)
+{
+   return (int) pAnel->mascara + 1;
+}
+
+/***************************************************************************
+*  Funo: ANL Obter posio
+******/
+void * ANL_ObterPosicao(ANL_tppAnel pAnel, int posicao)
+{
+   return pAnel->vtElementos + posicao * pAnel->tamElemento;
+}
+
+/***************************************************************************
+*  Funo: ANL Obter espao livre
+******/
+void * ANL_ObterEspacoLivre(ANL_tppAnel pAnel)
+{
+   // A cabea s  escrita por esta linha; a cauda vem do consumidor
+   long cabeca = pAnel->cabeca;
+   long cauda = LER_ADQUIRINDO(&pAnel->cauda);
+
+   if ((unsigned long) cabeca - (unsigned long) cauda > (unsigned long) pAnel->mascara)
+   {
+      return NULL;
+   }
+
+   return pAnel->vtElementos + ((unsigned long) cabeca & pAnel->mascara) * pAnel->tamElemento;
+}
+
+/***************************************************************************
+*  Funo: ANL Publicar
+******/
+void ANL_Publicar(ANL_tppAnel pAnel)
+{
+   GRAVAR_LIBERANDO(&pAnel->cabeca, (long) ((unsigned long) pAnel->cabeca + 1));
+}
+
+/***************************************************************************
+*  Funo: ANL Nmero de publicados
+******/
+int ANL_NumPublicados(ANL_tppAnel pAnel)
+{
+   return (int) ((unsigned long) LER_ADQUIRINDO(&pAnel->cabeca) - (unsigned long) pAnel->cauda);
+}
+
+/***************************************************************************
+*  Funo: ANL Obter publicado
+******/
+void * ANL_ObterPublicado(ANL_tppAnel pAnel, int i)
+{
+   return pAnel->vtElementos +
+          (((unsigned long) pAnel->cauda + i) & pAnel->mascara) * pAnel->tamElemento;
+}
+
+/***************************************************************************
+*  Funo: ANL Liberar
+******/
+void ANL_Liberar(ANL_tppAnel pAnel, int numElementos)
+{
+   GRAVAR_LIBERANDO(&pAnel->cauda, (long) ((unsigned long) pAnel->cauda + numElementos));
+}
+
+/********** Fim do mdulo de implementao: ANL  Anel sem trava de um produtor e um consumidor **********/
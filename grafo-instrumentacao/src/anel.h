@@ -0,0 +1,175 @@
+#if ! defined( ANEL_ )
+#define ANEL_
+/***************************************************************************
+*
+*  Mdulo de definio: ANL  Anel sem trava de um produtor e um consumidor
+*
+*  Arquivo gerado:              anel.h
+*  Letras identificadoras:      ANL
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+*  Descrio do mdulo
+*     Implementa uma fila circular de elementos de tamanho fixo, em que uma
+*     linha de execuo produz e outra consome sem trava nem chamada ao
+*     sistema: cada lado escreve s o seu contador, e a leitura do
+*     contador do outro lado  feita com ordem de memria de aquisio.
+*
+*     O produtor obtm o espao do prximo elemento, o preenche e o
+*     publica. O consumidor l os elementos publicados no lugar e os
+*     libera quando no precisar mais deles. Enquanto no  liberado, um
+*     elemento no  reescrito, de forma que ponteiros guardados nele
+*     continuam vlidos para o consumidor.
+*
+*     O espao dos elementos no  zerado ao ser reaproveitado: o
+*     produtor encontra nele o que escreveu na volta anterior do anel.
+*
+*     O anel em si  criado e destrudo por uma s linha, quando nenhuma
+*     das duas o est usando.
+*
+***************************************************************************/
+
+#if defined( ANEL_OWN )
+   #define ANEL_EXT
+#else
+   #define ANEL_EXT extern
+#endif
+
+#include   <stddef.h>
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/* Tipo referncia para um anel */
+typedef struct ANL_stAnel * ANL_tppAnel ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: ANL Condies de retorno
+*
+***********************************************************************/
+
+   typedef enum {
+
+         ANL_CondRetOK ,
+               /* Concluiu corretamente */
+
+         ANL_CondRetFaltouMemoria
+               /* Faltou memria */
+
+   } ANL_tpCondRet ;
+
+
+/***********************************************************************
+*
+*  Funo: ANL Criar anel
+*
+*  Descrio
+*     Cria um anel vazio com espao para pelo menos capacidade elementos
+*     de tamElemento bytes. A capacidade  arredondada para potncia de 2.
+*     O espao de todos os elementos comea zerado.
+*
+*  Condies de retorno
+*     ANL_CondRetOK
+*     ANL_CondRetFaltouMemoria
+*
+***********************************************************************/
+   ANL_tpCondRet ANL_CriarAnel(ANL_tppAnel *ppAnel, size_t tamElemento, int capacidade);
+
+/***********************************************************************
+*
+*  Funo: ANL Destruir anel
+*
+*  Descrio
+*     Libera o anel. Aceita NULL.
+*
+***********************************************************************/
+   void ANL_DestruirAnel(ANL_tppAnel pAnel);
+
+/***********************************************************************
+*
+*  Funo: ANL Obter capacidade
+*
+***********************************************************************/
+   int ANL_ObterCapacidade(ANL_tppAnel pAnel);
+
+/***********************************************************************
+*
+*  Funo: ANL Obter posio
+*
+*  Descrio
+*     Retorna o espao da posio dada, de 0 a capacidade - 1, esteja ela
+*     ocupada ou no. Destinada a quem cria ou destri o anel, para
+*     iniciar ou liberar o que os elementos guardam.
+*
+***********************************************************************/
+   void * ANL_ObterPosicao(ANL_tppAnel pAnel, int posicao);
+
+/***********************************************************************
+*
+*  Funo: ANL Obter espao livre
+*
+*  Descrio
+*     Usada pelo produtor. Retorna o espao do prximo elemento a
+*     publicar, ou NULL se o anel est cheio.
+*
+***********************************************************************/
+   void * ANL_ObterEspacoLivre(ANL_tppAnel pAnel);
+
+/***********************************************************************
+*
+*  Funo: ANL Publicar
+*
+*  Descrio
+*     Usada pelo produtor, depois de preencher o espao retornado por
+*     ANL_ObterEspacoLivre. Tudo o que foi escrito antes fica visvel ao
+*     consumidor junto com o elemento.
+*
+***********************************************************************/
+   void ANL_Publicar(ANL_tppAnel pAnel);
+
+/***********************************************************************
+*
+*  Funo: ANL Nmero de publicados
+*
+*  Descrio
+*     Usada pelo consumidor. Retorna quantos elementos foram publicados e
+*     ainda no liberados.
+*
+***********************************************************************/
+   int ANL_NumPublicados(ANL_tppAnel pAnel);
+
+/***********************************************************************
+*
+*  Funo: ANL Obter publicado
+*
+*  Descrio
+*     Usada pelo consumidor. Retorna o i-simo elemento publicado e ainda
+*     no liberado, do mais antigo, 0, a ANL_NumPublicados - 1.
+*
+***********************************************************************/
+   void * ANL_ObterPublicado(ANL_tppAnel pAnel, int i);
+
+/***********************************************************************
+*
+*  Funo: ANL Liberar
+*
+*  Descrio
+*     Usada pelo consumidor. Devolve ao produtor os numElementos
+*     publicados mais antigos.
+*
+***********************************************************************/
+   void ANL_Liberar(ANL_tppAnel pAnel, int numElementos);
+
+/***********************************************************************/
+#undef ANEL_EXT
+
+/********** Fim do mdulo de definio: ANL  Anel sem trava de um produtor e um consumidor **********/
+
+#else
+#endif
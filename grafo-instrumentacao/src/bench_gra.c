@@ -0,0 +1,704 @@
+/***************************************************************************
+*
+*  Mdulo de implementao: BGRA Medio de desempenho do grafo
+*
+*  Arquivo gerado:              bench_gra.c
+*  Letras identificadoras:      BGRA
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Medio de percursos antes e depois de GRA_Reordenar.
+*     1.1     rc       19/out/26   Medio da busca de arestas em cada modo de chave.
+*     1.2     rc       19/out/26   Espao e busca de arestas com graus em lei de potncia.
+*
+*  Descrio do mdulo
+*     Programa independente, que no usa o arcabouo de teste. Monta uma
+*     grade dirigida (cada clula aponta para a da direita e para a de
+*     baixo) inserindo as clulas em ordem aleatria e intercalando
+*     alocaes de outros dados, como aconteceria numa aplicao real.
+*     Para cada ordem de GRA_Reordenar, monta a grade de novo, reordena e
+*     mede percursos em largura a partir do canto superior esquerdo.
+*
+*     Depois compara os modos de chave: em grafos com lado*lado vrtices,
+*     cada um com GRAU_CHAVES arestas de nomes do mesmo tamanho que s
+*     diferem no final, mede a busca de arestas com nomes de tamanho
+*     varivel e com chaves fixas de 16 e 32 bytes.
+*
+*     Por fim monta um grafo com lado*lado vrtices cujos graus seguem uma
+*     lei de potncia (o i-simo vrtice tem cerca de lado*lado/(4i)
+*     arestas, a maioria tem s duas) e mede o espao das adjacncias de
+*     sucessores, comparado com o de listas, e a busca de arestas num
+*     passeio aleatrio, que passa mais pelos vrtices de grau alto.
+*
+*     Uso: bench_gra [lado [repeticoes]]
+*
+*     O tempo  medido com clock. As falhas de cache so lidas dos
+*     contadores de hardware em Linux (perf_event_open); se o contador no
+*     estiver disponvel  impresso "n/d".
+*
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "grafo.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define LADO_PADRAO        60
+#define REPETICOES_PADRAO  50
+#define TAM_RUIDO          192
+#define GRAU_CHAVES        32
+#define FRACAO_HUB         4
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+   static GRA_tppGrafo MontarGrade(int lado, void **vtRuido);
+   static void LiberarRuido(void **vtRuido, int numRuido);
+   static char * CriarNome(char prefixo, int linha, int coluna);
+   static int ContarVisitados(char *nomeVertice, void *pValor, void *pContexto);
+   static int PertenceATodos(char *nomeVertice, void *pValor, void *pContexto);
+   static void Medir(GRA_tppGrafo pGrafo, int repeticoes, double *pMilissegundos,
+      long long *pFalhasCache, int *pVisitados);
+   static double MedirChaves(int lado, int repeticoes, int larguraChave);
+   static double MedirLeiDePotencia(int lado, int repeticoes, int *pNumArestas,
+      int *pMaiorGrau, size_t *pEspaco, size_t *pEspacoEmListas);
+   static int AbrirContador(void);
+   static long long LerContador(int descritor);
+   static void FecharContador(int descritor);
+
+/***** Cdigo das funes exportadas pelo mdulo  *****/
+
+/***********************************************************************
+*
+*  Funo: BGRA Principal
+*
+***********************************************************************/
+
+   int main(int argc, char **argv)
+   {
+      static const char *vtNomesOrdens[] = {
+         "insercao", "largura", "cuthill-mckee", "grau" };
+      int lado = LADO_PADRAO, repeticoes = REPETICOES_PADRAO;
+      int ordem;
+
+      if (argc > 1)
+      {
+         lado = atoi(argv[1]);
+      }
+      if (argc > 2)
+      {
+         repeticoes = atoi(argv[2]);
+      }
+      if (lado < 2 || repeticoes < 1)
+      {
+         fprintf(stderr, "Uso: %s [lado [repeticoes]]\n", argv[0]);
+         return 1;
+      }
+
+      printf("Grade %dx%d, %d vertices, %d percursos por ordem\n",
+             lado, lado, lado * lado, repeticoes);
+      printf("%-15s %12s %12s %18s\n", "ordem", "visitados", "ms/percurso", "falhas/percurso");
+
+      for (ordem = -1; ordem <= (int) GRA_OrdemGrau; ordem++)
+      {
+         void **vtRuido = (void**) malloc(lado * lado * sizeof(void*));
+         GRA_tppGrafo pGrafo;
+         double milissegundos = 0;
+         long long falhasCache = -1;
+         int visitados = 0;
+
+         // A mesma semente em todas as ordens para que a grade seja idntica
+         srand(1301);
+         pGrafo = MontarGrade(lado, vtRuido);
+         if (pGrafo == NULL)
+         {
+            fprintf(stderr, "Faltou memoria ao montar a grade\n");
+            return 1;
+         }
+
+         if (ordem >= 0 && GRA_Reordenar(pGrafo, (GRA_tpOrdem) ordem) != GRA_CondRetOK)
+         {
+            fprintf(stderr, "Faltou memoria ao reordenar\n");
+            return 1;
+         }
+
+         Medir(pGrafo, repeticoes, &milissegundos, &falhasCache, &visitados);
+
+         if (falhasCache >= 0)
+         {
+            printf("%-15s %12d %12.3f %18lld\n", vtNomesOrdens[ordem + 1], visitados,
+                   milissegundos / repeticoes, falhasCache / repeticoes);
+         }
+         else
+         {
+            printf("%-15s %12d %12.3f %18s\n", vtNomesOrdens[ordem + 1], visitados,
+                   milissegundos / repeticoes, "n/d");
+         }
+
+         GRA_DestruirGrafo(&pGrafo);
+         LiberarRuido(vtRuido, lado * lado);
+      }
+
+      printf("\nBusca de arestas, %d arestas por vertice\n", GRAU_CHAVES);
+      printf("%-15s %12s\n", "chave", "ns/busca");
+
+      for (ordem = 0; ordem <= 32; ordem += 16)
+      {
+         double nanossegundos = MedirChaves(lado, repeticoes, ordem);
+
+         if (nanossegundos < 0)
+         {
+            fprintf(stderr, "Faltou memoria ao montar o grafo de chaves\n");
+            return 1;
+         }
+
+         if (ordem == 0)
+         {
+            printf("%-15s %12.1f\n", "variavel", nanossegundos);
+         }
+         else
+         {
+            printf("fixa %-10d %12.1f\n", ordem, nanossegundos);
+         }
+      }
+
+      {
+         int numArestas = 0, maiorGrau = 0;
+         size_t espaco = 0, espacoEmListas = 0;
+         double nanossegundos = MedirLeiDePotencia(lado, repeticoes, &numArestas, &maiorGrau,
+                                                   &espaco, &espacoEmListas);
+
+         if (nanossegundos < 0)
+         {
+            fprintf(stderr, "Faltou memoria ao montar o grafo em lei de potencia\n");
+            return 1;
+         }
+
+         printf("\nLei de potencia, %d vertices, %d arestas, maior grau %d\n",
+                lado * lado, numArestas, maiorGrau);
+         printf("%-15s %12s %12s\n", "sucessores", "bytes", "bytes/vert");
+         printf("%-15s %12lu %12.1f\n", "adjacencias", (unsigned long) espaco,
+                (double) espaco / (lado * lado));
+         printf("%-15s %12lu %12.1f\n", "listas", (unsigned long) espacoEmListas,
+                (double) espacoEmListas / (lado * lado));
+         printf("%-15s %12.1f\n", "ns/busca", nanossegundos);
+      }
+
+      return 0;
+   }
+
+/***** Cdigo das funes encapsuladas no mdulo  *****/
+
+/***********************************************************************
+*
+*  Funo: BGRA Montar grade
+*
+*  Descrio:
+*    Insere as clulas em ordem aleatria e depois as arestas, tambm em
+*    ordem aleatria. Aps cada vrtice aloca um bloco de rudo, guardado
+*    em vtRuido, que s  liberado depois do grafo.
+*    Retorna NULL se faltou memria.
+*
+***********************************************************************/
+
+   GRA_tppGrafo MontarGrade(int lado, void **vtRuido)
+   {
+      GRA_tppGrafo pGrafo = NULL;
+      int numCelulas = lado * lado;
+      int *vtPermutacao;
+      int i;
+
+      vtPermutacao = (int*) malloc(numCelulas * sizeof(int));
+      if (vtPermutacao == NULL || GRA_CriarGrafo(&pGrafo, free) != GRA_CondRetOK)
+      {
+         free(vtPermutacao);
+         return NULL;
+      }
+
+      for (i = 0; i < numCelulas; i++)
+      {
+         vtPermutacao[i] = i;
+      }
+      for (i = numCelulas - 1; i > 0; i--)
+      {
+         int j = rand() % (i + 1);
+         int troca = vtPermutacao[i];
+         vtPermutacao[i] = vtPermutacao[j];
+         vtPermutacao[j] = troca;
+      }
+
+      for (i = 0; i < numCelulas; i++)
+      {
+         int celula = vtPermutacao[i];
+         int *pValor = (int*) malloc(sizeof(int));
+
+         *pValor = celula;
+         GRA_InserirVertice(pGrafo, CriarNome('v', celula / lado, celula % lado), pValor);
+         if (celula == 0)
+         {
+            GRA_TornarCorrenteUmaOrigem(pGrafo);
+         }
+
+         vtRuido[i] = malloc(TAM_RUIDO + rand() % TAM_RUIDO);
+      }
+
+      for (i = 0; i < numCelulas; i++)
+      {
+         int celula = vtPermutacao[numCelulas - 1 - i];
+         int linha = celula / lado, coluna = celula % lado;
+         char *nomeOrigem = CriarNome('v', linha, coluna);
+
+         if (coluna + 1 < lado)
+         {
+            char *nomeDestino = CriarNome('v', linha, coluna + 1);
+            GRA_InserirAresta(pGrafo, CriarNome('d', linha, coluna), nomeOrigem, nomeDestino);
+            free(nomeDestino);
+         }
+         if (linha + 1 < lado)
+         {
+            char *nomeDestino = CriarNome('v', linha + 1, coluna);
+            GRA_InserirAresta(pGrafo, CriarNome('b', linha, coluna), nomeOrigem, nomeDestino);
+            free(nomeDestino);
+         }
+
+         free(nomeOrigem);
+      }
+
+      free(vtPermutacao);
+
+      return pGrafo;
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Liberar rudo
+*
+***********************************************************************/
+
+   void LiberarRuido(void **vtRuido, int numRuido)
+   {
+      int i;
+
+      for (i = 0; i < numRuido; i++)
+      {
+         free(vtRuido[i]);
+      }
+
+      free(vtRuido);
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Criar nome
+*
+***********************************************************************/
+
+   char * CriarNome(char prefixo, int linha, int coluna)
+   {
+      char *nome = (char*) malloc(32);
+      sprintf(nome, "%c%d_%d", prefixo, linha, coluna);
+      return nome;
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Contar visitados
+*
+***********************************************************************/
+
+   int ContarVisitados(char *nomeVertice, void *pValor, void *pContexto)
+   {
+      (void) nomeVertice;
+      (void) pValor;
+
+      (*(int*) pContexto)++;
+      return 0;
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Pertence a todos
+*
+***********************************************************************/
+
+   int PertenceATodos(char *nomeVertice, void *pValor, void *pContexto)
+   {
+      (void) nomeVertice;
+      (void) pValor;
+      (void) pContexto;
+
+      return 1;
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Medir
+*
+*  Descrio:
+*    Executa os percursos sobre uma viso com o grafo inteiro e retorna
+*    o tempo total, o total de falhas de cache (-1 se indisponvel) e a
+*    quantidade de vrtices visitados por percurso.
+*
+***********************************************************************/
+
+   void Medir(GRA_tppGrafo pGrafo, int repeticoes, double *pMilissegundos,
+      long long *pFalhasCache, int *pVisitados)
+   {
+      GRA_tppVisao pVisao = NULL;
+      GRA_tppMarcador pMarcador = NULL;
+      char *nomeInicio = CriarNome('v', 0, 0);
+      int descritor, i;
+      clock_t inicio;
+
+      GRA_CriarVisao(pGrafo, &pVisao, PertenceATodos, NULL);
+      GRA_CriarMarcador(pGrafo, &pMarcador);
+
+      // Um percurso de aquecimento, que tambm dimensiona o marcador
+      GRA_VisaoPercorrerEmLargura(pVisao, nomeInicio, pMarcador, ContarVisitados, pVisitados);
+
+      descritor = AbrirContador();
+      inicio = clock();
+
+      for (i = 0; i < repeticoes; i++)
+      {
+         int visitados = 0;
+         GRA_ReiniciarMarcador(pMarcador);
+         GRA_VisaoPercorrerEmLargura(pVisao, nomeInicio, pMarcador, ContarVisitados, &visitados);
+      }
+
+      *pMilissegundos = 1000.0 * (clock() - inicio) / CLOCKS_PER_SEC;
+      *pFalhasCache = LerContador(descritor);
+      FecharContador(descritor);
+
+      GRA_DestruirMarcador(&pMarcador);
+      GRA_DestruirVisao(&pVisao);
+      free(nomeInicio);
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Medir chaves
+*
+*  Descrio:
+*    Monta um grafo com lado*lado vrtices, cada um com GRAU_CHAVES
+*    arestas para vrtices aleatrios, e caminha por ele seguindo
+*    arestas escolhidas ao acaso, com os nomes preparados antes da
+*    medio. Com larguraChave 0 o grafo usa nomes de tamanho varivel.
+*    Retorna o tempo mdio de cada passo em nanossegundos, ou -1 se
+*    faltou memria.
+*
+***********************************************************************/
+
+   double MedirChaves(int lado, int repeticoes, int larguraChave)
+   {
+      GRA_tppGrafo pGrafo = NULL;
+      int numVertices = lado * lado;
+      int numPassos = numVertices * repeticoes;
+      char vtArestas[GRAU_CHAVES][16];
+      char nomeOrigem[16];
+      char **vtPassos;
+      GRA_tpCondRet condRet;
+      clock_t inicio;
+      double nanossegundos;
+      int i, j;
+
+      if (larguraChave == 0)
+      {
+         condRet = GRA_CriarGrafo(&pGrafo, free);
+      }
+      else
+      {
+         condRet = GRA_CriarGrafoComChavesFixas(&pGrafo, free, larguraChave);
+      }
+
+      vtPassos = (char**) malloc(numPassos * sizeof(char*));
+      if (condRet != GRA_CondRetOK || vtPassos == NULL)
+      {
+         free(vtPassos);
+         GRA_DestruirGrafo(&pGrafo);
+         return -1;
+      }
+
+      // Nomes com 15 caracteres, que diferem s nos trs ltimos
+      for (j = 0; j < GRAU_CHAVES; j++)
+      {
+         sprintf(vtArestas[j], "aresta/longa%03d", j);
+      }
+
+      srand(1301);
+      for (i = 0; i < numVertices; i++)
+      {
+         GRA_InserirVertice(pGrafo, CriarNome('k', i / lado, i % lado), NULL);
+         if (i == 0)
+         {
+            GRA_TornarCorrenteUmaOrigem(pGrafo);
+         }
+      }
+      for (i = 0; i < numVertices; i++)
+      {
+         char *nomeVertice = CriarNome('k', i / lado, i % lado);
+
+         for (j = 0; j < GRAU_CHAVES; j++)
+         {
+            int destino = rand() % numVertices;
+            char *nomeDestino = CriarNome('k', destino / lado, destino % lado);
+            char *nomeAresta = (char*) malloc(sizeof(vtArestas[j]));
+
+            strcpy(nomeAresta, vtArestas[j]);
+            GRA_InserirAresta(pGrafo, nomeAresta, nomeVertice, nomeDestino);
+            free(nomeDestino);
+         }
+
+         free(nomeVertice);
+      }
+
+      for (i = 0; i < numPassos; i++)
+      {
+         vtPassos[i] = vtArestas[rand() % GRAU_CHAVES];
+      }
+
+      sprintf(nomeOrigem, "k0_0");
+      GRA_IrParaAOrigem(pGrafo, nomeOrigem);
+
+      inicio = clock();
+
+      for (i = 0; i < numPassos; i++)
+      {
+         GRA_SeguirPelaAresta(pGrafo, vtPassos[i]);
+      }
+
+      nanossegundos = 1e9 * (clock() - inicio) / CLOCKS_PER_SEC / numPassos;
+
+      free(vtPassos);
+      GRA_DestruirGrafo(&pGrafo);
+
+      return nanossegundos;
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Medir lei de potncia
+*
+*  Descrio:
+*    Monta um grafo com lado*lado vrtices em que o i-simo tem
+*    2 + lado*lado/(FRACAO_HUB*(i+1)) arestas. Cada destino  a origem de
+*    uma aresta sorteada, de forma que os vrtices com mais arestas
+*    tambm recebem mais. Obtm o espao dos sucessores e caminha pelo
+*    grafo seguindo arestas sorteadas, com os nomes preparados antes da
+*    medio. Retorna o tempo mdio de cada passo em nanossegundos, ou
+*    -1 se faltou memria.
+*
+***********************************************************************/
+
+   double MedirLeiDePotencia(int lado, int repeticoes, int *pNumArestas,
+      int *pMaiorGrau, size_t *pEspaco, size_t *pEspacoEmListas)
+   {
+      GRA_tppGrafo pGrafo = NULL;
+      int numVertices = lado * lado;
+      int numPassos = numVertices * repeticoes;
+      int maiorGrau = 2 + numVertices / FRACAO_HUB;
+      int numArestas = 0;
+      int *vtInicio, *vtOrigens, *vtDestinos;
+      char (*vtNomes)[16];
+      char **vtPassos;
+      char nomeOrigem[16];
+      clock_t inicio;
+      double nanossegundos;
+      int i, j, vertice;
+
+      vtInicio = (int*) malloc((numVertices + 1) * sizeof(int));
+      vtNomes = (char(*)[16]) malloc(maiorGrau * sizeof(*vtNomes));
+      vtPassos = (char**) malloc(numPassos * sizeof(char*));
+      if (vtInicio == NULL || vtNomes == NULL || vtPassos == NULL ||
+          GRA_CriarGrafo(&pGrafo, free) != GRA_CondRetOK)
+      {
+         free(vtInicio);
+         free(vtNomes);
+         free(vtPassos);
+         return -1;
+      }
+
+      for (i = 0; i < numVertices; i++)
+      {
+         vtInicio[i] = numArestas;
+         numArestas += 2 + numVertices / (FRACAO_HUB * (i + 1));
+      }
+      vtInicio[numVertices] = numArestas;
+
+      vtOrigens = (int*) malloc(2 * (size_t) numArestas * sizeof(int));
+      if (vtOrigens == NULL)
+      {
+         free(vtInicio);
+         free(vtNomes);
+         free(vtPassos);
+         GRA_DestruirGrafo(&pGrafo);
+         return -1;
+      }
+      vtDestinos = vtOrigens + numArestas;
+
+      for (j = 0; j < maiorGrau; j++)
+      {
+         sprintf(vtNomes[j], "aresta%d", j);
+      }
+
+      srand(1301);
+      for (i = 0; i < numVertices; i++)
+      {
+         GRA_InserirVertice(pGrafo, CriarNome('p', i / lado, i % lado), NULL);
+         if (i == 0)
+         {
+            GRA_TornarCorrenteUmaOrigem(pGrafo);
+         }
+
+         for (j = vtInicio[i]; j < vtInicio[i + 1]; j++)
+         {
+            vtOrigens[j] = i;
+         }
+      }
+
+      for (i = 0; i < numVertices; i++)
+      {
+         char *nomeVertice = CriarNome('p', i / lado, i % lado);
+
+         for (j = vtInicio[i]; j < vtInicio[i + 1]; j++)
+         {
+            int destino = vtOrigens[rand() % numArestas];
+            char *nomeDestino = CriarNome('p', destino / lado, destino % lado);
+            char *nomeAresta = (char*) malloc(sizeof(vtNomes[0]));
+
+            strcpy(nomeAresta, vtNomes[j - vtInicio[i]]);
+            GRA_InserirAresta(pGrafo, nomeAresta, nomeVertice, nomeDestino);
+            vtDestinos[j] = destino;
+            free(nomeDestino);
+         }
+
+         free(nomeVertice);
+      }
+
+      GRA_ObterEspacoDosSucessores(pGrafo, pEspaco, pEspacoEmListas);
+
+      vertice = 0;
+      for (i = 0; i < numPassos; i++)
+      {
+         j = rand() % (vtInicio[vertice + 1] - vtInicio[vertice]);
+         vtPassos[i] = vtNomes[j];
+         vertice = vtDestinos[vtInicio[vertice] + j];
+      }
+
+      sprintf(nomeOrigem, "p0_0");
+      GRA_IrParaAOrigem(pGrafo, nomeOrigem);
+
+      inicio = clock();
+
+      for (i = 0; i < numPassos; i++)
+      {
+         GRA_SeguirPelaAresta(pGrafo, vtPassos[i]);
+      }
+
+      nanossegundos = 1e9 * (clock() - inicio) / CLOCKS_PER_SEC / numPassos;
+
+      *pNumArestas = numArestas;
+      *pMaiorGrau = maiorGrau;
+
+      free(vtInicio);
+      free(vtOrigens);
+      free(vtNomes);
+      free(vtPassos);
+      GRA_DestruirGrafo(&pGrafo);
+
+      return nanossegundos;
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Abrir contador
+*
+*  Descrio:
+*    Abre e zera o contador de falhas de cache do processo corrente.
+*    Retorna -1 se no houver contador disponvel.
+*
+***********************************************************************/
+
+   int AbrirContador(void)
+   {
+#ifdef __linux__
+      struct perf_event_attr atributos;
+      int descritor;
+
+      memset(&atributos, 0, sizeof(atributos));
+      atributos.type = PERF_TYPE_HARDWARE;
+      atributos.size = sizeof(atributos);
+      atributos.config = PERF_COUNT_HW_CACHE_MISSES;
+      atributos.disabled = 1;
+      atributos.exclude_kernel = 1;
+      atributos.exclude_hv = 1;
+
+      descritor = (int) syscall(__NR_perf_event_open, &atributos, 0, -1, -1, 0);
+      if (descritor >= 0)
+      {
+         ioctl(descritor, PERF_EVENT_IOC_RESET, 0);
+         ioctl(descritor, PERF_EVENT_IOC_ENABLE, 0);
+      }
+
+      return descritor;
+#else
+      return -1;
+#endif
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Ler contador
+*
+***********************************************************************/
+
+   long long LerContador(int descritor)
+   {
+#ifdef __linux__
+      long long valor = -1;
+
+      if (descritor < 0)
+      {
+         return -1;
+      }
+
+      ioctl(descritor, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(descritor, &valor, sizeof(valor)) != sizeof(valor))
+      {
+         return -1;
+      }
+
+      return valor;
+#else
+      return -1;
+#endif
+   }
+
+/***********************************************************************
+*
+*  Funo: BGRA Fechar contador
+*
+***********************************************************************/
+
+   void FecharContador(int descritor)
+   {
+#ifdef __linux__
+      if (descritor >= 0)
+      {
+         close(descritor);
+      }
+#endif
+   }
+
+/********** Fim do mdulo de implementao: BGRA Medio de desempenho do grafo **********/
@@ -0,0 +1,424 @@
+/***************************************************************************
+*  Mdulo de implementao: CNJ  Conjunto de identificadores com contagem
+*
+*  Arquivo gerado:              conjunto.c
+*  Letras identificadoras:      CNJ
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+***************************************************************************/
+
+#include   <stdlib.h>
+#include   <string.h>
+
+#define CONJUNTO_OWN
+#include "conjunto.h"
+#undef CONJUNTO_OWN
+
+/* Capacidade inicial do vetor ordenado */
+#define CAPACIDADE_INICIAL 4
+
+/* Marca de posio livre na tabela de espalhamento */
+#define CHAVE_LIVRE -1
+
+/***********************************************************************
+*  Tipo de dados: CNJ Entrada
+***********************************************************************/
+
+typedef struct {
+
+   int chave;
+   /* Chave, ou CHAVE_LIVRE numa posio vazia da tabela */
+
+   int contagem;
+   /* Ocorrncias da chave */
+
+} tpEntrada;
+
+/***********************************************************************
+*  Tipo de dados: CNJ Conjunto
+***********************************************************************/
+
+typedef struct CNJ_stConjunto {
+
+   tpEntrada *vtEntradas;
+   /* Vetor ordenado pela chave ou tabela de espalhamento */
+
+   int numChaves;
+   /* Quantidade de chaves distintas */
+
+   int capacidade;
+   /* Posies de vtEntradas; potncia de 2 na tabela */
+
+   int bitsTabela;
+   /* log2 da capacidade da tabela, ou 0 enquanto o vetor  ordenado */
+
+} tpConjunto;
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+   static int BuscarOrdenado(tpConjunto *pConjunto, int chave, int *pPosicao);
+   static int BuscarNaTabela(tpConjunto *pConjunto, int chave, int *pPosicao);
+   static unsigned int Espalhar(int chave, int bitsTabela);
+   static tpEntrada * CriarTabela(int bitsTabela);
+   static void InserirNaTabela(tpEntrada *vtTabela, int bitsTabela, tpEntrada entrada);
+   static void RemoverDaTabela(tpConjunto *pConjunto, int posicao);
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: CNJ Acrescentar
+******/
+CNJ_tpCondRet CNJ_Acrescentar(CNJ_tppConjunto *ppConjunto, int chave)
+{
+   tpConjunto *pConjunto = *ppConjunto;
+   tpEntrada nova;
+   int posicao;
+
+   if (pConjunto == NULL)
+   {
+      pConjunto = (tpConjunto*) malloc(sizeof(tpConjunto));
+      if (pConjunto == NULL)
+      {
+         return CNJ_CondRetFaltouMemoria;
+      }
+      pConjunto->vtEntradas = (tpEntrada*) malloc(CAPACIDADE_INICIAL * sizeof(tpEntrada));
+      if (pConjunto->vtEntradas == NULL)
+      {
+         free(pConjunto);
+         return CNJ_CondRetFaltouMemoria;
+      }
+      pConjunto->numChaves = 0;
+      pConjunto->capacidade = CAPACIDADE_INICIAL;
+      pConjunto->bitsTabela = 0;
+      *ppConjunto = pConjunto;
+   }
+
+   nova.chave = chave;
+   nova.contagem = 1;
+
+   if (pConjunto->bitsTabela == 0)
+   {
+      if (BuscarOrdenado(pConjunto, chave, &posicao))
+      {
+         pConjunto->vtEntradas[posicao].contagem++;
+         return CNJ_CondRetOK;
+      }
+
+      if (pConjunto->numChaves < CNJ_LIMITE_ORDENADO)
+      {
+         if (pConjunto->numChaves == pConjunto->capacidade)
+         {
+            tpEntrada *vtEntradas = (tpEntrada*) realloc(pConjunto->vtEntradas,
+                                       2 * pConjunto->capacidade * sizeof(tpEntrada));
+            if (vtEntradas == NULL)
+            {
+               return CNJ_CondRetFaltouMemoria;
+            }
+            pConjunto->vtEntradas = vtEntradas;
+            pConjunto->capacidade *= 2;
+         }
+
+         memmove(pConjunto->vtEntradas + posicao + 1, pConjunto->vtEntradas + posicao,
+                 (pConjunto->numChaves - posicao) * sizeof(tpEntrada));
+         pConjunto->vtEntradas[posicao] = nova;
+         pConjunto->numChaves++;
+         return CNJ_CondRetOK;
+      }
+   }
+   else if (BuscarNaTabela(pConjunto, chave, &posicao))
+   {
+      pConjunto->vtEntradas[posicao].contagem++;
+      return CNJ_CondRetOK;
+   }
+
+   // Vetor ordenado cheio ou tabela mais que meio cheia: troca por uma
+   // tabela maior, com pelo menos o qudruplo das chaves
+   if (pConjunto->bitsTabela == 0 || 2 * (pConjunto->numChaves + 1) > pConjunto->capacidade)
+   {
+      int bitsTabela = pConjunto->bitsTabela == 0 ? 6 : pConjunto->bitsTabela + 1;
+      tpEntrada *vtTabela = CriarTabela(bitsTabela);
+      int i;
+
+      if (vtTabela == NULL)
+      {
+         return CNJ_CondRetFaltouMemoria;
+      }
+
+      for (i = 0; i < pConjunto->capacidade; i++)
+      {
+         if (pConjunto->bitsTabela == 0 ? i < pConjunto->numChaves
+                                        : pConjunto->vtEntradas[i].chave != CHAVE_LIVRE)
+         {
+            InserirNaTabela(vtTabela, bitsTabela, pConjunto->vtEntradas[i]);
+         }
+      }
+
+      free(pConjunto->vtEntradas);
+      pConjunto->vtEntradas = vtTabela;
+      pConjunto->bitsTabela = bitsTabela;
+      pConjunto->capacidade = 1 << bitsTabela;
+   }
+
+   InserirNaTabela(pConjunto->vtEntradas, pConjunto->bitsTabela, nova);
+   pConjunto->numChaves++;
+
+   return CNJ_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: CNJ Retirar
+******/
+CNJ_tpCondRet CNJ_Retirar(CNJ_tppConjunto pConjunto, int chave)
+{
+   int posicao;
+
+   if (pConjunto == NULL)
+   {
+      return CNJ_CondRetNaoAchou;
+   }
+
+   if (pConjunto->bitsTabela == 0)
+   {
+      if (!BuscarOrdenado(pConjunto, chave, &posicao))
+      {
+         return CNJ_CondRetNaoAchou;
+      }
+      if (--pConjunto->vtEntradas[posicao].contagem == 0)
+      {
+         pConjunto->numChaves--;
+         memmove(pConjunto->vtEntradas + posicao, pConjunto->vtEntradas + posicao + 1,
+                 (pConjunto->numChaves - posicao) * sizeof(tpEntrada));
+      }
+      return CNJ_CondRetOK;
+   }
+
+   if (!BuscarNaTabela(pConjunto, chave, &posicao))
+   {
+      return CNJ_CondRetNaoAchou;
+   }
+   if (--pConjunto->vtEntradas[posicao].contagem == 0)
+   {
+      RemoverDaTabela(pConjunto, posicao);
+      pConjunto->numChaves--;
+   }
+
+   return CNJ_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: CNJ Contar
+******/
+int CNJ_Contar(CNJ_tppConjunto pConjunto, int chave)
+{
+   int posicao;
+
+   if (pConjunto == NULL)
+   {
+      return 0;
+   }
+
+   if (pConjunto->bitsTabela == 0 ? BuscarOrdenado(pConjunto, chave, &posicao)
+                                  : BuscarNaTabela(pConjunto, chave, &posicao))
+   {
+      return pConjunto->vtEntradas[posicao].contagem;
+   }
+
+   return 0;
+}
+
+/***************************************************************************
+*  Funo: CNJ Nmero de chaves
+******/
+int CNJ_NumChaves(CNJ_tppConjunto pConjunto)
+{
+   return pConjunto == NULL ? 0 : pConjunto->numChaves;
+}
+
+/***************************************************************************
+*  Funo: CNJ Destruir
+******/
+void CNJ_Destruir(CNJ_tppConjunto pConjunto)
+{
+   if (pConjunto == NULL)
+   {
+      return;
+   }
+
+   free(pConjunto->vtEntradas);
+   free(pConjunto);
+}
+
+/*****  Cdigo das funes encapsuladas no mdulo  *****/
+
+/***********************************************************************
+*
+*  Funo: CNJ Buscar no vetor ordenado
+*
+*  Descrio:
+*    Busca binria. Retorna 1 se achou; *pPosicao recebe a posio da
+*    chave ou aquela em que ela deveria ser inserida.
+*
+***********************************************************************/
+int BuscarOrdenado(tpConjunto *pConjunto, int chave, int *pPosicao)
+{
+   int inicio = 0, fim = pConjunto->numChaves;
+
+   while (inicio < fim)
+   {
+      int meio = (inicio + fim) / 2;
+
+      if (pConjunto->vtEntradas[meio].chave < chave)
+      {
+         inicio = meio + 1;
+      }
+      else
+      {
+         fim = meio;
+      }
+   }
+
+   *pPosicao = inicio;
+
+   return inicio < pConjunto->numChaves && pConjunto->vtEntradas[inicio].chave == chave;
+}
+
+/***********************************************************************
+*
+*  Funo: CNJ Buscar na tabela
+*
+*  Descrio:
+*    Sondagem linear a partir da posio de espalhamento. Retorna 1 se
+*    achou; *pPosicao recebe a posio da chave.
+*
+***********************************************************************/
+int BuscarNaTabela(tpConjunto *pConjunto, int chave, int *pPosicao)
+{
+   unsigned int mascara = (unsigned int) pConjunto->capacidade - 1;
+   unsigned int posicao = Espalhar(chave, pConjunto->bitsTabela);
+
+   while (pConjunto->vtEntradas[posicao].chave != CHAVE_LIVRE)
+   {
+      if (pConjunto->vtEntradas[posicao].chave == chave)
+      {
+         *pPosicao = (int) posicao;
+         return 1;
+      }
+      posicao = (posicao + 1) & mascara;
+   }
+
+   return 0;
+}
+
+/***********************************************************************
+*
+*  Funo: CNJ Espalhar
+*
+*  Descrio:
+*    Espalhamento multiplicativo de Fibonacci: usa os bits altos do
+*    produto, que dependem de todos os bits da chave.
+*
+***********************************************************************/
+unsigned int Espalhar(int chave, int bitsTabela)
+{
+   unsigned long produto = ((unsigned long) (unsigned int) chave * 2654435769UL) & 0xFFFFFFFFUL;
+
+   return (unsigned int) (produto >> (32 - bitsTabela));
+}
+
+/***********************************************************************
+*
+*  Funo: CNJ Criar tabela
+*
+*  Descrio:
+*    Aloca uma tabela com 2^bitsTabela posies livres.
+*
+***********************************************************************/
+tpEntrada * CriarTabela(int bitsTabela)
+{
+   int capacidade = 1 << bitsTabela;
+   tpEntrada *vtTabela = (tpEntrada*) malloc(capacidade * sizeof(tpEntrada));
+   int i;
+
+   if (vtTabela == NULL)
+   {
+      return NULL;
+   }
+
+   for (i = 0; i < capacidade; i++)
+   {
+      vtTabela[i].chave = CHAVE_LIVRE;
+      vtTabela[i].contagem = 0;
+   }
+
+   return vtTabela;
+}
+
+/***********************************************************************
+*
+*  Funo: CNJ Inserir na tabela
+*
+*  Descrio:
+*    Grava a entrada, que no est na tabela, na primeira posio livre
+*    a partir da posio de espalhamento.
+*
+***********************************************************************/
+void InserirNaTabela(tpEntrada *vtTabela, int bitsTabela, tpEntrada entrada)
+{
+   unsigned int mascara = (1u << bitsTabela) - 1;
+   unsigned int posicao = Espalhar(entrada.chave, bitsTabela);
+
+   while (vtTabela[posicao].chave != CHAVE_LIVRE)
+   {
+      posicao = (posicao + 1) & mascara;
+   }
+
+   vtTabela[posicao] = entrada;
+}
+
+/***********************************************************************
+*
+*  Funo: CNJ Remover da tabela
+*
+*  Descrio:
+*    Libera a posio e traz de volta as entradas seguintes da mesma
+*    sequncia de sondagem que ficariam inalcanveis, de forma que a
+*    tabela nunca precisa de marcas de remoo.
+*
+***********************************************************************/
+void RemoverDaTabela(tpConjunto *pConjunto, int posicao)
+{
+   unsigned int mascara = (unsigned int) pConjunto->capacidade - 1;
+   unsigned int livre = (unsigned int) posicao;
+   unsigned int atual = livre;
+
+   for (;;)
+   {
+      unsigned int ideal;
+
+      atual = (atual + 1) & mascara;
+      if (pConjunto->vtEntradas[atual].chave == CHAVE_LIVRE)
+      {
+         break;
+      }
+
+      // A entrada pode ocupar a posio livre se a sua posio ideal no
+      // estiver entre a livre (exclusive) e a atual (inclusive)
+      ideal = Espalhar(pConjunto->vtEntradas[atual].chave, pConjunto->bitsTabela);
+      if (((atual - ideal) & mascara) >= ((atual - livre) & mascara))
+      {
+         pConjunto->vtEntradas[livre] = pConjunto->vtEntradas[atual];
+         livre = atual;
+      }
+   }
+
+   pConjunto->vtEntradas[livre].chave = CHAVE_LIVRE;
+   pConjunto->vtEntradas[livre].contagem = 0;
+}
+
+/********** Fim do mdulo de implementao: CNJ  Conjunto de identificadores com contagem **********/
@@ -0,0 +1,137 @@
+#if ! defined( CONJUNTO_ )
+#define CONJUNTO_
+/***************************************************************************
+*
+*  Mdulo de definio: CNJ  Conjunto de identificadores com contagem
+*
+*  Arquivo gerado:              conjunto.h
+*  Letras identificadoras:      CNJ
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+*  Descrio do mdulo
+*     Implementa um multiconjunto de inteiros no negativos: para cada
+*     chave guarda quantas vezes ela foi acrescentada e ainda no
+*     retirada.
+*
+*     Enquanto h poucas chaves distintas elas ficam num vetor ordenado,
+*     com busca binria, que ocupa uma ou duas linhas de cache. Acima de
+*     CNJ_LIMITE_ORDENADO chaves o vetor vira uma tabela de espalhamento
+*     com sondagem linear, mantida no mximo meio cheia, de forma que a
+*     busca custa O(1) em mdia.
+*
+*     Um conjunto vazio  representado por NULL: CNJ_Acrescentar cria o
+*     conjunto na primeira chave, e as consultas aceitam NULL.
+*
+***************************************************************************/
+
+#if defined( CONJUNTO_OWN )
+   #define CONJUNTO_EXT
+#else
+   #define CONJUNTO_EXT extern
+#endif
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/* Quantidade de chaves distintas guardadas em vetor ordenado */
+#define CNJ_LIMITE_ORDENADO 16
+
+/* Tipo referncia para um conjunto */
+typedef struct CNJ_stConjunto * CNJ_tppConjunto ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: CNJ Condies de retorno
+*
+***********************************************************************/
+
+   typedef enum {
+
+         CNJ_CondRetOK ,
+               /* Concluiu corretamente */
+
+         CNJ_CondRetNaoAchou ,
+               /* A chave no est no conjunto */
+
+         CNJ_CondRetFaltouMemoria
+               /* Faltou memria */
+
+   } CNJ_tpCondRet ;
+
+
+/***********************************************************************
+*
+*  Funo: CNJ Acrescentar
+*
+*  Descrio
+*     Acrescenta uma ocorrncia da chave, criando o conjunto se
+*     *ppConjunto for NULL.
+*
+*  Parmetros
+*     ppConjunto  - referncia do conjunto, possivelmente NULL.
+*     chave       - inteiro no negativo.
+*
+*  Condies de retorno
+*     CNJ_CondRetOK
+*     CNJ_CondRetFaltouMemoria  - o conjunto no foi alterado.
+*
+***********************************************************************/
+   CNJ_tpCondRet CNJ_Acrescentar(CNJ_tppConjunto *ppConjunto, int chave);
+
+/***********************************************************************
+*
+*  Funo: CNJ Retirar
+*
+*  Descrio
+*     Retira uma ocorrncia da chave. No aloca memria.
+*
+*  Condies de retorno
+*     CNJ_CondRetOK
+*     CNJ_CondRetNaoAchou
+*
+***********************************************************************/
+   CNJ_tpCondRet CNJ_Retirar(CNJ_tppConjunto pConjunto, int chave);
+
+/***********************************************************************
+*
+*  Funo: CNJ Contar
+*
+*  Descrio
+*     Retorna quantas ocorrncias da chave h no conjunto, 0 se nenhuma.
+*
+***********************************************************************/
+   int CNJ_Contar(CNJ_tppConjunto pConjunto, int chave);
+
+/***********************************************************************
+*
+*  Funo: CNJ Nmero de chaves
+*
+*  Descrio
+*     Retorna a quantidade de chaves distintas do conjunto.
+*
+***********************************************************************/
+   int CNJ_NumChaves(CNJ_tppConjunto pConjunto);
+
+/***********************************************************************
+*
+*  Funo: CNJ Destruir
+*
+*  Descrio
+*     Libera o conjunto. Aceita NULL.
+*
+***********************************************************************/
+   void CNJ_Destruir(CNJ_tppConjunto pConjunto);
+
+/***********************************************************************/
+#undef CONJUNTO_EXT
+
+/********** Fim do mdulo de definio: CNJ  Conjunto de identificadores com contagem **********/
+
+#else
+#endif
@@ -13,13 +13,38 @@
 *     Verso  Autor    Data        Observaes
 *     1.0     hg & rc  06/out/13   Preparao do mdulo para trabalhar com grafos direcionados.
 *     2.0     hg & rc  03/dez/13   Adaptao para uma estrutura auto-verificvel.
+*     3.0     rc       19/out/26   Identificadores internos de vrtices e vises de subgrafos.
+*     3.1     rc       19/out/26   Marcadores de vrtices com reincio por poca.
+*     3.2     rc       19/out/26   Reordenao dos vrtices para localidade de memria.
+*     3.3     rc       19/out/26   Publicao somente leitura em memria compartilhada.
+*     3.4     rc       19/out/26   Modo persistente com registro de escrita antecipada.
+*     3.5     rc       19/out/26   ndice ordenado de nomes e listagem por prefixo e intervalo.
+*     3.6     rc       19/out/26   Nomes curtos guardados dentro do vrtice e da aresta.
+*     3.7     rc       19/out/26   Modo de chaves de largura fixa com comparao vetorial.
+*     3.8     rc       19/out/26   Valores de tamanho fixo guardados dentro do vrtice.
+*     3.9     rc       19/out/26   Destruio em lote, opcionalmente em segundo plano.
+*     3.10    rc       19/out/26   ndice dos destinos de cada vrtice.
+*     3.11    rc       19/out/26   Percurso por funes de visita, tambm em paralelo.
+*     3.12    rc       19/out/26   Consultas que no alteram o corrente das listas.
+*     3.13    rc       19/out/26   Buscas nas listas com comparao expandida pelo compilador.
+*     3.14    rc       19/out/26   Percursos retomveis, avanados em fatias de passos.
+*     3.15    rc       19/out/26   Assinaturas de mudanas, entregues em lotes ou por anel.
+*     3.16    rc       19/out/26   Ordem topolgica mantida a cada insero de aresta.
+*     3.17    rc       19/out/26   Componentes fracamente conexos por unio e busca.
+*     3.18    rc       19/out/26   PageRank e PageRank personalizado em paralelo.
+*     3.19    rc       19/out/26   Contagem de tringulos e decomposio em k-ncleos.
+*     3.20    rc       19/out/26   Caminhos restritos por expresses sobre rtulos de arestas.
+*     3.21    rc       19/out/26   Caminho mnimo entre dois vrtices por busca bidirecional.
+*     3.22    rc       19/out/26   Distncias estimadas por marcos e caminho mnimo por A*.
+*     3.23    rc       19/out/26   Listas de sucessores e de origens auto-organizveis.
+*     3.24    rc       19/out/26   Arestas de sada em adjacncias adaptveis ao grau.
 *
 *  Assertivas Estruturais
 *     Antecessor aponta de volta para o vrtice como sucessor
-*        Para todo vrtice pVerAnt em pVer->pAntecessores existir uma aresta pAreSuc em pVerAnt->pSucessores tal que pAreSuc->pVertice = pVer
+*        Para todo vrtice pVerAnt em pVer->pAntecessores existir uma aresta pAreSuc em pVerAnt->sucessores tal que pAreSuc->pVertice = pVer
 *     
 *     Sucessor aponta de volta para o vrtice como antecessor
-*        Para toda aresta pAreSuc em pVer->pSucessores existir um vrtice pVerAnt em pAreSuc->pVertice->pAntecessores tal que pVerAnt = pVer
+*        Para toda aresta pAreSuc em pVer->sucessores existir um vrtice pVerAnt em pAreSuc->pVertice->pAntecessores tal que pVerAnt = pVer
 *     
 *     Se est na origem tem que estar na lista de vrtices
 *        Para todo vrtice pVerOri em pGrafo->pOrigens existir um vrtice pVer em pGrafo->pVertices tal que pVerOri = pVer
@@ -31,19 +56,46 @@
 *        Para todo vrtice pVer e pVerAnt tal que pVer pertence  pGrafo->pVertices e pVerAnt pertence  pVer->Antecessores existir um pVer2 pertencente  pGrafo->pVertices tal que pVerAnt = pVer2
 *     
 *     Todas as arestas dos vrtices de um grafo G tm que apontar para um vrtice que est na lista desse grafo
-*        Para todo vrtice pVer e aresta pAre tal que pVer pertence  pGrafo->pVertices e pAre pertence  pVer->pSucessores, existir um pVer2 pertencente  pGrafo->pVertices tal que pVer2 = pAre->pVertice.
+*        Para todo vrtice pVer e aresta pAre tal que pVer pertence  pGrafo->pVertices e pAre pertence  pVer->sucessores, existir um pVer2 pertencente  pGrafo->pVertices tal que pVer2 = pAre->pVertice.
+*
+*     Todo vrtice do grafo est na tabela de identificadores na posio do seu id
+*        Para todo vrtice pVer pertencente  pGrafo->pVertices, 0 <= pVer->id < pGrafo->numIds e pGrafo->vtVertices[pVer->id] = pVer
+*
+*     Posies livres da tabela de identificadores so nulas
+*        Para todo id em pGrafo->vtIdsLivres, pGrafo->vtVertices[id] = NULL
 *
 ***************************************************************************/
 
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <limits.h>
 #include "lista.h"
+#include "listaesp.h"
+#include "memcomp.h"
+#include "wal.h"
+#include "indice.h"
+#include "tarefa.h"
+#include "conjunto.h"
+#include "anel.h"
+#include "adjacencia.h"
+
+#if defined( __AVX2__ )
+   #include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+   #include <emmintrin.h>
+   #define GRA_SSE2
+#endif
 
 #define GRAFO_OWN
 #include "grafo.h"
 #undef GRAFO_OWN
 
+#define SUFIXO_LOG                  ".wal"
+#define SUFIXO_PONTO_DE_CONTROLE    ".chk"
+#define SUFIXO_TEMPORARIO           ".chk.tmp"
+#define BYTES_PONTO_DE_CONTROLE     ( 4L * 1024 * 1024 )
+
 #ifdef _DEBUG
 #include   "Generico.h"
 #include   "Conta.h"
@@ -51,6 +103,25 @@
 #include   "IdTiposEspaco.def"
 #endif
 
+/* Espao para nomes guardados dentro do vrtice ou da aresta, com o '\0' */
+#define TAM_NOME_CURTO 16
+
+/* Maior largura aceita no modo de chaves fixas */
+#define MAX_LARGURA_CHAVE 32
+
+/* Quantidade de valores entregues de cada vez  destruio em lote */
+#define TAM_LOTE_VALORES 256
+
+/* Quantidade de expresses de caminho compiladas guardadas pelo grafo */
+#define TAM_CACHE_EXPRESSOES 8
+
+/* Separador entre o rtulo e o resto do nome de uma aresta, como string
+   para strcspn */
+#define SEPARADOR_ROTULO ":"
+
+/* Quantidade de marcos escolhidos antes de GRA_PrepararMarcos */
+#define NUM_MARCOS_PADRAO 8
+
 
 /***********************************************************************
 *  Tipo de dados: GRA Vertice do grafo
@@ -59,20 +130,44 @@
 typedef struct stVerticeGrafo {
 
 	char *nome;
-	/* Nome do vrtice */
+	/* Nome do vrtice. Aponta para nomeCurto quando o nome cabe nele */
+
+   size_t tamNome;
+   /* Quantidade de caracteres do nome, sem o '\0' */
+
+   char nomeCurto[TAM_NOME_CURTO];
+   /* Nomes curtos, guardados na mesma linha de cache que o vrtice */
 
-	LIS_tppLista pSucessores;
-	/* Ponteiros para as arestas originadas neste vrtice */
+   ADJ_tpAdjacencia sucessores;
+   /* Arestas originadas neste vrtice, na ordem de insero, com o
+      espalhamento do nome como chave */
 
 	LIS_tppLista pAntecessores;
 	/* Ponteiro para os vrtices que tm arestas 
 	direcionadas para este vrtice */
 
+   CNJ_tppConjunto pDestinos;
+   /* Ids dos destinos das arestas que saem do vrtice, com a quantidade
+      de arestas para cada um. NULL enquanto o vrtice no tem arestas */
+
+   ADJ_tpAdjacencia gruposRotulo;
+   /* Arestas que saem do vrtice agrupadas pelo rtulo: um
+      tpGrupoRotulo por rtulo, com o espalhamento do rtulo como chave.
+      Vazia enquanto os grupos do grafo no esto montados */
+
 	void (*destruirValor)(void *pValor);
 	/* Lgica responsvel por destruir o valor do vrtice do grafo */
 
 	void * pValor;
-	/* valor contido no vrtice */
+	/* valor contido no vrtice. Nos grafos com valores fixos aponta para
+	   os bytes alocados logo aps o vrtice */
+
+   int id;
+   /* Identificador interno denso do vrtice, usado como ndice em
+      tabelas auxiliares (vises, marcaes etc.) */
+
+   int posTopologica;
+   /* Posio do vrtice em vtOrdemTopologica, quando o grafo a mantm */
 
 #ifdef _DEBUG
    struct stGrafo *pGrafo;
@@ -88,11 +183,20 @@ typedef struct stVerticeGrafo {
 typedef struct stArestaGrafo {
 
 	char *nome;
-	/* Nome da aresta */
+	/* Nome da aresta. Aponta para nomeCurto quando o nome cabe nele */
+
+   size_t tamNome;
+   /* Quantidade de caracteres do nome, sem o '\0' */
+
+   char nomeCurto[TAM_NOME_CURTO];
+   /* Nomes curtos, guardados dentro da aresta */
 
 	tpVertice * pVertice;
 	/* Ponteiro para o vrtice destino da aresta */
 
+   int rotulo;
+   /* Rtulo da aresta, internado pelo grafo */
+
 #ifdef _DEBUG
    struct stGrafo *pGrafo;
    /* Ponteiro para o cabea cuja aresta pertence */
@@ -101,6 +205,105 @@ typedef struct stArestaGrafo {
 } tpAresta;
 
 
+/***********************************************************************
+*  Tipo de dados: GRA Grupo de arestas de um rtulo
+***********************************************************************/
+
+typedef struct {
+
+   int rotulo;
+   /* Rtulo comum s arestas do grupo */
+
+   ADJ_tpAdjacencia arestas;
+   /* Arestas do vrtice com o rtulo, que continuam pertencendo aos
+      sucessores; a chave  o espalhamento do endereo da aresta */
+
+} tpGrupoRotulo;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA N de componente
+***********************************************************************/
+
+typedef struct {
+
+   int pai;
+   /* Id do pai na floresta de unio e busca; a raiz  pai de si mesma */
+
+   int tamanho;
+   /* Na raiz, quantidade de vrtices do componente */
+
+   int proximo;
+   /* Prximo membro do componente, numa lista circular */
+
+   int anterior;
+   /* Membro anterior do componente na lista circular */
+
+   char desatualizado;
+   /* Na raiz, 1 se uma aresta ou vrtice do componente foi destrudo
+      e ele talvez tenha se partido */
+
+   char naPilha;
+   /* 1 enquanto o id est na pilha de componentes desatualizados */
+
+} tpNoComponente;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Rtulo de aresta
+*
+*  O rtulo de uma aresta  o seu nome at o primeiro SEPARADOR_ROTULO,
+*  ou o nome inteiro. Cada rtulo distinto  guardado uma vez, com um
+*  nmero, enquanto alguma aresta ou expresso guardada o usa; o nmero
+*  de um rtulo liberado  reaproveitado.
+***********************************************************************/
+
+typedef struct {
+
+   char *nome;
+   /* Texto do rtulo, guardado logo aps a estrutura */
+
+   int id;
+   /* Nmero do rtulo, de 0 a numRotulos - 1 */
+
+   int numReferencias;
+   /* Arestas e posies de expresses guardadas com o rtulo */
+
+} tpRotulo;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Expresso de caminho compilada
+*
+*  Autmato de posies (de Glushkov) da expresso: cada ocorrncia de
+*  um rtulo na expresso  uma posio, de 1 a numPosicoes, e  tambm
+*  o estado alcanado ao seguir uma aresta com esse rtulo. O estado 0 
+*  o inicial. Conjuntos de estados so mscaras de bits.
+***********************************************************************/
+
+typedef struct {
+
+   char *texto;
+   /* Texto da expresso, chave do cache */
+
+   int numPosicoes;
+   /* Quantidade de posies */
+
+   int vtRotulos[GRA_MAX_NOMES_EXPRESSAO + 1];
+   /* Rtulo de cada posio; a posio 0 no  usada */
+
+   unsigned long vtMesmoRotulo[GRA_MAX_NOMES_EXPRESSAO + 1];
+   /* Posies com o mesmo rtulo de cada posio, ela inclusive */
+
+   unsigned long vtSeguintes[GRA_MAX_NOMES_EXPRESSAO + 1];
+   /* Posies que podem vir depois de cada estado */
+
+   unsigned long finais;
+   /* Estados em que um caminho aceito pode terminar */
+
+} tpExpressao;
+
+
 /***********************************************************************
 *  Tipo de dados: GRA Grafo
 ***********************************************************************/
@@ -119,1418 +322,10541 @@ typedef struct stGrafo {
 	void (*destruirValor)(void *pValor);
 	/* Lgica responsvel por destruir o valor do vrtice do grafo */
 
-#ifdef _DEBUG
-   unsigned int qntVertices;
-   /* Quantidade de vrtices que foram adicionados atravs da interface
-      exportada */
+   tpVertice **vtVertices;
+   /* Vrtices indexados pelo identificador interno. As posies de
+      identificadores livres so nulas */
 
-   unsigned long totalEspacoAlocado;
-   /* Tamanho em bytes de todo espao alocado para o armazenamento do grafo */
-#endif
+   int numIds;
+   /* Quantidade de identificadores j distribudos (maior id + 1) */
 
-} tpGrafo;
+   int capIds;
+   /* Capacidade da tabela vtVertices */
 
-/***** Dados encapsulados no mdulo ******/
-#ifdef _DEBUG
+   int *vtIdsLivres;
+   /* Pilha de identificadores liberados, reaproveitados na insero */
 
-   static char EspacoLixo[256] =
-            "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
-         /* Espao de dados lixo usado ao testar */
-   
-   static unsigned long espacoAlocado;
-#endif
+   int numIdsLivres;
+   /* Quantidade de identificadores na pilha de livres */
 
-/***** Prottipos das funes encapuladas no mdulo *****/
+   LIS_tppLista pVisoes;
+   /* Vises registradas sobre este grafo */
 
-#ifdef _DEBUG
-   // deturpacao
-   static void DET_EliminaElementoCorrente(tpGrafo *pGrafo);
-   static void DET_AtribuiNullParaVerticeSucessor(tpGrafo *pGrafo);
-   static void DET_AtribuiNullAOPonteiroDoVerticePredecessor(tpGrafo *pGrafo);
-   static void DET_LixoNaReferenciaParaSucessor(tpGrafo *pGrafo);
+   LIS_tppLista pMarcadores;
+   /* Marcadores registrados sobre este grafo */
 
-   //Verificacao
-   static GRA_tpCondRet VER_VerticeSucessorNaoEhNulo(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_VerticePredecessorNaoEhNulo(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_NaoExisteLixoNaReferenciaParaSucessor(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_NaoExisteLixoNaReferenciaParaAntecessor(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_VerticesNaoPossuemConteudoNulo(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_NenhumVerticeTemConteudoComOTipoCorrompido(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_NenhumVerticeEstaDestacado(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_NenhumVerticeFoiLiberado(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_CorrenteNaoEhNulo(tpGrafo *pGrafo, int *numFalhas);
-   static GRA_tpCondRet VER_NaoExisteOrigemNula(tpGrafo *pGrafo, int *numFalhas);
+   LIS_tppLista pPercursos;
+   /* Percursos retomveis ainda no terminados sobre este grafo */
 
-   static GRA_tpCondRet VerificaVertice(tpVertice *pVertice, int *numFalhas);
+   LIS_tppLista pAssinaturas;
+   /* Assinaturas das mudanas deste grafo */
 
-   static void DET_LixoNaReferenciaParaAntecessor(tpGrafo *pGrafo);
-   static void DET_ConteudoDoVerticeNULL(tpGrafo *pGrafo);
-   static void DET_AlteraTipoDoValorDoVertice(tpGrafo *pGrafo);
-   static void DET_DestacaVertice(tpGrafo *pGrafo);
-   static void DET_AtribuiNullAoCorrente(tpGrafo *pGrafo);
-   static void DET_AtribuiNullParaUmaOrigem(tpGrafo *pGrafo);
+   int numAssinaturas;
+   /* Quantidade de assinaturas, testada a cada alterao do grafo */
 
-   static void DET_EspalharLixosPelaEstrutura(tpGrafo *pGrafo);
-   static void DET_GrafoEhEspacoLixo(tpGrafo *pGrafo);
-#endif
+   struct stMarcador *pMarcadorInterno;
+   /* Marcador reutilizado pelos percursos do prprio mdulo */
 
-static void DestruirVertice(void *pVazio);
-static void DestruirAresta(void *pVazio);
-static int CompararVerticeENome (void *pVazio1, void *pVazio2);
-static int CompararArestaENome (void *pVazio1, void *pVazio2);
-static int EstaVazio(tpGrafo *pGrafo);
-static GRA_tpCondRet ProcurarVertice(tpGrafo *pGrafo, char *nome, tpVertice **pVertice);
-static GRA_tpCondRet ProcurarOrigem(tpGrafo *pGrafo, char *nome, tpVertice **pVertice);
-static GRA_tpCondRet ProcurarAresta(tpVertice *pVertice, char *nome, tpAresta **pAresta);
-static int ExisteVertice(tpGrafo *pGrafo, char *nome);
-static int ExisteOrigem(tpGrafo *pGrafo, char *nome);
-static int ExisteAresta(tpVertice *pVertice, char *nome);
-static void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo);
+   int marcadorInternoEmUso;
+   /* 1 enquanto algum percurso do mdulo usa o marcador interno */
 
-/*****  Cdigo das funes exportadas pelo mdulo  *****/
+   struct stPersistencia *pPersistencia;
+   /* Estado do modo persistente, ou NULL se o grafo s existe em memria */
 
-/***************************************************************************
-*  Funo: GRA Criar grafo
-******/
-GRA_tpCondRet GRA_CriarGrafo(GRA_tppGrafo *ppGrafo,
-	void (*destruirValor)(void *pValor))
-{
-	tpGrafo *pGrafo;
-   pGrafo = (tpGrafo*) malloc(sizeof(tpGrafo));
+   IND_tppIndice pIndiceNomes;
+   /* Vrtices indexados pelo nome, em ordem. As chaves so os prprios
+      nomes dos vrtices */
 
-	pGrafo->pCorrente = NULL;
-	pGrafo->destruirValor = destruirValor;
+   size_t larguraChave;
+   /* Largura das chaves fixas, ou 0 se os nomes tm tamanho varivel.
+      No modo de chaves fixas todo nome ocupa larguraChave bytes,
+      completados com zeros */
 
-	LIS_CriarLista(&pGrafo->pOrigens, NULL, CompararVerticeENome);
-	LIS_CriarLista(&pGrafo->pVertices, DestruirVertice, CompararVerticeENome);
+   size_t tamValor;
+   /* Tamanho dos valores guardados dentro do vrtice, ou 0 se os
+      vrtices guardam ponteiros para valores externos */
 
-   #ifdef _DEBUG
-      CED_DefinirTipoEspaco(pGrafo, GRA_TipoEspacoCabeca);
-      pGrafo->qntVertices = 0;
-      
-      pGrafo->totalEspacoAlocado = _msize(pGrafo);
-      
-      LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
-      
-      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
-      
-      CED_MarcarEspacoAtivo(pGrafo);
-   #endif
+   int recusarParalelas;
+   /* 1 se a insero de uma segunda aresta com a mesma origem e o
+      mesmo destino deve ser recusada */
 
-	*ppGrafo = (GRA_tppGrafo) pGrafo;
+   int *vtOrdemTopologica;
+   /* Ids dos vrtices em ordem topolgica, ou NULL se o grafo no a
+      mantm. As posies de vrtices destrudos valem -1 */
 
-	return GRA_CondRetOK;
-}
+   int numPosicoesTopologicas;
+   /* Quantidade de posies usadas de vtOrdemTopologica */
 
-/***************************************************************************
-*  Funo: GRA Destruir grafo
-******/
-GRA_tpCondRet GRA_DestruirGrafo(GRA_tppGrafo *ppGrafo)
-{
-	tpGrafo *pGrafo = (tpGrafo*) *ppGrafo;
+   int capPosicoesTopologicas;
+   /* Capacidade de vtOrdemTopologica */
 
-	if (pGrafo == NULL)
-	{
-		return GRA_CondRetOK;
-	}
+   int *vtAfetados;
+   /* Posies dos vrtices a reordenar ao inserir uma aresta, ou ids dos
+      membros de um componente a recalcular. Guardado entre as operaes
+      para no alocar a cada uma */
 
-	LIS_DestruirLista(pGrafo->pVertices);
-	LIS_DestruirLista(pGrafo->pOrigens);
+   int capAfetados;
+   /* Capacidade de vtAfetados */
 
-	free(pGrafo);
-	pGrafo = NULL;
-	*ppGrafo = NULL;
-	
-	return GRA_CondRetOK;
-}
+   int *vtPosicaoNaBusca;
+   /* Posio de cada id, mais 1, na fila da ponta de GRA_CaminhoEntre
+      que o alcanou, com sinal negativo na ponta do destino. Nunca 
+      limpo: s vale se a fila confirma o id */
 
-/***************************************************************************
-*  Funo: GRA Inserir vertice
-******/
-GRA_tpCondRet GRA_InserirVertice(GRA_tppGrafo pGrafoParm, char *nomeVertice, void *pValor)
-{
-	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
-	tpVertice *pVertice;
+   int capPosicaoNaBusca;
+   /* Capacidade de vtPosicaoNaBusca */
 
-	if (pGrafo == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+   int *vtDistanciasMarcos;
+   /* Distncias de e para os marcos, 2 * numMarcos por id: em
+      [2 * (id * numMarcos + i)] a do marco i at id e na seguinte a de
+      id at o marco i; -1 se no h caminho. NULL at a primeira
+      consulta e depois de cada alterao das arestas */
 
-   if (ExisteVertice(pGrafo, nomeVertice))
-   {
-      return GRA_CondRetJaExiste;
-   }
+   int numMarcos;
+   /* Quantidade de marcos em vtDistanciasMarcos */
 
-	pVertice = (tpVertice*) malloc(sizeof(tpVertice));
-	if (pVertice == NULL)
-	{
-		return GRA_CondRetFaltouMemoria;
-	}
+   int numIdsMarcos;
+   /* Quantidade de ids quando as distncias foram calculadas */
 
-	pVertice->nome = nomeVertice;
-	pVertice->pValor = pValor;
-	pVertice->destruirValor = pGrafo->destruirValor;
+   int numMarcosPedidos;
+   /* Quantidade de marcos a escolher no prximo clculo */
 
-#if _DEBUG
-   pVertice->pGrafo = pGrafo;
-#endif
-   
+   tpNoComponente *vtComponentes;
+   /* Componentes fracamente conexos, indexados pelo id do vrtice. NULL
+      at a primeira consulta; a partir dela mantidos a cada insero */
 
-	LIS_CriarLista(&pVertice->pAntecessores, NULL, CompararVerticeENome);
-	LIS_CriarLista(&pVertice->pSucessores, DestruirAresta, CompararArestaENome);
+   int capComponentes;
+   /* Capacidade de vtComponentes e de vtDesatualizados */
 
-   #ifdef _DEBUG
-      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
-      pGrafo->totalEspacoAlocado -= espacoAlocado;
-   #endif
+   int numComponentes;
+   /* Quantidade de componentes, contando cada desatualizado como um */
 
-	pGrafo->pCorrente = pVertice;
-	LIS_InserirElementoApos(pGrafo->pVertices, pVertice);
-   
-   #ifdef _DEBUG
-      CED_DefinirTipoEspaco(pVertice, GRA_TipoEspacoVertice);
-      CED_DefinirTipoEspaco(pVertice->pValor, GRA_TipoEspacoValorVertice);
-      pGrafo->qntVertices++;
-      CED_MarcarEspacoAtivo(pVertice);
-      CED_MarcarEspacoAtivo(pVertice->pValor);
+   int *vtDesatualizados;
+   /* Pilha de ids cujo componente pode estar desatualizado */
 
-      pGrafo->totalEspacoAlocado += _msize(pVertice);
+   int numDesatualizados;
+   /* Quantidade de ids na pilha de desatualizados */
 
-      LIS_TotalEspacoAlocado(pVertice->pAntecessores, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
+   int numIdsRetidos;
+   /* Ids de vrtices destrudos que ainda so ns de um componente
+      desatualizado. S vo para a pilha de livres no reclculo */
 
-      LIS_TotalEspacoAlocado(pVertice->pSucessores, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
-      
-      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
-   #endif
+   IND_tppIndice pIndiceRotulos;
+   /* Rtulos de arestas indexados pelo texto */
 
-	return GRA_CondRetOK;
-}
+   tpRotulo **vtRotulos;
+   /* Rtulos indexados pelo nmero, NULL nos nmeros livres */
 
-/***************************************************************************
-*  Funo: GRA Inserir aresta
-******/
-GRA_tpCondRet GRA_InserirAresta(GRA_tppGrafo pGrafoParm,
-	char *nomeAresta, char *nomeVerticeOrigem, char *nomeVerticeDestino)
-{
-	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
-	tpAresta *pAresta;
-	LIS_tpCondRet lisCondRet;
-   GRA_tpCondRet graCondRet;
-   tpVertice *pVerticeOrigem, *pVerticeDestino;
+   int numRotulos;
+   /* Quantidade de nmeros de rtulo j distribudos */
 
-	if (pGrafo == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+   int capRotulos;
+   /* Capacidade de vtRotulos e de vtRotulosLivres */
 
-   // Procura vrtice origem
-   graCondRet = ProcurarVertice(pGrafo, nomeVerticeOrigem, &pVerticeOrigem);
-   if (graCondRet != GRA_CondRetOK)
-   {
-      return graCondRet;
-   }
+   int *vtRotulosLivres;
+   /* Pilha dos nmeros de rtulos liberados, para reaproveitamento */
 
-   // Procura vrtice destino
-   graCondRet = ProcurarVertice(pGrafo, nomeVerticeDestino, &pVerticeDestino);
-   if (graCondRet != GRA_CondRetOK)
-   {
-      return graCondRet;
-   }
+   int numRotulosLivres;
+   /* Quantidade de nmeros em vtRotulosLivres */
 
-   // Verifica se j existe uma aresta com este nome
-   if (ExisteAresta(pVerticeOrigem, nomeAresta))
-   {
-      return GRA_CondRetJaExiste;
-   }
+   tpExpressao *vtExpressoes[TAM_CACHE_EXPRESSOES];
+   /* Expresses de caminho j compiladas, NULL nas posies livres */
 
-	pAresta = (tpAresta*) malloc(sizeof(tpAresta));
+   int proximaExpressao;
+   /* Posio substituda na prxima expresso compilada */
 
-   #ifdef _DEBUG
-      CED_DefinirTipoEspaco(pAresta, GRA_TipoEspacoAresta);
-   #endif
+   int gruposMontados;
+   /* 1 se as arestas de cada vrtice esto agrupadas por rtulo. Os
+      grupos s so montados pela primeira GRA_AlcancarPorExpressao, e
+      da em diante acompanham as inseres e excluses de arestas */
 
-	if (pAresta == NULL)
-	{
-		return GRA_CondRetFaltouMemoria;
-	}
+   GRA_tpAutoOrganizacao autoOrganizacao;
+   /* Poltica das listas de sucessores e da lista de origens */
 
-   #ifdef _DEBUG
-      LIS_TotalEspacoAlocado(pVerticeDestino->pAntecessores, &espacoAlocado);
-      pGrafo->totalEspacoAlocado -= espacoAlocado;
+   GRA_tpEstatisticasBusca estatisticasArestas;
+   /* Posies das arestas achadas por GRA_SeguirPelaAresta */
 
-      LIS_TotalEspacoAlocado(pVerticeOrigem->pSucessores, &espacoAlocado);
-      pGrafo->totalEspacoAlocado -= espacoAlocado;
-   #endif
+   GRA_tpEstatisticasBusca estatisticasOrigens;
+   /* Posies das origens achadas por GRA_IrParaAOrigem */
 
-   // Atualiza os antecessores do vrtice destino
-	lisCondRet = LIS_InserirElementoApos(pVerticeDestino->pAntecessores, pVerticeOrigem);
-	if (lisCondRet == LIS_CondRetFaltouMemoria)
-	{
-		return GRA_CondRetFaltouMemoria;
-	}
+#ifdef _DEBUG
+   unsigned int qntVertices;
+   /* Quantidade de vrtices que foram adicionados atravs da interface
+      exportada */
 
-   // Atualiza os sucessores do vrtice origem
-	lisCondRet = LIS_InserirElementoApos(pVerticeOrigem->pSucessores, pAresta);
-	if (lisCondRet == LIS_CondRetFaltouMemoria)
-	{
-		return GRA_CondRetFaltouMemoria;
-	}
+   unsigned long totalEspacoAlocado;
+   /* Tamanho em bytes de todo espao alocado para o armazenamento do grafo */
+#endif
 
-	pAresta->nome = nomeAresta;
-   pAresta->pVertice = pVerticeDestino;
+} tpGrafo;
 
-#if _DEBUG
-   pAresta->pGrafo = pGrafo;
-#endif
-   
 
-   #ifdef _DEBUG
-      CED_DefinirTipoEspaco( pAresta , GRA_TipoEspacoAresta ) ;
-      CED_MarcarEspacoAtivo(pAresta);
+/***********************************************************************
+*  Tipo de dados: GRA Viso de subgrafo induzido
+***********************************************************************/
 
-      pGrafo->totalEspacoAlocado += _msize(pAresta);
-      
-      LIS_TotalEspacoAlocado(pVerticeDestino->pAntecessores, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
+typedef struct stVisao {
 
-      LIS_TotalEspacoAlocado(pVerticeOrigem->pSucessores, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
-   #endif
+   tpGrafo *pGrafo;
+   /* Grafo pai. Nulo se o grafo j foi destrudo */
 
-	return GRA_CondRetOK;
-}
+   int (*pertence)(char *nomeVertice, void *pValor, void *pContexto);
+   /* Predicado de pertinncia. Se nulo, usa o conjunto de bits */
 
-/***************************************************************************
-*  Funo: GRA Obter valor do vrtice corrente
-******/
-GRA_tpCondRet GRA_ObterValorCorrente(GRA_tppGrafo pGrafoParm, void **ppValor)
-{
-	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   void *pContexto;
+   /* Contexto repassado ao predicado */
 
-	if (pGrafo == NULL)
-	{
-		*ppValor = NULL;
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+   unsigned char *vtBits;
+   /* Conjunto de bits indexado pelo id do vrtice */
 
-	if (EstaVazio(pGrafo))
-	{
-		*ppValor = NULL;
-		return GRA_CondRetGrafoVazio; 
-	}
+   int numBytes;
+   /* Tamanho em bytes do conjunto de bits */
 
-	*ppValor = pGrafo->pCorrente->pValor;
-	return GRA_CondRetOK;
-}
+   tpVertice *pCorrente;
+   /* Vrtice corrente da viso */
 
-/***************************************************************************
-*  Funo: GRA Alterar valor do vrtice corrente
-******/
-GRA_tpCondRet GRA_AlterarValorCorrente(GRA_tppGrafo pGrafoParm, void *pValor)
-{
-	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+} tpVisao;
 
-	if (pGrafo == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
 
-	if (EstaVazio(pGrafo))
-	{
-		return GRA_CondRetGrafoVazio;
-	}
+/***********************************************************************
+*  Tipo de dados: GRA Marcador de vrtices
+***********************************************************************/
 
-	pGrafo->pCorrente->pValor = pValor;
-	return GRA_CondRetOK;
-}
+typedef struct stMarcador {
 
+   tpGrafo *pGrafo;
+   /* Grafo marcado. Nulo se o grafo j foi destrudo */
 
-/***************************************************************************
-*  Funo: GRA Tornar vrtice corrente uma origem
-******/
-GRA_tpCondRet GRA_TornarCorrenteUmaOrigem(GRA_tppGrafo pGrafoParm)
-{
-	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   unsigned int *vtEpocas;
+   /* poca em que cada vrtice, indexado pelo id, foi marcado */
 
-	if (pGrafo == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+   int numEpocas;
+   /* Tamanho do vetor de pocas */
 
-	if (EstaVazio(pGrafo))
-	{
-		return GRA_CondRetGrafoVazio;
-	}
+   unsigned int epocaCorrente;
+   /* Vrtices cuja poca  igual a esta esto marcados. Nunca  0 */
 
-   if (ExisteOrigem(pGrafo, pGrafo->pCorrente->nome))
-   {
-      return GRA_CondRetJaExiste;
-   }
+} tpMarcador;
 
-#ifdef _DEBUG
-   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
-   pGrafo->totalEspacoAlocado -= espacoAlocado;
-#endif
 
-	LIS_InserirElementoApos(pGrafo->pOrigens, pGrafo->pCorrente);
+/***********************************************************************
+*  Tipo de dados: GRA Percurso retomvel
+***********************************************************************/
 
-#ifdef _DEBUG
-   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
-   pGrafo->totalEspacoAlocado += espacoAlocado;
-#endif
+typedef struct GRA_stPercurso {
 
-	return GRA_CondRetOK;
-}
+   tpGrafo *pGrafo;
+   /* Grafo percorrido. Nulo se o grafo j foi destrudo */
 
+   GRA_tpModoPercurso modo;
+   /* Ordem de visita */
 
-/***************************************************************************
-*  Funo: GRA Deixar de ser origem
-******/
-GRA_tpCondRet GRA_DeixarDeSerOrigem(GRA_tppGrafo pGrafoParm)
-{
-   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpMarcador *pMarcador;
+   /* Em largura, vrtices que j entraram na fronteira; em profundidade,
+      vrtices j visitados. Registrado na lista de marcadores do grafo */
 
-   if (pGrafo == NULL)
-   {
-      return GRA_CondRetGrafoNaoFoiCriado;
-   }
+   int *vtFronteira;
+   /* Ids dos vrtices a visitar. Em largura  uma fila, de inicio a
+      fim - 1; em profundidade  uma pilha, com o topo em fim - 1.
+      Ids de vrtices excludos do grafo so trocados por -1 */
 
-   if (EstaVazio(pGrafo))
-   {
-      return GRA_CondRetGrafoVazio;
-   }
+   int inicio;
+   /* Primeira posio ocupada da fronteira */
 
-   if (!ExisteOrigem(pGrafo, pGrafo->pCorrente->nome))
-   {
-      return GRA_CondRetNaoAchou;
-   }
+   int fim;
+   /* Primeira posio livre da fronteira */
 
-#ifdef _DEBUG
-   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
-   pGrafo->totalEspacoAlocado -= espacoAlocado;
-#endif
+   int capacidade;
+   /* Tamanho do vetor vtFronteira */
 
-   LIS_ExcluirElemento(pGrafo->pOrigens);
+   int (*visitar)(const char *nome, void *pValor, void *pContexto);
+   /* Funo chamada para cada vrtice visitado */
 
-#ifdef _DEBUG
-   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
-   pGrafo->totalEspacoAlocado += espacoAlocado;
-#endif
+   void *pContexto;
+   /* Contexto repassado  funo visitar */
 
-   return GRA_CondRetOK;
-}
+} tpPercurso;
 
-/***************************************************************************
-*  Funo: GRA Destruir vrtice corrente
-******/
-GRA_tpCondRet GRA_DestruirVerticeCorrente(GRA_tppGrafo pGrafoParm)
-{
-	tpGrafo *pGrafo = NULL;
-	int estaVazia = -1;
 
-	if (pGrafoParm == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+/***********************************************************************
+*  Tipo de dados: GRA Nomes guardados de uma mudana
+***********************************************************************/
 
-	pGrafo = (tpGrafo*) pGrafoParm;
+typedef struct {
 
-	if (EstaVazio(pGrafo))
-	{
-		return GRA_CondRetGrafoVazio;
-	}
+   char *nomes;
+   /* Cpia dos nomes da mudana, um aps o outro, com os terminadores */
 
-	LIS_EstaVazia(pGrafo->pOrigens,&estaVazia);
+   size_t capNomes;
+   /* Tamanho de nomes. O espao  reaproveitado pelas mudanas seguintes */
 
-	if (estaVazia)
-	{
-		return GRA_CondRetNaoAchou;
-	}
+} tpNomesGuardados;
 
-   DestacarVertice(pGrafo, pGrafo->pCorrente);
-	
-   #ifdef _DEBUG
-      pGrafo->qntVertices--;
-   #endif
 
-	return GRA_CondRetOK;
-}
+/***********************************************************************
+*  Tipo de dados: GRA Mudana no anel
+***********************************************************************/
 
+typedef struct {
 
-/***************************************************************************
-*  Funo: GRA Destruir aresta adjacente
-******/
-GRA_tpCondRet GRA_DestruirArestaAdjacente(GRA_tppGrafo pGrafoParm, char *nomeAresta)
-{
-	tpGrafo *pGrafo = NULL;
-	tpAresta *pAresta = NULL;
-	GRA_tpCondRet graCondRet;
-   LIS_tppLista pAntecessores, pSucessores;
+   GRA_tpMudanca mudanca;
+   /* Mudana, com os nomes apontando para nomesGuardados */
 
-	if (pGrafoParm == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+   tpNomesGuardados nomesGuardados;
+   /* Pertence  posio do anel, e no  mudana */
 
-	pGrafo = (tpGrafo*) pGrafoParm;
+} tpMudancaNoAnel;
 
-	if (EstaVazio(pGrafo))
-	{
-		return GRA_CondRetGrafoVazio;
-	}
 
-	// Busca Aresta  remover
-   graCondRet = ProcurarAresta(pGrafo->pCorrente, nomeAresta, &pAresta);
-   if (graCondRet != GRA_CondRetOK)
-   {
-      return GRA_CondRetNaoAchou;
-   }
+/***********************************************************************
+*  Tipo de dados: GRA Assinatura de mudanas
+***********************************************************************/
 
-   pAntecessores = pAresta->pVertice->pAntecessores;
-   pSucessores = pGrafo->pCorrente->pSucessores;
+typedef struct GRA_stAssinatura {
 
-	// Remove referncia do vrtice corrente
-	LIS_IrInicioLista(pAntecessores);
-	LIS_ProcurarValor(pAntecessores, pGrafo->pCorrente->nome);
+   tpGrafo *pGrafo;
+   /* Grafo assinado. Nulo se o grafo j foi destrudo */
 
-#ifdef _DEBUG
-   LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
-   pGrafo->totalEspacoAlocado -= espacoAlocado;
-   
-   LIS_TotalEspacoAlocado(pSucessores, &espacoAlocado);
-   pGrafo->totalEspacoAlocado -= espacoAlocado;
-#endif
+   unsigned long numSequencia;
+   /* Nmero de sequncia da ltima mudana gerada, entregue ou no */
 
-	LIS_ExcluirElemento(pAntecessores);
-	LIS_ExcluirElemento(pSucessores);
-   
-#ifdef _DEBUG
-   LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
-   pGrafo->totalEspacoAlocado += espacoAlocado;
-   
-   LIS_TotalEspacoAlocado(pSucessores, &espacoAlocado);
-   pGrafo->totalEspacoAlocado += espacoAlocado;
-#endif
+   void (*entregar)(const GRA_tpMudanca *vtMudancas, int numMudancas, void *pContexto);
+   /* Funo que recebe os lotes, ou NULL numa assinatura em anel */
 
-	return GRA_CondRetOK;
-}
+   void *pContexto;
+   /* Contexto repassado  funo entregar */
 
-/***************************************************************************
-*  Funo: GRA Ir para o vrtice adjacente
-******/
-GRA_tpCondRet GRA_IrParaVerticeAdjacente(GRA_tppGrafo pGrafoParm, char *nomeVertice)
-{
-	tpGrafo *pGrafo = NULL;
-	tpAresta *pAresta = NULL;
-	tpVertice *pVertice = NULL;
-	int numElemLista = 0;
+   GRA_tpMudanca *vtLote;
+   /* Mudanas ainda no entregues da assinatura sncrona */
 
-	if (pGrafoParm == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+   tpNomesGuardados *vtNomesLote;
+   /* Nomes das mudanas de vtLote, na mesma posio */
 
-	pGrafo = (tpGrafo*) pGrafoParm;
-	if (EstaVazio(pGrafo))
-	{
-		return GRA_CondRetGrafoVazio;
-	}
+   int tamLote;
+   /* Tamanho de vtLote */
 
-	LIS_NumELementos(pGrafo->pCorrente->pSucessores, &numElemLista);
-	LIS_IrInicioLista(pGrafo->pCorrente->pSucessores);
+   int numNoLote;
+   /* Mudanas em vtLote */
 
-	while(numElemLista > 0)
-	{
-		LIS_ObterValor(pGrafo->pCorrente->pSucessores, (void**)&pAresta);
+   ANL_tppAnel pAnel;
+   /* Anel de tpMudancaNoAnel, ou NULL na assinatura sncrona */
 
-		if (!strcmp(nomeVertice, pAresta->pVertice->nome))
-		{
-			pGrafo->pCorrente = pAresta->pVertice;
-			return GRA_CondRetOK;
-		}
+   int numEmLeitura;
+   /* Mudanas do anel retornadas na ltima consumao e ainda no
+      liberadas, porque o consumidor ainda pode ler os seus nomes */
 
-		LIS_AvancarElementoCorrente(pGrafo->pCorrente->pSucessores,1);
+} tpAssinatura;
 
-		numElemLista--;
-	}
 
-	return GRA_CondRetNaoAchou;
-}
+/***********************************************************************
+*  Tipo de dados: GRA Cabea da cpia compartilhada
+*
+*  A cpia publicada  formada pela cabea seguida dos vetores de
+*  vrtices, arestas e ndice de nomes, e por fim dos
+*  nomes e valores. Todas as referncias so deslocamentos em bytes a
+*  partir da cabea ou ndices nos vetores, nunca ponteiros.
+***********************************************************************/
 
-/***************************************************************************
-*  Funo: GRA Seguir pela aresta
-******/
-GRA_tpCondRet GRA_SeguirPelaAresta(GRA_tppGrafo pGrafoParm, char *nomeAresta)
-{
-	tpGrafo *pGrafo = NULL;
-	tpAresta *pAresta = NULL;
-   GRA_tpCondRet graCondRet;
+#define ASSINATURA_COMPARTILHADA "GRAFO-3"
 
-	if (pGrafoParm == NULL)
-	{
-		return GRA_CondRetGrafoNaoFoiCriado;
-	}
+typedef struct {
 
-	pGrafo = (tpGrafo*) pGrafoParm;
+   char assinatura[8];
+   /* ASSINATURA_COMPARTILHADA, escrita por ltimo quando a cpia est completa */
 
-	if (EstaVazio(pGrafo))
-	{
-		return GRA_CondRetGrafoVazio;
-	}
+   size_t tamanho;
+   /* Tamanho total da cpia em bytes */
 
-   graCondRet = ProcurarAresta(pGrafo->pCorrente, nomeAresta, &pAresta);
-   if (graCondRet != GRA_CondRetOK)
-   {
-      return GRA_CondRetNaoAchou;
-   }
+   int numVertices;
+   /* Quantidade de vrtices */
 
-	pGrafo->pCorrente = pAresta->pVertice;
+   int numArestas;
+   /* Quantidade de arestas */
 
-	return GRA_CondRetOK;
-}
+   size_t desVertices;
+   /* Deslocamento do vetor de tpVerticeCompartilhado */
 
-/***************************************************************************
-*  Funo: GRA Ir para a origem
-******/
-GRA_tpCondRet GRA_IrParaAOrigem(GRA_tppGrafo pGrafoParm, char *nomeVertice)
-{
+   size_t desArestas;
+   /* Deslocamento do vetor de tpArestaCompartilhada, agrupado por origem */
+
+   size_t desIndiceNomes;
+   /* Deslocamento do vetor de ndices de vrtices em ordem de nome */
+
+} tpCabecaCompartilhada;
+
+typedef struct {
+
+   size_t desNome;
+   /* Deslocamento do nome */
+
+   size_t desValor;
+   /* Deslocamento do valor, 0 se no publicado */
+
+   int primeiraAresta;
+   /* ndice da primeira aresta que sai do vrtice */
+
+   int numArestas;
+   /* Quantidade de arestas que saem do vrtice */
+
+} tpVerticeCompartilhado;
+
+typedef struct {
+
+   size_t desNome;
+   /* Deslocamento do nome da aresta */
+
+   int destino;
+   /* ndice do vrtice destino */
+
+} tpArestaCompartilhada;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Publicao
+***********************************************************************/
+
+typedef struct stPublicacao {
+
+   MCO_tppSegmento pSegmento;
+   /* Segmento criado pela publicao */
+
+} tpPublicacao;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Grafo compartilhado anexado
+***********************************************************************/
+
+typedef struct stGrafoCompartilhado {
+
+   MCO_tppSegmento pSegmento;
+   /* Segmento anexado */
+
+   const char *pBase;
+   /* Incio da cpia neste processo */
+
+   const tpCabecaCompartilhada *pCabeca;
+   /* Cabea da cpia, no incio do segmento */
+
+   const tpVerticeCompartilhado *vtVertices;
+   /* Vetor de vrtices dentro do segmento */
+
+   const tpArestaCompartilhada *vtArestas;
+   /* Vetor de arestas dentro do segmento */
+
+   int corrente;
+   /* ndice do vrtice corrente deste processo, -1 se no houver */
+
+} tpGrafoCompartilhado;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Tipos de registro do modo persistente
+*
+*  Os valores so gravados nos arquivos e no devem ser renumerados.
+***********************************************************************/
+
+typedef enum {
+
+   GRA_RegistroPontoDeControle = 0,
+   /* Primeiro registro de um ponto de controle: LSN do log coberto */
+
+   GRA_RegistroInserirVertice = 1,
+   /* Nome e valor */
+
+   GRA_RegistroInserirAresta = 2,
+   /* Nome da aresta, da origem e do destino */
+
+   GRA_RegistroAlterarValor = 3,
+   /* Nome do corrente e novo valor */
+
+   GRA_RegistroTornarOrigem = 4,
+   /* Nome do corrente */
+
+   GRA_RegistroDeixarOrigem = 5,
+   /* Nome do corrente */
+
+   GRA_RegistroDestruirVertice = 6,
+   /* Nome do vrtice destrudo */
+
+   GRA_RegistroDestruirAresta = 7
+   /* Nome do corrente e da aresta */
+
+} tpTipoRegistro;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Persistncia
+***********************************************************************/
+
+typedef struct stPersistencia {
+
+   WAL_tppLog pLog;
+   /* Log das mutaes posteriores ao ltimo ponto de controle */
+
+   char *caminhoBase;
+   /* Caminho ao qual so acrescentados os sufixos dos arquivos */
+
+   size_t (*tamanhoValor)(void *pValor);
+   /* Tamanho dos valores, copiados byte a byte; NULL se no so gravados */
+
+   long bytesParaPontoDeControle;
+   /* Tamanho do log que dispara um ponto de controle; 0 desliga */
+
+} tpPersistencia;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Recuperao
+***********************************************************************/
+
+typedef struct {
+
+   tpGrafo *pGrafo;
+   /* Grafo sendo reconstrudo */
+
+   WAL_tpLsn lsnPontoDeControle;
+   /* ltimo LSN do log coberto pelo ponto de controle lido */
+
+   GRA_tpCondRet condRet;
+   /* Motivo da interrupo da recuperao */
+
+} tpRecuperacao;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Listagem
+***********************************************************************/
+
+typedef struct {
+
+   int (*visitar)(const char *nome, void *pValor, void *pContexto);
+   /* Funo do cliente chamada para cada vrtice listado */
+
+   void *pContexto;
+   /* Contexto do cliente */
+
+} tpListagem;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Visita de sucessores
+***********************************************************************/
+
+typedef struct {
+
+   int (*visitar)(const char *nomeAresta, const char *nomeDestino, void *pValorDestino,
+                  void *pContexto);
+   /* Funo do cliente chamada para cada aresta */
+
+   void *pContexto;
+   /* Contexto do cliente */
+
+} tpVisitaSucessores;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Faixa de percurso paralelo
+***********************************************************************/
+
+typedef struct {
+
+   tpGrafo *pGrafo;
+   /* Grafo percorrido */
+
+   int inicio;
+   /* Primeiro identificador da faixa */
+
+   int fim;
+   /* Identificador seguinte ao ltimo da faixa */
+
+   int tarefa;
+   /* Nmero da tarefa repassado ao cliente */
+
+   void (*visitar)(const char *nome, void *pValor, int tarefa, void *pContexto);
+   /* Funo do cliente chamada para cada vrtice */
+
+   void *pContexto;
+   /* Contexto do cliente */
+
+   TAR_tppTarefa pTarefa;
+   /* Linha que visita a faixa, ou NULL se ela  visitada por quem chamou */
+
+} tpFaixa;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Clculo de PageRank
+*
+*  Vetores contguos, indexados por id, compartilhados pelas faixas de
+*  uma iterao. Ids livres tm salto 0 e nenhum antecessor, e por isso
+*  ficam com rank 0.
+***********************************************************************/
+
+typedef struct {
+
+   int *vtInicio;
+   /* Os antecessores de id esto em vtAntecessores[vtInicio[id]] at
+      vtAntecessores[vtInicio[id + 1] - 1]; numIds + 1 posies */
+
+   int *vtAntecessores;
+   /* Ids dos antecessores, um por aresta */
+
+   double *vtInversoGrau;
+   /* 1 / grau de sada, ou 0 para vrtices sem sucessores. Incio do
+      bloco que guarda tambm os outros vetores de double */
+
+   double *vtSalto;
+   /* Distribuio do salto; soma 1 */
+
+   double *vtRank;
+   /* Rank da iterao em curso, escrito por faixa */
+
+   double *vtContribuicao;
+   /* Rank / grau de sada da iterao anterior, s lido na iterao */
+
+   double *vtContribuicaoNova;
+   /* Rank / grau de sada da iterao em curso, escrito por faixa */
+
+   double amortecimento;
+   /* Chance de seguir uma aresta */
+
+   double fatorSalto;
+   /* Peso do salto na iterao: 1 - amortecimento, mais o rank dos
+      sumidouros da iterao anterior vezes amortecimento */
+
+} tpPageRank;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Faixa de PageRank
+***********************************************************************/
+
+typedef struct {
+
+   tpPageRank *pCalculo;
+   /* Vetores compartilhados */
+
+   int inicio;
+   /* Primeiro identificador da faixa */
+
+   int fim;
+   /* Identificador seguinte ao ltimo da faixa */
+
+   double diferenca;
+   /* Soma das diferenas de rank na faixa, calculada pela iterao */
+
+   double rankSumidouros;
+   /* Soma dos ranks de vrtices sem sucessores na faixa */
+
+   TAR_tppTarefa pTarefa;
+   /* Linha que calcula a faixa, ou NULL se ela  calculada por quem chamou */
+
+} tpFaixaPageRank;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Adjacncia ordenada
+*
+*  Vizinhos de cada id, nos dois sentidos, em vetores contguos de ids
+*  crescentes e sem repeties.
+***********************************************************************/
+
+typedef struct {
+
+   int *vtInicio;
+   /* Os vizinhos de id esto em vtVizinhos[vtInicio[id]] at
+      vtVizinhos[vtInicio[id + 1] - 1]; numIds + 1 posies */
+
+   int *vtVizinhos;
+   /* Ids dos vizinhos */
+
+   int numIds;
+   /* Quantidade de ids quando a adjacncia foi montada */
+
+} tpAdjacenciaOrdenada;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Faixa de contagem de tringulos
+***********************************************************************/
+
+typedef struct {
+
+   const tpAdjacenciaOrdenada *pAdjacencia;
+   /* Adjacncia compartilhada */
+
+   long *vtTriangulos;
+   /* Tringulos por id, escrito s nas posies da faixa */
+
+   int inicio;
+   /* Primeiro identificador da faixa */
+
+   int fim;
+   /* Identificador seguinte ao ltimo da faixa */
+
+   TAR_tppTarefa pTarefa;
+   /* Linha que conta a faixa, ou NULL se ela  contada por quem chamou */
+
+} tpFaixaTriangulos;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Subexpresso de caminho
+*
+*  Descrio:
+*  Resumo de uma parte j lida de uma expresso de caminho, usado para
+*  ligar as posies do autmato.
+***********************************************************************/
+
+typedef struct {
+
+   int anulavel;
+   /* 1 se a parte aceita o caminho vazio */
+
+   unsigned long primeiros;
+   /* Posies por onde a parte pode comear */
+
+   unsigned long ultimos;
+   /* Posies em que a parte pode terminar */
+
+} tpSubexpressao;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Leitura de expresso de caminho
+***********************************************************************/
+
+typedef struct {
+
+   const char *pProximo;
+   /* Prximo caractere a ser lido */
+
+   tpGrafo *pGrafo;
+   /* Grafo em que os rtulos so internados */
+
+   tpExpressao *pExpressao;
+   /* Expresso sendo compilada */
+
+   GRA_tpCondRet condRet;
+   /* Primeiro erro encontrado */
+
+} tpLeituraExpressao;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Passo da busca bidirecional
+***********************************************************************/
+
+typedef struct {
+
+   int id;
+   /* Id do vrtice alcanado */
+
+   int anterior;
+   /* Posio, na mesma fila, do vrtice de onde ele foi alcanado, ou
+      -1 na ponta */
+
+   int distancia;
+   /* Quantidade de arestas desde a ponta pelo caminho de anterior */
+
+} tpPassoBusca;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Ponta da busca bidirecional
+***********************************************************************/
+
+typedef struct {
+
+   tpPassoBusca *vtPassos;
+   /* Fila dos vrtices alcanados, em ordem de distncia */
+
+   int numPassos;
+   /* Quantidade de vrtices na fila */
+
+   int capPassos;
+   /* Capacidade de vtPassos */
+
+   int inicioNivel;
+   /* Primeira posio do nvel a ser expandido; o nvel vai at o fim
+      da fila */
+
+   int sentido;
+   /* 1 se a ponta segue os sucessores, -1 se segue os antecessores */
+
+} tpPontaBusca;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Vizinhos num sentido
+***********************************************************************/
+
+typedef struct {
+
+   int sentido;
+   /* 1 para os destinos das arestas que saem do vrtice, -1 para os
+      antecessores */
+
+   ADJ_tpIterador iterArestas;
+   /* Percurso dos sucessores, se sentido  1 */
+
+   LIS_tpIterador iterAntecessores;
+   /* Percurso dos antecessores, se sentido  -1 */
+
+} tpVizinhos;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Aberto da busca por marcos
+***********************************************************************/
+
+typedef struct {
+
+   int estimativa;
+   /* Distncia percorrida mais o limite inferior do resto */
+
+   int distancia;
+   /* Distncia percorrida quando o aberto foi inserido. Se a posio
+      foi alcanada depois por caminho menor, o aberto  descartado */
+
+   int posicao;
+   /* Posio do vrtice na fila da busca */
+
+} tpAberto;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Fila de prioridade de abertos
+***********************************************************************/
+
+typedef struct {
+
+   tpAberto *vtAbertos;
+   /* Heap binrio, com o prximo a sair na posio 0 */
+
+   int numAbertos;
+   /* Quantidade de abertos no heap */
+
+   int capAbertos;
+   /* Capacidade de vtAbertos */
+
+} tpFilaAbertos;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Destruio em lote
+***********************************************************************/
+
+typedef struct GRA_stDestruicao {
+
+   tpGrafo *pGrafo;
+   /* Grafo j separado de vises, marcadores e persistncia */
+
+   void (*destruirValores)(void **vtValores, int numValores);
+   /* Destruio dos valores em vetores, ou NULL */
+
+   TAR_tppTarefa pTarefa;
+   /* Tarefa que faz a liberao, ou NULL se ela foi feita na chamada */
+
+} tpDestruicao;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Vetor em preenchimento
+***********************************************************************/
+
+typedef struct {
+
+   tpVertice **vtVertices;
+   /* Vetor preenchido em ordem de nome */
+
+   int numVertices;
+   /* Quantidade de posies j preenchidas */
+
+} tpVetorEmPreenchimento;
+
+
+/***********************************************************************
+*  Tipo de dados: GRA Nome buscado
+*
+*  Chave das buscas nas listas de vrtices e de arestas. O tamanho
+*  permite descartar sem ler os caracteres os nomes de outro tamanho.
+***********************************************************************/
+
+typedef struct {
+
+   const char *nome;
+   /* Nome procurado; no modo de chaves fixas, aponta para vtChave */
+
+   size_t tamanho;
+   /* Quantidade de caracteres do nome */
+
+   size_t largura;
+   /* Largura da chave fixa, ou 0 para comparar pelo tamanho */
+
+   char vtChave[MAX_LARGURA_CHAVE];
+   /* Nome completado com zeros at a largura da chave */
+
+} tpNomeBuscado;
+
+/***** Dados encapsulados no mdulo ******/
+#ifdef _DEBUG
+
+   static char EspacoLixo[256] =
+            "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+         /* Espao de dados lixo usado ao testar */
+   
+   static unsigned long espacoAlocado;
+#endif
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+#ifdef _DEBUG
+   // deturpacao
+   static void DET_EliminaElementoCorrente(tpGrafo *pGrafo);
+   static void DET_AtribuiNullParaVerticeSucessor(tpGrafo *pGrafo);
+   static void DET_AtribuiNullAOPonteiroDoVerticePredecessor(tpGrafo *pGrafo);
+   static void DET_LixoNaReferenciaParaSucessor(tpGrafo *pGrafo);
+
+   //Verificacao
+   static GRA_tpCondRet VER_VerticeSucessorNaoEhNulo(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_VerticePredecessorNaoEhNulo(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_NaoExisteLixoNaReferenciaParaSucessor(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_NaoExisteLixoNaReferenciaParaAntecessor(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_VerticesNaoPossuemConteudoNulo(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_NenhumVerticeTemConteudoComOTipoCorrompido(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_NenhumVerticeEstaDestacado(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_NenhumVerticeFoiLiberado(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_CorrenteNaoEhNulo(tpGrafo *pGrafo, int *numFalhas);
+   static GRA_tpCondRet VER_NaoExisteOrigemNula(tpGrafo *pGrafo, int *numFalhas);
+
+   static GRA_tpCondRet VerificaVertice(tpVertice *pVertice, int *numFalhas);
+
+   static void DET_LixoNaReferenciaParaAntecessor(tpGrafo *pGrafo);
+   static void DET_ConteudoDoVerticeNULL(tpGrafo *pGrafo);
+   static void DET_AlteraTipoDoValorDoVertice(tpGrafo *pGrafo);
+   static void DET_DestacaVertice(tpGrafo *pGrafo);
+   static void DET_AtribuiNullAoCorrente(tpGrafo *pGrafo);
+   static void DET_AtribuiNullParaUmaOrigem(tpGrafo *pGrafo);
+
+   static void DET_EspalharLixosPelaEstrutura(tpGrafo *pGrafo);
+   static void DET_GrafoEhEspacoLixo(tpGrafo *pGrafo);
+#endif
+
+static void DestruirVertice(void *pVazio);
+static void DestruirAresta(void *pVazio);
+static int CompararVerticeENome (void *pVazio1, void *pVazio2);
+static int CompararArestaENome (void *pVazio1, void *pVazio2);
+static int VerticeTemNome(tpVertice *pVertice, tpNomeBuscado *pBuscado);
+static int ArestaTemNome(tpAresta *pAresta, tpNomeBuscado *pBuscado);
+static int PosicaoDaArestaPara(const tpVertice *pVertice, const tpVertice *pDestino);
+static int PosicaoDaAresta(tpGrafo *pGrafo, tpVertice *pVertice, const char *nome);
+static unsigned int EspalharNome(const char *nome, size_t tamanho);
+static unsigned int EspalharInteiro(unsigned int valor);
+static int MesmoPonteiro(void *pValor, void *pProcurado);
+static int EstaVazio(tpGrafo *pGrafo);
+static char * AtribuirNome(tpGrafo *pGrafo, char *nome, size_t *pTamNome, char *nomeCurto);
+static void LiberarNome(char *nome, char *nomeCurto);
+static int NomeCabeNaChave(tpGrafo *pGrafo, const char *nome);
+static tpNomeBuscado * MontarNomeBuscado(tpGrafo *pGrafo, tpNomeBuscado *pBuscado,
+                                         const char *nome, size_t tamanho);
+static int NomesIguais(const char *nome, size_t tamNome, tpNomeBuscado *pBuscado);
+static int ChavesFixasIguais(const char *chave1, const char *chave2, size_t largura);
+static GRA_tpCondRet ProcurarVertice(tpGrafo *pGrafo, char *nome, tpVertice **pVertice);
+static GRA_tpCondRet ProcurarOrigem(tpGrafo *pGrafo, char *nome, tpVertice **pVertice);
+static GRA_tpCondRet ProcurarAresta(tpGrafo *pGrafo, tpVertice *pVertice, char *nome, tpAresta **pAresta);
+static int ExisteOrigem(tpGrafo *pGrafo, char *nome);
+static int ExisteAresta(tpGrafo *pGrafo, tpVertice *pVertice, char *nome);
+static void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo);
+static int AtribuirId(tpGrafo *pGrafo, tpVertice *pVertice);
+static void LiberarId(tpGrafo *pGrafo, int id);
+static int PertenceAVisao(tpVisao *pVisao, tpVertice *pVertice);
+static void RetirarDasVisoes(tpGrafo *pGrafo, tpVertice *pVertice);
+static int CompararPonteiros(void *pVazio1, void *pVazio2);
+static void * RealocarEspaco(void *pEspaco, size_t tamAntigo, size_t tamNovo);
+static GRA_tpCondRet CriarMarcador(tpGrafo *pGrafo, tpMarcador **ppMarcador);
+static void DestruirMarcador(tpMarcador *pMarcador);
+static void ReiniciarMarcador(tpMarcador *pMarcador);
+static int Marcar(tpMarcador *pMarcador, tpVertice *pVertice);
+static int EstaMarcado(tpMarcador *pMarcador, tpVertice *pVertice);
+static tpMarcador * ObterMarcadorDePercurso(tpGrafo *pGrafo);
+static void DevolverMarcadorDePercurso(tpGrafo *pGrafo, tpMarcador *pMarcador);
+static int CalcularOrdem(tpGrafo *pGrafo, GRA_tpOrdem ordem, tpVertice **vtOrdem, int numVertices);
+static int OrdenarEmLargura(tpGrafo *pGrafo, GRA_tpOrdem ordem, tpVertice **vtOrdem,
+   int numVertices, unsigned char *vtVisitado);
+static int GrauDoVertice(tpVertice *pVertice);
+static int CompararGrauCrescente(const void *pVazio1, const void *pVazio2);
+static int CompararGrauDecrescente(const void *pVazio1, const void *pVazio2);
+static int CobrirIds(tpGrafo *pGrafo);
+static int CopiarEmOrdem(tpVertice **vtOrdem, int numVertices, tpVertice **vtNovos,
+                         size_t tamValor);
+static void DescartarCopias(tpVertice **vtOrdem, int numCopias, tpVertice **vtNovos);
+static void LiberarCasca(tpVertice *pVertice);
+static void RenumerarAuxiliares(tpGrafo *pGrafo, tpVertice **vtNovos, unsigned int *vtRascunho);
+static size_t Alinhar(size_t tamanho);
+static int AcrescentarAoVetor(const char *nome, void *pVazio, void *pContexto);
+static void MontarCopiaCompartilhada(tpGrafo *pGrafo, char *pBase, size_t tamanho,
+   size_t (*tamanhoValor)(void *pValor), tpVertice **vtPorNome, int *vtIndices);
+static int ProcurarCompartilhado(tpGrafoCompartilhado *pGrafo, const char *nome);
+static GRA_tpCondRet RegistrarMutacao(tpGrafo *pGrafo, tpTipoRegistro tipo,
+   const char *nome1, const char *nome2, const char *nome3, void *pValor);
+static WAL_tpCondRet GravarRegistro(WAL_tppLog pLog, size_t (*tamanhoValor)(void *pValor),
+   tpTipoRegistro tipo, const char *nome1, const char *nome2, const char *nome3, void *pValor);
+static GRA_tpCondRet GravarPontoDeControle(tpGrafo *pGrafo);
+static int AplicarRegistro(unsigned char tipo, int numCampos, const unsigned char **vtCampos,
+   const size_t *vtTamanhos, void *pContexto);
+static char * CopiarBytes(const void *pOrigem, size_t tamanho);
+static char * MontarCaminho(const char *caminhoBase, const char *sufixo);
+static GRA_tpCondRet TraduzirCondRetLog(WAL_tpCondRet walCondRet);
+static int VisitarVerticeListado(const char *nome, void *pVazio, void *pContexto);
+static int VisitarSucessor(void *pVazio, void *pContexto);
+static int VisitarAntecessor(void *pVazio, void *pContexto);
+static void VisitarFaixa(void *pVazio);
+static GRA_tpCondRet SepararGrafo(tpGrafo *pGrafo);
+static void LiberarEmLote(void *pVazio);
+static void RetirarDosPercursos(tpGrafo *pGrafo, tpVertice *pVertice);
+static int ReservarFronteira(tpPercurso *pPercurso, int quantidade);
+static void NotificarAssinaturas(tpGrafo *pGrafo, tpTipoRegistro tipo,
+   const char *nome1, const char *nome2, const char *nome3);
+static int GuardarMudanca(GRA_tpMudanca *pMudanca, tpNomesGuardados *pNomesGuardados,
+   GRA_tpTipoMudanca tipo, unsigned long numSequencia,
+   const char *nomeVertice, const char *nomeAresta, const char *nomeDestino);
+static void EntregarLote(tpAssinatura *pAssinatura);
+static void DestruirAssinatura(tpAssinatura *pAssinatura);
+static GRA_tpCondRet AjustarOrdemTopologica(tpGrafo *pGrafo, tpVertice *pOrigem, tpVertice *pDestino);
+static int ReservarPosicaoTopologica(tpGrafo *pGrafo);
+static int ReservarAfetados(tpGrafo *pGrafo, int quantidade);
+static int CompararInteiros(const void *pVazio1, const void *pVazio2);
+static int MontarComponentes(tpGrafo *pGrafo);
+static int ReservarComponentes(tpGrafo *pGrafo, int quantidade);
+static void IniciarNoComponente(tpGrafo *pGrafo, int id);
+static int EncontrarComponente(tpGrafo *pGrafo, int id);
+static void UnirComponentes(tpGrafo *pGrafo, int id1, int id2);
+static void MarcarDesatualizado(tpGrafo *pGrafo, int raiz);
+static int RecalcularComponente(tpGrafo *pGrafo, int raiz);
+static int RetirarDosComponentes(tpGrafo *pGrafo, tpVertice *pVertice);
+static int AtualizarComponentes(tpGrafo *pGrafo);
+static GRA_tpCondRet ObterComponente(tpGrafo *pGrafo, tpVertice *pVertice, int *pRaiz);
+static GRA_tpCondRet CalcularPageRank(tpGrafo *pGrafo, int personalizado,
+   double amortecimento, double tolerancia, int maxIteracoes, int numTarefas,
+   void (*visitar)(const char *nome, double rank, void *pContexto), void *pContexto,
+   int *pNumIteracoes);
+static int MontarPageRank(tpGrafo *pGrafo, int personalizado, tpPageRank *pCalculo);
+static void DestruirPageRank(tpPageRank *pCalculo);
+static void IterarFaixaPageRank(void *pVazio);
+static double SomarContribuicoes(const int *vtAntecessores, int inicio, int fim,
+   const double *vtContribuicao);
+static int FimDaFaixa(const int *vtInicio, int numIds, int inicio, int faixa, int numFaixas);
+static int MontarAdjacenciaOrdenada(tpGrafo *pGrafo, tpAdjacenciaOrdenada *pAdjacencia);
+static void DestruirAdjacenciaOrdenada(tpAdjacenciaOrdenada *pAdjacencia);
+static void ContarTriangulosDaFaixa(void *pVazio);
+static int ContarComuns(const int *vtValores1, int numValores1,
+   const int *vtValores2, int numValores2);
+static int ObterRotulo(tpGrafo *pGrafo, const char *texto, size_t tamanho, int *pRotulo);
+static void LiberarRotulo(tpGrafo *pGrafo, int rotulo);
+static void LiberarExpressao(tpGrafo *pGrafo, tpExpressao *pExpressao);
+static void DestruirRotulosEExpressoes(tpGrafo *pGrafo);
+static GRA_tpCondRet ObterExpressao(tpGrafo *pGrafo, const char *texto, tpExpressao **ppExpressao);
+static int LerAlternativas(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub);
+static int LerSequencia(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub);
+static int LerRepeticao(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub);
+static int LerPrimario(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub);
+static void PularEspacos(tpLeituraExpressao *pLeitura);
+static void LigarSeguintes(tpExpressao *pExpressao, unsigned long ultimos, unsigned long primeiros);
+static tpGrupoRotulo * ProcurarGrupoRotulo(tpVertice *pVertice, int rotulo);
+static int AgruparAresta(tpGrafo *pGrafo, tpVertice *pVertice, tpAresta *pAresta);
+static void DesagruparAresta(tpGrafo *pGrafo, tpVertice *pVertice, tpAresta *pAresta);
+static int MontarGruposRotulo(tpGrafo *pGrafo);
+static void DesmontarGruposRotulo(tpGrafo *pGrafo);
+static void DestruirGrupoRotulo(void *pVazio);
+static int CompararGrupoERotulo(void *pVazio1, void *pVazio2);
+static int ReservarPosicoesNaBusca(tpGrafo *pGrafo);
+static void IniciarPontaBusca(tpPontaBusca *pPonta, int sentido);
+static int AcrescentarPasso(tpGrafo *pGrafo, tpPontaBusca *pPonta, int id, int anterior);
+static int PosicaoNaPonta(const tpGrafo *pGrafo, const tpPontaBusca *pPonta, int id);
+static int ExpandirNivelDaBusca(tpGrafo *pGrafo, tpPontaBusca *pPonta, const tpPontaBusca *pOutra,
+   int *pPosPonta, int *pPosOutra);
+static void DescartarMarcos(tpGrafo *pGrafo);
+static int CalcularMarcos(tpGrafo *pGrafo);
+static void MedirDistanciasDoMarco(tpGrafo *pGrafo, int marco, int coluna, int *vtFila);
+static int LimiteInferiorPorMarcos(const tpGrafo *pGrafo, int idOrigem, int idDestino);
+static int LimiteSuperiorPorMarcos(const tpGrafo *pGrafo, int idOrigem, int idDestino);
+static int InserirAberto(tpFilaAbertos *pAbertos, int estimativa, int distancia, int posicao);
+static void RetirarAberto(tpFilaAbertos *pAbertos, tpAberto *pAberto);
+static int AbertoAntes(const tpAberto *pAberto1, const tpAberto *pAberto2);
+static void AplicarAutoOrganizacao(const tpGrafo *pGrafo, LIS_tppLista pLista);
+static int AutoOrganizarSucessores(const tpGrafo *pGrafo, ADJ_tpAdjacencia *pSucessores,
+   int posicao);
+static void RegistrarBusca(GRA_tpEstatisticasBusca *pEstatisticas, int posicao);
+static void IniciarVizinhos(tpVizinhos *pVizinhos, tpVertice *pVertice, int sentido);
+static int ProximoVizinho(tpVizinhos *pVizinhos, int *pId);
+
+/***** Buscas especializadas nas listas do mdulo *****/
+
+LIS_DEFINIR_BUSCA(Vertice, tpVertice, tpNomeBuscado *, VerticeTemNome)
+LIS_DEFINIR_BUSCA(Ponteiro, void, void *, MesmoPonteiro)
+LIS_DEFINIR_BUSCA_CONTADA(Vertice, tpVertice, tpNomeBuscado *, VerticeTemNome)
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: GRA Criar grafo
+******/
+GRA_tpCondRet GRA_CriarGrafo(GRA_tppGrafo *ppGrafo,
+	void (*destruirValor)(void *pValor))
+{
+	tpGrafo *pGrafo;
+   pGrafo = (tpGrafo*) malloc(sizeof(tpGrafo));
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (IND_CriarIndice(&pGrafo->pIndiceNomes) != IND_CondRetOK)
+   {
+      free(pGrafo);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (IND_CriarIndice(&pGrafo->pIndiceRotulos) != IND_CondRetOK)
+   {
+      IND_DestruirIndice(pGrafo->pIndiceNomes);
+      free(pGrafo);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+	pGrafo->pCorrente = NULL;
+	pGrafo->destruirValor = destruirValor;
+   pGrafo->larguraChave = 0;
+   pGrafo->tamValor = 0;
+   pGrafo->recusarParalelas = 0;
+   pGrafo->vtOrdemTopologica = NULL;
+   pGrafo->numPosicoesTopologicas = 0;
+   pGrafo->capPosicoesTopologicas = 0;
+   pGrafo->vtAfetados = NULL;
+   pGrafo->capAfetados = 0;
+   pGrafo->vtPosicaoNaBusca = NULL;
+   pGrafo->capPosicaoNaBusca = 0;
+   pGrafo->vtDistanciasMarcos = NULL;
+   pGrafo->numMarcos = 0;
+   pGrafo->numIdsMarcos = 0;
+   pGrafo->numMarcosPedidos = NUM_MARCOS_PADRAO;
+   pGrafo->autoOrganizacao = GRA_AutoOrganizacaoNenhuma;
+   memset(&pGrafo->estatisticasArestas, 0, sizeof(GRA_tpEstatisticasBusca));
+   memset(&pGrafo->estatisticasOrigens, 0, sizeof(GRA_tpEstatisticasBusca));
+   pGrafo->vtComponentes = NULL;
+   pGrafo->capComponentes = 0;
+   pGrafo->numComponentes = 0;
+   pGrafo->vtDesatualizados = NULL;
+   pGrafo->numDesatualizados = 0;
+   pGrafo->numIdsRetidos = 0;
+   pGrafo->vtRotulos = NULL;
+   pGrafo->numRotulos = 0;
+   pGrafo->capRotulos = 0;
+   pGrafo->vtRotulosLivres = NULL;
+   pGrafo->numRotulosLivres = 0;
+   memset(pGrafo->vtExpressoes, 0, sizeof(pGrafo->vtExpressoes));
+   pGrafo->proximaExpressao = 0;
+   pGrafo->gruposMontados = 0;
+
+   pGrafo->vtVertices = NULL;
+   pGrafo->numIds = 0;
+   pGrafo->capIds = 0;
+   pGrafo->vtIdsLivres = NULL;
+   pGrafo->numIdsLivres = 0;
+
+	LIS_CriarLista(&pGrafo->pOrigens, NULL, CompararVerticeENome);
+	LIS_CriarLista(&pGrafo->pVertices, DestruirVertice, CompararVerticeENome);
+	LIS_CriarLista(&pGrafo->pVisoes, NULL, CompararPonteiros);
+	LIS_CriarLista(&pGrafo->pMarcadores, NULL, CompararPonteiros);
+	LIS_CriarLista(&pGrafo->pPercursos, NULL, CompararPonteiros);
+	LIS_CriarLista(&pGrafo->pAssinaturas, NULL, CompararPonteiros);
+   pGrafo->numAssinaturas = 0;
+   pGrafo->pMarcadorInterno = NULL;
+   pGrafo->marcadorInternoEmUso = 0;
+   pGrafo->pPersistencia = NULL;
+
+   #ifdef _DEBUG
+      CED_DefinirTipoEspaco(pGrafo, GRA_TipoEspacoCabeca);
+      pGrafo->qntVertices = 0;
+      
+      pGrafo->totalEspacoAlocado = _msize(pGrafo);
+      
+      LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
+      pGrafo->totalEspacoAlocado += espacoAlocado;
+      
+      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
+      pGrafo->totalEspacoAlocado += espacoAlocado;
+      
+      CED_MarcarEspacoAtivo(pGrafo);
+   #endif
+
+	*ppGrafo = (GRA_tppGrafo) pGrafo;
+
+	return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Criar grafo com chaves fixas
+******/
+GRA_tpCondRet GRA_CriarGrafoComChavesFixas(GRA_tppGrafo *ppGrafo,
+   void (*destruirValor)(void *pValor), int larguraChave)
+{
+   GRA_tpCondRet condRet;
+
+   if (larguraChave != 16 && larguraChave != MAX_LARGURA_CHAVE)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   condRet = GRA_CriarGrafo(ppGrafo, destruirValor);
+   if (condRet == GRA_CondRetOK)
+   {
+      ((tpGrafo*) *ppGrafo)->larguraChave = (size_t) larguraChave;
+   }
+
+   return condRet;
+}
+
+/***************************************************************************
+*  Funo: GRA Criar grafo com valores fixos
+******/
+GRA_tpCondRet GRA_CriarGrafoComValoresFixos(GRA_tppGrafo *ppGrafo, int tamValor)
+{
+   GRA_tpCondRet condRet;
+
+   if (tamValor < 1 || tamValor > GRA_MAX_TAM_VALOR)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   condRet = GRA_CriarGrafo(ppGrafo, NULL);
+   if (condRet == GRA_CondRetOK)
+   {
+      ((tpGrafo*) *ppGrafo)->tamValor = (size_t) tamValor;
+   }
+
+   return condRet;
+}
+
+/***************************************************************************
+*  Funo: GRA Destruir grafo
+******/
+GRA_tpCondRet GRA_DestruirGrafo(GRA_tppGrafo *ppGrafo)
+{
+	tpGrafo *pGrafo = (tpGrafo*) *ppGrafo;
+   GRA_tpCondRet condRet;
+
+	if (pGrafo == NULL)
+	{
+		return GRA_CondRetOK;
+	}
+
+   condRet = SepararGrafo(pGrafo);
+
+	LIS_DestruirLista(pGrafo->pVertices);
+	LIS_DestruirLista(pGrafo->pOrigens);
+
+   free(pGrafo->vtVertices);
+   free(pGrafo->vtIdsLivres);
+   free(pGrafo->vtOrdemTopologica);
+   free(pGrafo->vtAfetados);
+   free(pGrafo->vtPosicaoNaBusca);
+   free(pGrafo->vtDistanciasMarcos);
+   free(pGrafo->vtComponentes);
+   free(pGrafo->vtDesatualizados);
+   IND_DestruirIndice(pGrafo->pIndiceNomes);
+   DestruirRotulosEExpressoes(pGrafo);
+
+	free(pGrafo);
+	pGrafo = NULL;
+	*ppGrafo = NULL;
+	
+	return condRet;
+}
+
+/***************************************************************************
+*  Funo: GRA Destruir grafo em lote
+******/
+GRA_tpCondRet GRA_DestruirGrafoEmLote(GRA_tppGrafo *ppGrafo,
+   void (*destruirValores)(void **vtValores, int numValores),
+   GRA_tppDestruicao *ppDestruicao)
+{
+   tpGrafo *pGrafo = (tpGrafo*) *ppGrafo;
+   tpDestruicao destruicaoLocal;
+   tpDestruicao *pDestruicao = NULL;
+   GRA_tpCondRet condRet;
+
+   if (ppDestruicao != NULL)
+   {
+      *ppDestruicao = NULL;
+   }
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   condRet = SepararGrafo(pGrafo);
+   *ppGrafo = NULL;
+
+   #ifndef _DEBUG
+      // Em debug o controle de espaos dinmicos no admite outra linha
+      if (ppDestruicao != NULL)
+      {
+         pDestruicao = (tpDestruicao*) malloc(sizeof(tpDestruicao));
+      }
+   #endif
+
+   if (pDestruicao != NULL)
+   {
+      pDestruicao->pGrafo = pGrafo;
+      pDestruicao->destruirValores = destruirValores;
+      if (TAR_IniciarTarefa(&pDestruicao->pTarefa, LiberarEmLote, pDestruicao) == TAR_CondRetOK)
+      {
+         *ppDestruicao = (GRA_tppDestruicao) pDestruicao;
+         return condRet;
+      }
+      free(pDestruicao);
+   }
+
+   // Sem linha prpria, a liberao  feita aqui mesmo
+   destruicaoLocal.pGrafo = pGrafo;
+   destruicaoLocal.destruirValores = destruirValores;
+   destruicaoLocal.pTarefa = NULL;
+   LiberarEmLote(&destruicaoLocal);
+
+   return condRet;
+}
+
+/***************************************************************************
+*  Funo: GRA Esperar destruio
+******/
+GRA_tpCondRet GRA_EsperarDestruicao(GRA_tppDestruicao *ppDestruicao)
+{
+   tpDestruicao *pDestruicao = (tpDestruicao*) *ppDestruicao;
+
+   if (pDestruicao == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   TAR_EsperarTarefa(pDestruicao->pTarefa);
+   free(pDestruicao);
+   *ppDestruicao = NULL;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Inserir vertice
+******/
+GRA_tpCondRet GRA_InserirVertice(GRA_tppGrafo pGrafoParm, char *nomeVertice, void *pValor)
+{
+	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+	tpVertice *pVertice;
+   IND_tpCondRet indCondRet;
+
+	if (pGrafo == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+   if (!NomeCabeNaChave(pGrafo, nomeVertice))
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   if ((pGrafo->vtOrdemTopologica != NULL && !ReservarPosicaoTopologica(pGrafo)) ||
+       (pGrafo->vtComponentes != NULL && !ReservarComponentes(pGrafo, pGrafo->numIds + 1)))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+	pVertice = (tpVertice*) malloc(sizeof(tpVertice) + pGrafo->tamValor);
+	if (pVertice == NULL)
+	{
+		return GRA_CondRetFaltouMemoria;
+	}
+
+	pVertice->nome = AtribuirNome(pGrafo, nomeVertice, &pVertice->tamNome, pVertice->nomeCurto);
+   if (pVertice->nome == NULL)
+   {
+      free(pVertice);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   // A insero no ndice tambm detecta nomes repetidos
+   indCondRet = IND_Inserir(pGrafo->pIndiceNomes, pVertice->nome, pVertice);
+   if (indCondRet != IND_CondRetOK || !AtribuirId(pGrafo, pVertice))
+   {
+      if (indCondRet == IND_CondRetOK)
+      {
+         IND_Excluir(pGrafo->pIndiceNomes, pVertice->nome);
+      }
+      if (pVertice->nome != nomeVertice)
+      {
+         LiberarNome(pVertice->nome, pVertice->nomeCurto);
+      }
+      free(pVertice);
+      return indCondRet == IND_CondRetJaExiste ? GRA_CondRetJaExiste
+                                               : GRA_CondRetFaltouMemoria;
+   }
+
+   // Daqui em diante a insero no falha: o espao recebido j no  usado
+   if (pVertice->nome != nomeVertice)
+   {
+      free(nomeVertice);
+   }
+
+   // Sem arestas, o vrtice pode ficar em qualquer posio; fica na ltima
+   if (pGrafo->vtOrdemTopologica != NULL)
+   {
+      pVertice->posTopologica = pGrafo->numPosicoesTopologicas;
+      pGrafo->vtOrdemTopologica[pGrafo->numPosicoesTopologicas++] = pVertice->id;
+   }
+
+   if (pGrafo->vtComponentes != NULL)
+   {
+      IniciarNoComponente(pGrafo, pVertice->id);
+      pGrafo->numComponentes++;
+   }
+
+	pVertice->pValor = pValor;
+	pVertice->destruirValor = pGrafo->destruirValor;
+   pVertice->pDestinos = NULL;
+   ADJ_Iniciar(&pVertice->gruposRotulo);
+   if (pGrafo->tamValor != 0)
+   {
+      // O valor  copiado para os bytes que seguem o vrtice
+      pVertice->pValor = pVertice + 1;
+      if (pValor != NULL)
+      {
+         memcpy(pVertice->pValor, pValor, pGrafo->tamValor);
+      }
+      else
+      {
+         memset(pVertice->pValor, 0, pGrafo->tamValor);
+      }
+   }
+
+#if _DEBUG
+   pVertice->pGrafo = pGrafo;
+#endif
+   
+
+	LIS_CriarLista(&pVertice->pAntecessores, NULL, CompararVerticeENome);
+   ADJ_Iniciar(&pVertice->sucessores);
+
+   #ifdef _DEBUG
+      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
+      pGrafo->totalEspacoAlocado -= espacoAlocado;
+   #endif
+
+	pGrafo->pCorrente = pVertice;
+	LIS_IrFinalLista(pGrafo->pVertices);
+	LIS_InserirElementoApos(pGrafo->pVertices, pVertice);
+   
+   #ifdef _DEBUG
+      CED_DefinirTipoEspaco(pVertice, GRA_TipoEspacoVertice);
+      CED_DefinirTipoEspaco(pVertice->pValor, GRA_TipoEspacoValorVertice);
+      pGrafo->qntVertices++;
+      CED_MarcarEspacoAtivo(pVertice);
+      CED_MarcarEspacoAtivo(pVertice->pValor);
+
+      pGrafo->totalEspacoAlocado += _msize(pVertice);
+
+      LIS_TotalEspacoAlocado(pVertice->pAntecessores, &espacoAlocado);
+      pGrafo->totalEspacoAlocado += espacoAlocado;
+      
+      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
+      pGrafo->totalEspacoAlocado += espacoAlocado;
+   #endif
+
+	return RegistrarMutacao(pGrafo, GRA_RegistroInserirVertice, pVertice->nome, NULL, NULL, pValor);
+}
+
+/***************************************************************************
+*  Funo: GRA Inserir aresta
+******/
+GRA_tpCondRet GRA_InserirAresta(GRA_tppGrafo pGrafoParm,
+	char *nomeAresta, char *nomeVerticeOrigem, char *nomeVerticeDestino)
+{
+	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+	tpAresta *pAresta;
+	LIS_tpCondRet lisCondRet;
+   GRA_tpCondRet graCondRet;
+   tpVertice *pVerticeOrigem, *pVerticeDestino;
+
+	if (pGrafo == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+   // Procura vrtice origem
+   graCondRet = ProcurarVertice(pGrafo, nomeVerticeOrigem, &pVerticeOrigem);
+   if (graCondRet != GRA_CondRetOK)
+   {
+      return graCondRet;
+   }
+
+   // Procura vrtice destino
+   graCondRet = ProcurarVertice(pGrafo, nomeVerticeDestino, &pVerticeDestino);
+   if (graCondRet != GRA_CondRetOK)
+   {
+      return graCondRet;
+   }
+
+   if (!NomeCabeNaChave(pGrafo, nomeAresta))
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   // Verifica se j existe uma aresta com este nome ou, se as paralelas
+   // so recusadas, com este destino
+   if (ExisteAresta(pGrafo, pVerticeOrigem, nomeAresta) ||
+       (pGrafo->recusarParalelas &&
+        CNJ_Contar(pVerticeOrigem->pDestinos, pVerticeDestino->id) > 0))
+   {
+      return GRA_CondRetJaExiste;
+   }
+
+   // A ordem ajustada continua vlida mesmo que a insero falhe adiante
+   if (pGrafo->vtOrdemTopologica != NULL)
+   {
+      graCondRet = AjustarOrdemTopologica(pGrafo, pVerticeOrigem, pVerticeDestino);
+      if (graCondRet != GRA_CondRetOK)
+      {
+         return graCondRet;
+      }
+   }
+
+	pAresta = (tpAresta*) malloc(sizeof(tpAresta));
+
+   #ifdef _DEBUG
+      CED_DefinirTipoEspaco(pAresta, GRA_TipoEspacoAresta);
+   #endif
+
+	if (pAresta == NULL)
+	{
+		return GRA_CondRetFaltouMemoria;
+	}
+
+	pAresta->nome = AtribuirNome(pGrafo, nomeAresta, &pAresta->tamNome, pAresta->nomeCurto);
+   if (pAresta->nome == NULL)
+   {
+      free(pAresta);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (!ObterRotulo(pGrafo, nomeAresta, strcspn(nomeAresta, SEPARADOR_ROTULO), &pAresta->rotulo))
+   {
+      if (pAresta->nome != nomeAresta)
+      {
+         LiberarNome(pAresta->nome, pAresta->nomeCurto);
+      }
+      free(pAresta);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (!AgruparAresta(pGrafo, pVerticeOrigem, pAresta) ||
+       CNJ_Acrescentar(&pVerticeOrigem->pDestinos, pVerticeDestino->id) != CNJ_CondRetOK)
+   {
+      DesagruparAresta(pGrafo, pVerticeOrigem, pAresta);
+      LiberarRotulo(pGrafo, pAresta->rotulo);
+      if (pAresta->nome != nomeAresta)
+      {
+         LiberarNome(pAresta->nome, pAresta->nomeCurto);
+      }
+      free(pAresta);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   #ifdef _DEBUG
+      LIS_TotalEspacoAlocado(pVerticeDestino->pAntecessores, &espacoAlocado);
+      pGrafo->totalEspacoAlocado -= espacoAlocado;
+
+      pGrafo->totalEspacoAlocado -= ADJ_EspacoAlocado(&pVerticeOrigem->sucessores);
+   #endif
+
+   // Atualiza os antecessores do vrtice destino
+	lisCondRet = LIS_InserirElementoApos(pVerticeDestino->pAntecessores, pVerticeOrigem);
+	if (lisCondRet == LIS_CondRetFaltouMemoria)
+	{
+      CNJ_Retirar(pVerticeOrigem->pDestinos, pVerticeDestino->id);
+      DesagruparAresta(pGrafo, pVerticeOrigem, pAresta);
+      LiberarRotulo(pGrafo, pAresta->rotulo);
+      if (pAresta->nome != nomeAresta)
+      {
+         LiberarNome(pAresta->nome, pAresta->nomeCurto);
+      }
+      free(pAresta);
+		return GRA_CondRetFaltouMemoria;
+	}
+
+   // Atualiza os sucessores do vrtice origem, em ordem de insero
+   if (ADJ_Acrescentar(&pVerticeOrigem->sucessores, pAresta,
+                       EspalharNome(pAresta->nome, pAresta->tamNome)) != ADJ_CondRetOK)
+	{
+      LIS_ExcluirElemento(pVerticeDestino->pAntecessores);
+      CNJ_Retirar(pVerticeOrigem->pDestinos, pVerticeDestino->id);
+      DesagruparAresta(pGrafo, pVerticeOrigem, pAresta);
+      LiberarRotulo(pGrafo, pAresta->rotulo);
+      if (pAresta->nome != nomeAresta)
+      {
+         LiberarNome(pAresta->nome, pAresta->nomeCurto);
+      }
+      free(pAresta);
+		return GRA_CondRetFaltouMemoria;
+	}
+
+   pAresta->pVertice = pVerticeDestino;
+   if (pAresta->nome != nomeAresta)
+   {
+      free(nomeAresta);
+   }
+
+   if (pGrafo->vtComponentes != NULL)
+   {
+      UnirComponentes(pGrafo, pVerticeOrigem->id, pVerticeDestino->id);
+   }
+
+#if _DEBUG
+   pAresta->pGrafo = pGrafo;
+#endif
+   
+
+   #ifdef _DEBUG
+      CED_DefinirTipoEspaco( pAresta , GRA_TipoEspacoAresta ) ;
+      CED_MarcarEspacoAtivo(pAresta);
+
+      pGrafo->totalEspacoAlocado += _msize(pAresta);
+      
+      LIS_TotalEspacoAlocado(pVerticeDestino->pAntecessores, &espacoAlocado);
+      pGrafo->totalEspacoAlocado += espacoAlocado;
+
+      pGrafo->totalEspacoAlocado += ADJ_EspacoAlocado(&pVerticeOrigem->sucessores);
+   #endif
+
+	return RegistrarMutacao(pGrafo, GRA_RegistroInserirAresta,
+      pAresta->nome, pVerticeOrigem->nome, pVerticeDestino->nome, NULL);
+}
+
+/***************************************************************************
+*  Funo: GRA Obter valor do vrtice corrente
+******/
+GRA_tpCondRet GRA_ObterValorCorrente(GRA_tppGrafo pGrafoParm, void **ppValor)
+{
+	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+	if (pGrafo == NULL)
+	{
+		*ppValor = NULL;
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	if (EstaVazio(pGrafo))
+	{
+		*ppValor = NULL;
+		return GRA_CondRetGrafoVazio; 
+	}
+
+	*ppValor = pGrafo->pCorrente->pValor;
+	return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Alterar valor do vrtice corrente
+******/
+GRA_tpCondRet GRA_AlterarValorCorrente(GRA_tppGrafo pGrafoParm, void *pValor)
+{
+	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+	if (pGrafo == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	if (EstaVazio(pGrafo))
+	{
+		return GRA_CondRetGrafoVazio;
+	}
+
+   if (pGrafo->tamValor != 0)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+	pGrafo->pCorrente->pValor = pValor;
+	return RegistrarMutacao(pGrafo, GRA_RegistroAlterarValor, pGrafo->pCorrente->nome, NULL, NULL, pValor);
+}
+
+/***************************************************************************
+*  Funo: GRA Ler valor fixo do vrtice corrente
+******/
+GRA_tpCondRet GRA_LerValorCorrente(GRA_tppGrafo pGrafoParm, void *pDestino)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->tamValor == 0)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   if (EstaVazio(pGrafo))
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   memcpy(pDestino, pGrafo->pCorrente->pValor, pGrafo->tamValor);
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Gravar valor fixo do vrtice corrente
+******/
+GRA_tpCondRet GRA_GravarValorCorrente(GRA_tppGrafo pGrafoParm, const void *pOrigem)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->tamValor == 0)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   if (EstaVazio(pGrafo))
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   memcpy(pGrafo->pCorrente->pValor, pOrigem, pGrafo->tamValor);
+   return RegistrarMutacao(pGrafo, GRA_RegistroAlterarValor, pGrafo->pCorrente->nome,
+                           NULL, NULL, pGrafo->pCorrente->pValor);
+}
+
+
+/***************************************************************************
+*  Funo: GRA Tornar vrtice corrente uma origem
+******/
+GRA_tpCondRet GRA_TornarCorrenteUmaOrigem(GRA_tppGrafo pGrafoParm)
+{
+	tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+	if (pGrafo == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	if (EstaVazio(pGrafo))
+	{
+		return GRA_CondRetGrafoVazio;
+	}
+
+   if (ExisteOrigem(pGrafo, pGrafo->pCorrente->nome))
+   {
+      return GRA_CondRetJaExiste;
+   }
+
+#ifdef _DEBUG
+   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
+   pGrafo->totalEspacoAlocado -= espacoAlocado;
+#endif
+
+   LIS_IrFinalLista(pGrafo->pOrigens);
+	LIS_InserirElementoApos(pGrafo->pOrigens, pGrafo->pCorrente);
+
+#ifdef _DEBUG
+   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
+   pGrafo->totalEspacoAlocado += espacoAlocado;
+#endif
+
+	return RegistrarMutacao(pGrafo, GRA_RegistroTornarOrigem, pGrafo->pCorrente->nome, NULL, NULL, NULL);
+}
+
+
+/***************************************************************************
+*  Funo: GRA Deixar de ser origem
+******/
+GRA_tpCondRet GRA_DeixarDeSerOrigem(GRA_tppGrafo pGrafoParm)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpNomeBuscado buscado;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (EstaVazio(pGrafo))
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   // A excluso  feita no corrente da lista, que passa a ser a origem
+   if (!LIS_IrParaElemento(pGrafo->pOrigens, LIS_ProcurarVertice(pGrafo->pOrigens,
+          MontarNomeBuscado(pGrafo, &buscado, pGrafo->pCorrente->nome, pGrafo->pCorrente->tamNome))))
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+#ifdef _DEBUG
+   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
+   pGrafo->totalEspacoAlocado -= espacoAlocado;
+#endif
+
+   LIS_ExcluirElemento(pGrafo->pOrigens);
+
+#ifdef _DEBUG
+   LIS_TotalEspacoAlocado(pGrafo->pOrigens, &espacoAlocado);
+   pGrafo->totalEspacoAlocado += espacoAlocado;
+#endif
+
+   return RegistrarMutacao(pGrafo, GRA_RegistroDeixarOrigem, pGrafo->pCorrente->nome, NULL, NULL, NULL);
+}
+
+/***************************************************************************
+*  Funo: GRA Destruir vrtice corrente
+******/
+GRA_tpCondRet GRA_DestruirVerticeCorrente(GRA_tppGrafo pGrafoParm)
+{
+	tpGrafo *pGrafo = NULL;
+	int estaVazia = -1;
+   char *nomeRegistrado = NULL;
+   GRA_tpCondRet condRet;
+
+	if (pGrafoParm == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	pGrafo = (tpGrafo*) pGrafoParm;
+
+	if (EstaVazio(pGrafo))
+	{
+		return GRA_CondRetGrafoVazio;
+	}
+
+	LIS_EstaVazia(pGrafo->pOrigens,&estaVazia);
+
+	if (estaVazia)
+	{
+		return GRA_CondRetNaoAchou;
+	}
+
+   // O nome  liberado junto com o vrtice, mas o registro  feito depois
+   if (pGrafo->pPersistencia != NULL || pGrafo->numAssinaturas > 0)
+   {
+      nomeRegistrado = CopiarBytes(pGrafo->pCorrente->nome, pGrafo->pCorrente->tamNome + 1);
+      if (nomeRegistrado == NULL)
+      {
+         return GRA_CondRetFaltouMemoria;
+      }
+   }
+
+   DestacarVertice(pGrafo, pGrafo->pCorrente);
+	
+   #ifdef _DEBUG
+      pGrafo->qntVertices--;
+   #endif
+
+   condRet = RegistrarMutacao(pGrafo, GRA_RegistroDestruirVertice, nomeRegistrado, NULL, NULL, NULL);
+   free(nomeRegistrado);
+
+	return condRet;
+}
+
+
+/***************************************************************************
+*  Funo: GRA Destruir aresta adjacente
+******/
+GRA_tpCondRet GRA_DestruirArestaAdjacente(GRA_tppGrafo pGrafoParm, char *nomeAresta)
+{
+	tpGrafo *pGrafo = NULL;
+	tpAresta *pAresta = NULL;
+   LIS_tppLista pAntecessores;
+   ADJ_tpAdjacencia *pSucessores;
+   tpNomeBuscado buscado;
+   int posicao;
+
+	if (pGrafoParm == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	pGrafo = (tpGrafo*) pGrafoParm;
+
+	if (EstaVazio(pGrafo))
+	{
+		return GRA_CondRetGrafoVazio;
+	}
+
+	// Busca Aresta  remover
+   pSucessores = &pGrafo->pCorrente->sucessores;
+   posicao = PosicaoDaAresta(pGrafo, pGrafo->pCorrente, nomeAresta);
+   if (posicao < 0)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pAresta = (tpAresta*) ADJ_ObterValor(pSucessores, posicao);
+   pAntecessores = pAresta->pVertice->pAntecessores;
+
+	// Remove referncia do vrtice corrente; a excluso  feita no
+   // corrente da lista
+	LIS_IrParaElemento(pAntecessores, LIS_ProcurarVertice(pAntecessores,
+      MontarNomeBuscado(pGrafo, &buscado, pGrafo->pCorrente->nome, pGrafo->pCorrente->tamNome)));
+
+#ifdef _DEBUG
+   LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
+   pGrafo->totalEspacoAlocado -= espacoAlocado;
+   
+   pGrafo->totalEspacoAlocado -= ADJ_EspacoAlocado(pSucessores);
+#endif
+
+   CNJ_Retirar(pGrafo->pCorrente->pDestinos, pAresta->pVertice->id);
+   DesagruparAresta(pGrafo, pGrafo->pCorrente, pAresta);
+
+	LIS_ExcluirElemento(pAntecessores);
+   ADJ_Retirar(pSucessores, posicao);
+   LiberarRotulo(pGrafo, pAresta->rotulo);
+   DestruirAresta(pAresta);
+
+   // O componente s  recalculado quando consultado
+   if (pGrafo->vtComponentes != NULL)
+   {
+      MarcarDesatualizado(pGrafo, EncontrarComponente(pGrafo, pGrafo->pCorrente->id));
+   }
+   
+#ifdef _DEBUG
+   LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
+   pGrafo->totalEspacoAlocado += espacoAlocado;
+   
+   pGrafo->totalEspacoAlocado += ADJ_EspacoAlocado(pSucessores);
+#endif
+
+	return RegistrarMutacao(pGrafo, GRA_RegistroDestruirAresta, pGrafo->pCorrente->nome, nomeAresta, NULL, NULL);
+}
+
+/***************************************************************************
+*  Funo: GRA Ir para o vrtice adjacente
+******/
+GRA_tpCondRet GRA_IrParaVerticeAdjacente(GRA_tppGrafo pGrafoParm, char *nomeVertice)
+{
+	tpGrafo *pGrafo = NULL;
+	tpVertice *pVertice = NULL;
+
+	if (pGrafoParm == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	pGrafo = (tpGrafo*) pGrafoParm;
+	if (EstaVazio(pGrafo))
+	{
+		return GRA_CondRetGrafoVazio;
+	}
+
+   // O vrtice  achado pelo ndice de nomes e a aresta pelo ndice de
+   // destinos, sem percorrer as arestas do corrente
+   if (ProcurarVertice(pGrafo, nomeVertice, &pVertice) != GRA_CondRetOK ||
+       CNJ_Contar(pGrafo->pCorrente->pDestinos, pVertice->id) == 0)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pGrafo->pCorrente = pVertice;
+	return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Existe aresta entre
+******/
+GRA_tpCondRet GRA_ExisteArestaEntre(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pOrigem = NULL, *pDestino = NULL;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeOrigem, &pOrigem) != GRA_CondRetOK ||
+       ProcurarVertice(pGrafo, nomeDestino, &pDestino) != GRA_CondRetOK ||
+       CNJ_Contar(pOrigem->pDestinos, pDestino->id) == 0)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Recusar arestas paralelas
+******/
+GRA_tpCondRet GRA_RecusarArestasParalelas(GRA_tppGrafo pGrafoParm, int recusar)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   pGrafo->recusarParalelas = recusar != 0;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Seguir pela aresta
+******/
+GRA_tpCondRet GRA_SeguirPelaAresta(GRA_tppGrafo pGrafoParm, char *nomeAresta)
+{
+	tpGrafo *pGrafo = NULL;
+   ADJ_tpAdjacencia *pSucessores;
+   int posicao;
+
+	if (pGrafoParm == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	pGrafo = (tpGrafo*) pGrafoParm;
+
+	if (EstaVazio(pGrafo))
+	{
+		return GRA_CondRetGrafoVazio;
+	}
+
+   if (nomeAresta == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pSucessores = &pGrafo->pCorrente->sucessores;
+   posicao = PosicaoDaAresta(pGrafo, pGrafo->pCorrente, nomeAresta);
+   RegistrarBusca(&pGrafo->estatisticasArestas, posicao + 1);
+   if (posicao < 0)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   posicao = AutoOrganizarSucessores(pGrafo, pSucessores, posicao);
+	pGrafo->pCorrente = ((tpAresta*) ADJ_ObterValor(pSucessores, posicao))->pVertice;
+
+	return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Ir para a origem
+******/
+GRA_tpCondRet GRA_IrParaAOrigem(GRA_tppGrafo pGrafoParm, char *nomeVertice)
+{
 	tpGrafo *pGrafo = NULL;
+   const LIS_tpElemLista *pElem;
+   tpNomeBuscado buscado;
+   int posicao;
+
+	if (pGrafoParm == NULL)
+	{
+		return GRA_CondRetGrafoNaoFoiCriado;
+	}
+
+	pGrafo = (tpGrafo*) pGrafoParm;
+
+	if (EstaVazio(pGrafo))
+	{
+		return GRA_CondRetGrafoVazio;
+	}
+
+   if (nomeVertice == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pElem = LIS_ProcurarVerticeContando(pGrafo->pOrigens,
+      MontarNomeBuscado(pGrafo, &buscado, nomeVertice, strlen(nomeVertice)), &posicao);
+   RegistrarBusca(&pGrafo->estatisticasOrigens, pElem == NULL ? 0 : posicao);
+   if (pElem == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   LIS_AutoOrganizar(pGrafo->pOrigens, pElem);
+	pGrafo->pCorrente = (tpVertice*) pElem->pValor;
+
+	return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Criar viso
+******/
+GRA_tpCondRet GRA_CriarVisao(GRA_tppGrafo pGrafoParm, GRA_tppVisao *ppVisao,
+   int (*pertence)(char *nomeVertice, void *pValor, void *pContexto), void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVisao *pVisao;
+
+   *ppVisao = NULL;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   pVisao = (tpVisao*) malloc(sizeof(tpVisao));
+   if (pVisao == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   pVisao->pGrafo = pGrafo;
+   pVisao->pertence = pertence;
+   pVisao->pContexto = pContexto;
+   pVisao->vtBits = NULL;
+   pVisao->numBytes = 0;
+   pVisao->pCorrente = NULL;
+
+   LIS_IrFinalLista(pGrafo->pVisoes);
+   if (LIS_InserirElementoApos(pGrafo->pVisoes, pVisao) != LIS_CondRetOK)
+   {
+      free(pVisao);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   *ppVisao = (GRA_tppVisao) pVisao;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Destruir viso
+******/
+GRA_tpCondRet GRA_DestruirVisao(GRA_tppVisao *ppVisao)
+{
+   tpVisao *pVisao = (tpVisao*) *ppVisao;
+
+   if (pVisao == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   if (pVisao->pGrafo != NULL)
+   {
+      if (LIS_IrParaElemento(pVisao->pGrafo->pVisoes,
+                             LIS_ProcurarPonteiro(pVisao->pGrafo->pVisoes, pVisao)))
+      {
+         LIS_ExcluirElemento(pVisao->pGrafo->pVisoes);
+      }
+   }
+
+   free(pVisao->vtBits);
+   free(pVisao);
+   *ppVisao = NULL;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Incluir vrtice na viso
+******/
+GRA_tpCondRet GRA_IncluirVerticeNaVisao(GRA_tppVisao pVisaoParm, char *nomeVertice)
+{
+   tpVisao *pVisao = (tpVisao*) pVisaoParm;
+   tpVertice *pVertice;
+   GRA_tpCondRet graCondRet;
+
+   if (pVisao == NULL || pVisao->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pVisao->pertence != NULL)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   graCondRet = ProcurarVertice(pVisao->pGrafo, nomeVertice, &pVertice);
+   if (graCondRet != GRA_CondRetOK)
+   {
+      return graCondRet;
+   }
+
+   if (pVertice->id / 8 >= pVisao->numBytes)
+   {
+      int numBytes = pVisao->pGrafo->capIds / 8 + 1;
+      unsigned char *vtBits = (unsigned char*) RealocarEspaco(pVisao->vtBits,
+                                 pVisao->numBytes, numBytes);
+      if (vtBits == NULL)
+      {
+         return GRA_CondRetFaltouMemoria;
+      }
+      memset(vtBits + pVisao->numBytes, 0, numBytes - pVisao->numBytes);
+      pVisao->vtBits = vtBits;
+      pVisao->numBytes = numBytes;
+   }
+
+   pVisao->vtBits[pVertice->id / 8] |= (unsigned char) (1 << (pVertice->id % 8));
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Excluir vrtice da viso
+******/
+GRA_tpCondRet GRA_ExcluirVerticeDaVisao(GRA_tppVisao pVisaoParm, char *nomeVertice)
+{
+   tpVisao *pVisao = (tpVisao*) pVisaoParm;
+   tpVertice *pVertice;
+   GRA_tpCondRet graCondRet;
+
+   if (pVisao == NULL || pVisao->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pVisao->pertence != NULL)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   graCondRet = ProcurarVertice(pVisao->pGrafo, nomeVertice, &pVertice);
+   if (graCondRet != GRA_CondRetOK)
+   {
+      return graCondRet;
+   }
+
+   if (pVertice->id / 8 < pVisao->numBytes)
+   {
+      pVisao->vtBits[pVertice->id / 8] &= (unsigned char) ~(1 << (pVertice->id % 8));
+   }
+
+   if (pVisao->pCorrente == pVertice)
+   {
+      pVisao->pCorrente = NULL;
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Viso ir para vrtice
+******/
+GRA_tpCondRet GRA_VisaoIrParaVertice(GRA_tppVisao pVisaoParm, char *nomeVertice)
+{
+   tpVisao *pVisao = (tpVisao*) pVisaoParm;
+   tpVertice *pVertice;
+
+   if (pVisao == NULL || pVisao->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pVisao->pGrafo, nomeVertice, &pVertice) != GRA_CondRetOK ||
+       !PertenceAVisao(pVisao, pVertice))
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pVisao->pCorrente = pVertice;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Viso ir para o vrtice adjacente
+******/
+GRA_tpCondRet GRA_VisaoIrParaVerticeAdjacente(GRA_tppVisao pVisaoParm, char *nomeVertice)
+{
+   tpVisao *pVisao = (tpVisao*) pVisaoParm;
+   tpVertice *pVertice = NULL;
+
+   if (pVisao == NULL || pVisao->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pVisao->pCorrente == NULL)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   if (ProcurarVertice(pVisao->pGrafo, nomeVertice, &pVertice) != GRA_CondRetOK ||
+       CNJ_Contar(pVisao->pCorrente->pDestinos, pVertice->id) == 0 ||
+       !PertenceAVisao(pVisao, pVertice))
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pVisao->pCorrente = pVertice;
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Viso seguir pela aresta
+******/
+GRA_tpCondRet GRA_VisaoSeguirPelaAresta(GRA_tppVisao pVisaoParm, char *nomeAresta)
+{
+   tpVisao *pVisao = (tpVisao*) pVisaoParm;
+   tpAresta *pAresta = NULL;
+
+   if (pVisao == NULL || pVisao->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pVisao->pCorrente == NULL)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   if (ProcurarAresta(pVisao->pGrafo, pVisao->pCorrente, nomeAresta, &pAresta) != GRA_CondRetOK ||
+       !PertenceAVisao(pVisao, pAresta->pVertice))
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pVisao->pCorrente = pAresta->pVertice;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Viso obter valor corrente
+******/
+GRA_tpCondRet GRA_VisaoObterValorCorrente(GRA_tppVisao pVisaoParm, void **ppValor)
+{
+   tpVisao *pVisao = (tpVisao*) pVisaoParm;
+
+   *ppValor = NULL;
+
+   if (pVisao == NULL || pVisao->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pVisao->pCorrente == NULL)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   *ppValor = pVisao->pCorrente->pValor;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Viso percorrer em largura
+******/
+GRA_tpCondRet GRA_VisaoPercorrerEmLargura(GRA_tppVisao pVisaoParm, char *nomeOrigem,
+   GRA_tppMarcador pMarcadorParm,
+   int (*visitar)(char *nomeVertice, void *pValor, void *pContexto), void *pContexto)
+{
+   tpVisao *pVisao = (tpVisao*) pVisaoParm;
+   tpMarcador *pMarcador = (tpMarcador*) pMarcadorParm;
+   tpVertice *pOrigem;
+   int *vtFila;
+   int inicioFila = 0, fimFila = 0;
+
+   if (pVisao == NULL || pVisao->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pMarcador != NULL && pMarcador->pGrafo != pVisao->pGrafo)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pVisao->pGrafo, nomeOrigem, &pOrigem) != GRA_CondRetOK ||
+       !PertenceAVisao(pVisao, pOrigem))
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   if (pMarcador != NULL && EstaMarcado(pMarcador, pOrigem))
+   {
+      return GRA_CondRetOK;
+   }
+
+   vtFila = (int*) malloc(pVisao->pGrafo->numIds * sizeof(int));
+   if (vtFila == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (pMarcador == NULL)
+   {
+      pMarcador = ObterMarcadorDePercurso(pVisao->pGrafo);
+   }
+
+   if (pMarcador == NULL || !Marcar(pMarcador, pOrigem))
+   {
+      if (pMarcador != (tpMarcador*) pMarcadorParm)
+      {
+         DevolverMarcadorDePercurso(pVisao->pGrafo, pMarcador);
+      }
+      free(vtFila);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   vtFila[fimFila++] = pOrigem->id;
+
+   while (inicioFila < fimFila)
+   {
+      tpVertice *pVertice = pVisao->pGrafo->vtVertices[vtFila[inicioFila++]];
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterador;
+
+      if (visitar(pVertice->nome, pVertice->pValor, pContexto))
+      {
+         break;
+      }
+
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         // O marcador j teve espao reservado para todos os ids ao marcar a origem
+         if (!EstaMarcado(pMarcador, pAresta->pVertice) &&
+             PertenceAVisao(pVisao, pAresta->pVertice))
+         {
+            Marcar(pMarcador, pAresta->pVertice);
+            vtFila[fimFila++] = pAresta->pVertice->id;
+         }
+      }
+   }
+
+   if (pMarcador != (tpMarcador*) pMarcadorParm)
+   {
+      DevolverMarcadorDePercurso(pVisao->pGrafo, pMarcador);
+   }
+   free(vtFila);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Criar marcador
+******/
+GRA_tpCondRet GRA_CriarMarcador(GRA_tppGrafo pGrafoParm, GRA_tppMarcador *ppMarcador)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpMarcador *pMarcador = NULL;
+   GRA_tpCondRet graCondRet;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   graCondRet = CriarMarcador(pGrafo, &pMarcador);
+   if (graCondRet != GRA_CondRetOK)
+   {
+      return graCondRet;
+   }
+
+   if (LIS_InserirElementoApos(pGrafo->pMarcadores, pMarcador) != LIS_CondRetOK)
+   {
+      DestruirMarcador(pMarcador);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   *ppMarcador = (GRA_tppMarcador) pMarcador;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Destruir marcador
+******/
+GRA_tpCondRet GRA_DestruirMarcador(GRA_tppMarcador *ppMarcador)
+{
+   tpMarcador *pMarcador = (tpMarcador*) *ppMarcador;
+
+   if (pMarcador == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   if (pMarcador->pGrafo != NULL)
+   {
+      if (LIS_IrParaElemento(pMarcador->pGrafo->pMarcadores,
+                             LIS_ProcurarPonteiro(pMarcador->pGrafo->pMarcadores, pMarcador)))
+      {
+         LIS_ExcluirElemento(pMarcador->pGrafo->pMarcadores);
+      }
+   }
+
+   DestruirMarcador(pMarcador);
+   *ppMarcador = NULL;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Reiniciar marcador
+******/
+GRA_tpCondRet GRA_ReiniciarMarcador(GRA_tppMarcador pMarcadorParm)
+{
+   tpMarcador *pMarcador = (tpMarcador*) pMarcadorParm;
+
+   if (pMarcador == NULL || pMarcador->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   ReiniciarMarcador(pMarcador);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Marcar vrtice
+******/
+GRA_tpCondRet GRA_MarcarVertice(GRA_tppMarcador pMarcadorParm, char *nomeVertice)
+{
+   tpMarcador *pMarcador = (tpMarcador*) pMarcadorParm;
+   tpVertice *pVertice = NULL;
+
+   if (pMarcador == NULL || pMarcador->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pMarcador->pGrafo, nomeVertice, &pVertice) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   return Marcar(pMarcador, pVertice) ? GRA_CondRetOK : GRA_CondRetFaltouMemoria;
+}
+
+/***************************************************************************
+*  Funo: GRA Vrtice est marcado
+******/
+GRA_tpCondRet GRA_VerticeEstaMarcado(GRA_tppMarcador pMarcadorParm, char *nomeVertice,
+   int *pResposta)
+{
+   tpMarcador *pMarcador = (tpMarcador*) pMarcadorParm;
+   tpVertice *pVertice = NULL;
+
+   if (pMarcador == NULL || pMarcador->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pMarcador->pGrafo, nomeVertice, &pVertice) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   *pResposta = EstaMarcado(pMarcador, pVertice);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Marcar corrente
+******/
+GRA_tpCondRet GRA_MarcarCorrente(GRA_tppGrafo pGrafoParm, GRA_tppMarcador pMarcadorParm)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpMarcador *pMarcador = (tpMarcador*) pMarcadorParm;
+
+   if (pGrafo == NULL || pMarcador == NULL || pMarcador->pGrafo != pGrafo)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->pCorrente == NULL)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   return Marcar(pMarcador, pGrafo->pCorrente) ? GRA_CondRetOK : GRA_CondRetFaltouMemoria;
+}
+
+/***************************************************************************
+*  Funo: GRA Corrente est marcado
+******/
+GRA_tpCondRet GRA_CorrenteEstaMarcado(GRA_tppGrafo pGrafoParm, GRA_tppMarcador pMarcadorParm,
+   int *pResposta)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpMarcador *pMarcador = (tpMarcador*) pMarcadorParm;
+
+   if (pGrafo == NULL || pMarcador == NULL || pMarcador->pGrafo != pGrafo)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->pCorrente == NULL)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   *pResposta = EstaMarcado(pMarcador, pGrafo->pCorrente);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Reordenar
+******/
+GRA_tpCondRet GRA_Reordenar(GRA_tppGrafo pGrafoParm, GRA_tpOrdem ordem)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice **vtOrdem, **vtNovos;
+   unsigned int *vtRascunho;
+   int numVertices = 0, numOrigens = 0, i;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   LIS_NumELementos(pGrafo->pVertices, &numVertices);
+   if (numVertices == 0)
+   {
+      return GRA_CondRetOK;
+   }
+
+   vtOrdem = (tpVertice**) malloc(numVertices * sizeof(tpVertice*));
+   vtNovos = (tpVertice**) malloc(pGrafo->numIds * sizeof(tpVertice*));
+   vtRascunho = (unsigned int*) malloc(pGrafo->numIds * sizeof(unsigned int));
+   if (vtOrdem == NULL || vtNovos == NULL || vtRascunho == NULL ||
+       !CobrirIds(pGrafo) ||
+       !CalcularOrdem(pGrafo, ordem, vtOrdem, numVertices) ||
+       !CopiarEmOrdem(vtOrdem, numVertices, vtNovos, pGrafo->tamValor))
+   {
+      free(vtOrdem);
+      free(vtNovos);
+      free(vtRascunho);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   // Daqui em diante nada mais aloca memria: as cpias substituem os originais
+
+   LIS_IrInicioLista(pGrafo->pVertices);
+   for (i = 0; i < numVertices; i++)
+   {
+      LIS_AlterarValor(pGrafo->pVertices, vtNovos[vtOrdem[i]->id]);
+      IND_Substituir(pGrafo->pIndiceNomes, vtOrdem[i]->nome,
+                     vtNovos[vtOrdem[i]->id]->nome, vtNovos[vtOrdem[i]->id]);
+      LIS_AvancarElementoCorrente(pGrafo->pVertices, 1);
+   }
+
+   LIS_NumELementos(pGrafo->pOrigens, &numOrigens);
+   LIS_IrInicioLista(pGrafo->pOrigens);
+   while (numOrigens > 0)
+   {
+      tpVertice *pOrigem = NULL;
+      LIS_ObterValor(pGrafo->pOrigens, (void**)&pOrigem);
+      LIS_AlterarValor(pGrafo->pOrigens, vtNovos[pOrigem->id]);
+      LIS_AvancarElementoCorrente(pGrafo->pOrigens, 1);
+      numOrigens--;
+   }
+
+   if (pGrafo->pCorrente != NULL)
+   {
+      pGrafo->pCorrente = vtNovos[pGrafo->pCorrente->id];
+   }
+
+   RenumerarAuxiliares(pGrafo, vtNovos, vtRascunho);
+
+   memset(pGrafo->vtVertices, 0, pGrafo->numIds * sizeof(tpVertice*));
+   for (i = 0; i < numVertices; i++)
+   {
+      pGrafo->vtVertices[i] = vtNovos[vtOrdem[i]->id];
+      LiberarCasca(vtOrdem[i]);
+   }
+   pGrafo->numIds = numVertices;
+   pGrafo->numIdsLivres = 0;
+
+   // As cpias no tm grupos; a prxima busca por expresso os monta
+   pGrafo->gruposMontados = 0;
+
+   free(vtOrdem);
+   free(vtNovos);
+   free(vtRascunho);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Publicar em memria compartilhada
+******/
+GRA_tpCondRet GRA_PublicarMemoriaCompartilhada(GRA_tppGrafo pGrafoParm, const char *nomeSegmento,
+   size_t (*tamanhoValor)(void *pValor), GRA_tppPublicacao *ppPublicacao)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpPublicacao *pPublicacao;
+   tpVertice **vtPorNome;
+   tpVetorEmPreenchimento porNome;
+   int *vtIndices;
+   int numVertices = 0, numArestas = 0, i;
+   size_t tamanho;
+   MCO_tpCondRet mcoCondRet;
+   LIS_tpIterador iterVertices;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   LIS_NumELementos(pGrafo->pVertices, &numVertices);
+
+   pPublicacao = (tpPublicacao*) malloc(sizeof(tpPublicacao));
+   vtPorNome = (tpVertice**) malloc((numVertices + 1) * sizeof(tpVertice*));
+   vtIndices = (int*) malloc((pGrafo->numIds + 1) * sizeof(int));
+   if (pPublicacao == NULL || vtPorNome == NULL || vtIndices == NULL)
+   {
+      free(pPublicacao);
+      free(vtPorNome);
+      free(vtIndices);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   // Primeira passada: numera os vrtices na ordem da lista e mede a cpia
+   tamanho = 0;
+   LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
+   for (i = 0; i < numVertices; i++)
+   {
+      tpVertice *pVertice = NULL;
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterArestas;
+
+      LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
+      vtIndices[pVertice->id] = i;
+
+      tamanho += Alinhar(pVertice->tamNome + 1);
+      if (tamanhoValor != NULL && pVertice->pValor != NULL)
+      {
+         tamanho += Alinhar(tamanhoValor(pVertice->pValor));
+      }
+
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterArestas);
+      while (ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         tamanho += Alinhar(pAresta->tamNome + 1);
+         numArestas++;
+      }
+   }
+
+   // O ndice de nomes j entrega os vrtices na ordem da busca binria
+   porNome.vtVertices = vtPorNome;
+   porNome.numVertices = 0;
+   IND_PercorrerIntervalo(pGrafo->pIndiceNomes, NULL, NULL, AcrescentarAoVetor, &porNome);
+
+   tamanho += Alinhar(sizeof(tpCabecaCompartilhada))
+            + Alinhar(numVertices * sizeof(tpVerticeCompartilhado))
+            + Alinhar(numArestas * sizeof(tpArestaCompartilhada))
+            + Alinhar(numVertices * sizeof(int));
+
+   mcoCondRet = MCO_CriarSegmento(nomeSegmento, tamanho, &pPublicacao->pSegmento);
+   if (mcoCondRet != MCO_CondRetOK)
+   {
+      free(pPublicacao);
+      free(vtPorNome);
+      free(vtIndices);
+
+      if (mcoCondRet == MCO_CondRetJaExiste)
+      {
+         return GRA_CondRetJaExiste;
+      }
+      return mcoCondRet == MCO_CondRetFaltouMemoria ? GRA_CondRetFaltouMemoria
+                                                    : GRA_CondRetErroSistema;
+   }
+
+   MontarCopiaCompartilhada(pGrafo, (char*) MCO_ObterEndereco(pPublicacao->pSegmento, NULL),
+                            tamanho, tamanhoValor, vtPorNome, vtIndices);
+
+   free(vtPorNome);
+   free(vtIndices);
+
+   *ppPublicacao = (GRA_tppPublicacao) pPublicacao;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Retirar publicao
+******/
+GRA_tpCondRet GRA_RetirarPublicacao(GRA_tppPublicacao *ppPublicacao)
+{
+   tpPublicacao *pPublicacao = (tpPublicacao*) *ppPublicacao;
+
+   if (pPublicacao == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   MCO_FecharSegmento(pPublicacao->pSegmento, 1);
+   free(pPublicacao);
+   *ppPublicacao = NULL;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Anexar memria compartilhada
+******/
+GRA_tpCondRet GRA_AnexarMemoriaCompartilhada(const char *nomeSegmento,
+   GRA_tppGrafoCompartilhado *ppGrafo)
+{
+   tpGrafoCompartilhado *pGrafo;
+   MCO_tpCondRet mcoCondRet;
+   size_t tamanho = 0;
+
+   pGrafo = (tpGrafoCompartilhado*) malloc(sizeof(tpGrafoCompartilhado));
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   mcoCondRet = MCO_AbrirSegmento(nomeSegmento, &pGrafo->pSegmento);
+   if (mcoCondRet != MCO_CondRetOK)
+   {
+      free(pGrafo);
+
+      if (mcoCondRet == MCO_CondRetNaoAchou)
+      {
+         return GRA_CondRetNaoAchou;
+      }
+      return mcoCondRet == MCO_CondRetFaltouMemoria ? GRA_CondRetFaltouMemoria
+                                                    : GRA_CondRetErroSistema;
+   }
+
+   pGrafo->pBase = (const char*) MCO_ObterEndereco(pGrafo->pSegmento, &tamanho);
+   pGrafo->pCabeca = (const tpCabecaCompartilhada*) pGrafo->pBase;
+
+   // Uma cpia ainda sendo gravada no tem assinatura
+   if (tamanho < sizeof(tpCabecaCompartilhada) ||
+       memcmp(pGrafo->pCabeca->assinatura, ASSINATURA_COMPARTILHADA,
+              sizeof(pGrafo->pCabeca->assinatura)) != 0 ||
+       pGrafo->pCabeca->tamanho > tamanho)
+   {
+      MCO_FecharSegmento(pGrafo->pSegmento, 0);
+      free(pGrafo);
+      return GRA_CondRetNaoAchou;
+   }
+
+   pGrafo->vtVertices = (const tpVerticeCompartilhado*) (pGrafo->pBase + pGrafo->pCabeca->desVertices);
+   pGrafo->vtArestas = (const tpArestaCompartilhada*) (pGrafo->pBase + pGrafo->pCabeca->desArestas);
+   pGrafo->corrente = -1;
+
+   *ppGrafo = (GRA_tppGrafoCompartilhado) pGrafo;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Desanexar memria compartilhada
+******/
+GRA_tpCondRet GRA_DesanexarMemoriaCompartilhada(GRA_tppGrafoCompartilhado *ppGrafo)
+{
+   tpGrafoCompartilhado *pGrafo = (tpGrafoCompartilhado*) *ppGrafo;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   MCO_FecharSegmento(pGrafo->pSegmento, 0);
+   free(pGrafo);
+   *ppGrafo = NULL;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Compartilhado ir para vrtice
+******/
+GRA_tpCondRet GRA_CompartilhadoIrParaVertice(GRA_tppGrafoCompartilhado pGrafoParm,
+   const char *nomeVertice)
+{
+   tpGrafoCompartilhado *pGrafo = (tpGrafoCompartilhado*) pGrafoParm;
+   int indice;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   indice = ProcurarCompartilhado(pGrafo, nomeVertice);
+   if (indice < 0)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pGrafo->corrente = indice;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Compartilhado seguir pela aresta
+******/
+GRA_tpCondRet GRA_CompartilhadoSeguirPelaAresta(GRA_tppGrafoCompartilhado pGrafoParm,
+   const char *nomeAresta)
+{
+   tpGrafoCompartilhado *pGrafo = (tpGrafoCompartilhado*) pGrafoParm;
+   const tpVerticeCompartilhado *pVertice;
+   int i;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->corrente < 0)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   pVertice = &pGrafo->vtVertices[pGrafo->corrente];
+
+   for (i = pVertice->primeiraAresta; i < pVertice->primeiraAresta + pVertice->numArestas; i++)
+   {
+      if (strcmp(pGrafo->pBase + pGrafo->vtArestas[i].desNome, nomeAresta) == 0)
+      {
+         pGrafo->corrente = pGrafo->vtArestas[i].destino;
+         return GRA_CondRetOK;
+      }
+   }
+
+   return GRA_CondRetNaoAchou;
+}
+
+/***************************************************************************
+*  Funo: GRA Compartilhado obter valor corrente
+******/
+GRA_tpCondRet GRA_CompartilhadoObterValorCorrente(GRA_tppGrafoCompartilhado pGrafoParm,
+   const void **ppValor)
+{
+   tpGrafoCompartilhado *pGrafo = (tpGrafoCompartilhado*) pGrafoParm;
+   size_t desValor;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->corrente < 0)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   desValor = pGrafo->vtVertices[pGrafo->corrente].desValor;
+   *ppValor = desValor == 0 ? NULL : (const void*) (pGrafo->pBase + desValor);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Compartilhado percorrer em largura
+******/
+GRA_tpCondRet GRA_CompartilhadoPercorrerEmLargura(GRA_tppGrafoCompartilhado pGrafoParm,
+   const char *nomeOrigem,
+   int (*visitar)(char *nomeVertice, void *pValor, void *pContexto), void *pContexto)
+{
+   tpGrafoCompartilhado *pGrafo = (tpGrafoCompartilhado*) pGrafoParm;
+   unsigned char *vtVisitado;
+   int *vtFila;
+   int inicioFila = 0, fimFila = 0, origem;
+   int numVertices;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   origem = ProcurarCompartilhado(pGrafo, nomeOrigem);
+   if (origem < 0)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   numVertices = pGrafo->pCabeca->numVertices;
+   vtVisitado = (unsigned char*) malloc(numVertices);
+   vtFila = (int*) malloc(numVertices * sizeof(int));
+   if (vtVisitado == NULL || vtFila == NULL)
+   {
+      free(vtVisitado);
+      free(vtFila);
+      return GRA_CondRetFaltouMemoria;
+   }
+   memset(vtVisitado, 0, numVertices);
+
+   vtVisitado[origem] = 1;
+   vtFila[fimFila++] = origem;
+
+   while (inicioFila < fimFila)
+   {
+      const tpVerticeCompartilhado *pVertice = &pGrafo->vtVertices[vtFila[inicioFila++]];
+      int i;
+
+      if (visitar((char*) (pGrafo->pBase + pVertice->desNome),
+                  pVertice->desValor == 0 ? NULL : (void*) (pGrafo->pBase + pVertice->desValor),
+                  pContexto))
+      {
+         break;
+      }
+
+      for (i = pVertice->primeiraAresta; i < pVertice->primeiraAresta + pVertice->numArestas; i++)
+      {
+         int destino = pGrafo->vtArestas[i].destino;
+
+         if (!vtVisitado[destino])
+         {
+            vtVisitado[destino] = 1;
+            vtFila[fimFila++] = destino;
+         }
+      }
+   }
+
+   free(vtVisitado);
+   free(vtFila);
+
+   return GRA_CondRetOK;
+}
+
+
+/***************************************************************************
+*  Funo: GRA Abrir grafo persistente
+******/
+GRA_tpCondRet GRA_AbrirGrafoPersistente(GRA_tppGrafo *ppGrafo, const char *caminhoBase,
+   void (*destruirValor)(void *pValor), size_t (*tamanhoValor)(void *pValor))
+{
+   GRA_tppGrafo pGrafoParm = NULL;
+   tpGrafo *pGrafo;
+   tpPersistencia *pPersistencia;
+   tpRecuperacao recuperacao;
+   WAL_tpCondRet walCondRet;
+   char *caminho;
+   int numVertices = 0;
+
+   *ppGrafo = NULL;
+
+   pPersistencia = (tpPersistencia*) malloc(sizeof(tpPersistencia));
+   if (pPersistencia == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+   pPersistencia->caminhoBase = CopiarBytes(caminhoBase, strlen(caminhoBase) + 1);
+   pPersistencia->pLog = NULL;
+   pPersistencia->tamanhoValor = tamanhoValor;
+   pPersistencia->bytesParaPontoDeControle = BYTES_PONTO_DE_CONTROLE;
+
+   if (pPersistencia->caminhoBase == NULL ||
+       GRA_CriarGrafo(&pGrafoParm, destruirValor) != GRA_CondRetOK)
+   {
+      free(pPersistencia->caminhoBase);
+      free(pPersistencia);
+      return GRA_CondRetFaltouMemoria;
+   }
+   pGrafo = (tpGrafo*) pGrafoParm;
+
+   // Primeiro o ponto de controle, depois o log a partir do LSN que ele cobre
+   recuperacao.pGrafo = pGrafo;
+   recuperacao.lsnPontoDeControle = 0;
+   recuperacao.condRet = GRA_CondRetOK;
+
+   caminho = MontarCaminho(caminhoBase, SUFIXO_PONTO_DE_CONTROLE);
+   walCondRet = caminho == NULL ? WAL_CondRetFaltouMemoria :
+                WAL_Ler(caminho, AplicarRegistro, &recuperacao);
+   free(caminho);
+
+   if (walCondRet == WAL_CondRetOK || walCondRet == WAL_CondRetNaoAchou)
+   {
+      caminho = MontarCaminho(caminhoBase, SUFIXO_LOG);
+      walCondRet = caminho == NULL ? WAL_CondRetFaltouMemoria :
+                   WAL_Abrir(caminho, recuperacao.lsnPontoDeControle, AplicarRegistro,
+                             &recuperacao, &pPersistencia->pLog);
+      free(caminho);
+   }
+
+   if (walCondRet != WAL_CondRetOK)
+   {
+      GRA_DestruirGrafo(&pGrafoParm);
+      free(pPersistencia->caminhoBase);
+      free(pPersistencia);
+      return walCondRet == WAL_CondRetInterrompido ? recuperacao.condRet :
+                                                     TraduzirCondRetLog(walCondRet);
+   }
+
+   // A navegao no  registrada: o corrente recomea numa origem
+   pGrafo->pCorrente = NULL;
+   LIS_NumELementos(pGrafo->pOrigens, &numVertices);
+   if (numVertices > 0)
+   {
+      LIS_IrInicioLista(pGrafo->pOrigens);
+      LIS_ObterValor(pGrafo->pOrigens, (void**)&pGrafo->pCorrente);
+   }
+   else
+   {
+      LIS_NumELementos(pGrafo->pVertices, &numVertices);
+      if (numVertices > 0)
+      {
+         LIS_IrInicioLista(pGrafo->pVertices);
+         LIS_ObterValor(pGrafo->pVertices, (void**)&pGrafo->pCorrente);
+      }
+   }
+
+   pGrafo->pPersistencia = pPersistencia;
+   *ppGrafo = pGrafoParm;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Gravar ponto de controle
+******/
+GRA_tpCondRet GRA_GravarPontoDeControle(GRA_tppGrafo pGrafoParm)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->pPersistencia == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   return GravarPontoDeControle(pGrafo);
+}
+
+/***************************************************************************
+*  Funo: GRA Sincronizar persistncia
+******/
+GRA_tpCondRet GRA_SincronizarPersistencia(GRA_tppGrafo pGrafoParm)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->pPersistencia == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   return TraduzirCondRetLog(WAL_Confirmar(pGrafo->pPersistencia->pLog));
+}
+
+/***************************************************************************
+*  Funo: GRA Definir confirmao em grupo
+******/
+GRA_tpCondRet GRA_DefinirConfirmacaoEmGrupo(GRA_tppGrafo pGrafoParm, int registrosPorGrupo,
+   long bytesParaPontoDeControle)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->pPersistencia == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   WAL_DefinirGrupo(pGrafo->pPersistencia->pLog, registrosPorGrupo);
+   pGrafo->pPersistencia->bytesParaPontoDeControle =
+      bytesParaPontoDeControle < 0 ? 0 : bytesParaPontoDeControle;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Listar vrtices por prefixo
+******/
+GRA_tpCondRet GRA_ListarVerticesPorPrefixo(GRA_tppGrafo pGrafoParm, const char *prefixo,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpListagem listagem;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   listagem.visitar = visitar;
+   listagem.pContexto = pContexto;
+   IND_PercorrerPrefixo(pGrafo->pIndiceNomes, prefixo, VisitarVerticeListado, &listagem);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Listar vrtices no intervalo
+******/
+GRA_tpCondRet GRA_ListarVerticesNoIntervalo(GRA_tppGrafo pGrafoParm, const char *inicio,
+   const char *fim, int (*visitar)(const char *nome, void *pValor, void *pContexto),
+   void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpListagem listagem;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   listagem.visitar = visitar;
+   listagem.pContexto = pContexto;
+   IND_PercorrerIntervalo(pGrafo->pIndiceNomes, inicio, fim, VisitarVerticeListado, &listagem);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Para cada vrtice
+******/
+GRA_tpCondRet GRA_ParaCadaVertice(GRA_tppGrafo pGrafoParm,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pVertice;
+   int id;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      pVertice = pGrafo->vtVertices[id];
+      if (pVertice != NULL && visitar(pVertice->nome, pVertice->pValor, pContexto))
+      {
+         break;
+      }
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Para cada sucessor
+******/
+GRA_tpCondRet GRA_ParaCadaSucessor(GRA_tppGrafo pGrafoParm, char *nomeVertice,
+   int (*visitar)(const char *nomeAresta, const char *nomeDestino, void *pValorDestino,
+                  void *pContexto),
+   void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pVertice;
+   tpAresta *pAresta;
+   ADJ_tpIterador iterador;
+   tpVisitaSucessores visita;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeVertice, &pVertice) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   visita.visitar = visitar;
+   visita.pContexto = pContexto;
+   ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+   while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK &&
+          !VisitarSucessor(pAresta, &visita))
+   {
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Para cada antecessor
+******/
+GRA_tpCondRet GRA_ParaCadaAntecessor(GRA_tppGrafo pGrafoParm, char *nomeVertice,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pVertice;
+   tpListagem listagem;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeVertice, &pVertice) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   listagem.visitar = visitar;
+   listagem.pContexto = pContexto;
+   LIS_ParaCadaElemento(pVertice->pAntecessores, VisitarAntecessor, &listagem);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Para cada vrtice em paralelo
+******/
+GRA_tpCondRet GRA_ParaCadaVerticeParalelo(GRA_tppGrafo pGrafoParm, int numTarefas,
+   void (*visitar)(const char *nome, void *pValor, int tarefa, void *pContexto),
+   void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpFaixa vtFaixas[GRA_MAX_TAREFAS];
+   int i;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (numTarefas < 1 || numTarefas > GRA_MAX_TAREFAS)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   // As faixas so montadas antes de qualquer linha comear
+   for (i = 0; i < numTarefas; i++)
+   {
+      vtFaixas[i].pGrafo = pGrafo;
+      vtFaixas[i].inicio = (int) ((long long) pGrafo->numIds * i / numTarefas);
+      vtFaixas[i].fim = (int) ((long long) pGrafo->numIds * (i + 1) / numTarefas);
+      vtFaixas[i].tarefa = i;
+      vtFaixas[i].visitar = visitar;
+      vtFaixas[i].pContexto = pContexto;
+      vtFaixas[i].pTarefa = NULL;
+   }
+
+   for (i = 1; i < numTarefas; i++)
+   {
+      if (vtFaixas[i].inicio < vtFaixas[i].fim &&
+          TAR_IniciarTarefa(&vtFaixas[i].pTarefa, VisitarFaixa, &vtFaixas[i]) != TAR_CondRetOK)
+      {
+         vtFaixas[i].pTarefa = NULL;
+      }
+   }
+
+   VisitarFaixa(&vtFaixas[0]);
+
+   for (i = 1; i < numTarefas; i++)
+   {
+      if (vtFaixas[i].pTarefa != NULL)
+      {
+         TAR_EsperarTarefa(vtFaixas[i].pTarefa);
+      }
+      else
+      {
+         VisitarFaixa(&vtFaixas[i]);
+      }
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Iniciar percurso
+******/
+GRA_tpCondRet GRA_IniciarPercurso(GRA_tppGrafo pGrafoParm, char *nomeOrigem,
+   GRA_tpModoPercurso modo,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto,
+   GRA_tppPercurso *ppPercurso)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpPercurso *pPercurso;
+   tpVertice *pOrigem = NULL;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (modo != GRA_PercursoEmLargura && modo != GRA_PercursoEmProfundidade)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeOrigem, &pOrigem) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pPercurso = (tpPercurso*) malloc(sizeof(tpPercurso));
+   if (pPercurso == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   pPercurso->pGrafo = pGrafo;
+   pPercurso->modo = modo;
+   pPercurso->pMarcador = NULL;
+   pPercurso->vtFronteira = NULL;
+   pPercurso->inicio = 0;
+   pPercurso->fim = 0;
+   pPercurso->capacidade = 0;
+   pPercurso->visitar = visitar;
+   pPercurso->pContexto = pContexto;
+
+   if (CriarMarcador(pGrafo, &pPercurso->pMarcador) != GRA_CondRetOK ||
+       !ReservarFronteira(pPercurso, 1) ||
+       (modo == GRA_PercursoEmLargura && !Marcar(pPercurso->pMarcador, pOrigem)))
+   {
+      if (pPercurso->pMarcador != NULL)
+      {
+         DestruirMarcador(pPercurso->pMarcador);
+      }
+      free(pPercurso->vtFronteira);
+      free(pPercurso);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   pPercurso->vtFronteira[pPercurso->fim++] = pOrigem->id;
+
+   // O marcador  registrado para que excluses e reordenaes o atualizem
+   if (LIS_InserirElementoApos(pGrafo->pMarcadores, pPercurso->pMarcador) != LIS_CondRetOK)
+   {
+      DestruirMarcador(pPercurso->pMarcador);
+      free(pPercurso->vtFronteira);
+      free(pPercurso);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (LIS_InserirElementoApos(pGrafo->pPercursos, pPercurso) != LIS_CondRetOK)
+   {
+      LIS_ExcluirElemento(pGrafo->pMarcadores);
+      DestruirMarcador(pPercurso->pMarcador);
+      free(pPercurso->vtFronteira);
+      free(pPercurso);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   *ppPercurso = (GRA_tppPercurso) pPercurso;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Avanar percurso
+******/
+GRA_tpCondRet GRA_AvancarPercurso(GRA_tppPercurso pPercursoParm, int numPassos,
+   int *pTerminou)
+{
+   tpPercurso *pPercurso = (tpPercurso*) pPercursoParm;
+   tpGrafo *pGrafo;
+   int numVisitados = 0;
+
+   if (pPercurso == NULL || pPercurso->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (numPassos < 1)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   pGrafo = pPercurso->pGrafo;
+
+   while (numVisitados < numPassos && pPercurso->inicio < pPercurso->fim)
+   {
+      tpVertice *pVertice;
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterador;
+      int id, numSucessores = 0, primeiroEmpilhado, i;
+
+      if (pPercurso->modo == GRA_PercursoEmLargura)
+      {
+         id = pPercurso->vtFronteira[pPercurso->inicio];
+      }
+      else
+      {
+         id = pPercurso->vtFronteira[pPercurso->fim - 1];
+      }
+
+      pVertice = id < 0 ? NULL : pGrafo->vtVertices[id];
+
+      // Vrtices excludos, e em profundidade os j visitados, so descartados
+      if (pVertice == NULL ||
+          (pPercurso->modo == GRA_PercursoEmProfundidade &&
+           EstaMarcado(pPercurso->pMarcador, pVertice)))
+      {
+         if (pPercurso->modo == GRA_PercursoEmLargura)
+         {
+            pPercurso->inicio++;
+         }
+         else
+         {
+            pPercurso->fim--;
+         }
+         continue;
+      }
+
+      // Todo o espao  reservado antes da visita, para que ela no fique pela metade.
+      // Em largura o vrtice j est marcado, e marc-lo de novo s faz o vetor
+      // de pocas cobrir os ids de vrtices inseridos desde a ltima fatia
+      numSucessores = ADJ_NumElementos(&pVertice->sucessores);
+      if (!ReservarFronteira(pPercurso, numSucessores) ||
+          !Marcar(pPercurso->pMarcador, pVertice))
+      {
+         *pTerminou = 0;
+         return GRA_CondRetFaltouMemoria;
+      }
+
+      if (pPercurso->modo == GRA_PercursoEmLargura)
+      {
+         pPercurso->inicio++;
+      }
+      else
+      {
+         pPercurso->fim--;
+      }
+
+      numVisitados++;
+      if (pPercurso->visitar(pVertice->nome, pVertice->pValor, pPercurso->pContexto))
+      {
+         pPercurso->inicio = pPercurso->fim = 0;
+         break;
+      }
+
+      primeiroEmpilhado = pPercurso->fim;
+
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         if (!EstaMarcado(pPercurso->pMarcador, pAresta->pVertice))
+         {
+            if (pPercurso->modo == GRA_PercursoEmLargura)
+            {
+               Marcar(pPercurso->pMarcador, pAresta->pVertice);
+            }
+            pPercurso->vtFronteira[pPercurso->fim++] = pAresta->pVertice->id;
+         }
+      }
+
+      // Na pilha, o primeiro sucessor tem que ficar no topo
+      if (pPercurso->modo == GRA_PercursoEmProfundidade)
+      {
+         for (i = 0; i < (pPercurso->fim - primeiroEmpilhado) / 2; i++)
+         {
+            id = pPercurso->vtFronteira[primeiroEmpilhado + i];
+            pPercurso->vtFronteira[primeiroEmpilhado + i] = pPercurso->vtFronteira[pPercurso->fim - 1 - i];
+            pPercurso->vtFronteira[pPercurso->fim - 1 - i] = id;
+         }
+      }
+   }
+
+   *pTerminou = pPercurso->inicio == pPercurso->fim;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Terminar percurso
+******/
+GRA_tpCondRet GRA_TerminarPercurso(GRA_tppPercurso *ppPercurso)
+{
+   tpPercurso *pPercurso = (tpPercurso*) *ppPercurso;
+
+   if (pPercurso == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   if (pPercurso->pGrafo != NULL)
+   {
+      if (LIS_IrParaElemento(pPercurso->pGrafo->pPercursos,
+                             LIS_ProcurarPonteiro(pPercurso->pGrafo->pPercursos, pPercurso)))
+      {
+         LIS_ExcluirElemento(pPercurso->pGrafo->pPercursos);
+      }
+      if (LIS_IrParaElemento(pPercurso->pGrafo->pMarcadores,
+                             LIS_ProcurarPonteiro(pPercurso->pGrafo->pMarcadores, pPercurso->pMarcador)))
+      {
+         LIS_ExcluirElemento(pPercurso->pGrafo->pMarcadores);
+      }
+   }
+
+   DestruirMarcador(pPercurso->pMarcador);
+   free(pPercurso->vtFronteira);
+   free(pPercurso);
+   *ppPercurso = NULL;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Assinar mudanas
+******/
+GRA_tpCondRet GRA_AssinarMudancas(GRA_tppGrafo pGrafoParm, int tamLote,
+   void (*entregar)(const GRA_tpMudanca *vtMudancas, int numMudancas, void *pContexto),
+   void *pContexto, GRA_tppAssinatura *ppAssinatura)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpAssinatura *pAssinatura;
+   int i;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (tamLote < 1 || entregar == NULL)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   pAssinatura = (tpAssinatura*) malloc(sizeof(tpAssinatura));
+   if (pAssinatura == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   pAssinatura->vtLote = (GRA_tpMudanca*) malloc(tamLote * sizeof(GRA_tpMudanca));
+   pAssinatura->vtNomesLote = (tpNomesGuardados*) malloc(tamLote * sizeof(tpNomesGuardados));
+   if (pAssinatura->vtLote == NULL || pAssinatura->vtNomesLote == NULL)
+   {
+      free(pAssinatura->vtLote);
+      free(pAssinatura->vtNomesLote);
+      free(pAssinatura);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   for (i = 0; i < tamLote; i++)
+   {
+      pAssinatura->vtNomesLote[i].nomes = NULL;
+      pAssinatura->vtNomesLote[i].capNomes = 0;
+   }
+
+   pAssinatura->pGrafo = pGrafo;
+   pAssinatura->numSequencia = 0;
+   pAssinatura->entregar = entregar;
+   pAssinatura->pContexto = pContexto;
+   pAssinatura->tamLote = tamLote;
+   pAssinatura->numNoLote = 0;
+   pAssinatura->pAnel = NULL;
+   pAssinatura->numEmLeitura = 0;
+
+   if (LIS_InserirElementoApos(pGrafo->pAssinaturas, pAssinatura) != LIS_CondRetOK)
+   {
+      DestruirAssinatura(pAssinatura);
+      return GRA_CondRetFaltouMemoria;
+   }
+   pGrafo->numAssinaturas++;
+
+   *ppAssinatura = (GRA_tppAssinatura) pAssinatura;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Assinar mudanas em anel
+******/
+GRA_tpCondRet GRA_AssinarMudancasEmAnel(GRA_tppGrafo pGrafoParm, int capacidade,
+   GRA_tppAssinatura *ppAssinatura)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpAssinatura *pAssinatura;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (capacidade < 1)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   pAssinatura = (tpAssinatura*) malloc(sizeof(tpAssinatura));
+   if (pAssinatura == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   // O anel comea zerado, ou seja, sem espao de nomes em nenhuma posio
+   if (ANL_CriarAnel(&pAssinatura->pAnel, sizeof(tpMudancaNoAnel), capacidade) != ANL_CondRetOK)
+   {
+      free(pAssinatura);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   pAssinatura->pGrafo = pGrafo;
+   pAssinatura->numSequencia = 0;
+   pAssinatura->entregar = NULL;
+   pAssinatura->pContexto = NULL;
+   pAssinatura->vtLote = NULL;
+   pAssinatura->vtNomesLote = NULL;
+   pAssinatura->tamLote = 0;
+   pAssinatura->numNoLote = 0;
+   pAssinatura->numEmLeitura = 0;
+
+   if (LIS_InserirElementoApos(pGrafo->pAssinaturas, pAssinatura) != LIS_CondRetOK)
+   {
+      DestruirAssinatura(pAssinatura);
+      return GRA_CondRetFaltouMemoria;
+   }
+   pGrafo->numAssinaturas++;
+
+   *ppAssinatura = (GRA_tppAssinatura) pAssinatura;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Entregar mudanas
+******/
+GRA_tpCondRet GRA_EntregarMudancas(GRA_tppAssinatura pAssinaturaParm)
+{
+   tpAssinatura *pAssinatura = (tpAssinatura*) pAssinaturaParm;
+
+   if (pAssinatura == NULL || pAssinatura->pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pAssinatura->pAnel != NULL)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   EntregarLote(pAssinatura);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Consumir mudanas
+******/
+GRA_tpCondRet GRA_ConsumirMudancas(GRA_tppAssinatura pAssinaturaParm,
+   GRA_tpMudanca *vtMudancas, int maxMudancas, int *pNumMudancas)
+{
+   tpAssinatura *pAssinatura = (tpAssinatura*) pAssinaturaParm;
+   int numMudancas, i;
+
+   if (pAssinatura == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pAssinatura->pAnel == NULL || maxMudancas < 1)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   // S agora os nomes da consumao anterior podem ser reescritos
+   ANL_Liberar(pAssinatura->pAnel, pAssinatura->numEmLeitura);
+
+   numMudancas = ANL_NumPublicados(pAssinatura->pAnel);
+   if (numMudancas > maxMudancas)
+   {
+      numMudancas = maxMudancas;
+   }
+
+   for (i = 0; i < numMudancas; i++)
+   {
+      vtMudancas[i] = ((tpMudancaNoAnel*) ANL_ObterPublicado(pAssinatura->pAnel, i))->mudanca;
+   }
+
+   pAssinatura->numEmLeitura = numMudancas;
+   *pNumMudancas = numMudancas;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Cancelar assinatura
+******/
+GRA_tpCondRet GRA_CancelarAssinatura(GRA_tppAssinatura *ppAssinatura)
+{
+   tpAssinatura *pAssinatura = (tpAssinatura*) *ppAssinatura;
+
+   if (pAssinatura == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   if (pAssinatura->pGrafo != NULL)
+   {
+      if (pAssinatura->pAnel == NULL)
+      {
+         EntregarLote(pAssinatura);
+      }
+
+      if (LIS_IrParaElemento(pAssinatura->pGrafo->pAssinaturas,
+                             LIS_ProcurarPonteiro(pAssinatura->pGrafo->pAssinaturas, pAssinatura)))
+      {
+         LIS_ExcluirElemento(pAssinatura->pGrafo->pAssinaturas);
+         pAssinatura->pGrafo->numAssinaturas--;
+      }
+   }
+
+   DestruirAssinatura(pAssinatura);
+   *ppAssinatura = NULL;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Manter ordem topolgica
+******/
+GRA_tpCondRet GRA_ManterOrdemTopologica(GRA_tppGrafo pGrafoParm, int manter)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpAresta *pAresta = NULL;
+   ADJ_tpIterador iterador;
+   int *vtOrdem, *vtGrauEntrada;
+   int numVertices = 0, numOrdenados = 0, capacidade, id, i;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (!manter)
+   {
+      free(pGrafo->vtOrdemTopologica);
+      free(pGrafo->vtAfetados);
+      pGrafo->vtOrdemTopologica = NULL;
+      pGrafo->numPosicoesTopologicas = 0;
+      pGrafo->capPosicoesTopologicas = 0;
+      pGrafo->vtAfetados = NULL;
+      pGrafo->capAfetados = 0;
+      return GRA_CondRetOK;
+   }
+
+   if (pGrafo->vtOrdemTopologica != NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   LIS_NumELementos(pGrafo->pVertices, &numVertices);
+   capacidade = numVertices < 8 ? 16 : numVertices * 2;
+
+   vtOrdem = (int*) malloc(capacidade * sizeof(int));
+   vtGrauEntrada = (int*) malloc((pGrafo->numIds + 1) * sizeof(int));
+   if (vtOrdem == NULL || vtGrauEntrada == NULL)
+   {
+      free(vtOrdem);
+      free(vtGrauEntrada);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   // Ordenao de Kahn, usando o prprio vetor da ordem como fila. A lista
+   // de antecessores tem um elemento por aresta, logo d o grau de entrada
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      if (pGrafo->vtVertices[id] != NULL)
+      {
+         LIS_NumELementos(pGrafo->vtVertices[id]->pAntecessores, &vtGrauEntrada[id]);
+         if (vtGrauEntrada[id] == 0)
+         {
+            vtOrdem[numOrdenados++] = id;
+         }
+      }
+   }
+
+   for (i = 0; i < numOrdenados; i++)
+   {
+      ADJ_IniciarIterador(&pGrafo->vtVertices[vtOrdem[i]]->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         if (--vtGrauEntrada[pAresta->pVertice->id] == 0)
+         {
+            vtOrdem[numOrdenados++] = pAresta->pVertice->id;
+         }
+      }
+   }
+
+   free(vtGrauEntrada);
+
+   // Os vrtices de um ciclo nunca chegam a grau de entrada 0
+   if (numOrdenados < numVertices)
+   {
+      free(vtOrdem);
+      return GRA_CondRetCriaCiclo;
+   }
+
+   for (i = 0; i < numOrdenados; i++)
+   {
+      pGrafo->vtVertices[vtOrdem[i]]->posTopologica = i;
+   }
+
+   pGrafo->vtOrdemTopologica = vtOrdem;
+   pGrafo->numPosicoesTopologicas = numOrdenados;
+   pGrafo->capPosicoesTopologicas = capacidade;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Para cada vrtice em ordem topolgica
+******/
+GRA_tpCondRet GRA_ParaCadaVerticeEmOrdemTopologica(GRA_tppGrafo pGrafoParm,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pVertice;
+   int i;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pGrafo->vtOrdemTopologica == NULL)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   for (i = 0; i < pGrafo->numPosicoesTopologicas; i++)
+   {
+      if (pGrafo->vtOrdemTopologica[i] < 0)
+      {
+         continue;
+      }
+
+      pVertice = pGrafo->vtVertices[pGrafo->vtOrdemTopologica[i]];
+      if (visitar(pVertice->nome, pVertice->pValor, pContexto))
+      {
+         break;
+      }
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Mesmo componente
+******/
+GRA_tpCondRet GRA_MesmoComponente(GRA_tppGrafo pGrafoParm, char *nomeVertice1,
+   char *nomeVertice2, int *pMesmo)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pVertice1, *pVertice2;
+   GRA_tpCondRet condRet;
+   int raiz1, raiz2;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeVertice1, &pVertice1) != GRA_CondRetOK ||
+       ProcurarVertice(pGrafo, nomeVertice2, &pVertice2) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   condRet = ObterComponente(pGrafo, pVertice1, &raiz1);
+   if (condRet != GRA_CondRetOK)
+   {
+      return condRet;
+   }
+
+   condRet = ObterComponente(pGrafo, pVertice2, &raiz2);
+   if (condRet != GRA_CondRetOK)
+   {
+      return condRet;
+   }
+
+   // Recalcular o segundo componente pode ter mudado a raiz do primeiro
+   *pMesmo = EncontrarComponente(pGrafo, pVertice1->id) == raiz2;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Nmero de componentes
+******/
+GRA_tpCondRet GRA_NumeroComponentes(GRA_tppGrafo pGrafoParm, int *pNumComponentes)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if ((pGrafo->vtComponentes == NULL && !MontarComponentes(pGrafo)) ||
+       !AtualizarComponentes(pGrafo))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   *pNumComponentes = pGrafo->numComponentes;
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA PageRank
+******/
+GRA_tpCondRet GRA_PageRank(GRA_tppGrafo pGrafoParm, double amortecimento,
+   double tolerancia, int maxIteracoes, int numTarefas,
+   void (*visitar)(const char *nome, double rank, void *pContexto), void *pContexto,
+   int *pNumIteracoes)
+{
+   return CalcularPageRank((tpGrafo*) pGrafoParm, 0, amortecimento, tolerancia,
+                           maxIteracoes, numTarefas, visitar, pContexto, pNumIteracoes);
+}
+
+/***************************************************************************
+*  Funo: GRA PageRank personalizado
+******/
+GRA_tpCondRet GRA_PageRankPersonalizado(GRA_tppGrafo pGrafoParm, double amortecimento,
+   double tolerancia, int maxIteracoes, int numTarefas,
+   void (*visitar)(const char *nome, double rank, void *pContexto), void *pContexto,
+   int *pNumIteracoes)
+{
+   return CalcularPageRank((tpGrafo*) pGrafoParm, 1, amortecimento, tolerancia,
+                           maxIteracoes, numTarefas, visitar, pContexto, pNumIteracoes);
+}
+
+/***************************************************************************
+*  Funo: GRA Contar tringulos
+******/
+GRA_tpCondRet GRA_ContarTriangulos(GRA_tppGrafo pGrafoParm, int numTarefas,
+   void (*visitar)(const char *nome, long numTriangulos, void *pContexto), void *pContexto,
+   long *pTotal)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpAdjacenciaOrdenada adjacencia;
+   tpFaixaTriangulos vtFaixas[GRA_MAX_TAREFAS];
+   long *vtTriangulos, total = 0;
+   int i, id;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (numTarefas < 1 || numTarefas > GRA_MAX_TAREFAS)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   if (!MontarAdjacenciaOrdenada(pGrafo, &adjacencia))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   vtTriangulos = (long*) malloc((adjacencia.numIds + 1) * sizeof(long));
+   if (vtTriangulos == NULL)
+   {
+      DestruirAdjacenciaOrdenada(&adjacencia);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   id = 0;
+   for (i = 0; i < numTarefas; i++)
+   {
+      vtFaixas[i].pAdjacencia = &adjacencia;
+      vtFaixas[i].vtTriangulos = vtTriangulos;
+      vtFaixas[i].inicio = id;
+      id = FimDaFaixa(adjacencia.vtInicio, adjacencia.numIds, id, i, numTarefas);
+      vtFaixas[i].fim = id;
+   }
+
+   for (i = 1; i < numTarefas; i++)
+   {
+      if (vtFaixas[i].inicio == vtFaixas[i].fim ||
+          TAR_IniciarTarefa(&vtFaixas[i].pTarefa, ContarTriangulosDaFaixa,
+                            &vtFaixas[i]) != TAR_CondRetOK)
+      {
+         vtFaixas[i].pTarefa = NULL;
+      }
+   }
+
+   ContarTriangulosDaFaixa(&vtFaixas[0]);
+
+   for (i = 1; i < numTarefas; i++)
+   {
+      if (vtFaixas[i].pTarefa != NULL)
+      {
+         TAR_EsperarTarefa(vtFaixas[i].pTarefa);
+      }
+      else
+      {
+         ContarTriangulosDaFaixa(&vtFaixas[i]);
+      }
+   }
+
+   for (id = 0; id < adjacencia.numIds; id++)
+   {
+      if (pGrafo->vtVertices[id] == NULL)
+      {
+         continue;
+      }
+
+      total += vtTriangulos[id];
+      if (visitar != NULL)
+      {
+         visitar(pGrafo->vtVertices[id]->nome, vtTriangulos[id], pContexto);
+      }
+   }
+
+   // Cada tringulo foi contado uma vez em cada um dos seus trs vrtices
+   if (pTotal != NULL)
+   {
+      *pTotal = total / 3;
+   }
+
+   free(vtTriangulos);
+   DestruirAdjacenciaOrdenada(&adjacencia);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Decomposio em k-ncleos
+******/
+GRA_tpCondRet GRA_DecomposicaoKCore(GRA_tppGrafo pGrafoParm,
+   void (*visitar)(const char *nome, int nucleo, void *pContexto), void *pContexto,
+   int *pMaiorNucleo)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpAdjacenciaOrdenada adjacencia;
+   int *vtGrau, *vtPosicao, *vtOrdem, *vtBalde;
+   int numIds, maiorGrau = 0, maiorNucleo = 0, id, vizinho, i, j, grau, inicio, outro;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (!MontarAdjacenciaOrdenada(pGrafo, &adjacencia))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+   numIds = adjacencia.numIds;
+
+   for (id = 0; id < numIds; id++)
+   {
+      grau = adjacencia.vtInicio[id + 1] - adjacencia.vtInicio[id];
+      if (grau > maiorGrau)
+      {
+         maiorGrau = grau;
+      }
+   }
+
+   vtGrau = (int*) malloc((3 * (size_t) numIds + maiorGrau + 1) * sizeof(int));
+   if (vtGrau == NULL)
+   {
+      DestruirAdjacenciaOrdenada(&adjacencia);
+      return GRA_CondRetFaltouMemoria;
+   }
+   vtPosicao = vtGrau + numIds;
+   vtOrdem = vtPosicao + numIds;
+   vtBalde = vtOrdem + numIds;
+
+   // Ordena os ids por grau, por contagem: vtBalde[g]  onde comeam
+   // os de grau g em vtOrdem
+   memset(vtBalde, 0, (maiorGrau + 1) * sizeof(int));
+   for (id = 0; id < numIds; id++)
+   {
+      vtGrau[id] = adjacencia.vtInicio[id + 1] - adjacencia.vtInicio[id];
+      vtBalde[vtGrau[id]]++;
+   }
+
+   inicio = 0;
+   for (grau = 0; grau <= maiorGrau; grau++)
+   {
+      i = vtBalde[grau];
+      vtBalde[grau] = inicio;
+      inicio += i;
+   }
+
+   for (id = 0; id < numIds; id++)
+   {
+      vtPosicao[id] = vtBalde[vtGrau[id]]++;
+      vtOrdem[vtPosicao[id]] = id;
+   }
+
+   for (grau = maiorGrau; grau > 0; grau--)
+   {
+      vtBalde[grau] = vtBalde[grau - 1];
+   }
+   vtBalde[0] = 0;
+
+   // Retira os ids em ordem de grau; cada vizinho de grau maior desce
+   // um balde, trocando de lugar com o primeiro do seu balde
+   for (i = 0; i < numIds; i++)
+   {
+      id = vtOrdem[i];
+
+      for (j = adjacencia.vtInicio[id]; j < adjacencia.vtInicio[id + 1]; j++)
+      {
+         vizinho = adjacencia.vtVizinhos[j];
+         if (vtGrau[vizinho] > vtGrau[id])
+         {
+            grau = vtGrau[vizinho];
+            outro = vtOrdem[vtBalde[grau]];
+            if (outro != vizinho)
+            {
+               vtOrdem[vtPosicao[vizinho]] = outro;
+               vtPosicao[outro] = vtPosicao[vizinho];
+               vtOrdem[vtBalde[grau]] = vizinho;
+               vtPosicao[vizinho] = vtBalde[grau];
+            }
+            vtBalde[grau]++;
+            vtGrau[vizinho]--;
+         }
+      }
+   }
+
+   // O grau que restou a cada id quando ele foi retirado  o seu ncleo
+   for (id = 0; id < numIds; id++)
+   {
+      if (pGrafo->vtVertices[id] == NULL)
+      {
+         continue;
+      }
+
+      if (vtGrau[id] > maiorNucleo)
+      {
+         maiorNucleo = vtGrau[id];
+      }
+      if (visitar != NULL)
+      {
+         visitar(pGrafo->vtVertices[id]->nome, vtGrau[id], pContexto);
+      }
+   }
+
+   if (pMaiorNucleo != NULL)
+   {
+      *pMaiorNucleo = maiorNucleo;
+   }
+
+   free(vtGrau);
+   DestruirAdjacenciaOrdenada(&adjacencia);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Alcanar por expresso
+******/
+GRA_tpCondRet GRA_AlcancarPorExpressao(GRA_tppGrafo pGrafoParm, char *nomeOrigem,
+   const char *expressao,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpExpressao *pExpressao = NULL;
+   tpVertice *pVertice, *pOrigem;
+   tpAresta *pAresta;
+   tpGrupoRotulo *pGrupo;
+   ADJ_tpIterador iterador;
    GRA_tpCondRet graCondRet;
-	tpVertice *pVertice;
-	if (pGrafoParm == NULL)
+   unsigned long *vtAlcancados, *vtPendentes;
+   unsigned long seguintes, restantes, mascara, novos;
+   int *vtFila, inicioFila = 0, numNaFila = 0, numIds, id, estado, parar = 0;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeOrigem, &pOrigem) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   graCondRet = ObterExpressao(pGrafo, expressao, &pExpressao);
+   if (graCondRet != GRA_CondRetOK)
+   {
+      return graCondRet;
+   }
+
+   if (!pGrafo->gruposMontados && !MontarGruposRotulo(pGrafo))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   numIds = pGrafo->numIds;
+   vtAlcancados = (unsigned long*) malloc(2 * (size_t) numIds * sizeof(unsigned long));
+   vtFila = (int*) malloc(numIds * sizeof(int));
+   if (vtAlcancados == NULL || vtFila == NULL)
+   {
+      free(vtAlcancados);
+      free(vtFila);
+      return GRA_CondRetFaltouMemoria;
+   }
+   vtPendentes = vtAlcancados + numIds;
+
+   memset(vtAlcancados, 0, 2 * (size_t) numIds * sizeof(unsigned long));
+
+   // Percurso em largura pelo produto do grafo com o autmato: um
+   // vrtice volta  fila quando alcana estados novos
+   vtAlcancados[pOrigem->id] = 1UL;
+   vtPendentes[pOrigem->id] = 1UL;
+   vtFila[numNaFila++] = pOrigem->id;
+   if (pExpressao->finais & 1UL)
+   {
+      parar = visitar(pOrigem->nome, pOrigem->pValor, pContexto);
+   }
+
+   while (numNaFila > 0 && !parar)
+   {
+      id = vtFila[inicioFila];
+      inicioFila = (inicioFila + 1) % numIds;
+      numNaFila--;
+
+      seguintes = 0;
+      for (estado = 0; estado <= pExpressao->numPosicoes; estado++)
+      {
+         if (vtPendentes[id] & (1UL << estado))
+         {
+            seguintes |= pExpressao->vtSeguintes[estado];
+         }
+      }
+      vtPendentes[id] = 0;
+
+      // S os grupos dos rtulos das posies seguintes so percorridos,
+      // cada um uma vez, mesmo que o rtulo aparea em vrias posies
+      pVertice = pGrafo->vtVertices[id];
+      restantes = seguintes;
+      for (estado = 1; estado <= pExpressao->numPosicoes && !parar; estado++)
+      {
+         if ((restantes & (1UL << estado)) == 0)
+         {
+            continue;
+         }
+
+         mascara = pExpressao->vtMesmoRotulo[estado];
+         restantes &= ~mascara;
+
+         pGrupo = ProcurarGrupoRotulo(pVertice, pExpressao->vtRotulos[estado]);
+         if (pGrupo == NULL)
+         {
+            continue;
+         }
+
+         ADJ_IniciarIterador(&pGrupo->arestas, &iterador);
+         while (!parar && ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+         {
+            id = pAresta->pVertice->id;
+            novos = mascara & seguintes & ~vtAlcancados[id];
+            if (novos == 0)
+            {
+               continue;
+            }
+
+            if (vtPendentes[id] == 0)
+            {
+               vtFila[(inicioFila + numNaFila) % numIds] = id;
+               numNaFila++;
+            }
+            vtPendentes[id] |= novos;
+
+            if ((vtAlcancados[id] & pExpressao->finais) == 0 && (novos & pExpressao->finais) != 0)
+            {
+               parar = visitar(pAresta->pVertice->nome, pAresta->pVertice->pValor, pContexto);
+            }
+            vtAlcancados[id] |= novos;
+         }
+      }
+   }
+
+   free(vtAlcancados);
+   free(vtFila);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Caminho entre
+******/
+GRA_tpCondRet GRA_CaminhoEntre(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto,
+   int *pComprimento)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pOrigem, *pDestino, **vtCaminho;
+   tpPontaBusca frente, tras, *pPonta, *pOutra;
+   int posFrente = -1, posTras = -1, encontro = 0, numFrente = 0, numVertices = 0, i, pos;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeOrigem, &pOrigem) != GRA_CondRetOK ||
+       ProcurarVertice(pGrafo, nomeDestino, &pDestino) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   if (pOrigem == pDestino)
+   {
+      if (pComprimento != NULL)
+      {
+         *pComprimento = 0;
+      }
+      if (visitar != NULL)
+      {
+         visitar(pOrigem->nome, pOrigem->pValor, pContexto);
+      }
+      return GRA_CondRetOK;
+   }
+
+   IniciarPontaBusca(&frente, 1);
+   IniciarPontaBusca(&tras, -1);
+   if (!ReservarPosicoesNaBusca(pGrafo) ||
+       !AcrescentarPasso(pGrafo, &frente, pOrigem->id, -1) ||
+       !AcrescentarPasso(pGrafo, &tras, pDestino->id, -1))
+   {
+      free(frente.vtPassos);
+      free(tras.vtPassos);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   // Expande um nvel inteiro por vez, sempre da ponta com a menor
+   // fronteira, at que uma alcance um vrtice j alcanado pela outra
+   while (encontro == 0 && frente.inicioNivel < frente.numPassos &&
+          tras.inicioNivel < tras.numPassos)
+   {
+      if (frente.numPassos - frente.inicioNivel <= tras.numPassos - tras.inicioNivel)
+      {
+         pPonta = &frente;
+         pOutra = &tras;
+      }
+      else
+      {
+         pPonta = &tras;
+         pOutra = &frente;
+      }
+
+      encontro = ExpandirNivelDaBusca(pGrafo, pPonta, pOutra, &pos, &i);
+      if (encontro == 1)
+      {
+         posFrente = pPonta == &frente ? pos : i;
+         posTras = pPonta == &frente ? i : pos;
+      }
+   }
+
+   if (encontro < 0)
+   {
+      free(frente.vtPassos);
+      free(tras.vtPassos);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (encontro == 0)
+   {
+      free(frente.vtPassos);
+      free(tras.vtPassos);
+      if (pComprimento != NULL)
+      {
+         *pComprimento = -1;
+      }
+      return GRA_CondRetOK;
+   }
+
+   // O caminho vai da origem at frente[posFrente] e, por uma aresta,
+   // de tras[posTras] at o destino
+   for (pos = posFrente; pos >= 0; pos = frente.vtPassos[pos].anterior)
+   {
+      numFrente++;
+   }
+   for (pos = posTras; pos >= 0; pos = tras.vtPassos[pos].anterior)
+   {
+      numVertices++;
+   }
+   numVertices += numFrente;
+
+   vtCaminho = (tpVertice**) malloc(numVertices * sizeof(tpVertice*));
+   if (vtCaminho == NULL)
+   {
+      free(frente.vtPassos);
+      free(tras.vtPassos);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   i = numFrente;
+   for (pos = posFrente; pos >= 0; pos = frente.vtPassos[pos].anterior)
+   {
+      vtCaminho[--i] = pGrafo->vtVertices[frente.vtPassos[pos].id];
+   }
+   i = numFrente;
+   for (pos = posTras; pos >= 0; pos = tras.vtPassos[pos].anterior)
+   {
+      vtCaminho[i++] = pGrafo->vtVertices[tras.vtPassos[pos].id];
+   }
+
+   free(frente.vtPassos);
+   free(tras.vtPassos);
+
+   if (pComprimento != NULL)
+   {
+      *pComprimento = numVertices - 1;
+   }
+
+   for (i = 0; i < numVertices && visitar != NULL; i++)
+   {
+      if (visitar(vtCaminho[i]->nome, vtCaminho[i]->pValor, pContexto))
+      {
+         break;
+      }
+   }
+
+   free(vtCaminho);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Preparar marcos
+******/
+GRA_tpCondRet GRA_PrepararMarcos(GRA_tppGrafo pGrafoParm, int numMarcos)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (numMarcos < 1 || numMarcos > GRA_MAX_MARCOS)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   DescartarMarcos(pGrafo);
+   pGrafo->numMarcosPedidos = numMarcos;
+
+   return CalcularMarcos(pGrafo) ? GRA_CondRetOK : GRA_CondRetFaltouMemoria;
+}
+
+/***************************************************************************
+*  Funo: GRA Estimar distncia
+******/
+GRA_tpCondRet GRA_EstimarDistancia(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino,
+   int *pInferior, int *pSuperior)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pOrigem, *pDestino;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeOrigem, &pOrigem) != GRA_CondRetOK ||
+       ProcurarVertice(pGrafo, nomeDestino, &pDestino) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   if (pGrafo->vtDistanciasMarcos == NULL && !CalcularMarcos(pGrafo))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   *pInferior = LimiteInferiorPorMarcos(pGrafo, pOrigem->id, pDestino->id);
+   *pSuperior = *pInferior < 0 ? -1 : LimiteSuperiorPorMarcos(pGrafo, pOrigem->id, pDestino->id);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Caminho por marcos
+******/
+GRA_tpCondRet GRA_CaminhoPorMarcos(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto,
+   int *pComprimento)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpVertice *pOrigem, *pDestino, *pVertice, **vtCaminho;
+   tpPontaBusca busca;
+   tpFilaAbertos abertos;
+   tpAberto aberto;
+   tpAresta *pAresta;
+   ADJ_tpIterador iterador;
+   int posDestino = -1, numVertices = 0, faltouMemoria = 0, distancia, estimativa, vizinho, pos, i;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (ProcurarVertice(pGrafo, nomeOrigem, &pOrigem) != GRA_CondRetOK ||
+       ProcurarVertice(pGrafo, nomeDestino, &pDestino) != GRA_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   if (pGrafo->vtDistanciasMarcos == NULL && !CalcularMarcos(pGrafo))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   estimativa = LimiteInferiorPorMarcos(pGrafo, pOrigem->id, pDestino->id);
+
+   IniciarPontaBusca(&busca, 1);
+   abertos.vtAbertos = NULL;
+   abertos.numAbertos = 0;
+   abertos.capAbertos = 0;
+
+   if (estimativa >= 0)
+   {
+      if (!ReservarPosicoesNaBusca(pGrafo) ||
+          !AcrescentarPasso(pGrafo, &busca, pOrigem->id, -1) ||
+          !InserirAberto(&abertos, estimativa, 0, 0))
+      {
+         faltouMemoria = 1;
+      }
+   }
+
+   // A* com a estimativa dos marcos, que nunca passa da distncia real e
+   // no passa de 1 mais a estimativa de um sucessor: um vrtice sai da
+   // fila pela primeira vez j pelo caminho mnimo
+   while (!faltouMemoria && abertos.numAbertos > 0)
+   {
+      RetirarAberto(&abertos, &aberto);
+      if (aberto.distancia != busca.vtPassos[aberto.posicao].distancia)
+      {
+         continue;
+      }
+
+      if (busca.vtPassos[aberto.posicao].id == pDestino->id)
+      {
+         posDestino = aberto.posicao;
+         break;
+      }
+
+      distancia = aberto.distancia + 1;
+      pVertice = pGrafo->vtVertices[busca.vtPassos[aberto.posicao].id];
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         vizinho = pAresta->pVertice->id;
+         pos = PosicaoNaPonta(pGrafo, &busca, vizinho);
+
+         if (pos >= 0)
+         {
+            if (busca.vtPassos[pos].distancia <= distancia)
+            {
+               continue;
+            }
+            busca.vtPassos[pos].anterior = aberto.posicao;
+            busca.vtPassos[pos].distancia = distancia;
+         }
+         else
+         {
+            // Vrtices de onde os marcos garantem que o destino no 
+            // alcanvel nem entram na busca
+            estimativa = LimiteInferiorPorMarcos(pGrafo, vizinho, pDestino->id);
+            if (estimativa < 0)
+            {
+               continue;
+            }
+            if (!AcrescentarPasso(pGrafo, &busca, vizinho, aberto.posicao))
+            {
+               faltouMemoria = 1;
+               break;
+            }
+            pos = busca.numPassos - 1;
+         }
+
+         if (!InserirAberto(&abertos, distancia + LimiteInferiorPorMarcos(pGrafo, vizinho, pDestino->id),
+                            distancia, pos))
+         {
+            faltouMemoria = 1;
+            break;
+         }
+      }
+   }
+
+   free(abertos.vtAbertos);
+
+   if (faltouMemoria)
+   {
+      free(busca.vtPassos);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   if (posDestino < 0)
+   {
+      free(busca.vtPassos);
+      if (pComprimento != NULL)
+      {
+         *pComprimento = -1;
+      }
+      return GRA_CondRetOK;
+   }
+
+   numVertices = busca.vtPassos[posDestino].distancia + 1;
+   vtCaminho = (tpVertice**) malloc(numVertices * sizeof(tpVertice*));
+   if (vtCaminho == NULL)
+   {
+      free(busca.vtPassos);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   i = numVertices;
+   for (pos = posDestino; pos >= 0; pos = busca.vtPassos[pos].anterior)
+   {
+      vtCaminho[--i] = pGrafo->vtVertices[busca.vtPassos[pos].id];
+   }
+
+   free(busca.vtPassos);
+
+   if (pComprimento != NULL)
+   {
+      *pComprimento = numVertices - 1;
+   }
+
+   for (i = 0; i < numVertices && visitar != NULL; i++)
+   {
+      if (visitar(vtCaminho[i]->nome, vtCaminho[i]->pValor, pContexto))
+      {
+         break;
+      }
+   }
+
+   free(vtCaminho);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Definir auto-organizao
+******/
+GRA_tpCondRet GRA_DefinirAutoOrganizacao(GRA_tppGrafo pGrafoParm,
+   GRA_tpAutoOrganizacao autoOrganizacao)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (autoOrganizacao != GRA_AutoOrganizacaoNenhuma &&
+       autoOrganizacao != GRA_AutoOrganizacaoMoverParaFrente &&
+       autoOrganizacao != GRA_AutoOrganizacaoTranspor)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   pGrafo->autoOrganizacao = autoOrganizacao;
+
+   // Os sucessores seguem pGrafo->autoOrganizacao a cada busca
+   AplicarAutoOrganizacao(pGrafo, pGrafo->pOrigens);
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Obter estatsticas de busca
+******/
+GRA_tpCondRet GRA_ObterEstatisticasDeBusca(GRA_tppGrafo pGrafoParm,
+   GRA_tpEstatisticasBusca *pArestas, GRA_tpEstatisticasBusca *pOrigens)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (pArestas != NULL)
+   {
+      *pArestas = pGrafo->estatisticasArestas;
+   }
+   if (pOrigens != NULL)
+   {
+      *pOrigens = pGrafo->estatisticasOrigens;
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Zerar estatsticas de busca
+******/
+GRA_tpCondRet GRA_ZerarEstatisticasDeBusca(GRA_tppGrafo pGrafoParm)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   memset(&pGrafo->estatisticasArestas, 0, sizeof(GRA_tpEstatisticasBusca));
+   memset(&pGrafo->estatisticasOrigens, 0, sizeof(GRA_tpEstatisticasBusca));
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: GRA Obter espao dos sucessores
+******/
+GRA_tpCondRet GRA_ObterEspacoDosSucessores(GRA_tppGrafo pGrafoParm, size_t *pEspaco,
+   size_t *pEspacoEmListas)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   tpGrupoRotulo *pGrupo;
+   ADJ_tpIterador iterador;
+   size_t espaco = 0, espacoEmListas = 0;
+   int id;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      tpVertice *pVertice = pGrafo->vtVertices[id];
+
+      if (pVertice == NULL)
+      {
+         continue;
+      }
+
+      espaco += sizeof(ADJ_tpAdjacencia) + ADJ_EspacoAlocado(&pVertice->sucessores) +
+                ADJ_EspacoAlocado(&pVertice->gruposRotulo);
+      ADJ_IniciarIterador(&pVertice->gruposRotulo, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**) &pGrupo) == ADJ_CondRetOK)
+      {
+         espaco += sizeof(tpGrupoRotulo) + ADJ_EspacoAlocado(&pGrupo->arestas);
+      }
+      espacoEmListas += sizeof(LIS_tppLista) + LIS_TamanhoCabeca() +
+                        ADJ_NumElementos(&pVertice->sucessores) * sizeof(LIS_tpElemLista);
+   }
+
+   if (pEspaco != NULL)
+   {
+      *pEspaco = espaco;
+   }
+   if (pEspacoEmListas != NULL)
+   {
+      *pEspacoEmListas = espacoEmListas;
+   }
+
+   return GRA_CondRetOK;
+}
+
+#ifdef _DEBUG
+
+GRA_tpCondRet VER_VerificaEspaosDoGrafo(tpGrafo *pGrafo, int *numFalhas)
+{
+   LIS_tpIterador iterVertices, iterOrigens;
+   int erroNaEstrutura = 0;
+   int numElemVer = 0, numElemOri = 0;
+
+   if(!CED_VerificarEspaco(pGrafo->pCorrente,NULL))
+   {
+      CNT_CONTAR("verEspacos corrente nao eh espaco valido");
+      TST_NotificarFalha( "Controle do espao acusou erro." ) ;
+      (*numFalhas)++;
+      return GRA_CondRetErroNaEstrutura;
+   }
+   else
+   {
+      CNT_CONTAR("verEspacos corrente eh espaco valido");
+   }
+
+   LIS_NumELementos(pGrafo->pVertices,&numElemVer);
+   LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
+
+   while(numElemVer > 0)
+   {
+      tpVertice *pVertice = NULL;
+      int numElemSuc = 0, numElemAnt = 0;
+
+      CNT_CONTAR("verEspacos percorre vertices");
+
+      LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
+
+      if(VerificaVertice(pVertice,numFalhas) == GRA_CondRetErroNaEstrutura)
+      {
+         CNT_CONTAR("verEspacos erro encontrado em vertice");
+         erroNaEstrutura = 1;
+      }
+      else
+      {
+         CNT_CONTAR("verEspacos sem erros encontrados em vertice");
+      }
+
+      numElemVer--;
+   }
+   CNT_CONTAR("verEspacos percorreu todos os vertices");
+
+   LIS_NumELementos(pGrafo->pOrigens,&numElemOri);
+   LIS_IniciarIterador(pGrafo->pOrigens, &iterOrigens);
+
+   while(numElemOri > 0)
+   {
+      tpVertice *pVerticeOri = NULL;
+
+      CNT_CONTAR("verEspacos percorre origens");
+
+      LIS_AvancarIterador(&iterOrigens, (void**)&pVerticeOri);
+
+      if(!CED_VerificarEspaco(pVerticeOri,NULL))
+      {
+         CNT_CONTAR("verEspacos erro encontrado em origem");
+         TST_NotificarFalha( "Controle do espao acusou erro no ponteiro vertice origem." ) ;
+         (*numFalhas)++;
+         erroNaEstrutura = 1;
+      }
+      else
+      {
+         CNT_CONTAR("verEspacos sem erros encontrados em origem");
+      }
+      numElemOri--;
+   }
+   CNT_CONTAR("verEspacos percorreu todas as origens");
+
+   if (erroNaEstrutura)
+   {
+      CNT_CONTAR("verEspacos estrutura contem erros");
+      return GRA_CondRetErroNaEstrutura;
+   }
+   else
+   {
+      CNT_CONTAR("verEspacos estrutura nao contem erros");
+      return GRA_CondRetOK;
+   }
+}
+
+// Checa os espaos do vertice, das arestas + vertices apontados por elas e os vertices antecessores
+GRA_tpCondRet VerificaVertice(tpVertice *pVertice, int* numFalhas)
+{
+   LIS_tpIterador iterAdjacentes;
+   ADJ_tpIterador iterArestas;
+   int erroNaEstrutura = 0;
+   int numElemSuc = 0, numElemAnt = 0;
+   if(!CED_VerificarEspaco(pVertice,NULL))
+   {
+      CNT_CONTAR("verEspacos vertice nao eh valido");
+      TST_NotificarFalha( "Controle do espao acusou erro no vertice da lista de vertices." ) ;
+      (*numFalhas)++;
+      return GRA_CondRetErroNaEstrutura;
+   }
+   else
+   {
+      CNT_CONTAR("verEspacos vertice eh valido");
+   }
+
+   if(!CED_VerificarEspaco(pVertice->pValor,NULL))
+   {
+      CNT_CONTAR("verEspacos valor vertice nao eh valido");
+      TST_NotificarFalha( "Controle do espao acusou erro no valor do vertice." ) ;
+      (*numFalhas)++;
+      erroNaEstrutura = 1;
+   }
+   else
+   {
+      CNT_CONTAR("verEspacos valor vertice eh valido");
+   }
+
+   // Checa os espaos das arestas e vertices apontados por ela
+
+   numElemSuc = ADJ_NumElementos(&pVertice->sucessores);
+   ADJ_IniciarIterador(&pVertice->sucessores, &iterArestas);
+
+   while(numElemSuc > 0)
+   {
+      tpAresta *pAresta = NULL;
+    
+      CNT_CONTAR("verEspacos percorrer sucessores");
+      
+      ADJ_AvancarIterador(&iterArestas, (void**)&pAresta);
+
+      if(!CED_VerificarEspaco(pAresta,NULL))
+      {
+         CNT_CONTAR("verEspacos aresta nao eh valida");
+         TST_NotificarFalha( "Controle do espao acusou erro na aresta." ) ;
+         (*numFalhas)++;
+         erroNaEstrutura = 1;
+      }
+      else
+      {
+         CNT_CONTAR("verEspacos aresta eh valida");
+         
+         if(!CED_VerificarEspaco(pAresta->pVertice,NULL))
+         {
+            CNT_CONTAR("verEspacos sucessor nao eh valido");
+            TST_NotificarFalha( "Controle do espao acusou erro no ponteiro vertice da aresta." ) ;
+            (*numFalhas)++;
+            erroNaEstrutura = 1;
+         }
+         else
+         {
+            CNT_CONTAR("verEspacos sucessor eh valido");
+         }
+      }
+      numElemSuc--;
+   }
+   CNT_CONTAR("verEspacos percorreu todos os sucessores");
+
+   // Checa os espaos dos vertices antecessores
+
+   LIS_NumELementos(pVertice->pAntecessores, &numElemAnt);
+   LIS_IniciarIterador(pVertice->pAntecessores, &iterAdjacentes);
+
+   while(numElemAnt > 0)
+   {
+      tpVertice *pVerticeAnt = NULL;
+      
+      CNT_CONTAR("verEspacos percorre antecessores");
+
+      LIS_AvancarIterador(&iterAdjacentes, (void**)&pVerticeAnt);
+      if(!CED_VerificarEspaco(pVerticeAnt,NULL))
+      {
+         CNT_CONTAR("verEspacos antecessor nao eh valido");
+         TST_NotificarFalha( "Controle do espao acusou erro no ponteiro vertice antecessor." ) ;
+         (*numFalhas)++;
+         erroNaEstrutura = 1;
+      }
+      else
+      {
+         CNT_CONTAR("verEspacos antecessor eh valido");
+      }
+      numElemAnt--;
+   }
+   CNT_CONTAR("verEspacos percorreu todos os antecessores");
+
+   if (erroNaEstrutura)
+   {
+      CNT_CONTAR("verEspacos vertice contem erros");
+      return GRA_CondRetErroNaEstrutura;
+   }
+   else
+   {
+      CNT_CONTAR("verEspacos vertice nao contem erros");
+      return GRA_CondRetOK;
+   }
+}
+
+/***************************************************************************
+*
+*  Funo: GRA  Deturpar grafo
+*  ****/
+
+GRA_tpCondRet GRA_Deturpar(void *pGrafoParm, GRA_tpModosDeturpacao ModoDeturpar)
+{
+
+   tpGrafo *pGrafo = NULL ;
+
+   if ( pGrafoParm == NULL )
+   {
+      return GRA_CondRetOK;
+   } /* if */
+
+   pGrafo = (tpGrafo*) pGrafoParm;
+
+   switch ( ModoDeturpar ) {
+   case DeturpaEliminaElementoCorrente :
+      {
+         DET_EliminaElementoCorrente(pGrafo);
+         break;
+      } 
+
+   case GRA_DeturpaAtribuiNullParaVerticeSucessor:
+      {
+         DET_AtribuiNullParaVerticeSucessor(pGrafo);
+         break;
+      }
+
+   case GRA_AtribuiNullAOPonteiroDoVerticePredecessor:
+      {
+         DET_AtribuiNullAOPonteiroDoVerticePredecessor(pGrafo);
+         break;
+      }
+
+   case GRA_LixoNaReferenciaParaSucessor:
+      {
+         DET_LixoNaReferenciaParaSucessor(pGrafo);
+         break;
+      }
+   
+   case GRA_LixoNaReferenciaParaAntecessor:
+      {
+         DET_LixoNaReferenciaParaAntecessor(pGrafo);
+         break;
+      }
+
+   case GRA_ConteudoDoVerticeNULL:
+      {
+         DET_ConteudoDoVerticeNULL(pGrafo);
+         break;
+      }
+
+   case GRA_AlteraTipoDoValorDoVertice:
+      {
+         DET_AlteraTipoDoValorDoVertice(pGrafo);
+         break;
+      }
+
+   case GRA_DestacaVertice:
+      {
+         DET_DestacaVertice(pGrafo);
+         break;
+      }
+
+   case GRA_AtribuiNullAoCorrente:
+      {
+         DET_AtribuiNullAoCorrente(pGrafo);
+         break;
+      }
+
+   case GRA_AtribuiNullParaUmaOrigem:
+      {
+         DET_AtribuiNullParaUmaOrigem(pGrafo);
+         break;
+      }
+   case GRA_EspalhaLixoPelaEstrutura:
+      {
+         DET_EspalharLixosPelaEstrutura(pGrafo);
+         break;
+      }
+   case GRA_GrafoEhEspacoLixo:
+      {
+         DET_GrafoEhEspacoLixo(pGrafo);
+         break;
+      }
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***************************************************************************
+*
+*  Funo: GRA  Verificar grafo
+*  ****/
+
+GRA_tpCondRet GRA_Verificar(void *pGrafoParm, int *numFalhas)
+{
+   int erroNaEstrutura = 0;
+   tpGrafo *pGrafo = NULL;
+   GRA_tpCondRet ret;
+   if (CED_ObterTipoEspaco(pGrafoParm) != GRA_TipoEspacoCabeca ||
+      !CED_VerificarEspaco(pGrafo,NULL))
+   {
+      CNT_CONTAR("ver00 grafo nao existe");
+      TST_NotificarFalha("Tentou verificar um grafo que no existe.");
+      (*numFalhas)++;
+      return GRA_CondRetErroNaEstrutura;
+   }
+   CNT_CONTAR("ver00 grafo existe");
+
+   pGrafo = (tpGrafo*) pGrafoParm;
+
+    ret = VER_VerificaEspaosDoGrafo(pGrafo, numFalhas);
+    if (ret == GRA_CondRetErroNaEstrutura)
+    {
+       CNT_CONTAR("ver00 foi encontrado algum espaco invalido");
+       erroNaEstrutura = 1;
+    }
+    CNT_CONTAR("ver00 nao foi encontrado algum espaco invalido");
+
+   ret = VER_NenhumVerticeFoiLiberado(pGrafo, numFalhas);
+   if (ret == GRA_CondRetErroNaEstrutura)
+   {
+      CNT_CONTAR("ver00 existe vertice liberado");
+      erroNaEstrutura = 1;
+   }
+   CNT_CONTAR("ver00 nao existe vertice liberado");
+
+    ret = VER_VerticeSucessorNaoEhNulo(pGrafo, numFalhas);
+    if (ret == GRA_CondRetErroNaEstrutura)
+    {
+       CNT_CONTAR("ver00 existe vertice cujo sucessor eh nulo");
+       erroNaEstrutura = 1;
+    }
+    CNT_CONTAR("ver00 nao existe vertice cujo sucessor eh nulo");
+
+    ret = VER_VerticePredecessorNaoEhNulo(pGrafo, numFalhas);
+    if (ret == GRA_CondRetErroNaEstrutura)
+    {
+       erroNaEstrutura = 1;
+    }
+
+   ret = VER_NaoExisteLixoNaReferenciaParaSucessor(pGrafo, numFalhas);
+   if (ret == GRA_CondRetErroNaEstrutura)
+   {
+      CNT_CONTAR("ver00 existe vertice que tem lixo como referencia para sucessor");
+      erroNaEstrutura = 1;
+   }
+   CNT_CONTAR("ver00 nao existe vertice que tem lixo como referencia para sucessor");
+
+   ret = VER_NaoExisteLixoNaReferenciaParaAntecessor(pGrafo, numFalhas);
+   if (ret == GRA_CondRetErroNaEstrutura)
+   {
+      CNT_CONTAR("ver00 existe vertice que tem lixo como referencia para antecessor");
+      erroNaEstrutura = 1;
+   }
+   CNT_CONTAR("ver00 nao existe vertice que tem lixo como referencia para antecessor");
+
+   ret = VER_VerticesNaoPossuemConteudoNulo(pGrafo, numFalhas);
+   if (ret == GRA_CondRetErroNaEstrutura)
+   {
+      CNT_CONTAR("ver00 existe um vertice com conteudo nulo");
+      erroNaEstrutura = 1;
+   }
+   CNT_CONTAR("ver00 nao existe um vertice com conteudo nulo");
+   
+   ret = VER_NenhumVerticeTemConteudoComOTipoCorrompido(pGrafo, numFalhas);
+   if (ret == GRA_CondRetErroNaEstrutura)
+   {
+      erroNaEstrutura = 1;
+      CNT_CONTAR("ver00 existe vertice com conteudo de tipo errado");
+   }
+   CNT_CONTAR("ver00 nao existe vertice com conteudo de tipo errado");
+
+    ret = VER_NenhumVerticeEstaDestacado(pGrafo, numFalhas);
+    if (ret == GRA_CondRetErroNaEstrutura)
+    {
+      CNT_CONTAR("ver00 existe vertice destacado");
+       erroNaEstrutura = 1;
+    }
+    CNT_CONTAR("ver00 nao existe vertice destacado");
+   
+   ret = VER_CorrenteNaoEhNulo(pGrafo, numFalhas);
+   if (ret == GRA_CondRetErroNaEstrutura)
+   {
+      erroNaEstrutura = 1;
+      CNT_CONTAR("ver00 corrente eh nulo");
+   }
+   CNT_CONTAR("ver00 corrente nao eh nulo");
+   
+   ret = VER_NaoExisteOrigemNula(pGrafo, numFalhas);
+   if (ret == GRA_CondRetErroNaEstrutura)
+   {
+      CNT_CONTAR("ver00 existe origem nula");
+      erroNaEstrutura = 1;
+   }
+   CNT_CONTAR("ver00 nao existe origem nula");
+
+   if (erroNaEstrutura)
+   {
+      CNT_CONTAR("ver00 com erros na estrutura");
+      return GRA_CondRetErroNaEstrutura;
+   }
+   CNT_CONTAR("ver00 sem erros na estrutura");
+
+   return GRA_CondRetOK;
+}
+
+
+
+/***************************************************************************
+*
+*  Funo: GRA  Total espao alocado
+*  ****/
+GRA_tpCondRet GRA_TotalEspacoAlocado(GRA_tppGrafo pGrafoParm, unsigned long *pTotalEspaco)
+{
+   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
+   *pTotalEspaco = pGrafo->totalEspacoAlocado;
+   return GRA_CondRetOK;
+}
+
+#endif
+
+/*****  Cdigo das funes encapsuladas no mdulo  *****/
+/***********************************************************************
+*
+*  Funo: GRA Destruir vrtice
+*
+*  Descrio:
+*    Funo responsvel por destruir vrtices. Passada como ponteiro de funcao para listas de vrtices.
+*
+***********************************************************************/
+void DestruirVertice(void *pVazio)
+{
+	tpVertice *pVertice = (tpVertice*) pVazio;
+
+#ifdef _DEBUG
+   LIS_TotalEspacoAlocado(pVertice->pAntecessores, &espacoAlocado);
+   pVertice->pGrafo->totalEspacoAlocado -= espacoAlocado;
+   
+   pVertice->pGrafo->totalEspacoAlocado -= ADJ_EspacoAlocado(&pVertice->sucessores);
+#endif
+
+	LIS_DestruirLista(pVertice->pAntecessores);
+   ADJ_Esvaziar(&pVertice->sucessores, DestruirAresta);
+   
+#ifdef _DEBUG
+   pVertice->pGrafo->totalEspacoAlocado -= _msize(pVertice);
+
+   LIS_TotalEspacoAlocado(pVertice->pAntecessores, &espacoAlocado);
+   pVertice->pGrafo->totalEspacoAlocado += espacoAlocado;
+#endif
+
+   if (pVertice->destruirValor != NULL)
+   {
+	   pVertice->destruirValor(pVertice->pValor);
+   }
+
+   CNJ_Destruir(pVertice->pDestinos);
+   ADJ_Esvaziar(&pVertice->gruposRotulo, DestruirGrupoRotulo);
+
+	LiberarNome(pVertice->nome, pVertice->nomeCurto);
+
+	free(pVertice);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Separar grafo
+*
+*  Descrio:
+*    Confirma e fecha o registro persistente e faz as vises e os
+*    marcadores que sobreviverem ao grafo deixarem de referenci-lo.
+*    Depois disso s resta liberar os vrtices e as tabelas do grafo.
+*    Retorna o resultado do fechamento do registro.
+*
+***********************************************************************/
+GRA_tpCondRet SepararGrafo(tpGrafo *pGrafo)
+{
+   GRA_tpCondRet condRet = GRA_CondRetOK;
+   int numVisoes = 0;
+
+   // Os registros do ltimo grupo so confirmados antes de descartar o grafo
+   if (pGrafo->pPersistencia != NULL)
+   {
+      condRet = TraduzirCondRetLog(WAL_Fechar(pGrafo->pPersistencia->pLog));
+      free(pGrafo->pPersistencia->caminhoBase);
+      free(pGrafo->pPersistencia);
+      pGrafo->pPersistencia = NULL;
+   }
+
+   // Vises que sobreviverem ao grafo deixam de referenci-lo
+   LIS_NumELementos(pGrafo->pVisoes, &numVisoes);
+   LIS_IrInicioLista(pGrafo->pVisoes);
+
+   while (numVisoes > 0)
+   {
+      tpVisao *pVisao = NULL;
+      LIS_ObterValor(pGrafo->pVisoes, (void**)&pVisao);
+
+      pVisao->pGrafo = NULL;
+      pVisao->pCorrente = NULL;
+
+      LIS_AvancarElementoCorrente(pGrafo->pVisoes, 1);
+      numVisoes--;
+   }
+   LIS_DestruirLista(pGrafo->pVisoes);
+
+   if (pGrafo->pMarcadorInterno != NULL)
+   {
+      DestruirMarcador(pGrafo->pMarcadorInterno);
+   }
+
+   // Idem para os marcadores
+   LIS_NumELementos(pGrafo->pMarcadores, &numVisoes);
+   LIS_IrInicioLista(pGrafo->pMarcadores);
+
+   while (numVisoes > 0)
+   {
+      tpMarcador *pMarcador = NULL;
+      LIS_ObterValor(pGrafo->pMarcadores, (void**)&pMarcador);
+
+      pMarcador->pGrafo = NULL;
+
+      LIS_AvancarElementoCorrente(pGrafo->pMarcadores, 1);
+      numVisoes--;
+   }
+   LIS_DestruirLista(pGrafo->pMarcadores);
+
+   // As assinaturas recebem o que falta entregar antes de serem desligadas
+   LIS_NumELementos(pGrafo->pAssinaturas, &numVisoes);
+   LIS_IrInicioLista(pGrafo->pAssinaturas);
+
+   while (numVisoes > 0)
+   {
+      tpAssinatura *pAssinatura = NULL;
+      LIS_ObterValor(pGrafo->pAssinaturas, (void**)&pAssinatura);
+
+      if (pAssinatura->pAnel == NULL)
+      {
+         EntregarLote(pAssinatura);
+      }
+      pAssinatura->pGrafo = NULL;
+
+      LIS_AvancarElementoCorrente(pGrafo->pAssinaturas, 1);
+      numVisoes--;
+   }
+   LIS_DestruirLista(pGrafo->pAssinaturas);
+   pGrafo->numAssinaturas = 0;
+
+   // E para os percursos, cujos marcadores j foram desligados acima
+   LIS_NumELementos(pGrafo->pPercursos, &numVisoes);
+   LIS_IrInicioLista(pGrafo->pPercursos);
+
+   while (numVisoes > 0)
+   {
+      tpPercurso *pPercurso = NULL;
+      LIS_ObterValor(pGrafo->pPercursos, (void**)&pPercurso);
+
+      pPercurso->pGrafo = NULL;
+
+      LIS_AvancarElementoCorrente(pGrafo->pPercursos, 1);
+      numVisoes--;
+   }
+   LIS_DestruirLista(pGrafo->pPercursos);
+
+   return condRet;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Liberar em lote
+*
+*  Descrio:
+*    Libera um grafo j separado. Os vrtices so percorridos pela
+*    tabela de identificadores, sem passar pela lista de vrtices nem
+*    desfazer as ligaes entre eles, e o ndice de nomes  descartado
+*    inteiro. Os valores so acumulados em vetores de TAM_LOTE_VALORES
+*    e entregues de uma vez a destruirValores. Pode ser executada numa
+*    linha de execuo prpria, pois o grafo no  mais alcanvel.
+*
+***********************************************************************/
+void LiberarEmLote(void *pVazio)
+{
+   tpDestruicao *pDestruicao = (tpDestruicao*) pVazio;
+   tpGrafo *pGrafo = pDestruicao->pGrafo;
+   void *vtLote[TAM_LOTE_VALORES];
+   int numLote = 0;
+   int id;
+
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      tpVertice *pVertice = pGrafo->vtVertices[id];
+
+      if (pVertice == NULL)
+      {
+         continue;
+      }
+
+      ADJ_Esvaziar(&pVertice->sucessores, DestruirAresta);
+      LIS_DestruirLista(pVertice->pAntecessores);
+      CNJ_Destruir(pVertice->pDestinos);
+      ADJ_Esvaziar(&pVertice->gruposRotulo, DestruirGrupoRotulo);
+
+      if (pGrafo->tamValor == 0 && pVertice->pValor != NULL)
+      {
+         if (pDestruicao->destruirValores != NULL)
+         {
+            vtLote[numLote++] = pVertice->pValor;
+            if (numLote == TAM_LOTE_VALORES)
+            {
+               pDestruicao->destruirValores(vtLote, numLote);
+               numLote = 0;
+            }
+         }
+         else if (pGrafo->destruirValor != NULL)
+         {
+            pGrafo->destruirValor(pVertice->pValor);
+         }
+      }
+
+      LiberarNome(pVertice->nome, pVertice->nomeCurto);
+      free(pVertice);
+   }
+
+   if (numLote > 0)
+   {
+      pDestruicao->destruirValores(vtLote, numLote);
+   }
+
+   // As listas s referenciam vrtices, que j foram liberados
+   LIS_DestruirListaSemValores(pGrafo->pVertices);
+   LIS_DestruirListaSemValores(pGrafo->pOrigens);
+
+   free(pGrafo->vtVertices);
+   free(pGrafo->vtIdsLivres);
+   free(pGrafo->vtOrdemTopologica);
+   free(pGrafo->vtAfetados);
+   free(pGrafo->vtPosicaoNaBusca);
+   free(pGrafo->vtDistanciasMarcos);
+   free(pGrafo->vtComponentes);
+   free(pGrafo->vtDesatualizados);
+   IND_DestruirIndice(pGrafo->pIndiceNomes);
+   DestruirRotulosEExpressoes(pGrafo);
+
+   free(pGrafo);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Destruir aresta
+*
+*  Descrio:
+*    Funo responsvel por destruir arestas. Passada como ponteiro de funcao para listas de sucessores do vrtice.
+*
+***********************************************************************/
+void DestruirAresta(void *pVazio)
+{
+	tpAresta *pAresta = (tpAresta*) pVazio;
+   
+#ifdef _DEBUG
+   pAresta->pGrafo->totalEspacoAlocado -= _msize(pAresta);
+#endif
+
+	LiberarNome(pAresta->nome, pAresta->nomeCurto);
+	free(pAresta);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Comparar vrtice e nome
+*
+*  Descrio:
+*    Funo responsvel por comparar vrtices pelo nome. Usado para fazer a busca na lista de vertices.
+*    O segundo parmetro  um tpNomeBuscado. S a igualdade  usada:
+*    nomes diferentes no so ordenados.
+*
+***********************************************************************/
+int CompararVerticeENome( void *pVazio1, void *pVazio2 )
+{
+	return !VerticeTemNome((tpVertice*) pVazio1, (tpNomeBuscado*) pVazio2);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Vrtice tem nome
+*
+*  Descrio:
+*    Comparao das buscas especializadas nas listas de vrtices.
+*    Retorna 1 se o vrtice tem o nome buscado.
+*
+***********************************************************************/
+int VerticeTemNome(tpVertice *pVertice, tpNomeBuscado *pBuscado)
+{
+	return NomesIguais(pVertice->nome, pVertice->tamNome, pBuscado);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Comparar aresta e nome
+*
+*  Descrio:
+*    Funo responsvel por comparar arestas pelo nome. Usado para fazer a busca na lista de arestas.
+*    Como CompararVerticeENome, recebe um tpNomeBuscado.
+*
+***********************************************************************/
+int CompararArestaENome(void *pVazio1, void *pVazio2)
+{
+	return !ArestaTemNome((tpAresta*) pVazio1, (tpNomeBuscado*) pVazio2);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Aresta tem nome
+*
+*  Descrio:
+*    Comparao das buscas especializadas nas listas de arestas.
+*    Retorna 1 se a aresta tem o nome buscado.
+*
+***********************************************************************/
+int ArestaTemNome(tpAresta *pAresta, tpNomeBuscado *pBuscado)
+{
+	return NomesIguais(pAresta->nome, pAresta->tamNome, pBuscado);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Posio da aresta para
+*
+*  Descrio:
+*    Retorna a posio, nos sucessores do vrtice, da primeira aresta
+*    que chega em pDestino, ou -1 se no h nenhuma.
+*
+***********************************************************************/
+int PosicaoDaArestaPara(const tpVertice *pVertice, const tpVertice *pDestino)
+{
+   ADJ_tpIterador iterador;
+   tpAresta *pAresta;
+
+   ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+   while (ADJ_AvancarIterador(&iterador, (void**) &pAresta) == ADJ_CondRetOK)
+   {
+      if (pAresta->pVertice == pDestino)
+      {
+         return ADJ_PosicaoDoIterador(&iterador);
+      }
+   }
+
+   return -1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Posio da aresta
+*
+*  Descrio:
+*    Retorna a posio, nos sucessores do vrtice, da aresta com o nome
+*    dado, ou -1 se no h nenhuma ou o nome  NULL.
+*
+***********************************************************************/
+int PosicaoDaAresta(tpGrafo *pGrafo, tpVertice *pVertice, const char *nome)
+{
+   tpNomeBuscado buscado;
+   size_t tamanho;
+
+   if (nome == NULL)
+   {
+      return -1;
+   }
+
+   tamanho = strlen(nome);
+   return ADJ_Procurar(&pVertice->sucessores, EspalharNome(nome, tamanho), CompararArestaENome,
+                       MontarNomeBuscado(pGrafo, &buscado, nome, tamanho));
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Espalhar nome
+*
+*  Descrio:
+*    Chave das arestas nas adjacncias: FNV-1a dos caracteres do nome,
+*    seguido da mistura final do MurmurHash3, para que os bits baixos,
+*    que escolhem a posio na tabela, dependam de todos os caracteres.
+*
+***********************************************************************/
+unsigned int EspalharNome(const char *nome, size_t tamanho)
+{
+   unsigned int chave = 2166136261u;
+   size_t i;
+
+   for (i = 0; i < tamanho; i++)
+   {
+      chave = (chave ^ (unsigned char) nome[i]) * 16777619u;
+   }
+
+   return EspalharInteiro(chave);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Espalhar inteiro
+*
+*  Descrio:
+*    Mistura final do MurmurHash3, que espalha todos os bits do valor
+*    pelos bits baixos da chave.
+*
+***********************************************************************/
+unsigned int EspalharInteiro(unsigned int valor)
+{
+   valor ^= valor >> 16;
+   valor *= 0x85ebca6bu;
+   valor ^= valor >> 13;
+   valor *= 0xc2b2ae35u;
+   valor ^= valor >> 16;
+
+   return valor;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Est vazio
+*
+*  Descrio:
+*    Funo responsvel por verificar se o grafo est vazio.
+*
+***********************************************************************/
+int EstaVazio(tpGrafo *pGrafo)
+{
+   return pGrafo->pCorrente == NULL;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Atribuir nome
+*
+*  Descrio:
+*    Retorna onde o nome de um vrtice ou aresta fica guardado e grava o
+*    seu tamanho em *pTamNome. Um nome que cabe em nomeCurto  copiado
+*    para ele; seno o prprio espao recebido  usado. No modo de chaves
+*    fixas o nome  sempre copiado, completado com zeros, para nomeCurto
+*    ou, se a chave no couber nele, para um bloco novo; retorna NULL se
+*    faltar memria para esse bloco.
+*    O espao recebido no  liberado aqui, para que uma insero que
+*    falhe possa devolv-lo.
+*
+***********************************************************************/
+char * AtribuirNome(tpGrafo *pGrafo, char *nome, size_t *pTamNome, char *nomeCurto)
+{
+   size_t tamanho = strlen(nome);
+   char *chave = nomeCurto;
+
+   *pTamNome = tamanho;
+
+   if (pGrafo->larguraChave == 0)
+   {
+      if (tamanho < TAM_NOME_CURTO)
+      {
+         memcpy(nomeCurto, nome, tamanho + 1);
+         return nomeCurto;
+      }
+      return nome;
+   }
+
+   if (pGrafo->larguraChave > TAM_NOME_CURTO)
+   {
+      chave = (char*) malloc(pGrafo->larguraChave);
+      if (chave == NULL)
+      {
+         return NULL;
+      }
+   }
+
+   memcpy(chave, nome, tamanho);
+   memset(chave + tamanho, 0, pGrafo->larguraChave - tamanho);
+
+   return chave;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Liberar nome
+*
+*  Descrio:
+*    Libera o nome de um vrtice ou aresta, se ele no est guardado no
+*    prprio registro.
+*
+***********************************************************************/
+void LiberarNome(char *nome, char *nomeCurto)
+{
+   if (nome != nomeCurto)
+   {
+      free(nome);
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Nome cabe na chave
+*
+*  Descrio:
+*    Retorna 0 se o grafo usa chaves fixas e o nome, com o '\0', no
+*    cabe nelas.
+*
+***********************************************************************/
+int NomeCabeNaChave(tpGrafo *pGrafo, const char *nome)
+{
+   return pGrafo->larguraChave == 0 || strlen(nome) < pGrafo->larguraChave;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Montar nome buscado
+*
+*  Descrio:
+*    Preenche a chave de busca nas listas e retorna o seu endereo. No
+*    modo de chaves fixas o nome  copiado, completado com zeros, para a
+*    prpria chave. Um nome que no cabe na largura  comparado pelo
+*    tamanho, o que o faz diferente de todos os nomes do grafo.
+*
+***********************************************************************/
+tpNomeBuscado * MontarNomeBuscado(tpGrafo *pGrafo, tpNomeBuscado *pBuscado,
+                                  const char *nome, size_t tamanho)
+{
+   pBuscado->nome = nome;
+   pBuscado->tamanho = tamanho;
+   pBuscado->largura = 0;
+
+   if (pGrafo->larguraChave != 0 && tamanho < pGrafo->larguraChave)
+   {
+      memcpy(pBuscado->vtChave, nome, tamanho);
+      memset(pBuscado->vtChave + tamanho, 0, pGrafo->larguraChave - tamanho);
+      pBuscado->nome = pBuscado->vtChave;
+      pBuscado->largura = pGrafo->larguraChave;
+   }
+
+   return pBuscado;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Nomes iguais
+*
+*  Descrio:
+*    Compara o nome guardado de um vrtice ou aresta com o nome buscado:
+*    pela chave inteira no modo de chaves fixas, seno primeiro pelo
+*    tamanho, que descarta sem ler os caracteres a maioria dos nomes
+*    diferentes.
+*
+***********************************************************************/
+int NomesIguais(const char *nome, size_t tamNome, tpNomeBuscado *pBuscado)
+{
+   if (pBuscado->largura != 0)
+   {
+      return ChavesFixasIguais(nome, pBuscado->nome, pBuscado->largura);
+   }
+
+   return tamNome == pBuscado->tamanho && memcmp(nome, pBuscado->nome, tamNome) == 0;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Chaves fixas iguais
+*
+*  Descrio:
+*    Compara duas chaves de 16 ou 32 bytes com instrues vetoriais:
+*    uma comparao de 32 bytes com AVX2, ou uma ou duas de 16 com SSE2.
+*    Sem elas, recorre a memcmp, que o compilador resolve com a largura
+*    constante.
+*
+***********************************************************************/
+int ChavesFixasIguais(const char *chave1, const char *chave2, size_t largura)
+{
+#if defined( __AVX2__ )
+   if (largura == 32)
+   {
+      __m256i igual = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) chave1),
+                                        _mm256_loadu_si256((const __m256i*) chave2));
+      return _mm256_movemask_epi8(igual) == -1;
+   }
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) chave1),
+                                           _mm_loadu_si128((const __m128i*) chave2))) == 0xFFFF;
+#elif defined( GRA_SSE2 )
+   __m128i igual = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) chave1),
+                                  _mm_loadu_si128((const __m128i*) chave2));
+
+   if (largura == 32)
+   {
+      igual = _mm_and_si128(igual,
+                 _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (chave1 + 16)),
+                                _mm_loadu_si128((const __m128i*) (chave2 + 16))));
+   }
+
+   return _mm_movemask_epi8(igual) == 0xFFFF;
+#else
+   return largura == 32 ? memcmp(chave1, chave2, 32) == 0 : memcmp(chave1, chave2, 16) == 0;
+#endif
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Procurar Vrtice
+*
+*  Descrio:
+*    Funo responsvel por realizar uma pesquisa no ndice de nomes
+*    dos vrtices.
+*
+***********************************************************************/
+GRA_tpCondRet ProcurarVertice(tpGrafo *pGrafo, char *nome, tpVertice **pVertice)
+{
+   void *pVazio;
+   *pVertice = NULL;
+
+   if (nome == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+	if (IND_Procurar(pGrafo->pIndiceNomes, nome, &pVazio) != IND_CondRetOK)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   *pVertice = (tpVertice*) pVazio;
+   return GRA_CondRetOK;
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Procurar Origem
+*
+*  Descrio:
+*    Funo responsvel por realizar uma pesquisa na lista de origens.
+*    O corrente da lista no  alterado.
+*
+***********************************************************************/
+GRA_tpCondRet ProcurarOrigem(tpGrafo *pGrafo, char *nome, tpVertice **pVertice)
+{
+   tpNomeBuscado buscado;
+   const LIS_tpElemLista *pElem;
+   *pVertice = NULL;
+
+   if (nome == NULL)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   pElem = LIS_ProcurarVertice(pGrafo->pOrigens,
+                               MontarNomeBuscado(pGrafo, &buscado, nome, strlen(nome)));
+   *pVertice = (tpVertice*) LIS_VALOR_ELEMENTO(pElem);
+
+   return *pVertice == NULL ? GRA_CondRetNaoAchou : GRA_CondRetOK;
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Procurar Aresta
+*
+*  Descrio:
+*    Funo responsvel por realizar uma pesquisa na lista de arestas partindo
+*    de um dado vrtice. O corrente da lista no  alterado.
+*
+***********************************************************************/
+GRA_tpCondRet ProcurarAresta(tpGrafo *pGrafo, tpVertice *pVertice, char *nome, tpAresta **pAresta)
+{
+   int posicao = PosicaoDaAresta(pGrafo, pVertice, nome);
+
+   if (posicao < 0)
+   {
+      *pAresta = NULL;
+      return GRA_CondRetNaoAchou;
+   }
+
+   *pAresta = (tpAresta*) ADJ_ObterValor(&pVertice->sucessores, posicao);
+   return GRA_CondRetOK;
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Existe Aresta
+*
+*  Descrio:
+*    Funo responsvel por verificar se existe uma aresta com o nome
+*    procurado partindo de um dado vrtice.
+*
+***********************************************************************/
+int ExisteAresta(tpGrafo *pGrafo, tpVertice *pVertice, char *nome)
+{
+   tpAresta*pAresta;
+   GRA_tpCondRet condRet;
+
+   condRet = ProcurarAresta(pGrafo, pVertice, nome, &pAresta);
+
+   return condRet == GRA_CondRetOK;
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Existe Vrtice
+*
+*  Descrio:
+*    Funo responsvel por verificar se existe uma origem com o nome
+*    procurado.
+*
+***********************************************************************/
+int ExisteOrigem(tpGrafo *pGrafo, char *nome)
+{
+   tpVertice *pVertice;
+   GRA_tpCondRet condRet;
+
+   condRet = ProcurarOrigem(pGrafo, nome, &pVertice);
+
+   return condRet == GRA_CondRetOK;
+}
+
+
+
+/***********************************************************************
+*
+*  Funo: GRA Destacar Vrtice
+*
+*  Descrio:
+*    Funo responsvel por destacar o vrtice do resto do grafo.
+*    Operao realizada antes de excluir o vrtice.
+*
+***********************************************************************/
+void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
+{
+   
+	tpVertice *pVertice = NULL, *pVerticeOrigem = NULL;
+   tpAresta *pAresta = NULL;
+   int numElemLista = 0, posicao;
+   LIS_tppLista pAntecessores;
+   ADJ_tpIterador iterArestas;
+   tpNomeBuscado buscado;
+
+   MontarNomeBuscado(pGrafo, &buscado, pAlvo->nome, pAlvo->tamNome);
+   
+   // remove corrente vai para origem
+	// Navega para o inicio da lista de origens
+	LIS_IrInicioLista(pGrafo->pOrigens);
+	//Pega o valor do primeiro vrtice de origem
+	LIS_ObterValor(pGrafo->pOrigens,(void**)&pVerticeOrigem);
+
+   // Para cada aresta que sai do alvo, remover o alvo dos antecessores do
+   // destino. As arestas so liberadas com o alvo, mas os rtulos j aqui
+	ADJ_IniciarIterador(&pAlvo->sucessores, &iterArestas);
+
+	while (ADJ_AvancarIterador(&iterArestas, (void**) &pAresta) == ADJ_CondRetOK)
 	{
-		return GRA_CondRetGrafoNaoFoiCriado;
+      LiberarRotulo(pGrafo, pAresta->rotulo);
+      pAntecessores = pAresta->pVertice->pAntecessores;
+
+      #ifdef _DEBUG
+         LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
+         pGrafo->totalEspacoAlocado -= espacoAlocado;
+      #endif
+
+      LIS_IrParaElemento(pAntecessores, LIS_ProcurarVertice(pAntecessores, &buscado));
+      LIS_ExcluirElemento(pAntecessores);
+      
+      #ifdef _DEBUG
+         LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
+         pGrafo->totalEspacoAlocado += espacoAlocado;
+      #endif
+   }
+
+	// Para cada item da lista de anteressores, remover aresta que aponta para o corrente
+	LIS_NumELementos(pAlvo->pAntecessores,&numElemLista);
+	LIS_IrInicioLista(pAlvo->pAntecessores);
+
+	while(numElemLista > 0)
+	{
+		LIS_ObterValor(pAlvo->pAntecessores,(void**)&pVertice);
+      
+      #ifdef _DEBUG
+         pGrafo->totalEspacoAlocado -= ADJ_EspacoAlocado(&pVertice->sucessores);
+      #endif
+
+      posicao = PosicaoDaArestaPara(pVertice, pAlvo);
+      if (posicao >= 0)
+      {
+         pAresta = (tpAresta*) ADJ_ObterValor(&pVertice->sucessores, posicao);
+
+         CNJ_Retirar(pVertice->pDestinos, pAlvo->id);
+         DesagruparAresta(pGrafo, pVertice, pAresta);
+         ADJ_Retirar(&pVertice->sucessores, posicao);
+         LiberarRotulo(pGrafo, pAresta->rotulo);
+         DestruirAresta(pAresta);
+      }
+      
+      #ifdef _DEBUG
+         pGrafo->totalEspacoAlocado += ADJ_EspacoAlocado(&pVertice->sucessores);
+      #endif
+
+		LIS_AvancarElementoCorrente(pAlvo->pAntecessores,1);
+		numElemLista--;
 	}
 
-	pGrafo = (tpGrafo*) pGrafoParm;
+   
+   RetirarDasVisoes(pGrafo, pAlvo);
+   RetirarDosPercursos(pGrafo, pAlvo);
+   if (pGrafo->vtOrdemTopologica != NULL)
+   {
+      pGrafo->vtOrdemTopologica[pAlvo->posTopologica] = -1;
+   }
+   pGrafo->vtVertices[pAlvo->id] = NULL;
+   if (pGrafo->vtComponentes == NULL || RetirarDosComponentes(pGrafo, pAlvo))
+   {
+      LiberarId(pGrafo, pAlvo->id);
+   }
+   IND_Excluir(pGrafo->pIndiceNomes, pAlvo->nome);
+
+   #ifdef _DEBUG
+      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
+      pGrafo->totalEspacoAlocado -= espacoAlocado;
+   #endif
+
+	//Exclui elemento corrente
+	LIS_IrParaElemento(pGrafo->pVertices, LIS_ProcurarPonteiro(pGrafo->pVertices, pAlvo));
+	LIS_ExcluirElemento(pGrafo->pVertices);
+   
+   #ifdef _DEBUG
+      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
+      pGrafo->totalEspacoAlocado += espacoAlocado;
+   #endif
+
+	pGrafo->pCorrente = pVerticeOrigem;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Atribuir identificador
+*
+*  Descrio:
+*    Atribui ao vrtice um identificador interno denso, reaproveitando
+*    identificadores liberados, e o registra na tabela de vrtices.
+*    Se no h livres e metade dos ids est retida pelos componentes,
+*    recalcula antes os componentes desatualizados, o que os libera.
+*    Retorna 0 se faltou memria para crescer a tabela.
+*
+***********************************************************************/
+int AtribuirId(tpGrafo *pGrafo, tpVertice *pVertice)
+{
+   // Quando metade dos ids est retida, os reclculos pendentes os
+   // devolvem; se faltar memria para eles, o id novo  distribudo
+   if (pGrafo->numIdsLivres == 0 && pGrafo->numIdsRetidos > 0 &&
+       2 * pGrafo->numIdsRetidos >= pGrafo->numIds)
+   {
+      AtualizarComponentes(pGrafo);
+   }
+
+   if (pGrafo->numIdsLivres > 0)
+   {
+      pVertice->id = pGrafo->vtIdsLivres[--pGrafo->numIdsLivres];
+      pGrafo->vtVertices[pVertice->id] = pVertice;
+      return 1;
+   }
+
+   if (pGrafo->numIds == pGrafo->capIds)
+   {
+      int capIds = pGrafo->capIds == 0 ? 16 : pGrafo->capIds * 2;
+      tpVertice **vtVertices;
+      int *vtIdsLivres;
+
+      vtVertices = (tpVertice**) RealocarEspaco(pGrafo->vtVertices,
+                      pGrafo->capIds * sizeof(tpVertice*), capIds * sizeof(tpVertice*));
+      if (vtVertices == NULL)
+      {
+         return 0;
+      }
+      pGrafo->vtVertices = vtVertices;
+
+      // A pilha de livres nunca excede a quantidade de ids distribudos
+      vtIdsLivres = (int*) RealocarEspaco(pGrafo->vtIdsLivres,
+                       pGrafo->capIds * sizeof(int), capIds * sizeof(int));
+      if (vtIdsLivres == NULL)
+      {
+         return 0;
+      }
+      pGrafo->vtIdsLivres = vtIdsLivres;
+
+      pGrafo->capIds = capIds;
+   }
+
+   pVertice->id = pGrafo->numIds++;
+   pGrafo->vtVertices[pVertice->id] = pVertice;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Liberar identificador
+*
+*  Descrio:
+*    Empilha o id, j nulo na tabela de vrtices, para ser reaproveitado.
+*    A marca do id  apagada em todos os marcadores, para que o prximo
+*    vrtice que o receber nasa desmarcado.
+*
+***********************************************************************/
+void LiberarId(tpGrafo *pGrafo, int id)
+{
+   int numMarcadores = 0;
+
+   LIS_NumELementos(pGrafo->pMarcadores, &numMarcadores);
+   LIS_IrInicioLista(pGrafo->pMarcadores);
+
+   while (numMarcadores > 0)
+   {
+      tpMarcador *pMarcador = NULL;
+      LIS_ObterValor(pGrafo->pMarcadores, (void**)&pMarcador);
+
+      if (id < pMarcador->numEpocas)
+      {
+         pMarcador->vtEpocas[id] = 0;
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pMarcadores, 1);
+      numMarcadores--;
+   }
+
+   if (pGrafo->pMarcadorInterno != NULL &&
+       id < pGrafo->pMarcadorInterno->numEpocas)
+   {
+      pGrafo->pMarcadorInterno->vtEpocas[id] = 0;
+   }
+
+   pGrafo->vtIdsLivres[pGrafo->numIdsLivres++] = id;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Pertence  viso
+*
+*  Descrio:
+*    Verifica se o vrtice pertence ao subgrafo induzido pela viso,
+*    consultando o predicado ou o conjunto de bits.
+*
+***********************************************************************/
+int PertenceAVisao(tpVisao *pVisao, tpVertice *pVertice)
+{
+   if (pVisao->pertence != NULL)
+   {
+      return pVisao->pertence(pVertice->nome, pVertice->pValor, pVisao->pContexto);
+   }
+
+   if (pVertice->id / 8 >= pVisao->numBytes)
+   {
+      return 0;
+   }
+
+   return (pVisao->vtBits[pVertice->id / 8] >> (pVertice->id % 8)) & 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Retirar das vises
+*
+*  Descrio:
+*    Retira o vrtice, que est sendo destacado do grafo, de todas as
+*    vises registradas, para que o seu id possa ser reaproveitado.
+*
+***********************************************************************/
+void RetirarDasVisoes(tpGrafo *pGrafo, tpVertice *pVertice)
+{
+   int numVisoes = 0;
+
+   LIS_NumELementos(pGrafo->pVisoes, &numVisoes);
+   LIS_IrInicioLista(pGrafo->pVisoes);
+
+   while (numVisoes > 0)
+   {
+      tpVisao *pVisao = NULL;
+      LIS_ObterValor(pGrafo->pVisoes, (void**)&pVisao);
+
+      if (pVertice->id / 8 < pVisao->numBytes)
+      {
+         pVisao->vtBits[pVertice->id / 8] &= (unsigned char) ~(1 << (pVertice->id % 8));
+      }
+
+      if (pVisao->pCorrente == pVertice)
+      {
+         pVisao->pCorrente = NULL;
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pVisoes, 1);
+      numVisoes--;
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Comparar ponteiros
+*
+*  Descrio:
+*    Funo de comparao por identidade, usada na lista de vises.
+*
+***********************************************************************/
+int CompararPonteiros(void *pVazio1, void *pVazio2)
+{
+   if (pVazio1 == pVazio2)
+   {
+      return 0;
+   }
+
+   return -1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Mesmo ponteiro
+*
+*  Descrio:
+*    Comparao por identidade das buscas especializadas.
+*
+***********************************************************************/
+int MesmoPonteiro(void *pValor, void *pProcurado)
+{
+   return pValor == pProcurado;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Realocar espao
+*
+*  Descrio:
+*    Equivalente a realloc, que no  suportado pelo controle de espao
+*    dinmico usado na verso de depurao. Copia os tamAntigo primeiros
+*    bytes para o novo espao e libera o antigo. Em caso de falta de
+*    memria retorna NULL e o espao antigo permanece vlido.
+*
+***********************************************************************/
+void * RealocarEspaco(void *pEspaco, size_t tamAntigo, size_t tamNovo)
+{
+   void *pNovo = malloc(tamNovo);
+   if (pNovo == NULL)
+   {
+      return NULL;
+   }
+
+   if (pEspaco != NULL)
+   {
+      memcpy(pNovo, pEspaco, tamAntigo < tamNovo ? tamAntigo : tamNovo);
+      free(pEspaco);
+   }
+
+   return pNovo;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Criar marcador
+*
+*  Descrio:
+*    Cria um marcador sem registr-lo no grafo, com todos os vrtices
+*    desmarcados. O vetor de pocas  criado sob demanda.
+*
+***********************************************************************/
+GRA_tpCondRet CriarMarcador(tpGrafo *pGrafo, tpMarcador **ppMarcador)
+{
+   tpMarcador *pMarcador = (tpMarcador*) malloc(sizeof(tpMarcador));
+   if (pMarcador == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   pMarcador->pGrafo = pGrafo;
+   pMarcador->vtEpocas = NULL;
+   pMarcador->numEpocas = 0;
+   pMarcador->epocaCorrente = 1;
+
+   *ppMarcador = pMarcador;
+
+   return GRA_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Destruir marcador
+*
+***********************************************************************/
+void DestruirMarcador(tpMarcador *pMarcador)
+{
+   free(pMarcador->vtEpocas);
+   free(pMarcador);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Reiniciar marcador
+*
+*  Descrio:
+*    Avana a poca, desmarcando todos os vrtices. Somente quando o
+*    contador de pocas d a volta o vetor  zerado.
+*
+***********************************************************************/
+void ReiniciarMarcador(tpMarcador *pMarcador)
+{
+   pMarcador->epocaCorrente++;
+
+   if (pMarcador->epocaCorrente == 0)
+   {
+      if (pMarcador->vtEpocas != NULL)
+      {
+         memset(pMarcador->vtEpocas, 0, pMarcador->numEpocas * sizeof(unsigned int));
+      }
+      pMarcador->epocaCorrente = 1;
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Marcar
+*
+*  Descrio:
+*    Marca o vrtice na poca corrente. Se o vetor de pocas no cobre o
+*    id do vrtice, ele  crescido at a capacidade da tabela de ids do
+*    grafo. Retorna 0 se faltou memria.
+*
+***********************************************************************/
+int Marcar(tpMarcador *pMarcador, tpVertice *pVertice)
+{
+   if (pVertice->id >= pMarcador->numEpocas)
+   {
+      int numEpocas = pMarcador->pGrafo->capIds;
+      unsigned int *vtEpocas;
+
+      vtEpocas = (unsigned int*) RealocarEspaco(pMarcador->vtEpocas,
+                    pMarcador->numEpocas * sizeof(unsigned int), numEpocas * sizeof(unsigned int));
+      if (vtEpocas == NULL)
+      {
+         return 0;
+      }
+
+      memset(vtEpocas + pMarcador->numEpocas, 0,
+             (numEpocas - pMarcador->numEpocas) * sizeof(unsigned int));
+
+      pMarcador->vtEpocas = vtEpocas;
+      pMarcador->numEpocas = numEpocas;
+   }
+
+   pMarcador->vtEpocas[pVertice->id] = pMarcador->epocaCorrente;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Est marcado
+*
+***********************************************************************/
+int EstaMarcado(tpMarcador *pMarcador, tpVertice *pVertice)
+{
+   return pVertice->id < pMarcador->numEpocas &&
+          pMarcador->vtEpocas[pVertice->id] == pMarcador->epocaCorrente;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Obter marcador de percurso
+*
+*  Descrio:
+*    Fornece, j reiniciado, o marcador interno do grafo, criando-o na
+*    primeira vez. Se ele estiver em uso por um percurso que chamou
+*    outro percurso de dentro da funo de visita, cria um marcador
+*    temporrio. Retorna NULL se faltou memria.
+*
+***********************************************************************/
+tpMarcador * ObterMarcadorDePercurso(tpGrafo *pGrafo)
+{
+   tpMarcador *pMarcador = NULL;
+
+   if (pGrafo->marcadorInternoEmUso)
+   {
+      CriarMarcador(pGrafo, &pMarcador);
+      return pMarcador;
+   }
+
+   if (pGrafo->pMarcadorInterno == NULL &&
+       CriarMarcador(pGrafo, &pGrafo->pMarcadorInterno) != GRA_CondRetOK)
+   {
+      return NULL;
+   }
+
+   ReiniciarMarcador(pGrafo->pMarcadorInterno);
+   pGrafo->marcadorInternoEmUso = 1;
+
+   return pGrafo->pMarcadorInterno;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Devolver marcador de percurso
+*
+*  Descrio:
+*    Encerra o uso de um marcador obtido com ObterMarcadorDePercurso,
+*    destruindo-o se for temporrio. NULL  ignorado.
+*
+***********************************************************************/
+void DevolverMarcadorDePercurso(tpGrafo *pGrafo, tpMarcador *pMarcador)
+{
+   if (pMarcador == NULL)
+   {
+      return;
+   }
+
+   if (pMarcador == pGrafo->pMarcadorInterno)
+   {
+      pGrafo->marcadorInternoEmUso = 0;
+      return;
+   }
+
+   DestruirMarcador(pMarcador);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Calcular ordem
+*
+*  Descrio:
+*    Preenche vtOrdem com todos os vrtices do grafo na ordem pedida.
+*    Retorna 0 se faltou memria.
+*
+***********************************************************************/
+int CalcularOrdem(tpGrafo *pGrafo, GRA_tpOrdem ordem, tpVertice **vtOrdem, int numVertices)
+{
+   unsigned char *vtVisitado;
+   int i, ok;
+
+   if (ordem == GRA_OrdemGrau)
+   {
+      LIS_IrInicioLista(pGrafo->pVertices);
+      for (i = 0; i < numVertices; i++)
+      {
+         LIS_ObterValor(pGrafo->pVertices, (void**)&vtOrdem[i]);
+         LIS_AvancarElementoCorrente(pGrafo->pVertices, 1);
+      }
+
+      qsort(vtOrdem, numVertices, sizeof(tpVertice*), CompararGrauDecrescente);
+      return 1;
+   }
+
+   vtVisitado = (unsigned char*) malloc(pGrafo->numIds);
+   if (vtVisitado == NULL)
+   {
+      return 0;
+   }
+   memset(vtVisitado, 0, pGrafo->numIds);
+
+   ok = OrdenarEmLargura(pGrafo, ordem, vtOrdem, numVertices, vtVisitado);
+
+   free(vtVisitado);
+
+   return ok;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Ordenar em largura
+*
+*  Descrio:
+*    Percorre em largura usando o prprio vtOrdem como fila.
+*
+*    Em GRA_OrdemLargura as sementes so as origens e depois os vrtices
+*    ainda no alcanados, na ordem da lista de vrtices, e apenas os
+*    sucessores so seguidos.
+*
+*    Em GRA_OrdemCuthillMcKeeReversa as arestas so seguidas nos dois
+*    sentidos, cada componente comea pelo vrtice de menor grau ainda
+*    no alcanado, os vizinhos de cada vrtice entram na fila em ordem
+*    crescente de grau e a ordem final  invertida.
+*
+***********************************************************************/
+int OrdenarEmLargura(tpGrafo *pGrafo, GRA_tpOrdem ordem, tpVertice **vtOrdem,
+   int numVertices, unsigned char *vtVisitado)
+{
+   tpVertice **vtSementes;
+   int numSementes = 0, numOrigens = 0;
+   int inicioFila = 0, fimFila = 0, i;
+
+   vtSementes = (tpVertice**) malloc(numVertices * 2 * sizeof(tpVertice*));
+   if (vtSementes == NULL)
+   {
+      return 0;
+   }
+
+   if (ordem == GRA_OrdemLargura)
+   {
+      LIS_NumELementos(pGrafo->pOrigens, &numOrigens);
+      LIS_IrInicioLista(pGrafo->pOrigens);
+      while (numOrigens > 0)
+      {
+         LIS_ObterValor(pGrafo->pOrigens, (void**)&vtSementes[numSementes++]);
+         LIS_AvancarElementoCorrente(pGrafo->pOrigens, 1);
+         numOrigens--;
+      }
+   }
+
+   LIS_IrInicioLista(pGrafo->pVertices);
+   for (i = 0; i < numVertices; i++)
+   {
+      LIS_ObterValor(pGrafo->pVertices, (void**)&vtSementes[numSementes++]);
+      LIS_AvancarElementoCorrente(pGrafo->pVertices, 1);
+   }
+
+   if (ordem == GRA_OrdemCuthillMcKeeReversa)
+   {
+      qsort(vtSementes, numSementes, sizeof(tpVertice*), CompararGrauCrescente);
+   }
+
+   for (i = 0; i < numSementes; i++)
+   {
+      if (vtVisitado[vtSementes[i]->id])
+      {
+         continue;
+      }
+
+      vtVisitado[vtSementes[i]->id] = 1;
+      vtOrdem[fimFila++] = vtSementes[i];
+
+      while (inicioFila < fimFila)
+      {
+         tpVertice *pVertice = vtOrdem[inicioFila++];
+         int inicioVizinhos = fimFila;
+         int numAntecessores = 0;
+         tpAresta *pAresta = NULL;
+         ADJ_tpIterador iterArestas;
+
+         ADJ_IniciarIterador(&pVertice->sucessores, &iterArestas);
+         while (ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+         {
+            if (!vtVisitado[pAresta->pVertice->id])
+            {
+               vtVisitado[pAresta->pVertice->id] = 1;
+               vtOrdem[fimFila++] = pAresta->pVertice;
+            }
+         }
+
+         if (ordem == GRA_OrdemCuthillMcKeeReversa)
+         {
+            LIS_NumELementos(pVertice->pAntecessores, &numAntecessores);
+            LIS_IrInicioLista(pVertice->pAntecessores);
+            while (numAntecessores > 0)
+            {
+               tpVertice *pAntecessor = NULL;
+               LIS_ObterValor(pVertice->pAntecessores, (void**)&pAntecessor);
+
+               if (!vtVisitado[pAntecessor->id])
+               {
+                  vtVisitado[pAntecessor->id] = 1;
+                  vtOrdem[fimFila++] = pAntecessor;
+               }
+
+               LIS_AvancarElementoCorrente(pVertice->pAntecessores, 1);
+               numAntecessores--;
+            }
+
+            qsort(vtOrdem + inicioVizinhos, fimFila - inicioVizinhos, sizeof(tpVertice*),
+                  CompararGrauCrescente);
+         }
+      }
+   }
+
+   if (ordem == GRA_OrdemCuthillMcKeeReversa)
+   {
+      for (i = 0; i < numVertices / 2; i++)
+      {
+         tpVertice *pTroca = vtOrdem[i];
+         vtOrdem[i] = vtOrdem[numVertices - 1 - i];
+         vtOrdem[numVertices - 1 - i] = pTroca;
+      }
+   }
+
+   free(vtSementes);
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Grau do vrtice
+*
+*  Descrio:
+*    Quantidade de sucessores mais quantidade de antecessores.
+*
+***********************************************************************/
+int GrauDoVertice(tpVertice *pVertice)
+{
+   int numSucessores = 0, numAntecessores = 0;
+
+   numSucessores = ADJ_NumElementos(&pVertice->sucessores);
+   LIS_NumELementos(pVertice->pAntecessores, &numAntecessores);
+
+   return numSucessores + numAntecessores;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Comparar grau crescente
+*
+*  Descrio:
+*    Comparao para qsort de vetores de ponteiros para vrtices.
+*    Empates so desfeitos pelo id, para que a ordem seja determinstica.
+*
+***********************************************************************/
+int CompararGrauCrescente(const void *pVazio1, const void *pVazio2)
+{
+   tpVertice *pVertice1 = *(tpVertice* const*) pVazio1;
+   tpVertice *pVertice2 = *(tpVertice* const*) pVazio2;
+   int grau1 = GrauDoVertice(pVertice1);
+   int grau2 = GrauDoVertice(pVertice2);
+
+   if (grau1 != grau2)
+   {
+      return grau1 < grau2 ? -1 : 1;
+   }
+
+   return pVertice1->id - pVertice2->id;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Comparar grau decrescente
+*
+***********************************************************************/
+int CompararGrauDecrescente(const void *pVazio1, const void *pVazio2)
+{
+   tpVertice *pVertice1 = *(tpVertice* const*) pVazio1;
+   tpVertice *pVertice2 = *(tpVertice* const*) pVazio2;
+   int grau1 = GrauDoVertice(pVertice1);
+   int grau2 = GrauDoVertice(pVertice2);
+
+   if (grau1 != grau2)
+   {
+      return grau1 > grau2 ? -1 : 1;
+   }
+
+   return pVertice1->id - pVertice2->id;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Cobrir identificadores
+*
+*  Descrio:
+*    Garante que os conjuntos de bits das vises e os vetores de pocas
+*    dos marcadores j usados cobrem todos os ids da tabela, para que a
+*    renumerao no precise alocar. Retorna 0 se faltou memria; o que
+*    j tiver crescido permanece vlido.
+*
+***********************************************************************/
+int CobrirIds(tpGrafo *pGrafo)
+{
+   int numVisoes = 0, numMarcadores = 0;
+   int numBytes = pGrafo->capIds / 8 + 1;
+   tpVertice vertice;
+
+   LIS_NumELementos(pGrafo->pVisoes, &numVisoes);
+   LIS_IrInicioLista(pGrafo->pVisoes);
+   while (numVisoes > 0)
+   {
+      tpVisao *pVisao = NULL;
+      LIS_ObterValor(pGrafo->pVisoes, (void**)&pVisao);
+
+      if (pVisao->vtBits != NULL && pVisao->numBytes < numBytes)
+      {
+         unsigned char *vtBits = (unsigned char*) RealocarEspaco(pVisao->vtBits,
+                                    pVisao->numBytes, numBytes);
+         if (vtBits == NULL)
+         {
+            return 0;
+         }
+         memset(vtBits + pVisao->numBytes, 0, numBytes - pVisao->numBytes);
+         pVisao->vtBits = vtBits;
+         pVisao->numBytes = numBytes;
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pVisoes, 1);
+      numVisoes--;
+   }
+
+   // Marcar o maior id possvel faz o vetor crescer at capIds
+   vertice.id = pGrafo->capIds - 1;
+
+   LIS_NumELementos(pGrafo->pMarcadores, &numMarcadores);
+   LIS_IrInicioLista(pGrafo->pMarcadores);
+   while (numMarcadores > 0)
+   {
+      tpMarcador *pMarcador = NULL;
+      LIS_ObterValor(pGrafo->pMarcadores, (void**)&pMarcador);
+
+      if (pMarcador->vtEpocas != NULL && pMarcador->numEpocas < pGrafo->capIds)
+      {
+         if (!Marcar(pMarcador, &vertice))
+         {
+            return 0;
+         }
+         pMarcador->vtEpocas[vertice.id] = 0;
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pMarcadores, 1);
+      numMarcadores--;
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Copiar em ordem
+*
+*  Descrio:
+*    Aloca, na ordem de vtOrdem, uma cpia de cada vrtice seguida das
+*    cpias das suas arestas, e depois refaz as listas de antecessores.
+*    As cpias no tm grupos por rtulo.
+*    As cpias recebem os ids da nova ordem e compartilham nomes longos
+*    e valores com os originais, que no so alterados; os nomes curtos
+*    vo copiados dentro dos registros.
+*    vtNovos, indexado pelo id antigo, recebe a cpia de cada vrtice.
+*    Se faltar memria, desfaz todas as cpias e retorna 0.
+*
+***********************************************************************/
+int CopiarEmOrdem(tpVertice **vtOrdem, int numVertices, tpVertice **vtNovos,
+                  size_t tamValor)
+{
+   tpAresta *pAresta = NULL;
+   ADJ_tpIterador iterArestas;
+   int i;
+
+   for (i = 0; i < numVertices; i++)
+   {
+      tpVertice *pAntigo = vtOrdem[i];
+      tpVertice *pNovo;
+
+      pNovo = (tpVertice*) malloc(sizeof(tpVertice) + tamValor);
+      if (pNovo == NULL)
+      {
+         DescartarCopias(vtOrdem, i, vtNovos);
+         return 0;
+      }
+
+      memcpy(pNovo, pAntigo, sizeof(tpVertice) + tamValor);
+      if (pAntigo->nome == pAntigo->nomeCurto)
+      {
+         pNovo->nome = pNovo->nomeCurto;
+      }
+      if (tamValor != 0)
+      {
+         pNovo->pValor = pNovo + 1;
+      }
+      pNovo->id = i;
+      ADJ_Iniciar(&pNovo->sucessores);
+      ADJ_Iniciar(&pNovo->gruposRotulo);
+      pNovo->pAntecessores = NULL;
+      pNovo->pDestinos = NULL;
+      vtNovos[pAntigo->id] = pNovo;
+
+      #ifdef _DEBUG
+         CED_DefinirTipoEspaco(pNovo, GRA_TipoEspacoVertice);
+         CED_MarcarEspacoAtivo(pNovo);
+         pNovo->pGrafo->totalEspacoAlocado += _msize(pNovo);
+      #endif
+
+      if (LIS_CriarLista(&pNovo->pAntecessores, NULL, CompararVerticeENome) != LIS_CondRetOK)
+      {
+         DescartarCopias(vtOrdem, i + 1, vtNovos);
+         return 0;
+      }
+
+      ADJ_IniciarIterador(&pAntigo->sucessores, &iterArestas);
+      while (ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         tpAresta *pNovaAresta;
+
+         pNovaAresta = (tpAresta*) malloc(sizeof(tpAresta));
+         if (pNovaAresta == NULL)
+         {
+            DescartarCopias(vtOrdem, i + 1, vtNovos);
+            return 0;
+         }
+
+         // O destino ainda  o vrtice antigo;  trocado na segunda passada
+         memcpy(pNovaAresta, pAresta, sizeof(tpAresta));
+         if (pAresta->nome == pAresta->nomeCurto)
+         {
+            pNovaAresta->nome = pNovaAresta->nomeCurto;
+         }
+
+         if (ADJ_Acrescentar(&pNovo->sucessores, pNovaAresta,
+                             EspalharNome(pNovaAresta->nome, pNovaAresta->tamNome)) != ADJ_CondRetOK)
+         {
+            free(pNovaAresta);
+            DescartarCopias(vtOrdem, i + 1, vtNovos);
+            return 0;
+         }
+
+         #ifdef _DEBUG
+            CED_DefinirTipoEspaco(pNovaAresta, GRA_TipoEspacoAresta);
+            CED_MarcarEspacoAtivo(pNovaAresta);
+            pNovaAresta->pGrafo->totalEspacoAlocado += _msize(pNovaAresta);
+         #endif
+      }
+   }
+
+   for (i = 0; i < numVertices; i++)
+   {
+      tpVertice *pNovo = vtNovos[vtOrdem[i]->id];
+
+      ADJ_IniciarIterador(&pNovo->sucessores, &iterArestas);
+      while (ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         pAresta->pVertice = vtNovos[pAresta->pVertice->id];
+         if (LIS_InserirElementoApos(pAresta->pVertice->pAntecessores, pNovo) != LIS_CondRetOK ||
+             CNJ_Acrescentar(&pNovo->pDestinos, pAresta->pVertice->id) != CNJ_CondRetOK)
+         {
+            DescartarCopias(vtOrdem, numVertices, vtNovos);
+            return 0;
+         }
+      }
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Descartar cpias
+*
+*  Descrio:
+*    Libera as cpias dos numCopias primeiros vrtices de vtOrdem, sem
+*    tocar nos nomes e valores, que pertencem aos originais.
+*
+***********************************************************************/
+void DescartarCopias(tpVertice **vtOrdem, int numCopias, tpVertice **vtNovos)
+{
+   int i;
+
+   for (i = 0; i < numCopias; i++)
+   {
+      LiberarCasca(vtNovos[vtOrdem[i]->id]);
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Liberar casca
+*
+*  Descrio:
+*    Libera o vrtice, as suas listas, o ndice de destinos, os grupos
+*    por rtulo e as suas arestas, mas no os nomes nem o valor, que
+*    passaram a pertencer a outra cpia do vrtice.
+*
+***********************************************************************/
+void LiberarCasca(tpVertice *pVertice)
+{
+   tpAresta *pAresta = NULL;
+   ADJ_tpIterador iterArestas;
+
+   ADJ_IniciarIterador(&pVertice->sucessores, &iterArestas);
+   while (ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+   {
+      pAresta->nome = NULL;
+   }
+   ADJ_Esvaziar(&pVertice->sucessores, DestruirAresta);
+
+   if (pVertice->pAntecessores != NULL)
+   {
+      LIS_DestruirLista(pVertice->pAntecessores);
+   }
+
+   CNJ_Destruir(pVertice->pDestinos);
+   ADJ_Esvaziar(&pVertice->gruposRotulo, DestruirGrupoRotulo);
+
+   #ifdef _DEBUG
+      pVertice->pGrafo->totalEspacoAlocado -= _msize(pVertice);
+   #endif
+
+   free(pVertice);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Renumerar auxiliares
+*
+*  Descrio:
+*    Leva para os novos ids o contedo das vises, dos marcadores, dos
+*    percursos e da ordem topolgica e troca os correntes pelas cpias.
+*    Usa vtRascunho, com ao menos numIds posies, para guardar o
+*    contedo antigo. No aloca memria.
+*
+***********************************************************************/
+void RenumerarAuxiliares(tpGrafo *pGrafo, tpVertice **vtNovos, unsigned int *vtRascunho)
+{
+   int numVisoes = 0, numMarcadores = 0, numPercursos = 0, id, i;
+
+   LIS_NumELementos(pGrafo->pVisoes, &numVisoes);
+   LIS_IrInicioLista(pGrafo->pVisoes);
+   while (numVisoes > 0)
+   {
+      tpVisao *pVisao = NULL;
+      LIS_ObterValor(pGrafo->pVisoes, (void**)&pVisao);
+
+      if (pVisao->pCorrente != NULL)
+      {
+         pVisao->pCorrente = vtNovos[pVisao->pCorrente->id];
+      }
+
+      if (pVisao->vtBits != NULL)
+      {
+         for (id = 0; id < pGrafo->numIds; id++)
+         {
+            vtRascunho[id] = (pVisao->vtBits[id / 8] >> (id % 8)) & 1;
+         }
+
+         memset(pVisao->vtBits, 0, pVisao->numBytes);
+
+         for (id = 0; id < pGrafo->numIds; id++)
+         {
+            if (vtRascunho[id] && pGrafo->vtVertices[id] != NULL)
+            {
+               int novoId = vtNovos[id]->id;
+               pVisao->vtBits[novoId / 8] |= (unsigned char) (1 << (novoId % 8));
+            }
+         }
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pVisoes, 1);
+      numVisoes--;
+   }
+
+   LIS_NumELementos(pGrafo->pMarcadores, &numMarcadores);
+   LIS_IrInicioLista(pGrafo->pMarcadores);
+   while (numMarcadores > 0)
+   {
+      tpMarcador *pMarcador = NULL;
+      LIS_ObterValor(pGrafo->pMarcadores, (void**)&pMarcador);
+
+      if (pMarcador->vtEpocas != NULL)
+      {
+         memcpy(vtRascunho, pMarcador->vtEpocas, pGrafo->numIds * sizeof(unsigned int));
+         memset(pMarcador->vtEpocas, 0, pMarcador->numEpocas * sizeof(unsigned int));
+
+         for (id = 0; id < pGrafo->numIds; id++)
+         {
+            if (pGrafo->vtVertices[id] != NULL)
+            {
+               pMarcador->vtEpocas[vtNovos[id]->id] = vtRascunho[id];
+            }
+         }
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pMarcadores, 1);
+      numMarcadores--;
+   }
+
+   // O marcador interno  sempre reiniciado antes de usado
+   if (pGrafo->pMarcadorInterno != NULL)
+   {
+      ReiniciarMarcador(pGrafo->pMarcadorInterno);
+   }
+
+   // Os marcadores dos percursos j foram renumerados acima; falta a fronteira
+   LIS_NumELementos(pGrafo->pPercursos, &numPercursos);
+   LIS_IrInicioLista(pGrafo->pPercursos);
+   while (numPercursos > 0)
+   {
+      tpPercurso *pPercurso = NULL;
+      LIS_ObterValor(pGrafo->pPercursos, (void**)&pPercurso);
+
+      for (i = pPercurso->inicio; i < pPercurso->fim; i++)
+      {
+         if (pPercurso->vtFronteira[i] >= 0)
+         {
+            pPercurso->vtFronteira[i] = vtNovos[pPercurso->vtFronteira[i]]->id;
+         }
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pPercursos, 1);
+      numPercursos--;
+   }
+
+   // Os componentes so descartados e montados de novo na prxima consulta
+   free(pGrafo->vtComponentes);
+   free(pGrafo->vtDesatualizados);
+   pGrafo->vtComponentes = NULL;
+   pGrafo->vtDesatualizados = NULL;
+   pGrafo->capComponentes = 0;
+   pGrafo->numDesatualizados = 0;
+   pGrafo->numIdsRetidos = 0;
+
+   // As distncias aos marcos tambm, por serem indexadas pelos ids
+   DescartarMarcos(pGrafo);
+
+   // As posies so copiadas com os vrtices; s os ids mudam
+   if (pGrafo->vtOrdemTopologica != NULL)
+   {
+      for (i = 0; i < pGrafo->numPosicoesTopologicas; i++)
+      {
+         if (pGrafo->vtOrdemTopologica[i] >= 0)
+         {
+            pGrafo->vtOrdemTopologica[i] = vtNovos[pGrafo->vtOrdemTopologica[i]]->id;
+         }
+      }
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Alinhar
+*
+*  Descrio:
+*    Arredonda o tamanho para mltiplo de 8 bytes, para que todos os
+*    blocos da cpia compartilhada fiquem alinhados.
+*
+***********************************************************************/
+size_t Alinhar(size_t tamanho)
+{
+   return (tamanho + 7) & ~(size_t) 7;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Acrescentar ao vetor
+*
+*  Descrio:
+*    Visita do ndice de nomes que acrescenta o vrtice ao vetor em
+*    preenchimento dado como contexto.
+*
+***********************************************************************/
+int AcrescentarAoVetor(const char *nome, void *pVazio, void *pContexto)
+{
+   tpVetorEmPreenchimento *pVetor = (tpVetorEmPreenchimento*) pContexto;
+
+   (void) nome;
+   pVetor->vtVertices[pVetor->numVertices++] = (tpVertice*) pVazio;
+
+   return 0;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Montar cpia compartilhada
+*
+*  Descrio:
+*    Grava a cpia no espao dado, que tem exatamente o tamanho medido
+*    por GRA_PublicarMemoriaCompartilhada e est zerado. vtPorNome tem os
+*    vrtices ordenados por nome e vtIndices, indexado pelo id, o ndice
+*    de cada vrtice na cpia. A assinatura  gravada por ltimo.
+*
+***********************************************************************/
+void MontarCopiaCompartilhada(tpGrafo *pGrafo, char *pBase, size_t tamanho,
+   size_t (*tamanhoValor)(void *pValor), tpVertice **vtPorNome, int *vtIndices)
+{
+   tpCabecaCompartilhada *pCabeca = (tpCabecaCompartilhada*) pBase;
+   tpVerticeCompartilhado *vtVertices;
+   tpArestaCompartilhada *vtArestas;
+   int *vtIndiceNomes;
+   int numVertices = 0, numArestas = 0, i;
+   size_t desLivre;
+   LIS_tpIterador iterVertices;
+
+   LIS_NumELementos(pGrafo->pVertices, &numVertices);
+   LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
+   for (i = 0; i < numVertices; i++)
+   {
+      tpVertice *pVertice = NULL;
+      int numSucessores = 0;
+
+      LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
+      numSucessores = ADJ_NumElementos(&pVertice->sucessores);
+      numArestas += numSucessores;
+   }
+
+   pCabeca->tamanho = tamanho;
+   pCabeca->numVertices = numVertices;
+   pCabeca->numArestas = numArestas;
+   pCabeca->desVertices = Alinhar(sizeof(tpCabecaCompartilhada));
+   pCabeca->desArestas = pCabeca->desVertices + Alinhar(numVertices * sizeof(tpVerticeCompartilhado));
+   pCabeca->desIndiceNomes = pCabeca->desArestas + Alinhar(numArestas * sizeof(tpArestaCompartilhada));
+   desLivre = pCabeca->desIndiceNomes + Alinhar(numVertices * sizeof(int));
+
+   vtVertices = (tpVerticeCompartilhado*) (pBase + pCabeca->desVertices);
+   vtArestas = (tpArestaCompartilhada*) (pBase + pCabeca->desArestas);
+   vtIndiceNomes = (int*) (pBase + pCabeca->desIndiceNomes);
+
+   numArestas = 0;
+   LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
+   for (i = 0; i < numVertices; i++)
+   {
+      tpVertice *pVertice = NULL;
+      tpVerticeCompartilhado *pCopia = &vtVertices[i];
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterArestas;
+
+      LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
+
+      pCopia->desNome = desLivre;
+      memcpy(pBase + desLivre, pVertice->nome, pVertice->tamNome + 1);
+      desLivre += Alinhar(pVertice->tamNome + 1);
+
+      if (tamanhoValor != NULL && pVertice->pValor != NULL)
+      {
+         size_t tamValor = tamanhoValor(pVertice->pValor);
+         pCopia->desValor = desLivre;
+         memcpy(pBase + desLivre, pVertice->pValor, tamValor);
+         desLivre += Alinhar(tamValor);
+      }
+
+      pCopia->primeiraAresta = numArestas;
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterArestas);
+      while (ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         vtArestas[numArestas].desNome = desLivre;
+         vtArestas[numArestas].destino = vtIndices[pAresta->pVertice->id];
+         memcpy(pBase + desLivre, pAresta->nome, pAresta->tamNome + 1);
+         desLivre += Alinhar(pAresta->tamNome + 1);
+         numArestas++;
+      }
+      pCopia->numArestas = numArestas - pCopia->primeiraAresta;
+   }
+
+   for (i = 0; i < numVertices; i++)
+   {
+      vtIndiceNomes[i] = vtIndices[vtPorNome[i]->id];
+   }
+
+   memcpy(pCabeca->assinatura, ASSINATURA_COMPARTILHADA, sizeof(pCabeca->assinatura));
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Procurar compartilhado
+*
+*  Descrio:
+*    Busca binria no ndice de nomes da cpia. Retorna o ndice do
+*    vrtice ou -1 se no existir.
+*
+***********************************************************************/
+int ProcurarCompartilhado(tpGrafoCompartilhado *pGrafo, const char *nome)
+{
+   const int *vtIndiceNomes = (const int*) (pGrafo->pBase + pGrafo->pCabeca->desIndiceNomes);
+   int inicio = 0, fim = pGrafo->pCabeca->numVertices - 1;
+
+   while (inicio <= fim)
+   {
+      int meio = inicio + (fim - inicio) / 2;
+      int indice = vtIndiceNomes[meio];
+      int comparacao = strcmp(nome, pGrafo->pBase + pGrafo->vtVertices[indice].desNome);
+
+      if (comparacao == 0)
+      {
+         return indice;
+      }
+
+      if (comparacao < 0)
+      {
+         fim = meio - 1;
+      }
+      else
+      {
+         inicio = meio + 1;
+      }
+   }
+
+   return -1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Registrar mutao
+*
+*  Descrio:
+*    Chamada pelas funes que alteram o grafo depois que a alterao
+*    foi feita. Num grafo persistente acrescenta o registro ao log e,
+*    se o log passou do limite, grava um ponto de controle. Tambm
+*    avisa as assinaturas e, se as arestas mudaram, descarta as
+*    distncias aos marcos.
+*
+***********************************************************************/
+GRA_tpCondRet RegistrarMutacao(tpGrafo *pGrafo, tpTipoRegistro tipo,
+   const char *nome1, const char *nome2, const char *nome3, void *pValor)
+{
+   tpPersistencia *pPersistencia = pGrafo->pPersistencia;
+   WAL_tpCondRet walCondRet;
+
+   if (pGrafo->numAssinaturas > 0)
+   {
+      NotificarAssinaturas(pGrafo, tipo, nome1, nome2, nome3);
+   }
+
+   // Um vrtice novo no muda as distncias; ele ainda no tem arestas
+   if (tipo == GRA_RegistroInserirAresta || tipo == GRA_RegistroDestruirAresta ||
+       tipo == GRA_RegistroDestruirVertice)
+   {
+      DescartarMarcos(pGrafo);
+   }
+
+   if (pPersistencia == NULL)
+   {
+      return GRA_CondRetOK;
+   }
+
+   walCondRet = GravarRegistro(pPersistencia->pLog, pPersistencia->tamanhoValor,
+                               tipo, nome1, nome2, nome3, pValor);
+   if (walCondRet != WAL_CondRetOK)
+   {
+      return TraduzirCondRetLog(walCondRet);
+   }
+
+   if (pPersistencia->bytesParaPontoDeControle > 0 &&
+       WAL_ObterTamanho(pPersistencia->pLog) >= pPersistencia->bytesParaPontoDeControle)
+   {
+      return GravarPontoDeControle(pGrafo);
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Gravar registro
+*
+*  Descrio:
+*    Acrescenta ao log um registro com os nomes no nulos, gravados com
+*    o terminador, seguidos do valor nos registros que o tm.
+*
+***********************************************************************/
+WAL_tpCondRet GravarRegistro(WAL_tppLog pLog, size_t (*tamanhoValor)(void *pValor),
+   tpTipoRegistro tipo, const char *nome1, const char *nome2, const char *nome3, void *pValor)
+{
+   const void *vtCampos[WAL_MAX_CAMPOS];
+   size_t vtTamanhos[WAL_MAX_CAMPOS];
+   const char *vtNomes[3];
+   int numCampos = 0, i;
+
+   vtNomes[0] = nome1;
+   vtNomes[1] = nome2;
+   vtNomes[2] = nome3;
+
+   for (i = 0; i < 3 && vtNomes[i] != NULL; i++)
+   {
+      vtCampos[numCampos] = vtNomes[i];
+      vtTamanhos[numCampos] = strlen(vtNomes[i]) + 1;
+      numCampos++;
+   }
+
+   if (tipo == GRA_RegistroInserirVertice || tipo == GRA_RegistroAlterarValor)
+   {
+      vtCampos[numCampos] = pValor;
+      vtTamanhos[numCampos] = (pValor != NULL && tamanhoValor != NULL) ? tamanhoValor(pValor) : 0;
+      numCampos++;
+   }
+
+   return WAL_Acrescentar(pLog, (unsigned char) tipo, numCampos, vtCampos, vtTamanhos);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Gravar ponto de controle
+*
+*  Descrio:
+*    Grava o grafo inteiro num arquivo temporrio, como a sequncia de
+*    inseres que o reconstri, e o pe no lugar do ponto de controle
+*    anterior de forma atmica. S ento esvazia o log. Uma queda entre
+*    a troca e o esvaziamento no duplica mutaes na recuperao,
+*    porque o ponto de controle guarda o ltimo LSN que ele cobre.
+*
+***********************************************************************/
+GRA_tpCondRet GravarPontoDeControle(tpGrafo *pGrafo)
+{
+   tpPersistencia *pPersistencia = pGrafo->pPersistencia;
+   WAL_tppLog pPonto = NULL;
+   WAL_tpCondRet walCondRet;
+   WAL_tpLsn lsn = WAL_ObterUltimoLsn(pPersistencia->pLog);
+   unsigned char vtLsn[8];
+   const void *pCampoLsn = vtLsn;
+   size_t tamCampoLsn = sizeof(vtLsn);
+   char *caminhoTemporario, *caminhoPonto;
+   tpVertice *pVertice = NULL;
+   LIS_tpIterador iterVertices;
+   int i;
+
+   caminhoTemporario = MontarCaminho(pPersistencia->caminhoBase, SUFIXO_TEMPORARIO);
+   caminhoPonto = MontarCaminho(pPersistencia->caminhoBase, SUFIXO_PONTO_DE_CONTROLE);
+   if (caminhoTemporario == NULL || caminhoPonto == NULL)
+   {
+      free(caminhoTemporario);
+      free(caminhoPonto);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   walCondRet = WAL_Criar(caminhoTemporario, &pPonto);
+   if (walCondRet == WAL_CondRetOK)
+   {
+      // Todo o ponto de controle  sincronizado uma nica vez, ao fechar
+      WAL_DefinirGrupo(pPonto, INT_MAX);
+
+      for (i = 0; i < 8; i++)
+      {
+         vtLsn[i] = (unsigned char) (lsn >> (8 * i));
+      }
+      walCondRet = WAL_Acrescentar(pPonto, GRA_RegistroPontoDeControle, 1, &pCampoLsn, &tamCampoLsn);
+   }
+
+   LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
+   while (walCondRet == WAL_CondRetOK &&
+          LIS_AvancarIterador(&iterVertices, (void**)&pVertice) == LIS_CondRetOK)
+   {
+      walCondRet = GravarRegistro(pPonto, pPersistencia->tamanhoValor, GRA_RegistroInserirVertice,
+                                  pVertice->nome, NULL, NULL, pVertice->pValor);
+   }
+
+   // As arestas s depois de todos os vrtices, que so os seus destinos
+   LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
+   while (walCondRet == WAL_CondRetOK &&
+          LIS_AvancarIterador(&iterVertices, (void**)&pVertice) == LIS_CondRetOK)
+   {
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterArestas;
+
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterArestas);
+      while (walCondRet == WAL_CondRetOK &&
+             ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         walCondRet = GravarRegistro(pPonto, NULL, GRA_RegistroInserirAresta,
+                                     pAresta->nome, pVertice->nome, pAresta->pVertice->nome, NULL);
+      }
+   }
+
+   LIS_IniciarIterador(pGrafo->pOrigens, &iterVertices);
+   while (walCondRet == WAL_CondRetOK &&
+          LIS_AvancarIterador(&iterVertices, (void**)&pVertice) == LIS_CondRetOK)
+   {
+      walCondRet = GravarRegistro(pPonto, NULL, GRA_RegistroTornarOrigem,
+                                  pVertice->nome, NULL, NULL, NULL);
+   }
+
+   if (pPonto != NULL)
+   {
+      WAL_tpCondRet fecharCondRet = WAL_Fechar(pPonto);
+      if (walCondRet == WAL_CondRetOK)
+      {
+         walCondRet = fecharCondRet;
+      }
+   }
+   if (walCondRet == WAL_CondRetOK)
+   {
+      walCondRet = WAL_Substituir(caminhoTemporario, caminhoPonto);
+   }
+   if (walCondRet == WAL_CondRetOK)
+   {
+      walCondRet = WAL_Esvaziar(pPersistencia->pLog);
+   }
+   else
+   {
+      remove(caminhoTemporario);
+   }
+
+   free(caminhoTemporario);
+   free(caminhoPonto);
+
+   return TraduzirCondRetLog(walCondRet);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Aplicar registro
+*
+*  Descrio:
+*    Refaz sobre o grafo em recuperao a mutao descrita por um
+*    registro do ponto de controle ou do log, usando as funes
+*    exportadas. O grafo ainda no  persistente, portanto nada 
+*    registrado de novo. Nomes e valores so copiados, j que o grafo
+*    passa a ser o dono deles.
+*    Retorna diferente de 0 para interromper a recuperao.
+*
+***********************************************************************/
+int AplicarRegistro(unsigned char tipo, int numCampos, const unsigned char **vtCampos,
+   const size_t *vtTamanhos, void *pContexto)
+{
+   static const int vtNumCampos[] = { 1, 2, 3, 2, 1, 1, 1, 2 };
+   tpRecuperacao *pRecuperacao = (tpRecuperacao*) pContexto;
+   tpGrafo *pGrafo = pRecuperacao->pGrafo;
+   GRA_tpCondRet condRet = GRA_CondRetOK;
+   char *vtNomes[WAL_MAX_CAMPOS];
+   char *nome = NULL, *pValor = NULL;
+   int numNomes = numCampos, i;
+
+   if (tipo >= sizeof(vtNumCampos) / sizeof(vtNumCampos[0]) || numCampos != vtNumCampos[tipo])
+   {
+      pRecuperacao->condRet = GRA_CondRetErroSistema;
+      return 1;
+   }
+
+   if (tipo == GRA_RegistroPontoDeControle)
+   {
+      if (vtTamanhos[0] != 8)
+      {
+         pRecuperacao->condRet = GRA_CondRetErroSistema;
+         return 1;
+      }
+      pRecuperacao->lsnPontoDeControle = 0;
+      for (i = 7; i >= 0; i--)
+      {
+         pRecuperacao->lsnPontoDeControle = (pRecuperacao->lsnPontoDeControle << 8) | vtCampos[0][i];
+      }
+      return 0;
+   }
+
+   if (tipo == GRA_RegistroInserirVertice || tipo == GRA_RegistroAlterarValor)
+   {
+      numNomes--;
+      if (vtTamanhos[numNomes] > 0)
+      {
+         pValor = CopiarBytes(vtCampos[numNomes], vtTamanhos[numNomes]);
+         if (pValor == NULL)
+         {
+            pRecuperacao->condRet = GRA_CondRetFaltouMemoria;
+            return 1;
+         }
+      }
+   }
+
+   for (i = 0; i < numNomes; i++)
+   {
+      if (vtTamanhos[i] == 0 || vtCampos[i][vtTamanhos[i] - 1] != '\0')
+      {
+         free(pValor);
+         pRecuperacao->condRet = GRA_CondRetErroSistema;
+         return 1;
+      }
+      vtNomes[i] = (char*) vtCampos[i];
+   }
+
+   switch (tipo)
+   {
+      case GRA_RegistroInserirVertice:
+      case GRA_RegistroInserirAresta:
+         nome = CopiarBytes(vtNomes[0], vtTamanhos[0]);
+         if (nome == NULL)
+         {
+            condRet = GRA_CondRetFaltouMemoria;
+         }
+         else if (tipo == GRA_RegistroInserirVertice)
+         {
+            condRet = GRA_InserirVertice((GRA_tppGrafo) pGrafo, nome, pValor);
+         }
+         else
+         {
+            condRet = GRA_InserirAresta((GRA_tppGrafo) pGrafo, nome, vtNomes[1], vtNomes[2]);
+         }
+         if (condRet != GRA_CondRetOK)
+         {
+            free(nome);
+            free(pValor);
+         }
+         break;
+
+      default:
+         // As demais mutaes agem sobre o vrtice corrente da poca
+         condRet = ProcurarVertice(pGrafo, vtNomes[0], &pGrafo->pCorrente);
+         if (condRet != GRA_CondRetOK)
+         {
+            free(pValor);
+            break;
+         }
+
+         if (tipo == GRA_RegistroAlterarValor)
+         {
+            void *pValorAntigo = pGrafo->pCorrente->pValor;
+            GRA_AlterarValorCorrente((GRA_tppGrafo) pGrafo, pValor);
+            if (pValorAntigo != NULL && pGrafo->destruirValor != NULL)
+            {
+               pGrafo->destruirValor(pValorAntigo);
+            }
+         }
+         else if (tipo == GRA_RegistroTornarOrigem)
+         {
+            condRet = GRA_TornarCorrenteUmaOrigem((GRA_tppGrafo) pGrafo);
+         }
+         else if (tipo == GRA_RegistroDeixarOrigem)
+         {
+            condRet = GRA_DeixarDeSerOrigem((GRA_tppGrafo) pGrafo);
+         }
+         else if (tipo == GRA_RegistroDestruirVertice)
+         {
+            condRet = GRA_DestruirVerticeCorrente((GRA_tppGrafo) pGrafo);
+         }
+         else
+         {
+            condRet = GRA_DestruirArestaAdjacente((GRA_tppGrafo) pGrafo, vtNomes[1]);
+         }
+         break;
+   }
+
+   if (condRet != GRA_CondRetOK)
+   {
+      // Um log ntegro sempre se reaplica; o contrrio indica arquivos trocados
+      pRecuperacao->condRet = condRet == GRA_CondRetFaltouMemoria ? condRet : GRA_CondRetErroSistema;
+      return 1;
+   }
+
+   return 0;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Copiar bytes
+*
+***********************************************************************/
+char * CopiarBytes(const void *pOrigem, size_t tamanho)
+{
+   char *pCopia = (char*) malloc(tamanho);
+
+   if (pCopia != NULL)
+   {
+      memcpy(pCopia, pOrigem, tamanho);
+   }
+
+   return pCopia;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Montar caminho
+*
+***********************************************************************/
+char * MontarCaminho(const char *caminhoBase, const char *sufixo)
+{
+   size_t tamBase = strlen(caminhoBase);
+   char *caminho = (char*) malloc(tamBase + strlen(sufixo) + 1);
+
+   if (caminho != NULL)
+   {
+      memcpy(caminho, caminhoBase, tamBase);
+      strcpy(caminho + tamBase, sufixo);
+   }
+
+   return caminho;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Traduzir condio de retorno do log
+*
+***********************************************************************/
+GRA_tpCondRet TraduzirCondRetLog(WAL_tpCondRet walCondRet)
+{
+   switch (walCondRet)
+   {
+      case WAL_CondRetOK:
+         return GRA_CondRetOK;
+      case WAL_CondRetFaltouMemoria:
+         return GRA_CondRetFaltouMemoria;
+      default:
+         return GRA_CondRetErroSistema;
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Visitar vrtice listado
+*
+*  Descrio:
+*    Visita do ndice de nomes que repassa o nome e o valor do vrtice
+*     funo do cliente guardada na listagem dada como contexto.
+*
+***********************************************************************/
+int VisitarVerticeListado(const char *nome, void *pVazio, void *pContexto)
+{
+   tpListagem *pListagem = (tpListagem*) pContexto;
+
+   return pListagem->visitar(nome, ((tpVertice*) pVazio)->pValor, pListagem->pContexto);
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Visitar sucessor
+*
+*  Descrio:
+*    Processamento da lista de sucessores que repassa a aresta e o seu
+*    destino  funo do cliente guardada na visita dada como contexto.
+*
+***********************************************************************/
+int VisitarSucessor(void *pVazio, void *pContexto)
+{
+   tpAresta *pAresta = (tpAresta*) pVazio;
+   tpVisitaSucessores *pVisita = (tpVisitaSucessores*) pContexto;
+
+   return pVisita->visitar(pAresta->nome, pAresta->pVertice->nome,
+                           pAresta->pVertice->pValor, pVisita->pContexto);
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Visitar antecessor
+*
+*  Descrio:
+*    Processamento da lista de antecessores que repassa o nome e o valor
+*    do vrtice  funo do cliente guardada na listagem dada como
+*    contexto.
+*
+***********************************************************************/
+int VisitarAntecessor(void *pVazio, void *pContexto)
+{
+   tpVertice *pVertice = (tpVertice*) pVazio;
+   tpListagem *pListagem = (tpListagem*) pContexto;
+
+   return pListagem->visitar(pVertice->nome, pVertice->pValor, pListagem->pContexto);
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Visitar faixa
+*
+*  Descrio:
+*    Visita os vrtices de uma faixa de identificadores.  a funo
+*    executada por cada linha de GRA_ParaCadaVerticeParalelo, e s l
+*    o grafo.
+*
+***********************************************************************/
+void VisitarFaixa(void *pVazio)
+{
+   tpFaixa *pFaixa = (tpFaixa*) pVazio;
+   tpVertice **vtVertices = pFaixa->pGrafo->vtVertices;
+   int id;
+
+   for (id = pFaixa->inicio; id < pFaixa->fim; id++)
+   {
+      if (vtVertices[id] != NULL)
+      {
+         pFaixa->visitar(vtVertices[id]->nome, vtVertices[id]->pValor,
+                         pFaixa->tarefa, pFaixa->pContexto);
+      }
+   }
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Retirar dos percursos
+*
+*  Descrio:
+*    Troca por -1 o id do vrtice, que est sendo destacado do grafo, na
+*    fronteira de todos os percursos, para que um vrtice que receba o
+*    mesmo id no seja visitado no seu lugar.
+*
+***********************************************************************/
+void RetirarDosPercursos(tpGrafo *pGrafo, tpVertice *pVertice)
+{
+   int numPercursos = 0, i;
+
+   LIS_NumELementos(pGrafo->pPercursos, &numPercursos);
+   LIS_IrInicioLista(pGrafo->pPercursos);
+
+   while (numPercursos > 0)
+   {
+      tpPercurso *pPercurso = NULL;
+      LIS_ObterValor(pGrafo->pPercursos, (void**)&pPercurso);
+
+      for (i = pPercurso->inicio; i < pPercurso->fim; i++)
+      {
+         if (pPercurso->vtFronteira[i] == pVertice->id)
+         {
+            pPercurso->vtFronteira[i] = -1;
+         }
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pPercursos, 1);
+      numPercursos--;
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Reservar fronteira
+*
+*  Descrio:
+*    Garante espao para mais quantidade ids aps o fim da fronteira.
+*    Se a fila j andou metade do vetor, os ids so trazidos para o
+*    incio; seno o vetor dobra. Retorna 0 se faltou memria, sem
+*    alterar a fronteira.
+*
+***********************************************************************/
+int ReservarFronteira(tpPercurso *pPercurso, int quantidade)
+{
+   int capacidade;
+   int *vtFronteira;
+
+   if (pPercurso->fim + quantidade <= pPercurso->capacidade)
+   {
+      return 1;
+   }
+
+   if (pPercurso->inicio > 0 && pPercurso->inicio >= pPercurso->capacidade / 2)
+   {
+      memmove(pPercurso->vtFronteira, pPercurso->vtFronteira + pPercurso->inicio,
+              (pPercurso->fim - pPercurso->inicio) * sizeof(int));
+      pPercurso->fim -= pPercurso->inicio;
+      pPercurso->inicio = 0;
+
+      if (pPercurso->fim + quantidade <= pPercurso->capacidade)
+      {
+         return 1;
+      }
+   }
+
+   capacidade = pPercurso->capacidade < 16 ? 16 : pPercurso->capacidade * 2;
+   if (capacidade < pPercurso->fim + quantidade)
+   {
+      capacidade = pPercurso->fim + quantidade;
+   }
+
+   vtFronteira = (int*) RealocarEspaco(pPercurso->vtFronteira,
+                    pPercurso->fim * sizeof(int), capacidade * sizeof(int));
+   if (vtFronteira == NULL)
+   {
+      return 0;
+   }
+
+   pPercurso->vtFronteira = vtFronteira;
+   pPercurso->capacidade = capacidade;
+
+   return 1;
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Notificar assinaturas
+*
+*  Descrio:
+*    Traduz uma mutao, com os nomes na ordem de RegistrarMutacao, numa
+*    mudana, e a guarda em cada assinatura. Mutaes que no mudam
+*    vrtices, arestas ou valores, como tornar origem, so ignoradas.
+*    Uma mudana que no couber no anel, ou cujos nomes no puderem ser
+*    copiados,  perdida, mas consome o seu nmero de sequncia.
+*
+***********************************************************************/
+void NotificarAssinaturas(tpGrafo *pGrafo, tpTipoRegistro tipo,
+   const char *nome1, const char *nome2, const char *nome3)
+{
+   GRA_tpTipoMudanca tipoMudanca;
+   const char *nomeVertice = nome1, *nomeAresta = NULL, *nomeDestino = NULL;
+   int numAssinaturas = 0;
+
+   switch (tipo)
+   {
+      case GRA_RegistroInserirVertice:
+         tipoMudanca = GRA_MudancaInserirVertice;
+         break;
+
+      case GRA_RegistroDestruirVertice:
+         tipoMudanca = GRA_MudancaDestruirVertice;
+         break;
+
+      case GRA_RegistroAlterarValor:
+         tipoMudanca = GRA_MudancaAlterarValor;
+         break;
+
+      case GRA_RegistroInserirAresta:
+         tipoMudanca = GRA_MudancaInserirAresta;
+         nomeAresta = nome1;
+         nomeVertice = nome2;
+         nomeDestino = nome3;
+         break;
+
+      case GRA_RegistroDestruirAresta:
+         tipoMudanca = GRA_MudancaDestruirAresta;
+         nomeAresta = nome2;
+         break;
+
+      default:
+         return;
+   }
+
+   LIS_NumELementos(pGrafo->pAssinaturas, &numAssinaturas);
+   LIS_IrInicioLista(pGrafo->pAssinaturas);
+
+   while (numAssinaturas > 0)
+   {
+      tpAssinatura *pAssinatura = NULL;
+      LIS_ObterValor(pGrafo->pAssinaturas, (void**)&pAssinatura);
+
+      pAssinatura->numSequencia++;
+
+      if (pAssinatura->pAnel == NULL)
+      {
+         if (GuardarMudanca(&pAssinatura->vtLote[pAssinatura->numNoLote],
+                            &pAssinatura->vtNomesLote[pAssinatura->numNoLote],
+                            tipoMudanca, pAssinatura->numSequencia,
+                            nomeVertice, nomeAresta, nomeDestino))
+         {
+            pAssinatura->numNoLote++;
+         }
+
+         if (pAssinatura->numNoLote == pAssinatura->tamLote)
+         {
+            EntregarLote(pAssinatura);
+         }
+      }
+      else
+      {
+         tpMudancaNoAnel *pNoAnel = (tpMudancaNoAnel*) ANL_ObterEspacoLivre(pAssinatura->pAnel);
+
+         if (pNoAnel != NULL &&
+             GuardarMudanca(&pNoAnel->mudanca, &pNoAnel->nomesGuardados,
+                            tipoMudanca, pAssinatura->numSequencia,
+                            nomeVertice, nomeAresta, nomeDestino))
+         {
+            ANL_Publicar(pAssinatura->pAnel);
+         }
+      }
+
+      LIS_AvancarElementoCorrente(pGrafo->pAssinaturas, 1);
+      numAssinaturas--;
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Guardar mudana
+*
+*  Descrio:
+*    Preenche a mudana, copiando os nomes no nulos para o espao
+*    guardado, que s cresce. Retorna 0 se faltou memria.
+*
+***********************************************************************/
+int GuardarMudanca(GRA_tpMudanca *pMudanca, tpNomesGuardados *pNomesGuardados,
+   GRA_tpTipoMudanca tipo, unsigned long numSequencia,
+   const char *nomeVertice, const char *nomeAresta, const char *nomeDestino)
+{
+   size_t tamVertice = strlen(nomeVertice) + 1;
+   size_t tamAresta = nomeAresta == NULL ? 0 : strlen(nomeAresta) + 1;
+   size_t tamDestino = nomeDestino == NULL ? 0 : strlen(nomeDestino) + 1;
+   size_t tamNomes = tamVertice + tamAresta + tamDestino;
+   char *nomes;
+
+   if (tamNomes > pNomesGuardados->capNomes)
+   {
+      nomes = (char*) malloc(tamNomes);
+      if (nomes == NULL)
+      {
+         return 0;
+      }
+      free(pNomesGuardados->nomes);
+      pNomesGuardados->nomes = nomes;
+      pNomesGuardados->capNomes = tamNomes;
+   }
+
+   nomes = pNomesGuardados->nomes;
+
+   pMudanca->tipo = tipo;
+   pMudanca->numSequencia = numSequencia;
+
+   memcpy(nomes, nomeVertice, tamVertice);
+   pMudanca->nomeVertice = nomes;
+
+   pMudanca->nomeAresta = NULL;
+   if (nomeAresta != NULL)
+   {
+      memcpy(nomes + tamVertice, nomeAresta, tamAresta);
+      pMudanca->nomeAresta = nomes + tamVertice;
+   }
+
+   pMudanca->nomeDestino = NULL;
+   if (nomeDestino != NULL)
+   {
+      memcpy(nomes + tamVertice + tamAresta, nomeDestino, tamDestino);
+      pMudanca->nomeDestino = nomes + tamVertice + tamAresta;
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Entregar lote
+*
+*  Descrio:
+*    Passa as mudanas acumuladas de uma assinatura sncrona  sua
+*    funo de entrega e esvazia o lote. No faz nada se ele est vazio.
+*
+***********************************************************************/
+void EntregarLote(tpAssinatura *pAssinatura)
+{
+   if (pAssinatura->numNoLote == 0)
+   {
+      return;
+   }
+
+   pAssinatura->entregar(pAssinatura->vtLote, pAssinatura->numNoLote, pAssinatura->pContexto);
+   pAssinatura->numNoLote = 0;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Destruir assinatura
+*
+*  Descrio:
+*    Libera a assinatura e os nomes guardados no lote ou em cada posio
+*    do anel.
+*
+***********************************************************************/
+void DestruirAssinatura(tpAssinatura *pAssinatura)
+{
+   int i;
+
+   if (pAssinatura->pAnel != NULL)
+   {
+      for (i = 0; i < ANL_ObterCapacidade(pAssinatura->pAnel); i++)
+      {
+         free(((tpMudancaNoAnel*) ANL_ObterPosicao(pAssinatura->pAnel, i))->nomesGuardados.nomes);
+      }
+      ANL_DestruirAnel(pAssinatura->pAnel);
+   }
+   else
+   {
+      for (i = 0; i < pAssinatura->tamLote; i++)
+      {
+         free(pAssinatura->vtNomesLote[i].nomes);
+      }
+      free(pAssinatura->vtLote);
+      free(pAssinatura->vtNomesLote);
+   }
+
+   free(pAssinatura);
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Ajustar ordem topolgica
+*
+*  Descrio:
+*    Prepara a ordem para a aresta de pOrigem para pDestino, pelo
+*    algoritmo de Pearce e Kelly. Se a origem j vem antes do destino
+*    nada muda. Seno s a faixa de posies entre o destino e a origem
+*     examinada: os vrtices da faixa alcanveis a partir do destino
+*    e os que alcanam a origem trocam de lugar entre si, os segundos
+*    antes dos primeiros, mantendo a ordem relativa de cada grupo nas
+*    posies que os dois grupos j ocupavam. Se a origem for alcanvel
+*    a partir do destino, a aresta fecharia um ciclo e a ordem no 
+*    alterada.
+*
+***********************************************************************/
+GRA_tpCondRet AjustarOrdemTopologica(tpGrafo *pGrafo, tpVertice *pOrigem, tpVertice *pDestino)
+{
+   int limiteInferior = pDestino->posTopologica;
+   int limiteSuperior = pOrigem->posTopologica;
+   int numAfetados = 0, numAdiante, numAtras, i;
+   GRA_tpCondRet condRet = GRA_CondRetOK;
+   tpMarcador *pMarcador;
+   int *vtAfetados;
+
+   if (pOrigem == pDestino)
+   {
+      return GRA_CondRetCriaCiclo;
+   }
+
+   if (limiteSuperior < limiteInferior)
+   {
+      return GRA_CondRetOK;
+   }
+
+   pMarcador = ObterMarcadorDePercurso(pGrafo);
+   if (pMarcador == NULL || !ReservarAfetados(pGrafo, 2) ||
+       !Marcar(pMarcador, pDestino) || !Marcar(pMarcador, pOrigem))
+   {
+      DevolverMarcadorDePercurso(pGrafo, pMarcador);
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   // Alcanveis a partir do destino sem sair da faixa. O vetor serve de fila
+   pGrafo->vtAfetados[numAfetados++] = limiteInferior;
+   for (i = 0; i < numAfetados && condRet == GRA_CondRetOK; i++)
+   {
+      tpVertice *pVertice = pGrafo->vtVertices[pGrafo->vtOrdemTopologica[pGrafo->vtAfetados[i]]];
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterador;
+      int numSucessores = 0;
+
+      numSucessores = ADJ_NumElementos(&pVertice->sucessores);
+      if (!ReservarAfetados(pGrafo, numAfetados + numSucessores + 1))
+      {
+         condRet = GRA_CondRetFaltouMemoria;
+         break;
+      }
+
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         if (pAresta->pVertice == pOrigem)
+         {
+            condRet = GRA_CondRetCriaCiclo;
+            break;
+         }
+
+         if (pAresta->pVertice->posTopologica < limiteSuperior &&
+             !EstaMarcado(pMarcador, pAresta->pVertice))
+         {
+            // O espao do marcador j cobre os ids, pois o destino foi marcado
+            Marcar(pMarcador, pAresta->pVertice);
+            pGrafo->vtAfetados[numAfetados++] = pAresta->pVertice->posTopologica;
+         }
+      }
+   }
+   numAdiante = numAfetados;
+
+   // Vrtices que alcanam a origem sem sair da faixa
+   if (condRet == GRA_CondRetOK)
+   {
+      pGrafo->vtAfetados[numAfetados++] = limiteSuperior;
+   }
+   for (i = numAdiante; i < numAfetados && condRet == GRA_CondRetOK; i++)
+   {
+      tpVertice *pVertice = pGrafo->vtVertices[pGrafo->vtOrdemTopologica[pGrafo->vtAfetados[i]]];
+      tpVertice *pAntecessor = NULL;
+      LIS_tpIterador iterador;
+      int numAntecessores = 0;
+
+      LIS_NumELementos(pVertice->pAntecessores, &numAntecessores);
+      if (!ReservarAfetados(pGrafo, numAfetados + numAntecessores))
+      {
+         condRet = GRA_CondRetFaltouMemoria;
+         break;
+      }
+
+      LIS_IniciarIterador(pVertice->pAntecessores, &iterador);
+      while (LIS_AvancarIterador(&iterador, (void**)&pAntecessor) == LIS_CondRetOK)
+      {
+         if (pAntecessor->posTopologica > limiteInferior &&
+             !EstaMarcado(pMarcador, pAntecessor))
+         {
+            Marcar(pMarcador, pAntecessor);
+            pGrafo->vtAfetados[numAfetados++] = pAntecessor->posTopologica;
+         }
+      }
+   }
+   numAtras = numAfetados - numAdiante;
+
+   DevolverMarcadorDePercurso(pGrafo, pMarcador);
+
+   if (condRet == GRA_CondRetOK && !ReservarAfetados(pGrafo, 2 * numAfetados))
+   {
+      condRet = GRA_CondRetFaltouMemoria;
+   }
+
+   if (condRet != GRA_CondRetOK)
+   {
+      return condRet;
+   }
+
+   // Na segunda metade do vetor ficam os ids na nova ordem: primeiro os
+   // que alcanam a origem, depois os alcanveis a partir do destino
+   vtAfetados = pGrafo->vtAfetados;
+   qsort(vtAfetados, numAdiante, sizeof(int), CompararInteiros);
+   qsort(vtAfetados + numAdiante, numAtras, sizeof(int), CompararInteiros);
+
+   for (i = 0; i < numAtras; i++)
+   {
+      vtAfetados[numAfetados + i] = pGrafo->vtOrdemTopologica[vtAfetados[numAdiante + i]];
+   }
+   for (i = 0; i < numAdiante; i++)
+   {
+      vtAfetados[numAfetados + numAtras + i] = pGrafo->vtOrdemTopologica[vtAfetados[i]];
+   }
+
+   // As posies ocupadas pelos dois grupos so distribudas em ordem
+   qsort(vtAfetados, numAfetados, sizeof(int), CompararInteiros);
+
+   for (i = 0; i < numAfetados; i++)
+   {
+      pGrafo->vtOrdemTopologica[vtAfetados[i]] = vtAfetados[numAfetados + i];
+      pGrafo->vtVertices[vtAfetados[numAfetados + i]]->posTopologica = vtAfetados[i];
+   }
+
+   return GRA_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Reservar posio topolgica
+*
+*  Descrio:
+*    Garante uma posio livre ao fim da ordem topolgica para um novo
+*    vrtice. Se metade das posies ou mais so de vrtices destrudos,
+*    os vrtices so trazidos para o incio, na mesma ordem; seno o
+*    vetor dobra. Retorna 0 se faltou memria, sem alterar a ordem.
+*
+***********************************************************************/
+int ReservarPosicaoTopologica(tpGrafo *pGrafo)
+{
+   int numVertices = 0, capacidade, i, j;
+   int *vtOrdem;
+
+   if (pGrafo->numPosicoesTopologicas < pGrafo->capPosicoesTopologicas)
+   {
+      return 1;
+   }
+
+   LIS_NumELementos(pGrafo->pVertices, &numVertices);
+   if (numVertices <= pGrafo->capPosicoesTopologicas / 2)
+   {
+      for (i = 0, j = 0; i < pGrafo->numPosicoesTopologicas; i++)
+      {
+         if (pGrafo->vtOrdemTopologica[i] >= 0)
+         {
+            pGrafo->vtOrdemTopologica[j] = pGrafo->vtOrdemTopologica[i];
+            pGrafo->vtVertices[pGrafo->vtOrdemTopologica[j]]->posTopologica = j;
+            j++;
+         }
+      }
+      pGrafo->numPosicoesTopologicas = j;
+
+      return 1;
+   }
+
+   capacidade = pGrafo->capPosicoesTopologicas * 2;
+
+   vtOrdem = (int*) RealocarEspaco(pGrafo->vtOrdemTopologica,
+                pGrafo->capPosicoesTopologicas * sizeof(int), capacidade * sizeof(int));
+   if (vtOrdem == NULL)
+   {
+      return 0;
+   }
+
+   pGrafo->vtOrdemTopologica = vtOrdem;
+   pGrafo->capPosicoesTopologicas = capacidade;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Reservar afetados
+*
+*  Descrio:
+*    Garante ao menos quantidade posies em vtAfetados, preservando o
+*    contedo. Retorna 0 se faltou memria.
+*
+***********************************************************************/
+int ReservarAfetados(tpGrafo *pGrafo, int quantidade)
+{
+   int capacidade;
+   int *vtAfetados;
+
+   if (quantidade <= pGrafo->capAfetados)
+   {
+      return 1;
+   }
+
+   capacidade = pGrafo->capAfetados < 16 ? 16 : pGrafo->capAfetados * 2;
+   if (capacidade < quantidade)
+   {
+      capacidade = quantidade;
+   }
+
+   vtAfetados = (int*) RealocarEspaco(pGrafo->vtAfetados,
+                   pGrafo->capAfetados * sizeof(int), capacidade * sizeof(int));
+   if (vtAfetados == NULL)
+   {
+      return 0;
+   }
+
+   pGrafo->vtAfetados = vtAfetados;
+   pGrafo->capAfetados = capacidade;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Comparar inteiros
+*
+*  Descrio:
+*    Ordena inteiros em ordem crescente, para qsort.
+*
+***********************************************************************/
+int CompararInteiros(const void *pVazio1, const void *pVazio2)
+{
+   int valor1 = *(const int*) pVazio1;
+   int valor2 = *(const int*) pVazio2;
+
+   return (valor1 > valor2) - (valor1 < valor2);
+}
+
+
+/***********************************************************************
+*
+*  Funo: GRA Montar componentes
+*
+*  Descrio:
+*    Cria a estrutura de componentes, unindo as pontas de todas as
+*    arestas. Retorna 0 se faltou memria, deixando-a por criar.
+*
+***********************************************************************/
+int MontarComponentes(tpGrafo *pGrafo)
+{
+   tpAresta *pAresta = NULL;
+   ADJ_tpIterador iterador;
+   int id;
+
+   if (!ReservarComponentes(pGrafo, pGrafo->numIds + 1))
+   {
+      free(pGrafo->vtComponentes);
+      free(pGrafo->vtDesatualizados);
+      pGrafo->vtComponentes = NULL;
+      pGrafo->vtDesatualizados = NULL;
+      pGrafo->capComponentes = 0;
+      return 0;
+   }
+
+   pGrafo->numComponentes = 0;
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      if (pGrafo->vtVertices[id] != NULL)
+      {
+         pGrafo->numComponentes++;
+      }
+   }
+
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      if (pGrafo->vtVertices[id] != NULL)
+      {
+         ADJ_IniciarIterador(&pGrafo->vtVertices[id]->sucessores, &iterador);
+         while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+         {
+            UnirComponentes(pGrafo, id, pAresta->pVertice->id);
+         }
+      }
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Reservar componentes
+*
+*  Descrio:
+*    Garante ns de componente para ao menos quantidade ids. Os ns
+*    novos so componentes de um s vrtice, fora da pilha. Retorna 0 se
+*    faltou memria, sem alterar os componentes.
+*
+***********************************************************************/
+int ReservarComponentes(tpGrafo *pGrafo, int quantidade)
+{
+   tpNoComponente *vtComponentes;
+   int *vtDesatualizados;
+   int capacidade, id;
+
+   if (quantidade <= pGrafo->capComponentes)
+   {
+      return 1;
+   }
+
+   capacidade = pGrafo->capComponentes < 16 ? 16 : pGrafo->capComponentes * 2;
+   if (capacidade < quantidade)
+   {
+      capacidade = quantidade;
+   }
+
+   vtComponentes = (tpNoComponente*) RealocarEspaco(pGrafo->vtComponentes,
+                      pGrafo->capComponentes * sizeof(tpNoComponente),
+                      capacidade * sizeof(tpNoComponente));
+   if (vtComponentes == NULL)
+   {
+      return 0;
+   }
+   pGrafo->vtComponentes = vtComponentes;
+
+   // A pilha nunca tem o mesmo id duas vezes, logo cabe em capacidade posies
+   vtDesatualizados = (int*) RealocarEspaco(pGrafo->vtDesatualizados,
+                         pGrafo->capComponentes * sizeof(int), capacidade * sizeof(int));
+   if (vtDesatualizados == NULL)
+   {
+      return 0;
+   }
+   pGrafo->vtDesatualizados = vtDesatualizados;
+
+   for (id = pGrafo->capComponentes; id < capacidade; id++)
+   {
+      IniciarNoComponente(pGrafo, id);
+      pGrafo->vtComponentes[id].naPilha = 0;
+   }
+   pGrafo->capComponentes = capacidade;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Iniciar n de componente
+*
+*  Descrio:
+*    Torna o id um componente de um s vrtice. No altera a presena
+*    do id na pilha de desatualizados.
+*
+***********************************************************************/
+void IniciarNoComponente(tpGrafo *pGrafo, int id)
+{
+   tpNoComponente *pNo = &pGrafo->vtComponentes[id];
+
+   pNo->pai = id;
+   pNo->tamanho = 1;
+   pNo->proximo = id;
+   pNo->anterior = id;
+   pNo->desatualizado = 0;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Encontrar componente
+*
+*  Descrio:
+*    Retorna o id da raiz do componente, encurtando o caminho pela
+*    metade: cada n visitado passa a apontar para o seu av.
+*
+***********************************************************************/
+int EncontrarComponente(tpGrafo *pGrafo, int id)
+{
+   tpNoComponente *vtComponentes = pGrafo->vtComponentes;
+
+   while (vtComponentes[id].pai != id)
+   {
+      vtComponentes[id].pai = vtComponentes[vtComponentes[id].pai].pai;
+      id = vtComponentes[id].pai;
+   }
+
+   return id;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Unir componentes
+*
+*  Descrio:
+*    Une os componentes dos dois ids, pendurando o menor no maior e
+*    emendando as listas de membros. O componente resultante fica
+*    desatualizado se algum dos dois estava.
+*
+***********************************************************************/
+void UnirComponentes(tpGrafo *pGrafo, int id1, int id2)
+{
+   tpNoComponente *vtComponentes = pGrafo->vtComponentes;
+   int raiz1 = EncontrarComponente(pGrafo, id1);
+   int raiz2 = EncontrarComponente(pGrafo, id2);
+   int proximo1;
+
+   if (raiz1 == raiz2)
+   {
+      return;
+   }
+
+   if (vtComponentes[raiz1].tamanho < vtComponentes[raiz2].tamanho)
+   {
+      int raiz = raiz1;
+      raiz1 = raiz2;
+      raiz2 = raiz;
+   }
+
+   vtComponentes[raiz2].pai = raiz1;
+   vtComponentes[raiz1].tamanho += vtComponentes[raiz2].tamanho;
+
+   proximo1 = vtComponentes[raiz1].proximo;
+   vtComponentes[raiz1].proximo = vtComponentes[raiz2].proximo;
+   vtComponentes[vtComponentes[raiz2].proximo].anterior = raiz1;
+   vtComponentes[raiz2].proximo = proximo1;
+   vtComponentes[proximo1].anterior = raiz2;
+
+   pGrafo->numComponentes--;
+
+   if (vtComponentes[raiz2].desatualizado)
+   {
+      MarcarDesatualizado(pGrafo, raiz1);
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Marcar desatualizado
+*
+*  Descrio:
+*    Marca o componente da raiz como talvez partido e empilha a raiz,
+*    se ela ainda no est na pilha.
+*
+***********************************************************************/
+void MarcarDesatualizado(tpGrafo *pGrafo, int raiz)
+{
+   pGrafo->vtComponentes[raiz].desatualizado = 1;
+
+   if (!pGrafo->vtComponentes[raiz].naPilha)
+   {
+      pGrafo->vtComponentes[raiz].naPilha = 1;
+      pGrafo->vtDesatualizados[pGrafo->numDesatualizados++] = raiz;
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Recalcular componente
+*
+*  Descrio:
+*    Desfaz o componente da raiz em vrtices isolados e os une de novo
+*    pelas arestas que saem deles. Como toda aresta liga vrtices do
+*    mesmo componente, s os membros e as suas arestas so percorridos.
+*    Os ids retidos de membros j destrudos so liberados aqui.
+*    Retorna 0 se faltou memria, sem alterar o componente.
+*
+***********************************************************************/
+int RecalcularComponente(tpGrafo *pGrafo, int raiz)
+{
+   tpNoComponente *vtComponentes = pGrafo->vtComponentes;
+   int numMembros = vtComponentes[raiz].tamanho;
+   int numVivos = 0;
+   int id, i;
+
+   if (!ReservarAfetados(pGrafo, numMembros))
+   {
+      return 0;
+   }
+
+   for (i = 0, id = raiz; i < numMembros; i++, id = vtComponentes[id].proximo)
+   {
+      pGrafo->vtAfetados[i] = id;
+   }
+
+   for (i = 0; i < numMembros; i++)
+   {
+      id = pGrafo->vtAfetados[i];
+      IniciarNoComponente(pGrafo, id);
+
+      if (pGrafo->vtVertices[id] == NULL)
+      {
+         LiberarId(pGrafo, id);
+         pGrafo->numIdsRetidos--;
+      }
+      else
+      {
+         pGrafo->vtAfetados[numVivos++] = id;
+      }
+   }
+   pGrafo->numComponentes += numVivos - 1;
+
+   for (i = 0; i < numVivos; i++)
+   {
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterador;
+
+      ADJ_IniciarIterador(&pGrafo->vtVertices[pGrafo->vtAfetados[i]]->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         UnirComponentes(pGrafo, pGrafo->vtAfetados[i], pAresta->pVertice->id);
+      }
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Retirar dos componentes
+*
+*  Descrio:
+*    Tira do seu componente o vrtice que est sendo destacado do grafo,
+*    cujas arestas j foram destrudas. Um componente de um s vrtice
+*    deixa de existir. Nos demais, o n continua na floresta e na lista
+*    de membros e o componente s  marcado desatualizado; o id fica
+*    retido, para que nenhum caminho passe por um id reaproveitado, at
+*    o reclculo. Retorna 1 se o id pode ser liberado j, 0 se retido.
+*
+***********************************************************************/
+int RetirarDosComponentes(tpGrafo *pGrafo, tpVertice *pVertice)
+{
+   int raiz = EncontrarComponente(pGrafo, pVertice->id);
+
+   if (pGrafo->vtComponentes[raiz].tamanho == 1)
+   {
+      pGrafo->numComponentes--;
+      IniciarNoComponente(pGrafo, pVertice->id);
+      return 1;
+   }
+
+   MarcarDesatualizado(pGrafo, raiz);
+   pGrafo->numIdsRetidos++;
+
+   return 0;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Atualizar componentes
+*
+*  Descrio:
+*    Esvazia a pilha de desatualizados, recalculando os componentes que
+*    ainda esto marcados. Retorna 0 se faltou memria, deixando na
+*    pilha os que no foram recalculados.
+*
+***********************************************************************/
+int AtualizarComponentes(tpGrafo *pGrafo)
+{
+   int id, raiz;
+
+   while (pGrafo->numDesatualizados > 0)
+   {
+      id = pGrafo->vtDesatualizados[pGrafo->numDesatualizados - 1];
+
+      // Um id liberado desde que foi empilhado  um componente atualizado
+      raiz = EncontrarComponente(pGrafo, id);
+      if (pGrafo->vtComponentes[raiz].desatualizado && !RecalcularComponente(pGrafo, raiz))
+      {
+         return 0;
+      }
+
+      pGrafo->vtComponentes[id].naPilha = 0;
+      pGrafo->numDesatualizados--;
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Obter componente
+*
+*  Descrio:
+*    Retorna em *pRaiz a raiz do componente atualizado do vrtice,
+*    montando a estrutura na primeira consulta e recalculando o
+*    componente se ele estiver desatualizado.
+*
+***********************************************************************/
+GRA_tpCondRet ObterComponente(tpGrafo *pGrafo, tpVertice *pVertice, int *pRaiz)
+{
+   int raiz;
+
+   if (pGrafo->vtComponentes == NULL && !MontarComponentes(pGrafo))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+
+   raiz = EncontrarComponente(pGrafo, pVertice->id);
+   if (pGrafo->vtComponentes[raiz].desatualizado)
+   {
+      if (!RecalcularComponente(pGrafo, raiz))
+      {
+         return GRA_CondRetFaltouMemoria;
+      }
+      raiz = EncontrarComponente(pGrafo, pVertice->id);
+   }
+
+   *pRaiz = raiz;
+
+   return GRA_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Calcular PageRank
+*
+*  Descrio:
+*    Implementa GRA_PageRank e GRA_PageRankPersonalizado. As faixas so
+*    divididas uma vez, por FimDaFaixa, e a cada iterao as
+*    faixas 1 em diante so calculadas em linhas prprias, esperadas
+*    antes da prxima. A faixa de uma linha que no pde ser criada 
+*    calculada por quem chamou, como em GRA_ParaCadaVerticeParalelo.
+*
+***********************************************************************/
+GRA_tpCondRet CalcularPageRank(tpGrafo *pGrafo, int personalizado,
+   double amortecimento, double tolerancia, int maxIteracoes, int numTarefas,
+   void (*visitar)(const char *nome, double rank, void *pContexto), void *pContexto,
+   int *pNumIteracoes)
+{
+   tpPageRank calculo;
+   tpFaixaPageRank vtFaixas[GRA_MAX_TAREFAS];
+   double diferenca, rankSumidouros, *vtTroca;
+   int numVertices = 0, numOrigens = 0, iteracao, i, id;
+
+   if (pGrafo == NULL)
+   {
+      return GRA_CondRetGrafoNaoFoiCriado;
+   }
+
+   if (!(amortecimento >= 0.0 && amortecimento < 1.0) || !(tolerancia >= 0.0) ||
+       maxIteracoes < 1 || numTarefas < 1 || numTarefas > GRA_MAX_TAREFAS)
+   {
+      return GRA_CondRetParametroInvalido;
+   }
+
+   LIS_NumELementos(pGrafo->pVertices, &numVertices);
+   if (numVertices == 0)
+   {
+      return GRA_CondRetGrafoVazio;
+   }
+
+   LIS_NumELementos(pGrafo->pOrigens, &numOrigens);
+   if (personalizado && numOrigens == 0)
+   {
+      return GRA_CondRetNaoAchou;
+   }
+
+   if (!MontarPageRank(pGrafo, personalizado, &calculo))
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+   calculo.amortecimento = amortecimento;
+
+   id = 0;
+   for (i = 0; i < numTarefas; i++)
+   {
+      vtFaixas[i].pCalculo = &calculo;
+      vtFaixas[i].inicio = id;
+      id = FimDaFaixa(calculo.vtInicio, pGrafo->numIds, id, i, numTarefas);
+      vtFaixas[i].fim = id;
+   }
+
+   // O rank inicial  o prprio salto
+   rankSumidouros = 0.0;
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      calculo.vtRank[id] = calculo.vtSalto[id];
+      calculo.vtContribuicao[id] = calculo.vtSalto[id] * calculo.vtInversoGrau[id];
+      if (calculo.vtInversoGrau[id] == 0.0)
+      {
+         rankSumidouros += calculo.vtSalto[id];
+      }
+   }
+
+   for (iteracao = 1; iteracao <= maxIteracoes; iteracao++)
+   {
+      calculo.fatorSalto = 1.0 - amortecimento + amortecimento * rankSumidouros;
+
+      for (i = 1; i < numTarefas; i++)
+      {
+         if (vtFaixas[i].inicio == vtFaixas[i].fim ||
+             TAR_IniciarTarefa(&vtFaixas[i].pTarefa, IterarFaixaPageRank,
+                               &vtFaixas[i]) != TAR_CondRetOK)
+         {
+            vtFaixas[i].pTarefa = NULL;
+         }
+      }
+
+      IterarFaixaPageRank(&vtFaixas[0]);
+
+      diferenca = vtFaixas[0].diferenca;
+      rankSumidouros = vtFaixas[0].rankSumidouros;
+      for (i = 1; i < numTarefas; i++)
+      {
+         if (vtFaixas[i].pTarefa != NULL)
+         {
+            TAR_EsperarTarefa(vtFaixas[i].pTarefa);
+         }
+         else
+         {
+            IterarFaixaPageRank(&vtFaixas[i]);
+         }
+         diferenca += vtFaixas[i].diferenca;
+         rankSumidouros += vtFaixas[i].rankSumidouros;
+      }
+
+      vtTroca = calculo.vtContribuicao;
+      calculo.vtContribuicao = calculo.vtContribuicaoNova;
+      calculo.vtContribuicaoNova = vtTroca;
+
+      if (diferenca <= tolerancia)
+      {
+         break;
+      }
+   }
+
+   if (pNumIteracoes != NULL)
+   {
+      *pNumIteracoes = iteracao > maxIteracoes ? maxIteracoes : iteracao;
+   }
+
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      if (pGrafo->vtVertices[id] != NULL)
+      {
+         visitar(pGrafo->vtVertices[id]->nome, calculo.vtRank[id], pContexto);
+      }
+   }
+
+   DestruirPageRank(&calculo);
+
+   return GRA_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Montar PageRank
+*
+*  Descrio:
+*    Aloca os vetores do clculo e copia para eles os antecessores, os
+*    graus de sada e o salto. Retorna 0 se faltou memria, caso em que
+*    nada fica alocado.
+*
+***********************************************************************/
+int MontarPageRank(tpGrafo *pGrafo, int personalizado, tpPageRank *pCalculo)
+{
+   int numIds = pGrafo->numIds, numArestas = 0, numVertices = 0, numOrigens = 0;
+   int id, numElementos;
+   tpVertice *pVertice, *pAntecessor;
+   LIS_tpIterador iterador;
+
+   pCalculo->vtInicio = (int*) malloc((numIds + 1) * sizeof(int));
+   if (pCalculo->vtInicio == NULL)
+   {
+      return 0;
+   }
+
+   pCalculo->vtInicio[0] = 0;
+   for (id = 0; id < numIds; id++)
+   {
+      numElementos = 0;
+      if (pGrafo->vtVertices[id] != NULL)
+      {
+         LIS_NumELementos(pGrafo->vtVertices[id]->pAntecessores, &numElementos);
+      }
+      numArestas += numElementos;
+      pCalculo->vtInicio[id + 1] = numArestas;
+   }
+
+   pCalculo->vtInversoGrau = (double*) malloc(5 * (size_t) numIds * sizeof(double));
+   pCalculo->vtAntecessores = (int*) malloc((numArestas + 1) * sizeof(int));
+   if (pCalculo->vtInversoGrau == NULL || pCalculo->vtAntecessores == NULL)
+   {
+      free(pCalculo->vtInversoGrau);
+      free(pCalculo->vtAntecessores);
+      free(pCalculo->vtInicio);
+      return 0;
+   }
+
+   pCalculo->vtSalto = pCalculo->vtInversoGrau + numIds;
+   pCalculo->vtRank = pCalculo->vtSalto + numIds;
+   pCalculo->vtContribuicao = pCalculo->vtRank + numIds;
+   pCalculo->vtContribuicaoNova = pCalculo->vtContribuicao + numIds;
+
+   LIS_NumELementos(pGrafo->pVertices, &numVertices);
+   LIS_NumELementos(pGrafo->pOrigens, &numOrigens);
+
+   for (id = 0; id < numIds; id++)
+   {
+      pVertice = pGrafo->vtVertices[id];
+      pCalculo->vtInversoGrau[id] = 0.0;
+      pCalculo->vtSalto[id] = 0.0;
+
+      if (pVertice == NULL)
+      {
+         continue;
+      }
+
+      numElementos = 0;
+      numElementos = ADJ_NumElementos(&pVertice->sucessores);
+      if (numElementos > 0)
+      {
+         pCalculo->vtInversoGrau[id] = 1.0 / numElementos;
+      }
+
+      if (!personalizado)
+      {
+         pCalculo->vtSalto[id] = 1.0 / numVertices;
+      }
+
+      numElementos = pCalculo->vtInicio[id];
+      LIS_IniciarIterador(pVertice->pAntecessores, &iterador);
+      while (LIS_AvancarIterador(&iterador, (void**)&pAntecessor) == LIS_CondRetOK)
+      {
+         pCalculo->vtAntecessores[numElementos++] = pAntecessor->id;
+      }
+   }
+
+   if (personalizado)
+   {
+      LIS_IniciarIterador(pGrafo->pOrigens, &iterador);
+      while (LIS_AvancarIterador(&iterador, (void**)&pVertice) == LIS_CondRetOK)
+      {
+         pCalculo->vtSalto[pVertice->id] = 1.0 / numOrigens;
+      }
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Destruir PageRank
+*
+***********************************************************************/
+void DestruirPageRank(tpPageRank *pCalculo)
+{
+   free(pCalculo->vtInicio);
+   free(pCalculo->vtAntecessores);
+   free(pCalculo->vtInversoGrau);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Iterar faixa de PageRank
+*
+*  Descrio:
+*    Calcula o novo rank dos vrtices de uma faixa. S l as
+*    contribuies da iterao anterior e s escreve nas posies da
+*    prpria faixa, de forma que as faixas no precisam de trava.  a
+*    funo executada pelas linhas de CalcularPageRank, e no aloca
+*    memria.
+*
+***********************************************************************/
+void IterarFaixaPageRank(void *pVazio)
+{
+   tpFaixaPageRank *pFaixa = (tpFaixaPageRank*) pVazio;
+   const tpPageRank *pCalculo = pFaixa->pCalculo;
+   const int *vtInicio = pCalculo->vtInicio;
+   const double *vtInversoGrau = pCalculo->vtInversoGrau;
+   const double *vtSalto = pCalculo->vtSalto;
+   double *vtRank = pCalculo->vtRank;
+   double *vtContribuicaoNova = pCalculo->vtContribuicaoNova;
+   double amortecimento = pCalculo->amortecimento, fatorSalto = pCalculo->fatorSalto;
+   double diferenca = 0.0, rankSumidouros = 0.0, rank;
+   int id;
+
+   for (id = pFaixa->inicio; id < pFaixa->fim; id++)
+   {
+      rank = fatorSalto * vtSalto[id] +
+             amortecimento * SomarContribuicoes(pCalculo->vtAntecessores, vtInicio[id],
+                                                vtInicio[id + 1], pCalculo->vtContribuicao);
+
+      diferenca += rank > vtRank[id] ? rank - vtRank[id] : vtRank[id] - rank;
+      rankSumidouros += vtInversoGrau[id] == 0.0 ? rank : 0.0;
+      vtRank[id] = rank;
+      vtContribuicaoNova[id] = rank * vtInversoGrau[id];
+   }
+
+   pFaixa->diferenca = diferenca;
+   pFaixa->rankSumidouros = rankSumidouros;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Somar contribuies
+*
+*  Descrio:
+*    Soma vtContribuicao[vtAntecessores[i]] para i de inicio a fim - 1.
+*    Com AVX2 as contribuies so lidas de quatro em quatro por
+*    _mm256_i32gather_pd; sem, o lao mantm quatro somas parciais
+*    independentes, que o compilador pode vetorizar. A ordem das somas
+*     a mesma em qualquer diviso em faixas.
+*
+***********************************************************************/
+double SomarContribuicoes(const int *vtAntecessores, int inicio, int fim,
+   const double *vtContribuicao)
+{
+   int i = inicio;
+   double soma;
+#if defined( __AVX2__ )
+   __m256d somas = _mm256_setzero_pd();
+   double vtSomas[4];
+
+   for (; i + 4 <= fim; i += 4)
+   {
+      somas = _mm256_add_pd(somas, _mm256_i32gather_pd(vtContribuicao,
+                 _mm_loadu_si128((const __m128i*) (vtAntecessores + i)), 8));
+   }
+   _mm256_storeu_pd(vtSomas, somas);
+   soma = (vtSomas[0] + vtSomas[1]) + (vtSomas[2] + vtSomas[3]);
+#else
+   double soma0 = 0.0, soma1 = 0.0, soma2 = 0.0, soma3 = 0.0;
+
+   for (; i + 4 <= fim; i += 4)
+   {
+      soma0 += vtContribuicao[vtAntecessores[i]];
+      soma1 += vtContribuicao[vtAntecessores[i + 1]];
+      soma2 += vtContribuicao[vtAntecessores[i + 2]];
+      soma3 += vtContribuicao[vtAntecessores[i + 3]];
+   }
+   soma = (soma0 + soma1) + (soma2 + soma3);
+#endif
+
+   for (; i < fim; i++)
+   {
+      soma += vtContribuicao[vtAntecessores[i]];
+   }
+
+   return soma;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Fim da faixa
+*
+*  Descrio:
+*    Retorna o id seguinte ao ltimo da faixa de nmero faixa, que comea
+*    em inicio, quando os ids de 0 a numIds - 1 so divididos em
+*    numFaixas faixas com somas parecidas de ids mais elementos, sendo
+*    vtInicio[id] a quantidade de elementos dos ids anteriores a id. A
+*    ltima faixa termina em numIds.
+*
+***********************************************************************/
+int FimDaFaixa(const int *vtInicio, int numIds, int inicio, int faixa, int numFaixas)
+{
+   int custoFim = (int) ((long long) (numIds + vtInicio[numIds]) * (faixa + 1) / numFaixas);
+   int id = inicio;
+
+   while (id < numIds && id + vtInicio[id] < custoFim)
+   {
+      id++;
+   }
+
+   return id;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Montar adjacncia ordenada
+*
+*  Descrio:
+*    Copia para pAdjacencia os vizinhos de cada vrtice, sucessores e
+*    antecessores juntos, sem repeties nem o prprio vrtice, em
+*    ordem crescente de id. Ids livres ficam sem vizinhos. Retorna 0 se
+*    faltou memria, caso em que nada fica alocado.
+*
+***********************************************************************/
+int MontarAdjacenciaOrdenada(tpGrafo *pGrafo, tpAdjacenciaOrdenada *pAdjacencia)
+{
+   int numIds = pGrafo->numIds, numVizinhos = 0, id, numElementos, i, reservado, fim;
+   int *vtVizinhos;
+   tpVertice *pVertice, *pAntecessor;
+   tpAresta *pAresta;
+   LIS_tpIterador iterador;
+   ADJ_tpIterador iterArestas;
+
+   pAdjacencia->numIds = numIds;
+   pAdjacencia->vtInicio = (int*) malloc((numIds + 1) * sizeof(int));
+   if (pAdjacencia->vtInicio == NULL)
+   {
+      return 0;
+   }
+
+   // Primeiro reserva espao para todas as arestas, nos dois sentidos
+   for (id = 0; id < numIds; id++)
+   {
+      pAdjacencia->vtInicio[id] = numVizinhos;
+      if (pGrafo->vtVertices[id] != NULL)
+      {
+         numElementos = ADJ_NumElementos(&pGrafo->vtVertices[id]->sucessores);
+         numVizinhos += numElementos;
+         LIS_NumELementos(pGrafo->vtVertices[id]->pAntecessores, &numElementos);
+         numVizinhos += numElementos;
+      }
+   }
+   pAdjacencia->vtInicio[numIds] = numVizinhos;
+
+   vtVizinhos = (int*) malloc((numVizinhos + 1) * sizeof(int));
+   if (vtVizinhos == NULL)
+   {
+      free(pAdjacencia->vtInicio);
+      return 0;
+   }
+   pAdjacencia->vtVizinhos = vtVizinhos;
+
+   // Depois copia, ordena e compacta os vizinhos de cada vrtice
+   numVizinhos = 0;
+   for (id = 0; id < numIds; id++)
+   {
+      pVertice = pGrafo->vtVertices[id];
+      reservado = pAdjacencia->vtInicio[id];
+      fim = reservado;
+      pAdjacencia->vtInicio[id] = numVizinhos;
+
+      if (pVertice == NULL)
+      {
+         continue;
+      }
+
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterArestas);
+      while (ADJ_AvancarIterador(&iterArestas, (void**)&pAresta) == ADJ_CondRetOK)
+      {
+         vtVizinhos[fim++] = pAresta->pVertice->id;
+      }
 
-	if (EstaVazio(pGrafo))
-	{
-		return GRA_CondRetGrafoVazio;
-	}
+      LIS_IniciarIterador(pVertice->pAntecessores, &iterador);
+      while (LIS_AvancarIterador(&iterador, (void**)&pAntecessor) == LIS_CondRetOK)
+      {
+         vtVizinhos[fim++] = pAntecessor->id;
+      }
 
-   graCondRet = ProcurarOrigem(pGrafo, nomeVertice, &pVertice);
-   if (graCondRet != GRA_CondRetOK)
-   {
-      return GRA_CondRetNaoAchou;
+      // O espao reservado nunca fica antes do j compactado
+      qsort(vtVizinhos + reservado, fim - reservado, sizeof(int), CompararInteiros);
+
+      for (i = reservado; i < fim; i++)
+      {
+         if (vtVizinhos[i] != id &&
+             (numVizinhos == pAdjacencia->vtInicio[id] || vtVizinhos[numVizinhos - 1] != vtVizinhos[i]))
+         {
+            vtVizinhos[numVizinhos++] = vtVizinhos[i];
+         }
+      }
    }
+   pAdjacencia->vtInicio[numIds] = numVizinhos;
 
-	pGrafo->pCorrente = pVertice;
+   return 1;
+}
 
-	return GRA_CondRetOK;
+/***********************************************************************
+*
+*  Funo: GRA Destruir adjacncia ordenada
+*
+***********************************************************************/
+void DestruirAdjacenciaOrdenada(tpAdjacenciaOrdenada *pAdjacencia)
+{
+   free(pAdjacencia->vtInicio);
+   free(pAdjacencia->vtVizinhos);
 }
 
-#ifdef _DEBUG
+/***********************************************************************
+*
+*  Funo: GRA Contar tringulos da faixa
+*
+*  Descrio:
+*    Conta os tringulos de cada vrtice u da faixa: para cada vizinho
+*    v de u, os vizinhos w de u maiores que v que tambm so vizinhos de
+*    v. Cada par {v, w}  contado uma vez.  a funo executada pelas
+*    linhas de GRA_ContarTriangulos; s escreve nas posies da faixa e
+*    no aloca memria.
+*
+***********************************************************************/
+void ContarTriangulosDaFaixa(void *pVazio)
+{
+   tpFaixaTriangulos *pFaixa = (tpFaixaTriangulos*) pVazio;
+   const int *vtInicio = pFaixa->pAdjacencia->vtInicio;
+   const int *vtVizinhos = pFaixa->pAdjacencia->vtVizinhos;
+   int id, i, vizinho, inicioVizinho, fimVizinho, meio;
+   long numTriangulos;
 
-GRA_tpCondRet VER_VerificaEspaosDoGrafo(tpGrafo *pGrafo, int *numFalhas)
+   for (id = pFaixa->inicio; id < pFaixa->fim; id++)
+   {
+      numTriangulos = 0;
+
+      for (i = vtInicio[id]; i < vtInicio[id + 1]; i++)
+      {
+         vizinho = vtVizinhos[i];
+
+         // Busca binria do primeiro vizinho do vizinho maior que ele
+         inicioVizinho = vtInicio[vizinho];
+         fimVizinho = vtInicio[vizinho + 1];
+         while (inicioVizinho < fimVizinho)
+         {
+            meio = inicioVizinho + (fimVizinho - inicioVizinho) / 2;
+            if (vtVizinhos[meio] <= vizinho)
+            {
+               inicioVizinho = meio + 1;
+            }
+            else
+            {
+               fimVizinho = meio;
+            }
+         }
+
+         numTriangulos += ContarComuns(vtVizinhos + i + 1, vtInicio[id + 1] - i - 1,
+                                       vtVizinhos + inicioVizinho,
+                                       vtInicio[vizinho + 1] - inicioVizinho);
+      }
+
+      pFaixa->vtTriangulos[id] = numTriangulos;
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Contar comuns
+*
+*  Descrio:
+*    Retorna quantos valores h nos dois vetores, crescentes e sem
+*    repeties. Com SSE2 compara blocos de quatro valores de cada
+*    vetor, todos contra todos, com trs rotaes do segundo bloco, e
+*    avana o bloco de menor ltimo valor; o resto  intercalado valor a
+*    valor.
+*
+***********************************************************************/
+int ContarComuns(const int *vtValores1, int numValores1, const int *vtValores2, int numValores2)
 {
-   int erroNaEstrutura = 0;
-   int numElemVer = 0, numElemOri = 0;
+   int i = 0, j = 0, numComuns = 0;
+#if defined( __AVX2__ ) || defined( GRA_SSE2 )
+   static const int vtBitsLigados[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+   __m128i bloco1, bloco2, iguais;
+   int ultimo1, ultimo2;
 
-   if(!CED_VerificarEspaco(pGrafo->pCorrente,NULL))
+   while (i + 4 <= numValores1 && j + 4 <= numValores2)
    {
-      CNT_CONTAR("verEspacos corrente nao eh espaco valido");
-      TST_NotificarFalha( "Controle do espao acusou erro." ) ;
-      (*numFalhas)++;
-      return GRA_CondRetErroNaEstrutura;
+      bloco1 = _mm_loadu_si128((const __m128i*) (vtValores1 + i));
+      bloco2 = _mm_loadu_si128((const __m128i*) (vtValores2 + j));
+
+      iguais = _mm_or_si128(
+         _mm_or_si128(_mm_cmpeq_epi32(bloco1, bloco2),
+                      _mm_cmpeq_epi32(bloco1, _mm_shuffle_epi32(bloco2, _MM_SHUFFLE(0, 3, 2, 1)))),
+         _mm_or_si128(_mm_cmpeq_epi32(bloco1, _mm_shuffle_epi32(bloco2, _MM_SHUFFLE(1, 0, 3, 2))),
+                      _mm_cmpeq_epi32(bloco1, _mm_shuffle_epi32(bloco2, _MM_SHUFFLE(2, 1, 0, 3)))));
+      numComuns += vtBitsLigados[_mm_movemask_ps(_mm_castsi128_ps(iguais))];
+
+      ultimo1 = vtValores1[i + 3];
+      ultimo2 = vtValores2[j + 3];
+      if (ultimo1 <= ultimo2)
+      {
+         i += 4;
+      }
+      if (ultimo2 <= ultimo1)
+      {
+         j += 4;
+      }
+   }
+#endif
+
+   while (i < numValores1 && j < numValores2)
+   {
+      if (vtValores1[i] < vtValores2[j])
+      {
+         i++;
+      }
+      else if (vtValores1[i] > vtValores2[j])
+      {
+         j++;
+      }
+      else
+      {
+         numComuns++;
+         i++;
+         j++;
+      }
+   }
+
+   return numComuns;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Obter rtulo
+*
+*  Descrio:
+*    Obtm o nmero do rtulo formado pelos tamanho primeiros caracteres
+*    de texto, internando-o se ele ainda no existe, e acrescenta uma
+*    referncia a ele, a ser desfeita por LiberarRotulo. Um rtulo j
+*    internado  procurado sem alocar memria, salvo se for maior que o
+*    vetor local. Retorna 0 se faltou memria.
+*
+***********************************************************************/
+int ObterRotulo(tpGrafo *pGrafo, const char *texto, size_t tamanho, int *pRotulo)
+{
+   char vtChave[64];
+   const char *chave = texto;
+   tpRotulo *pNovo, **vtRotulos;
+   void *pVazio;
+   int *vtRotulosLivres;
+   int capacidade;
+
+   if (texto[tamanho] != '\0')
+   {
+      chave = NULL;
+      if (tamanho < sizeof(vtChave))
+      {
+         memcpy(vtChave, texto, tamanho);
+         vtChave[tamanho] = '\0';
+         chave = vtChave;
+      }
+   }
+
+   if (chave != NULL && IND_Procurar(pGrafo->pIndiceRotulos, chave, &pVazio) == IND_CondRetOK)
+   {
+      ((tpRotulo*) pVazio)->numReferencias++;
+      *pRotulo = ((tpRotulo*) pVazio)->id;
+      return 1;
+   }
+
+   // O nome fica na mesma alocao do rtulo
+   pNovo = (tpRotulo*) malloc(sizeof(tpRotulo) + tamanho + 1);
+   if (pNovo == NULL)
+   {
+      return 0;
+   }
+   pNovo->nome = (char*) (pNovo + 1);
+   memcpy(pNovo->nome, texto, tamanho);
+   pNovo->nome[tamanho] = '\0';
+
+   if (chave == NULL && IND_Procurar(pGrafo->pIndiceRotulos, pNovo->nome, &pVazio) == IND_CondRetOK)
+   {
+      free(pNovo);
+      ((tpRotulo*) pVazio)->numReferencias++;
+      *pRotulo = ((tpRotulo*) pVazio)->id;
+      return 1;
+   }
+
+   if (pGrafo->numRotulosLivres == 0 && pGrafo->numRotulos == pGrafo->capRotulos)
+   {
+      capacidade = pGrafo->capRotulos < 16 ? 16 : pGrafo->capRotulos * 2;
+      vtRotulos = (tpRotulo**) RealocarEspaco(pGrafo->vtRotulos,
+                     pGrafo->capRotulos * sizeof(tpRotulo*), capacidade * sizeof(tpRotulo*));
+      if (vtRotulos == NULL)
+      {
+         free(pNovo);
+         return 0;
+      }
+      pGrafo->vtRotulos = vtRotulos;
+
+      // A pilha de livres nunca excede a quantidade de nmeros distribudos
+      vtRotulosLivres = (int*) RealocarEspaco(pGrafo->vtRotulosLivres,
+                           pGrafo->capRotulos * sizeof(int), capacidade * sizeof(int));
+      if (vtRotulosLivres == NULL)
+      {
+         free(pNovo);
+         return 0;
+      }
+      pGrafo->vtRotulosLivres = vtRotulosLivres;
+
+      pGrafo->capRotulos = capacidade;
+   }
+
+   if (IND_Inserir(pGrafo->pIndiceRotulos, pNovo->nome, pNovo) != IND_CondRetOK)
+   {
+      free(pNovo);
+      return 0;
+   }
+
+   if (pGrafo->numRotulosLivres > 0)
+   {
+      pNovo->id = pGrafo->vtRotulosLivres[--pGrafo->numRotulosLivres];
    }
    else
    {
-      CNT_CONTAR("verEspacos corrente eh espaco valido");
+      pNovo->id = pGrafo->numRotulos++;
+   }
+   pNovo->numReferencias = 1;
+   pGrafo->vtRotulos[pNovo->id] = pNovo;
+   *pRotulo = pNovo->id;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Liberar rtulo
+*
+*  Descrio:
+*    Desfaz uma referncia obtida por ObterRotulo. O rtulo sem
+*    referncias sai do ndice e o seu nmero  empilhado para ser
+*    reaproveitado, de forma que nomes de arestas que no se repetem no
+*    acumulam rtulos no grafo.
+*
+***********************************************************************/
+void LiberarRotulo(tpGrafo *pGrafo, int rotulo)
+{
+   tpRotulo *pRotulo = pGrafo->vtRotulos[rotulo];
+
+   pRotulo->numReferencias--;
+   if (pRotulo->numReferencias > 0)
+   {
+      return;
+   }
+
+   IND_Excluir(pGrafo->pIndiceRotulos, pRotulo->nome);
+   pGrafo->vtRotulos[rotulo] = NULL;
+   pGrafo->vtRotulosLivres[pGrafo->numRotulosLivres++] = rotulo;
+   free(pRotulo);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Destruir rtulos e expresses
+*
+*  Descrio:
+*    Libera os rtulos internados e as expresses compiladas do grafo,
+*    que est sendo destrudo.
+*
+***********************************************************************/
+void DestruirRotulosEExpressoes(tpGrafo *pGrafo)
+{
+   int i;
+
+   IND_DestruirIndice(pGrafo->pIndiceRotulos);
+
+   for (i = 0; i < pGrafo->numRotulos; i++)
+   {
+      free(pGrafo->vtRotulos[i]);
+   }
+   free(pGrafo->vtRotulos);
+   free(pGrafo->vtRotulosLivres);
+
+   for (i = 0; i < TAM_CACHE_EXPRESSOES; i++)
+   {
+      if (pGrafo->vtExpressoes[i] != NULL)
+      {
+         free(pGrafo->vtExpressoes[i]->texto);
+         free(pGrafo->vtExpressoes[i]);
+      }
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Obter expresso
+*
+*  Descrio:
+*    Procura a expresso entre as j compiladas ou a compila, guardando-a
+*    no lugar da mais antiga quando o cache est cheio. Os rtulos da
+*    expresso so internados na compilao, e cada posio guarda uma
+*    referncia ao seu, de forma que uma expresso guardada continua
+*    vlida quando arestas com esses rtulos so inseridas ou excludas
+*    depois.
+*
+*    A gramtica, em que espaos so ignorados, :
+*
+*       alternativas := sequencia { '|' sequencia }
+*       sequencia    := repeticao { '/' repeticao }
+*       repeticao    := primario { '*' | '+' | '?' }
+*       primario     := rotulo | '(' alternativas ')'
+*
+*  Condies de retorno:
+*    GRA_CondRetOK
+*    GRA_CondRetParametroInvalido  - expresso mal formada ou com mais de
+*                                    GRA_MAX_NOMES_EXPRESSAO rtulos.
+*    GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet ObterExpressao(tpGrafo *pGrafo, const char *texto, tpExpressao **ppExpressao)
+{
+   tpLeituraExpressao leitura;
+   tpSubexpressao inteira;
+   tpExpressao *pExpressao;
+   int i;
+
+   for (i = 0; i < TAM_CACHE_EXPRESSOES; i++)
+   {
+      if (pGrafo->vtExpressoes[i] != NULL && strcmp(pGrafo->vtExpressoes[i]->texto, texto) == 0)
+      {
+         *ppExpressao = pGrafo->vtExpressoes[i];
+         return GRA_CondRetOK;
+      }
+   }
+
+   pExpressao = (tpExpressao*) malloc(sizeof(tpExpressao));
+   if (pExpressao == NULL)
+   {
+      return GRA_CondRetFaltouMemoria;
+   }
+   memset(pExpressao, 0, sizeof(tpExpressao));
+
+   leitura.pProximo = texto;
+   leitura.pGrafo = pGrafo;
+   leitura.pExpressao = pExpressao;
+   leitura.condRet = GRA_CondRetOK;
+
+   if (LerAlternativas(&leitura, &inteira))
+   {
+      PularEspacos(&leitura);
+      if (*leitura.pProximo != '\0')
+      {
+         leitura.condRet = GRA_CondRetParametroInvalido;
+      }
+   }
+
+   if (leitura.condRet == GRA_CondRetOK)
+   {
+      pExpressao->texto = (char*) malloc(strlen(texto) + 1);
+      if (pExpressao->texto == NULL)
+      {
+         leitura.condRet = GRA_CondRetFaltouMemoria;
+      }
+   }
+
+   if (leitura.condRet != GRA_CondRetOK)
+   {
+      LiberarExpressao(pGrafo, pExpressao);
+      return leitura.condRet;
+   }
+
+   strcpy(pExpressao->texto, texto);
+   pExpressao->vtSeguintes[0] = inteira.primeiros;
+   pExpressao->finais = inteira.ultimos | (inteira.anulavel ? 1UL : 0);
+
+   for (i = 1; i <= pExpressao->numPosicoes; i++)
+   {
+      int j;
+
+      for (j = 1; j <= pExpressao->numPosicoes; j++)
+      {
+         if (pExpressao->vtRotulos[j] == pExpressao->vtRotulos[i])
+         {
+            pExpressao->vtMesmoRotulo[i] |= 1UL << j;
+         }
+      }
+   }
+
+   i = pGrafo->proximaExpressao;
+   if (pGrafo->vtExpressoes[i] != NULL)
+   {
+      LiberarExpressao(pGrafo, pGrafo->vtExpressoes[i]);
+   }
+   pGrafo->vtExpressoes[i] = pExpressao;
+   pGrafo->proximaExpressao = (i + 1) % TAM_CACHE_EXPRESSOES;
+
+   *ppExpressao = pExpressao;
+
+   return GRA_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Liberar expresso
+*
+*  Descrio:
+*    Desfaz as referncias das posies da expresso aos seus rtulos e
+*    libera a expresso, que no est no cache.
+*
+***********************************************************************/
+void LiberarExpressao(tpGrafo *pGrafo, tpExpressao *pExpressao)
+{
+   int i;
+
+   for (i = 1; i <= pExpressao->numPosicoes; i++)
+   {
+      LiberarRotulo(pGrafo, pExpressao->vtRotulos[i]);
+   }
+
+   free(pExpressao->texto);
+   free(pExpressao);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Ler alternativas
+*
+*  Descrio:
+*    L alternativas da expresso e calcula em pSub se ela aceita o
+*    caminho vazio, as posies por onde pode comear e as posies em
+*    que pode terminar. As funes de leitura retornam 0 no primeiro
+*    erro, guardado na leitura.
+*
+***********************************************************************/
+int LerAlternativas(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub)
+{
+   tpSubexpressao outra;
+
+   if (!LerSequencia(pLeitura, pSub))
+   {
+      return 0;
+   }
+
+   PularEspacos(pLeitura);
+   while (*pLeitura->pProximo == '|')
+   {
+      pLeitura->pProximo++;
+      if (!LerSequencia(pLeitura, &outra))
+      {
+         return 0;
+      }
+
+      pSub->anulavel = pSub->anulavel || outra.anulavel;
+      pSub->primeiros |= outra.primeiros;
+      pSub->ultimos |= outra.ultimos;
+      PularEspacos(pLeitura);
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Ler sequncia
+*
+*  Descrio:
+*    L repeties separadas por '/'. As posies em que a parte lida
+*    pode terminar passam a ser seguidas pelas que podem comear a
+*    prxima.
+*
+***********************************************************************/
+int LerSequencia(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub)
+{
+   tpSubexpressao proxima;
+
+   if (!LerRepeticao(pLeitura, pSub))
+   {
+      return 0;
+   }
+
+   PularEspacos(pLeitura);
+   while (*pLeitura->pProximo == '/')
+   {
+      pLeitura->pProximo++;
+      if (!LerRepeticao(pLeitura, &proxima))
+      {
+         return 0;
+      }
+
+      LigarSeguintes(pLeitura->pExpressao, pSub->ultimos, proxima.primeiros);
+      pSub->primeiros |= pSub->anulavel ? proxima.primeiros : 0;
+      pSub->ultimos = proxima.ultimos | (proxima.anulavel ? pSub->ultimos : 0);
+      pSub->anulavel = pSub->anulavel && proxima.anulavel;
+      PularEspacos(pLeitura);
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Ler repetio
+*
+*  Descrio:
+*    L um primrio seguido de operadores de repetio. Em '*' e '+' as
+*    posies em que o primrio termina passam a ser seguidas pelas em
+*    que ele comea.
+*
+***********************************************************************/
+int LerRepeticao(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub)
+{
+   if (!LerPrimario(pLeitura, pSub))
+   {
+      return 0;
    }
 
-   LIS_NumELementos(pGrafo->pVertices,&numElemVer);
-   LIS_IrInicioLista(pGrafo->pVertices);
-
-   while(numElemVer > 0)
+   PularEspacos(pLeitura);
+   while (*pLeitura->pProximo == '*' || *pLeitura->pProximo == '+' ||
+          *pLeitura->pProximo == '?')
    {
-      tpVertice *pVertice = NULL;
-      int numElemSuc = 0, numElemAnt = 0;
-
-      CNT_CONTAR("verEspacos percorre vertices");
-
-      LIS_ObterValor(pGrafo->pVertices,(void**)&pVertice);
-
-      if(VerificaVertice(pVertice,numFalhas) == GRA_CondRetErroNaEstrutura)
+      if (*pLeitura->pProximo != '?')
       {
-         CNT_CONTAR("verEspacos erro encontrado em vertice");
-         erroNaEstrutura = 1;
+         LigarSeguintes(pLeitura->pExpressao, pSub->ultimos, pSub->primeiros);
       }
-      else
+      if (*pLeitura->pProximo != '+')
       {
-         CNT_CONTAR("verEspacos sem erros encontrados em vertice");
+         pSub->anulavel = 1;
       }
 
-      LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
-      numElemVer--;
+      pLeitura->pProximo++;
+      PularEspacos(pLeitura);
    }
-   CNT_CONTAR("verEspacos percorreu todos os vertices");
-
-   LIS_NumELementos(pGrafo->pOrigens,&numElemOri);
-   LIS_IrInicioLista(pGrafo->pOrigens);
 
-   while(numElemOri > 0)
-   {
-      tpVertice *pVerticeOri = NULL;
+   return 1;
+}
 
-      CNT_CONTAR("verEspacos percorre origens");
+/***********************************************************************
+*
+*  Funo: GRA Ler primrio
+*
+*  Descrio:
+*    L um rtulo, que vira uma nova posio, ou alternativas entre
+*    parnteses. Um rtulo  uma sequncia de caracteres diferentes de
+*    espaos, de SEPARADOR_ROTULO e dos operadores.
+*
+***********************************************************************/
+int LerPrimario(tpLeituraExpressao *pLeitura, tpSubexpressao *pSub)
+{
+   tpExpressao *pExpressao = pLeitura->pExpressao;
+   size_t tamanho;
+   int posicao;
 
-      LIS_ObterValor(pGrafo->pOrigens,(void**)&pVerticeOri);
+   PularEspacos(pLeitura);
 
-      if(!CED_VerificarEspaco(pVerticeOri,NULL))
+   if (*pLeitura->pProximo == '(')
+   {
+      pLeitura->pProximo++;
+      if (!LerAlternativas(pLeitura, pSub))
       {
-         CNT_CONTAR("verEspacos erro encontrado em origem");
-         TST_NotificarFalha( "Controle do espao acusou erro no ponteiro vertice origem." ) ;
-         (*numFalhas)++;
-         erroNaEstrutura = 1;
+         return 0;
       }
-      else
+
+      if (*pLeitura->pProximo != ')')
       {
-         CNT_CONTAR("verEspacos sem erros encontrados em origem");
+         pLeitura->condRet = GRA_CondRetParametroInvalido;
+         return 0;
       }
-      LIS_AvancarElementoCorrente(pGrafo->pOrigens,1);
-      numElemOri--;
+
+      pLeitura->pProximo++;
+      return 1;
    }
-   CNT_CONTAR("verEspacos percorreu todas as origens");
 
-   if (erroNaEstrutura)
+   tamanho = strcspn(pLeitura->pProximo, " \t()|/*+?" SEPARADOR_ROTULO);
+   if (tamanho == 0 || pExpressao->numPosicoes == GRA_MAX_NOMES_EXPRESSAO)
    {
-      CNT_CONTAR("verEspacos estrutura contem erros");
-      return GRA_CondRetErroNaEstrutura;
+      pLeitura->condRet = GRA_CondRetParametroInvalido;
+      return 0;
    }
-   else
+
+   posicao = pExpressao->numPosicoes + 1;
+   if (!ObterRotulo(pLeitura->pGrafo, pLeitura->pProximo, tamanho,
+                    &pExpressao->vtRotulos[posicao]))
    {
-      CNT_CONTAR("verEspacos estrutura nao contem erros");
-      return GRA_CondRetOK;
+      pLeitura->condRet = GRA_CondRetFaltouMemoria;
+      return 0;
    }
+   pExpressao->numPosicoes = posicao;
+   pLeitura->pProximo += tamanho;
+
+   pSub->anulavel = 0;
+   pSub->primeiros = 1UL << posicao;
+   pSub->ultimos = 1UL << posicao;
+
+   return 1;
 }
 
-// Checa os espaos do vertice, das arestas + vertices apontados por elas e os vertices antecessores
-GRA_tpCondRet VerificaVertice(tpVertice *pVertice, int* numFalhas)
+/***********************************************************************
+*
+*  Funo: GRA Pular espaos
+*
+***********************************************************************/
+void PularEspacos(tpLeituraExpressao *pLeitura)
 {
-   int erroNaEstrutura = 0;
-   int numElemSuc = 0, numElemAnt = 0;
-   if(!CED_VerificarEspaco(pVertice,NULL))
-   {
-      CNT_CONTAR("verEspacos vertice nao eh valido");
-      TST_NotificarFalha( "Controle do espao acusou erro no vertice da lista de vertices." ) ;
-      (*numFalhas)++;
-      return GRA_CondRetErroNaEstrutura;
-   }
-   else
+   while (*pLeitura->pProximo == ' ' || *pLeitura->pProximo == '\t')
    {
-      CNT_CONTAR("verEspacos vertice eh valido");
+      pLeitura->pProximo++;
    }
+}
 
-   if(!CED_VerificarEspaco(pVertice->pValor,NULL))
+/***********************************************************************
+*
+*  Funo: GRA Ligar seguintes
+*
+*  Descrio:
+*    Acrescenta as posies de primeiros s que podem seguir cada posio
+*    de ultimos.
+*
+***********************************************************************/
+void LigarSeguintes(tpExpressao *pExpressao, unsigned long ultimos, unsigned long primeiros)
+{
+   int posicao;
+
+   for (posicao = 1; posicao <= pExpressao->numPosicoes; posicao++)
    {
-      CNT_CONTAR("verEspacos valor vertice nao eh valido");
-      TST_NotificarFalha( "Controle do espao acusou erro no valor do vertice." ) ;
-      (*numFalhas)++;
-      erroNaEstrutura = 1;
+      if (ultimos & (1UL << posicao))
+      {
+         pExpressao->vtSeguintes[posicao] |= primeiros;
+      }
    }
-   else
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Procurar grupo de rtulo
+*
+*  Descrio:
+*    Retorna o grupo das arestas do vrtice com o rtulo, ou NULL se o
+*    vrtice no tem aresta com ele.
+*
+***********************************************************************/
+tpGrupoRotulo * ProcurarGrupoRotulo(tpVertice *pVertice, int rotulo)
+{
+   int posicao = ADJ_Procurar(&pVertice->gruposRotulo, EspalharInteiro((unsigned int) rotulo),
+                              CompararGrupoERotulo, &rotulo);
+
+   if (posicao < 0)
    {
-      CNT_CONTAR("verEspacos valor vertice eh valido");
+      return NULL;
    }
 
-   // Checa os espaos das arestas e vertices apontados por ela
+   return (tpGrupoRotulo*) ADJ_ObterValor(&pVertice->gruposRotulo, posicao);
+}
 
-   LIS_NumELementos(pVertice->pSucessores, &numElemSuc);
-   LIS_IrInicioLista(pVertice->pSucessores);
+/***********************************************************************
+*
+*  Funo: GRA Agrupar aresta
+*
+*  Descrio:
+*    Acrescenta a aresta, que sai do vrtice, ao grupo do seu rtulo,
+*    criando o grupo se  a primeira. No faz nada enquanto os grupos do
+*    grafo no esto montados. Retorna 0 se faltou memria, sem alterar
+*    os grupos.
+*
+***********************************************************************/
+int AgruparAresta(tpGrafo *pGrafo, tpVertice *pVertice, tpAresta *pAresta)
+{
+   tpGrupoRotulo *pGrupo;
+   unsigned int chave = EspalharInteiro((unsigned int) (size_t) pAresta);
 
-   while(numElemSuc > 0)
+   if (!pGrafo->gruposMontados)
    {
-      tpAresta *pAresta = NULL;
-    
-      CNT_CONTAR("verEspacos percorrer sucessores");
-      
-      LIS_ObterValor(pVertice->pSucessores,(void**)&pAresta);
-
-      if(!CED_VerificarEspaco(pAresta,NULL))
-      {
-         CNT_CONTAR("verEspacos aresta nao eh valida");
-         TST_NotificarFalha( "Controle do espao acusou erro na aresta." ) ;
-         (*numFalhas)++;
-         erroNaEstrutura = 1;
-      }
-      else
-      {
-         CNT_CONTAR("verEspacos aresta eh valida");
-         
-         if(!CED_VerificarEspaco(pAresta->pVertice,NULL))
-         {
-            CNT_CONTAR("verEspacos sucessor nao eh valido");
-            TST_NotificarFalha( "Controle do espao acusou erro no ponteiro vertice da aresta." ) ;
-            (*numFalhas)++;
-            erroNaEstrutura = 1;
-         }
-         else
-         {
-            CNT_CONTAR("verEspacos sucessor eh valido");
-         }
-      }
-      LIS_AvancarElementoCorrente(pVertice->pSucessores,1);
-      numElemSuc--;
+      return 1;
    }
-   CNT_CONTAR("verEspacos percorreu todos os sucessores");
 
-   // Checa os espaos dos vertices antecessores
-
-   LIS_NumELementos(pVertice->pAntecessores, &numElemAnt);
-   LIS_IrInicioLista(pVertice->pAntecessores);
+   pGrupo = ProcurarGrupoRotulo(pVertice, pAresta->rotulo);
 
-   while(numElemAnt > 0)
+   if (pGrupo != NULL)
    {
-      tpVertice *pVerticeAnt = NULL;
-      
-      CNT_CONTAR("verEspacos percorre antecessores");
-
-      LIS_ObterValor(pVertice->pAntecessores,(void**)&pVerticeAnt);
-      if(!CED_VerificarEspaco(pVerticeAnt,NULL))
-      {
-         CNT_CONTAR("verEspacos antecessor nao eh valido");
-         TST_NotificarFalha( "Controle do espao acusou erro no ponteiro vertice antecessor." ) ;
-         (*numFalhas)++;
-         erroNaEstrutura = 1;
-      }
-      else
-      {
-         CNT_CONTAR("verEspacos antecessor eh valido");
-      }
-      LIS_AvancarElementoCorrente(pVertice->pAntecessores,1);
-      numElemAnt--;
+      return ADJ_Acrescentar(&pGrupo->arestas, pAresta, chave) == ADJ_CondRetOK;
    }
-   CNT_CONTAR("verEspacos percorreu todos os antecessores");
 
-   if (erroNaEstrutura)
+   pGrupo = (tpGrupoRotulo*) malloc(sizeof(tpGrupoRotulo));
+   if (pGrupo == NULL)
    {
-      CNT_CONTAR("verEspacos vertice contem erros");
-      return GRA_CondRetErroNaEstrutura;
+      return 0;
    }
-   else
+   pGrupo->rotulo = pAresta->rotulo;
+   ADJ_Iniciar(&pGrupo->arestas);
+
+   // Nas adjacncias vazias os primeiros elementos no alocam memria
+   ADJ_Acrescentar(&pGrupo->arestas, pAresta, chave);
+   if (ADJ_Acrescentar(&pVertice->gruposRotulo, pGrupo,
+                       EspalharInteiro((unsigned int) pGrupo->rotulo)) != ADJ_CondRetOK)
    {
-      CNT_CONTAR("verEspacos vertice nao contem erros");
-      return GRA_CondRetOK;
+      free(pGrupo);
+      return 0;
    }
+
+   return 1;
 }
 
-/***************************************************************************
+/***********************************************************************
 *
-*  Funo: GRA  Deturpar grafo
-*  ****/
-
-GRA_tpCondRet GRA_Deturpar(void *pGrafoParm, GRA_tpModosDeturpacao ModoDeturpar)
+*  Funo: GRA Desagrupar aresta
+*
+*  Descrio:
+*    Retira a aresta do grupo do seu rtulo, destruindo o grupo que
+*    fica vazio. No faz nada se a aresta no est agrupada.
+*
+***********************************************************************/
+void DesagruparAresta(tpGrafo *pGrafo, tpVertice *pVertice, tpAresta *pAresta)
 {
+   tpGrupoRotulo *pGrupo;
+   int posicao;
 
-   tpGrafo *pGrafo = NULL ;
-
-   if ( pGrafoParm == NULL )
+   if (!pGrafo->gruposMontados)
    {
-      return GRA_CondRetOK;
-   } /* if */
-
-   pGrafo = (tpGrafo*) pGrafoParm;
-
-   switch ( ModoDeturpar ) {
-   case DeturpaEliminaElementoCorrente :
-      {
-         DET_EliminaElementoCorrente(pGrafo);
-         break;
-      } 
-
-   case GRA_DeturpaAtribuiNullParaVerticeSucessor:
-      {
-         DET_AtribuiNullParaVerticeSucessor(pGrafo);
-         break;
-      }
-
-   case GRA_AtribuiNullAOPonteiroDoVerticePredecessor:
-      {
-         DET_AtribuiNullAOPonteiroDoVerticePredecessor(pGrafo);
-         break;
-      }
-
-   case GRA_LixoNaReferenciaParaSucessor:
-      {
-         DET_LixoNaReferenciaParaSucessor(pGrafo);
-         break;
-      }
-   
-   case GRA_LixoNaReferenciaParaAntecessor:
-      {
-         DET_LixoNaReferenciaParaAntecessor(pGrafo);
-         break;
-      }
+      return;
+   }
 
-   case GRA_ConteudoDoVerticeNULL:
-      {
-         DET_ConteudoDoVerticeNULL(pGrafo);
-         break;
-      }
+   pGrupo = ProcurarGrupoRotulo(pVertice, pAresta->rotulo);
+   if (pGrupo == NULL)
+   {
+      return;
+   }
 
-   case GRA_AlteraTipoDoValorDoVertice:
-      {
-         DET_AlteraTipoDoValorDoVertice(pGrafo);
-         break;
-      }
+   posicao = ADJ_Procurar(&pGrupo->arestas, EspalharInteiro((unsigned int) (size_t) pAresta),
+                          CompararPonteiros, pAresta);
+   if (posicao < 0)
+   {
+      return;
+   }
+   ADJ_Retirar(&pGrupo->arestas, posicao);
 
-   case GRA_DestacaVertice:
-      {
-         DET_DestacaVertice(pGrafo);
-         break;
-      }
+   if (ADJ_NumElementos(&pGrupo->arestas) == 0)
+   {
+      ADJ_Retirar(&pVertice->gruposRotulo,
+                  ADJ_Procurar(&pVertice->gruposRotulo, EspalharInteiro((unsigned int) pGrupo->rotulo),
+                               CompararPonteiros, pGrupo));
+      DestruirGrupoRotulo(pGrupo);
+   }
+}
 
-   case GRA_AtribuiNullAoCorrente:
-      {
-         DET_AtribuiNullAoCorrente(pGrafo);
-         break;
-      }
+/***********************************************************************
+*
+*  Funo: GRA Montar grupos de rtulo
+*
+*  Descrio:
+*    Agrupa por rtulo as arestas de todos os vrtices, em O(V + E), e
+*    marca os grupos do grafo como montados. Retorna 0 se faltou
+*    memria, caso em que nenhum grupo fica montado.
+*
+***********************************************************************/
+int MontarGruposRotulo(tpGrafo *pGrafo)
+{
+   tpAresta *pAresta;
+   ADJ_tpIterador iterador;
+   int id;
 
-   case GRA_AtribuiNullParaUmaOrigem:
-      {
-         DET_AtribuiNullParaUmaOrigem(pGrafo);
-         break;
-      }
-   case GRA_EspalhaLixoPelaEstrutura:
+   pGrafo->gruposMontados = 1;
+
+   for (id = 0; id < pGrafo->numIds; id++)
+   {
+      tpVertice *pVertice = pGrafo->vtVertices[id];
+
+      if (pVertice == NULL)
       {
-         DET_EspalharLixosPelaEstrutura(pGrafo);
-         break;
+         continue;
       }
-   case GRA_GrafoEhEspacoLixo:
+
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**) &pAresta) == ADJ_CondRetOK)
       {
-         DET_GrafoEhEspacoLixo(pGrafo);
-         break;
+         if (!AgruparAresta(pGrafo, pVertice, pAresta))
+         {
+            DesmontarGruposRotulo(pGrafo);
+            return 0;
+         }
       }
    }
 
-   return GRA_CondRetOK;
+   return 1;
 }
 
-/***************************************************************************
+/***********************************************************************
 *
-*  Funo: GRA  Verificar grafo
-*  ****/
-
-GRA_tpCondRet GRA_Verificar(void *pGrafoParm, int *numFalhas)
+*  Funo: GRA Desmontar grupos de rtulo
+*
+*  Descrio:
+*    Destri os grupos de todos os vrtices, sem destruir as arestas, e
+*    marca os grupos do grafo como no montados.
+*
+***********************************************************************/
+void DesmontarGruposRotulo(tpGrafo *pGrafo)
 {
-   int erroNaEstrutura = 0;
-   tpGrafo *pGrafo = NULL;
-   GRA_tpCondRet ret;
-   if (CED_ObterTipoEspaco(pGrafoParm) != GRA_TipoEspacoCabeca ||
-      !CED_VerificarEspaco(pGrafo,NULL))
+   int id;
+
+   for (id = 0; id < pGrafo->numIds; id++)
    {
-      CNT_CONTAR("ver00 grafo nao existe");
-      TST_NotificarFalha("Tentou verificar um grafo que no existe.");
-      (*numFalhas)++;
-      return GRA_CondRetErroNaEstrutura;
+      if (pGrafo->vtVertices[id] != NULL)
+      {
+         ADJ_Esvaziar(&pGrafo->vtVertices[id]->gruposRotulo, DestruirGrupoRotulo);
+      }
    }
-   CNT_CONTAR("ver00 grafo existe");
 
-   pGrafo = (tpGrafo*) pGrafoParm;
+   pGrafo->gruposMontados = 0;
+}
 
-    ret = VER_VerificaEspaosDoGrafo(pGrafo, numFalhas);
-    if (ret == GRA_CondRetErroNaEstrutura)
-    {
-       CNT_CONTAR("ver00 foi encontrado algum espaco invalido");
-       erroNaEstrutura = 1;
-    }
-    CNT_CONTAR("ver00 nao foi encontrado algum espaco invalido");
+/***********************************************************************
+*
+*  Funo: GRA Destruir grupo de rtulo
+*
+*  Descrio:
+*    Libera o grupo, sem destruir as arestas, que pertencem aos
+*    sucessores do vrtice.
+*
+***********************************************************************/
+void DestruirGrupoRotulo(void *pVazio)
+{
+   tpGrupoRotulo *pGrupo = (tpGrupoRotulo*) pVazio;
 
-   ret = VER_NenhumVerticeFoiLiberado(pGrafo, numFalhas);
-   if (ret == GRA_CondRetErroNaEstrutura)
+   ADJ_Esvaziar(&pGrupo->arestas, NULL);
+   free(pGrupo);
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Comparar grupo e rtulo
+*
+*  Descrio:
+*    Compara o rtulo de um grupo com o rtulo apontado por pVazio2,
+*    para a busca nos grupos de um vrtice.
+*
+***********************************************************************/
+int CompararGrupoERotulo(void *pVazio1, void *pVazio2)
+{
+   if (((tpGrupoRotulo*) pVazio1)->rotulo == *(int*) pVazio2)
    {
-      CNT_CONTAR("ver00 existe vertice liberado");
-      erroNaEstrutura = 1;
+      return 0;
    }
-   CNT_CONTAR("ver00 nao existe vertice liberado");
 
-    ret = VER_VerticeSucessorNaoEhNulo(pGrafo, numFalhas);
-    if (ret == GRA_CondRetErroNaEstrutura)
-    {
-       CNT_CONTAR("ver00 existe vertice cujo sucessor eh nulo");
-       erroNaEstrutura = 1;
-    }
-    CNT_CONTAR("ver00 nao existe vertice cujo sucessor eh nulo");
+   return -1;
+}
 
-    ret = VER_VerticePredecessorNaoEhNulo(pGrafo, numFalhas);
-    if (ret == GRA_CondRetErroNaEstrutura)
-    {
-       erroNaEstrutura = 1;
-    }
+/***********************************************************************
+*
+*  Funo: GRA Reservar posies na busca
+*
+*  Descrio:
+*    Garante que vtPosicaoNaBusca cobre todos os ids do grafo. As
+*    posies novas so zeradas uma nica vez; depois o vetor 
+*    reaproveitado sem ser limpo, porque cada posio  conferida contra
+*    a fila da ponta. Retorna 0 se faltou memria.
+*
+***********************************************************************/
+int ReservarPosicoesNaBusca(tpGrafo *pGrafo)
+{
+   int *vtPosicaoNaBusca;
 
-   ret = VER_NaoExisteLixoNaReferenciaParaSucessor(pGrafo, numFalhas);
-   if (ret == GRA_CondRetErroNaEstrutura)
+   if (pGrafo->numIds <= pGrafo->capPosicaoNaBusca)
    {
-      CNT_CONTAR("ver00 existe vertice que tem lixo como referencia para sucessor");
-      erroNaEstrutura = 1;
+      return 1;
    }
-   CNT_CONTAR("ver00 nao existe vertice que tem lixo como referencia para sucessor");
 
-   ret = VER_NaoExisteLixoNaReferenciaParaAntecessor(pGrafo, numFalhas);
-   if (ret == GRA_CondRetErroNaEstrutura)
+   vtPosicaoNaBusca = (int*) RealocarEspaco(pGrafo->vtPosicaoNaBusca,
+                         pGrafo->capPosicaoNaBusca * sizeof(int), pGrafo->capIds * sizeof(int));
+   if (vtPosicaoNaBusca == NULL)
    {
-      CNT_CONTAR("ver00 existe vertice que tem lixo como referencia para antecessor");
-      erroNaEstrutura = 1;
+      return 0;
    }
-   CNT_CONTAR("ver00 nao existe vertice que tem lixo como referencia para antecessor");
 
-   ret = VER_VerticesNaoPossuemConteudoNulo(pGrafo, numFalhas);
-   if (ret == GRA_CondRetErroNaEstrutura)
-   {
-      CNT_CONTAR("ver00 existe um vertice com conteudo nulo");
-      erroNaEstrutura = 1;
-   }
-   CNT_CONTAR("ver00 nao existe um vertice com conteudo nulo");
-   
-   ret = VER_NenhumVerticeTemConteudoComOTipoCorrompido(pGrafo, numFalhas);
-   if (ret == GRA_CondRetErroNaEstrutura)
-   {
-      erroNaEstrutura = 1;
-      CNT_CONTAR("ver00 existe vertice com conteudo de tipo errado");
-   }
-   CNT_CONTAR("ver00 nao existe vertice com conteudo de tipo errado");
+   memset(vtPosicaoNaBusca + pGrafo->capPosicaoNaBusca, 0,
+          (pGrafo->capIds - pGrafo->capPosicaoNaBusca) * sizeof(int));
 
-    ret = VER_NenhumVerticeEstaDestacado(pGrafo, numFalhas);
-    if (ret == GRA_CondRetErroNaEstrutura)
-    {
-      CNT_CONTAR("ver00 existe vertice destacado");
-       erroNaEstrutura = 1;
-    }
-    CNT_CONTAR("ver00 nao existe vertice destacado");
-   
-   ret = VER_CorrenteNaoEhNulo(pGrafo, numFalhas);
-   if (ret == GRA_CondRetErroNaEstrutura)
-   {
-      erroNaEstrutura = 1;
-      CNT_CONTAR("ver00 corrente eh nulo");
-   }
-   CNT_CONTAR("ver00 corrente nao eh nulo");
-   
-   ret = VER_NaoExisteOrigemNula(pGrafo, numFalhas);
-   if (ret == GRA_CondRetErroNaEstrutura)
+   pGrafo->vtPosicaoNaBusca = vtPosicaoNaBusca;
+   pGrafo->capPosicaoNaBusca = pGrafo->capIds;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Iniciar ponta da busca
+*
+*  Descrio:
+*    Inicia uma ponta vazia. sentido  1 para a que parte da origem pelos
+*    sucessores e -1 para a que parte do destino pelos antecessores.
+*
+***********************************************************************/
+void IniciarPontaBusca(tpPontaBusca *pPonta, int sentido)
+{
+   pPonta->vtPassos = NULL;
+   pPonta->numPassos = 0;
+   pPonta->capPassos = 0;
+   pPonta->inicioNivel = 0;
+   pPonta->sentido = sentido;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Acrescentar passo
+*
+*  Descrio:
+*    Pe o id no fim da fila da ponta, alcanado a partir da posio
+*    anterior, com a distncia de anterior mais 1, e registra a posio
+*    em vtPosicaoNaBusca com o sinal do sentido da ponta. Retorna 0 se
+*    faltou memria.
+*
+***********************************************************************/
+int AcrescentarPasso(tpGrafo *pGrafo, tpPontaBusca *pPonta, int id, int anterior)
+{
+   tpPassoBusca *vtPassos;
+   int capacidade;
+
+   if (pPonta->numPassos == pPonta->capPassos)
    {
-      CNT_CONTAR("ver00 existe origem nula");
-      erroNaEstrutura = 1;
+      capacidade = pPonta->capPassos < 64 ? 64 : pPonta->capPassos * 2;
+      vtPassos = (tpPassoBusca*) RealocarEspaco(pPonta->vtPassos,
+                    pPonta->capPassos * sizeof(tpPassoBusca), capacidade * sizeof(tpPassoBusca));
+      if (vtPassos == NULL)
+      {
+         return 0;
+      }
+      pPonta->vtPassos = vtPassos;
+      pPonta->capPassos = capacidade;
    }
-   CNT_CONTAR("ver00 nao existe origem nula");
 
-   if (erroNaEstrutura)
+   pPonta->vtPassos[pPonta->numPassos].id = id;
+   pPonta->vtPassos[pPonta->numPassos].anterior = anterior;
+   pPonta->vtPassos[pPonta->numPassos].distancia =
+      anterior < 0 ? 0 : pPonta->vtPassos[anterior].distancia + 1;
+   pPonta->numPassos++;
+   pGrafo->vtPosicaoNaBusca[id] = pPonta->sentido * pPonta->numPassos;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: GRA Posio na ponta
+*
+*  Descrio:
+*    Retorna a posio do id na fila da ponta, ou -1 se a ponta ainda
+*    no o alcanou. Um valor deixado em vtPosicaoNaBusca por outra
+*    busca no  confundido, porque a posio da fila tem de conter o
+*    prprio id.
+*
+***********************************************************************/
+int PosicaoNaPonta(const tpGrafo *pGrafo, const tpPontaBusca *pPonta, int id)
+{
+   int posicao = pGrafo->vtPosicaoNaBusca[id] * pPonta->sentido - 1;
+
+   if (posicao >= 0 && posicao < pPonta->numPassos && pPonta->vtPassos[posicao].id == id)
    {
-      CNT_CONTAR("ver00 com erros na estrutura");
-      return GRA_CondRetErroNaEstrutura;
+      return posicao;
    }
-   CNT_CONTAR("ver00 sem erros na estrutura");
 
-   return GRA_CondRetOK;
+   return -1;
 }
 
+/***********************************************************************
+*
+*  Funo: GRA Expandir nvel da busca
+*
+*  Descrio:
+*    Acrescenta  ponta os vizinhos ainda no alcanados dos vrtices do
+*    nvel corrente, que passam a formar o prximo nvel. Ao encontrar
+*    um vizinho j alcanado pela outra ponta, para e retorna 1, com as
+*    posies dos dois lados da aresta em *pPosPonta e *pPosOutra. Como
+*    os nveis so expandidos inteiros, o primeiro encontro fecha um
+*    caminho mnimo. Retorna 0 se no houve encontro e -1 se faltou
+*    memria.
+*
+***********************************************************************/
+int ExpandirNivelDaBusca(tpGrafo *pGrafo, tpPontaBusca *pPonta, const tpPontaBusca *pOutra,
+   int *pPosPonta, int *pPosOutra)
+{
+   int fimNivel = pPonta->numPassos, posicao, vizinho;
+   tpVizinhos vizinhos;
+
+   for (posicao = pPonta->inicioNivel; posicao < fimNivel; posicao++)
+   {
+      IniciarVizinhos(&vizinhos, pGrafo->vtVertices[pPonta->vtPassos[posicao].id],
+                      pPonta->sentido);
 
+      while (ProximoVizinho(&vizinhos, &vizinho))
+      {
+         *pPosOutra = PosicaoNaPonta(pGrafo, pOutra, vizinho);
+         if (*pPosOutra >= 0)
+         {
+            *pPosPonta = posicao;
+            return 1;
+         }
 
-/***************************************************************************
+         if (PosicaoNaPonta(pGrafo, pPonta, vizinho) < 0 &&
+             !AcrescentarPasso(pGrafo, pPonta, vizinho, posicao))
+         {
+            return -1;
+         }
+      }
+   }
+
+   pPonta->inicioNivel = fimNivel;
+
+   return 0;
+}
+
+/***********************************************************************
 *
-*  Funo: GRA  Total espao alocado
-*  ****/
-GRA_tpCondRet GRA_TotalEspacoAlocado(GRA_tppGrafo pGrafoParm, unsigned long *pTotalEspaco)
+*  Funo: GRA Descartar marcos
+*
+*  Descrio:
+*    Libera as distncias aos marcos, que so calculadas de novo na
+*    prxima consulta. Chamada quando as arestas ou os ids mudam.
+*
+***********************************************************************/
+void DescartarMarcos(tpGrafo *pGrafo)
 {
-   tpGrafo *pGrafo = (tpGrafo*) pGrafoParm;
-   *pTotalEspaco = pGrafo->totalEspacoAlocado;
-   return GRA_CondRetOK;
+   free(pGrafo->vtDistanciasMarcos);
+   pGrafo->vtDistanciasMarcos = NULL;
+   pGrafo->numMarcos = 0;
+   pGrafo->numIdsMarcos = 0;
 }
 
-#endif
-
-/*****  Cdigo das funes encapsuladas no mdulo  *****/
 /***********************************************************************
 *
-*  Funo: GRA Destruir vrtice
+*  Funo: GRA Calcular marcos
 *
 *  Descrio:
-*    Funo responsvel por destruir vrtices. Passada como ponteiro de funcao para listas de vrtices.
+*    Escolhe at numMarcosPedidos marcos, primeiro as origens, na ordem
+*    da lista, e depois os vrtices de maior grau, contando sucessores e
+*    antecessores, e calcula por buscas em largura a distncia de cada
+*    marco at cada vrtice e de cada vrtice at cada marco. Retorna 0
+*    se faltou memria, caso em que nada fica alocado.
 *
 ***********************************************************************/
-void DestruirVertice(void *pVazio)
+int CalcularMarcos(tpGrafo *pGrafo)
 {
-	tpVertice *pVertice = (tpVertice*) pVazio;
+   int vtMarcos[GRA_MAX_MARCOS], vtGraus[GRA_MAX_MARCOS];
+   int numIds = pGrafo->numIds, numMarcos = 0, numOrigens, id, grau, numElementos, i, j;
+   int *vtFila;
+   tpVertice *pVertice;
+   LIS_tpIterador iterador;
 
-#ifdef _DEBUG
-   LIS_TotalEspacoAlocado(pVertice->pAntecessores, &espacoAlocado);
-   pVertice->pGrafo->totalEspacoAlocado -= espacoAlocado;
-   
-   LIS_TotalEspacoAlocado(pVertice->pSucessores, &espacoAlocado);
-   pVertice->pGrafo->totalEspacoAlocado -= espacoAlocado;
-#endif
+   LIS_IniciarIterador(pGrafo->pOrigens, &iterador);
+   while (numMarcos < pGrafo->numMarcosPedidos &&
+          LIS_AvancarIterador(&iterador, (void**)&pVertice) == LIS_CondRetOK)
+   {
+      vtMarcos[numMarcos++] = pVertice->id;
+   }
+   numOrigens = numMarcos;
 
-	LIS_DestruirLista(pVertice->pAntecessores);
-	LIS_DestruirLista(pVertice->pSucessores);
-   
-#ifdef _DEBUG
-   pVertice->pGrafo->totalEspacoAlocado -= _msize(pVertice);
+   // Os de maior grau so mantidos em ordem decrescente depois das origens
+   for (id = 0; id < numIds; id++)
+   {
+      pVertice = pGrafo->vtVertices[id];
+      if (pVertice == NULL)
+      {
+         continue;
+      }
 
-   LIS_TotalEspacoAlocado(pVertice->pAntecessores, &espacoAlocado);
-   pVertice->pGrafo->totalEspacoAlocado += espacoAlocado;
-   
-   LIS_TotalEspacoAlocado(pVertice->pSucessores, &espacoAlocado);
-   pVertice->pGrafo->totalEspacoAlocado += espacoAlocado;
-#endif
+      numElementos = ADJ_NumElementos(&pVertice->sucessores);
+      grau = numElementos;
+      LIS_NumELementos(pVertice->pAntecessores, &numElementos);
+      grau += numElementos;
+
+      if (numMarcos == pGrafo->numMarcosPedidos &&
+          (numMarcos == numOrigens || grau <= vtGraus[numMarcos - 1]))
+      {
+         continue;
+      }
+
+      i = 0;
+      while (i < numOrigens && vtMarcos[i] != id)
+      {
+         i++;
+      }
+      if (i < numOrigens)
+      {
+         continue;
+      }
+
+      if (numMarcos < pGrafo->numMarcosPedidos)
+      {
+         numMarcos++;
+      }
+      for (j = numMarcos - 1; j > numOrigens && vtGraus[j - 1] < grau; j--)
+      {
+         vtMarcos[j] = vtMarcos[j - 1];
+         vtGraus[j] = vtGraus[j - 1];
+      }
+      vtMarcos[j] = id;
+      vtGraus[j] = grau;
+   }
 
-	pVertice->destruirValor(pVertice->pValor);
+   pGrafo->vtDistanciasMarcos = (int*) malloc((2 * (size_t) numMarcos * numIds + 1) * sizeof(int));
+   vtFila = (int*) malloc((numIds + 1) * sizeof(int));
+   if (pGrafo->vtDistanciasMarcos == NULL || vtFila == NULL)
+   {
+      free(pGrafo->vtDistanciasMarcos);
+      free(vtFila);
+      pGrafo->vtDistanciasMarcos = NULL;
+      return 0;
+   }
 
-	free(pVertice->nome);
+   pGrafo->numMarcos = numMarcos;
+   pGrafo->numIdsMarcos = numIds;
+   memset(pGrafo->vtDistanciasMarcos, 0xFF, 2 * (size_t) numMarcos * numIds * sizeof(int));
 
-	free(pVertice);
+   for (i = 0; i < numMarcos; i++)
+   {
+      MedirDistanciasDoMarco(pGrafo, vtMarcos[i], 2 * i, vtFila);
+      MedirDistanciasDoMarco(pGrafo, vtMarcos[i], 2 * i + 1, vtFila);
+   }
+
+   free(vtFila);
+
+   return 1;
 }
 
 /***********************************************************************
 *
-*  Funo: GRA Destruir aresta
+*  Funo: GRA Medir distncias do marco
 *
 *  Descrio:
-*    Funo responsvel por destruir arestas. Passada como ponteiro de funcao para listas de sucessores do vrtice.
+*    Busca em largura a partir do marco que preenche a coluna coluna das
+*    distncias: nas colunas pares, a distncia do marco at cada
+*    vrtice, seguindo os sucessores; nas mpares, a de cada vrtice at
+*    o marco, seguindo os antecessores. vtFila tem ao menos numIds
+*    posies.
 *
 ***********************************************************************/
-void DestruirAresta(void *pVazio)
+void MedirDistanciasDoMarco(tpGrafo *pGrafo, int marco, int coluna, int *vtFila)
 {
-	tpAresta *pAresta = (tpAresta*) pVazio;
-   
-#ifdef _DEBUG
-   pAresta->pGrafo->totalEspacoAlocado -= _msize(pAresta);
-#endif
+   int *vtDistancias = pGrafo->vtDistanciasMarcos + coluna;
+   int largura = 2 * pGrafo->numMarcos, inicio = 0, fim = 0, id, vizinho;
+   tpVizinhos vizinhos;
 
-	free(pAresta->nome);
-	free(pAresta);
+   vtDistancias[(size_t) marco * largura] = 0;
+   vtFila[fim++] = marco;
+
+   while (inicio < fim)
+   {
+      id = vtFila[inicio++];
+      IniciarVizinhos(&vizinhos, pGrafo->vtVertices[id], coluna % 2 == 0 ? 1 : -1);
+
+      while (ProximoVizinho(&vizinhos, &vizinho))
+      {
+         if (vtDistancias[(size_t) vizinho * largura] < 0)
+         {
+            vtDistancias[(size_t) vizinho * largura] = vtDistancias[(size_t) id * largura] + 1;
+            vtFila[fim++] = vizinho;
+         }
+      }
+   }
 }
 
 /***********************************************************************
 *
-*  Funo: GRA Comparar vrtice e nome
+*  Funo: GRA Limite inferior por marcos
 *
 *  Descrio:
-*    Funo responsvel por comparar vrtices pelo nome. Usado para fazer a busca na lista de vertices.
+*    Retorna o maior limite inferior da distncia de idOrigem a
+*    idDestino dado pela desigualdade triangular com cada marco, ou -1
+*    se algum marco garante que no h caminho: quando o marco alcana a
+*    origem mas no o destino, ou  alcanado pelo destino mas no pela
+*    origem. Custa O(numMarcos). Um id criado depois do clculo no tem
+*    arestas e  tratado como no alcanado por nenhum marco.
 *
 ***********************************************************************/
-int CompararVerticeENome( void *pVazio1, void *pVazio2 )
+int LimiteInferiorPorMarcos(const tpGrafo *pGrafo, int idOrigem, int idDestino)
 {
-	tpVertice *pVertice1 = (tpVertice*) pVazio1;
-	char *nomeBuscado = (char*) pVazio2;
+   const int *vtOrigem, *vtDestino;
+   int limite = 0, i, deMarcoOrigem, deMarcoDestino, ateMarcoOrigem, ateMarcoDestino;
+
+   if (idOrigem == idDestino)
+   {
+      return 0;
+   }
+
+   vtOrigem = idOrigem < pGrafo->numIdsMarcos ?
+                 pGrafo->vtDistanciasMarcos + 2 * (size_t) idOrigem * pGrafo->numMarcos : NULL;
+   vtDestino = idDestino < pGrafo->numIdsMarcos ?
+                 pGrafo->vtDistanciasMarcos + 2 * (size_t) idDestino * pGrafo->numMarcos : NULL;
+
+   for (i = 0; i < pGrafo->numMarcos; i++)
+   {
+      deMarcoOrigem = vtOrigem != NULL ? vtOrigem[2 * i] : -1;
+      ateMarcoOrigem = vtOrigem != NULL ? vtOrigem[2 * i + 1] : -1;
+      deMarcoDestino = vtDestino != NULL ? vtDestino[2 * i] : -1;
+      ateMarcoDestino = vtDestino != NULL ? vtDestino[2 * i + 1] : -1;
+
+      if ((deMarcoOrigem >= 0 && deMarcoDestino < 0) ||
+          (ateMarcoDestino >= 0 && ateMarcoOrigem < 0))
+      {
+         return -1;
+      }
+
+      if (deMarcoOrigem >= 0 && deMarcoDestino - deMarcoOrigem > limite)
+      {
+         limite = deMarcoDestino - deMarcoOrigem;
+      }
+      if (ateMarcoDestino >= 0 && ateMarcoOrigem - ateMarcoDestino > limite)
+      {
+         limite = ateMarcoOrigem - ateMarcoDestino;
+      }
+   }
 
-	return strcmp(pVertice1->nome, nomeBuscado);
+   return limite;
 }
 
 /***********************************************************************
 *
-*  Funo: GRA Comparar aresta e nome
+*  Funo: GRA Limite superior por marcos
 *
 *  Descrio:
-*    Funo responsvel por comparar arestas pelo nome. Usado para fazer a busca na lista de arestas.
+*    Retorna o comprimento do menor caminho de idOrigem a idDestino que
+*    passa por um marco, ou -1 se nenhum marco  alcanado pela origem e
+*    alcana o destino. Custa O(numMarcos).
 *
 ***********************************************************************/
-int CompararArestaENome(void *pVazio1, void *pVazio2)
+int LimiteSuperiorPorMarcos(const tpGrafo *pGrafo, int idOrigem, int idDestino)
 {
-	tpAresta *pAresta1 = (tpAresta*) pVazio1;
-	char *nomeBuscado = (char*) pVazio2;
+   const int *vtOrigem, *vtDestino;
+   int limite = -1, i;
+
+   if (idOrigem == idDestino)
+   {
+      return 0;
+   }
+
+   if (idOrigem >= pGrafo->numIdsMarcos || idDestino >= pGrafo->numIdsMarcos)
+   {
+      return -1;
+   }
+
+   vtOrigem = pGrafo->vtDistanciasMarcos + 2 * (size_t) idOrigem * pGrafo->numMarcos;
+   vtDestino = pGrafo->vtDistanciasMarcos + 2 * (size_t) idDestino * pGrafo->numMarcos;
+
+   for (i = 0; i < pGrafo->numMarcos; i++)
+   {
+      if (vtOrigem[2 * i + 1] >= 0 && vtDestino[2 * i] >= 0 &&
+          (limite < 0 || vtOrigem[2 * i + 1] + vtDestino[2 * i] < limite))
+      {
+         limite = vtOrigem[2 * i + 1] + vtDestino[2 * i];
+      }
+   }
 
-	return strcmp(pAresta1->nome, nomeBuscado);
+   return limite;
 }
 
 /***********************************************************************
 *
-*  Funo: GRA Est vazio
+*  Funo: GRA Inserir aberto
 *
 *  Descrio:
-*    Funo responsvel por verificar se o grafo est vazio.
+*    Acrescenta  fila de prioridade de GRA_CaminhoPorMarcos a posio
+*    da busca alcanada com a distncia dada e a estimativa total.
+*    Retorna 0 se faltou memria.
 *
 ***********************************************************************/
-int EstaVazio(tpGrafo *pGrafo)
+int InserirAberto(tpFilaAbertos *pAbertos, int estimativa, int distancia, int posicao)
 {
-   return pGrafo->pCorrente == NULL;
-}
+   tpAberto *vtAbertos, novo;
+   int capacidade, i, pai;
+
+   if (pAbertos->numAbertos == pAbertos->capAbertos)
+   {
+      capacidade = pAbertos->capAbertos < 64 ? 64 : pAbertos->capAbertos * 2;
+      vtAbertos = (tpAberto*) RealocarEspaco(pAbertos->vtAbertos,
+                     pAbertos->capAbertos * sizeof(tpAberto), capacidade * sizeof(tpAberto));
+      if (vtAbertos == NULL)
+      {
+         return 0;
+      }
+      pAbertos->vtAbertos = vtAbertos;
+      pAbertos->capAbertos = capacidade;
+   }
+
+   novo.estimativa = estimativa;
+   novo.distancia = distancia;
+   novo.posicao = posicao;
+
+   // Sobe no heap enquanto o pai sai depois
+   for (i = pAbertos->numAbertos++; i > 0; i = pai)
+   {
+      pai = (i - 1) / 2;
+      if (!AbertoAntes(&novo, &pAbertos->vtAbertos[pai]))
+      {
+         break;
+      }
+      pAbertos->vtAbertos[i] = pAbertos->vtAbertos[pai];
+   }
+   pAbertos->vtAbertos[i] = novo;
 
+   return 1;
+}
 
 /***********************************************************************
 *
-*  Funo: GRA Procurar Vrtice
+*  Funo: GRA Retirar aberto
 *
 *  Descrio:
-*    Funo responsvel por realizar uma pesquisa na lista de vrtices.
+*    Retira da fila de prioridade, que no est vazia, o aberto de menor
+*    estimativa total.
 *
 ***********************************************************************/
-GRA_tpCondRet ProcurarVertice(tpGrafo *pGrafo, char *nome, tpVertice **pVertice)
+void RetirarAberto(tpFilaAbertos *pAbertos, tpAberto *pAberto)
 {
-   LIS_tpCondRet lisCondRet;
-   *pVertice = NULL;
+   tpAberto *vtAbertos = pAbertos->vtAbertos;
+   tpAberto ultimo;
+   int i, filho;
 
-   if (nome == NULL)
-   {
-      return GRA_CondRetNaoAchou;
-   }
+   *pAberto = vtAbertos[0];
+   ultimo = vtAbertos[--pAbertos->numAbertos];
 
-	LIS_IrInicioLista(pGrafo->pVertices);
-	lisCondRet = LIS_ProcurarValor(pGrafo->pVertices, nome);
-	if (lisCondRet != LIS_CondRetOK)
+   // Desce o ltimo a partir da raiz enquanto algum filho sai antes dele
+   for (i = 0; 2 * i + 1 < pAbertos->numAbertos; i = filho)
    {
-      return GRA_CondRetNaoAchou;
+      filho = 2 * i + 1;
+      if (filho + 1 < pAbertos->numAbertos && AbertoAntes(&vtAbertos[filho + 1], &vtAbertos[filho]))
+      {
+         filho++;
+      }
+      if (!AbertoAntes(&vtAbertos[filho], &ultimo))
+      {
+         break;
+      }
+      vtAbertos[i] = vtAbertos[filho];
    }
-   else
-   {
-		void *pVazio;
-		LIS_ObterValor(pGrafo->pVertices, &pVazio);
-      *pVertice = (tpVertice*) pVazio;
-      return GRA_CondRetOK;
-	}
+   vtAbertos[i] = ultimo;
 }
 
-
 /***********************************************************************
 *
-*  Funo: GRA Procurar Origem
+*  Funo: GRA Aberto antes
 *
 *  Descrio:
-*    Funo responsvel por realizar uma pesquisa na lista de origens.
+*    Retorna 1 se pAberto1 deve sair da fila antes de pAberto2: menor
+*    estimativa total e, no empate, maior distncia j percorrida, que
+*    est mais perto do destino.
 *
 ***********************************************************************/
-GRA_tpCondRet ProcurarOrigem(tpGrafo *pGrafo, char *nome, tpVertice **pVertice)
+int AbertoAntes(const tpAberto *pAberto1, const tpAberto *pAberto2)
 {
-   LIS_tpCondRet lisCondRet;
-   *pVertice = NULL;
-
-   if (nome == NULL)
+   if (pAberto1->estimativa != pAberto2->estimativa)
    {
-      return GRA_CondRetNaoAchou;
+      return pAberto1->estimativa < pAberto2->estimativa;
    }
 
-	LIS_IrInicioLista(pGrafo->pOrigens);
-	lisCondRet = LIS_ProcurarValor(pGrafo->pOrigens, nome);
-	if (lisCondRet != LIS_CondRetOK)
-   {
-      return GRA_CondRetNaoAchou;
-   }
-   else
-   {
-		void *pVazio;
-		LIS_ObterValor(pGrafo->pOrigens, &pVazio);
-      *pVertice = (tpVertice*) pVazio;
-      return GRA_CondRetOK;
-	}
+   return pAberto1->distancia > pAberto2->distancia;
 }
 
-
 /***********************************************************************
 *
-*  Funo: GRA Procurar Aresta
+*  Funo: GRA Aplicar auto-organizao
 *
 *  Descrio:
-*    Funo responsvel por realizar uma pesquisa na lista de arestas partindo
-*    de um dado vrtice.
+*    Define, na lista de origens dada, a poltica de lista
+*    correspondente  do grafo.
 *
 ***********************************************************************/
-GRA_tpCondRet ProcurarAresta(tpVertice *pVertice, char *nome, tpAresta **pAresta)
+void AplicarAutoOrganizacao(const tpGrafo *pGrafo, LIS_tppLista pLista)
 {
-   LIS_tpCondRet lisCondRet;
-   *pAresta = NULL;
-
-   if (nome == NULL)
-   {
-      return GRA_CondRetNaoAchou;
-   }
-
-	LIS_IrInicioLista(pVertice->pSucessores);
-	lisCondRet = LIS_ProcurarValor(pVertice->pSucessores, nome);
-	if (lisCondRet != LIS_CondRetOK)
+   switch (pGrafo->autoOrganizacao)
    {
-      return GRA_CondRetNaoAchou;
+   case GRA_AutoOrganizacaoMoverParaFrente:
+      LIS_DefinirAutoOrganizacao(pLista, LIS_AutoOrganizacaoMoverParaFrente);
+      break;
+   case GRA_AutoOrganizacaoTranspor:
+      LIS_DefinirAutoOrganizacao(pLista, LIS_AutoOrganizacaoTranspor);
+      break;
+   default:
+      LIS_DefinirAutoOrganizacao(pLista, LIS_AutoOrganizacaoNenhuma);
+      break;
    }
-   else
-   {
-		void *pVazio;
-		LIS_ObterValor(pVertice->pSucessores, &pVazio);
-      *pAresta = (tpAresta*) pVazio;
-      return GRA_CondRetOK;
-	}
 }
 
-
 /***********************************************************************
 *
-*  Funo: GRA Existe Aresta
+*  Funo: GRA Auto-organizar sucessores
 *
 *  Descrio:
-*    Funo responsvel por verificar se existe uma aresta com o nome
-*    procurado partindo de um dado vrtice.
+*    Aplica a poltica do grafo  aresta achada na posio dada dos
+*    sucessores e retorna a posio em que ela ficou.
 *
 ***********************************************************************/
-int ExisteAresta(tpVertice *pVertice, char *nome)
+int AutoOrganizarSucessores(const tpGrafo *pGrafo, ADJ_tpAdjacencia *pSucessores,
+   int posicao)
 {
-   tpAresta*pAresta;
-   GRA_tpCondRet condRet;
-
-   condRet = ProcurarAresta(pVertice, nome, &pAresta);
-
-   return condRet == GRA_CondRetOK;
+   switch (pGrafo->autoOrganizacao)
+   {
+   case GRA_AutoOrganizacaoMoverParaFrente:
+      ADJ_Mover(pSucessores, posicao, 0);
+      return 0;
+   case GRA_AutoOrganizacaoTranspor:
+      if (posicao > 0)
+      {
+         ADJ_Mover(pSucessores, posicao, posicao - 1);
+         return posicao - 1;
+      }
+      return posicao;
+   default:
+      return posicao;
+   }
 }
 
-
 /***********************************************************************
 *
-*  Funo: GRA Existe Vrtice
+*  Funo: GRA Registrar busca
 *
 *  Descrio:
-*    Funo responsvel por verificar se existe um vrtice com o nome
-*    procurado.
+*    Conta uma busca por nome, que achou o elemento na posio dada, a
+*    partir de 1, ou no achou se a posio  0.
 *
 ***********************************************************************/
-int ExisteVertice(tpGrafo *pGrafo, char *nome)
+void RegistrarBusca(GRA_tpEstatisticasBusca *pEstatisticas, int posicao)
 {
-   tpVertice *pVertice;
-   GRA_tpCondRet condRet;
+   int faixa = 0;
 
-   condRet = ProcurarVertice(pGrafo, nome, &pVertice);
+   pEstatisticas->numBuscas++;
+   if (posicao == 0)
+   {
+      return;
+   }
 
-   return condRet == GRA_CondRetOK;
-}
+   pEstatisticas->numAchadas++;
+   pEstatisticas->somaPosicoes += posicao;
 
+   // A faixa  o menor i com posicao <= 2^i
+   while (faixa < GRA_NUM_FAIXAS_BUSCA - 1 && (1 << faixa) < posicao)
+   {
+      faixa++;
+   }
+   pEstatisticas->vtFaixas[faixa]++;
+}
 
 /***********************************************************************
 *
-*  Funo: GRA Existe Vrtice
+*  Funo: GRA Iniciar vizinhos
 *
 *  Descrio:
-*    Funo responsvel por verificar se existe uma origem com o nome
-*    procurado.
+*    Prepara o percurso dos vizinhos do vrtice: os destinos das arestas
+*    que saem dele, se sentido > 0, ou os seus antecessores.
 *
 ***********************************************************************/
-int ExisteOrigem(tpGrafo *pGrafo, char *nome)
+void IniciarVizinhos(tpVizinhos *pVizinhos, tpVertice *pVertice, int sentido)
 {
-   tpVertice *pVertice;
-   GRA_tpCondRet condRet;
-
-   condRet = ProcurarOrigem(pGrafo, nome, &pVertice);
-
-   return condRet == GRA_CondRetOK;
+   pVizinhos->sentido = sentido;
+   if (sentido > 0)
+   {
+      ADJ_IniciarIterador(&pVertice->sucessores, &pVizinhos->iterArestas);
+   }
+   else
+   {
+      LIS_IniciarIterador(pVertice->pAntecessores, &pVizinhos->iterAntecessores);
+   }
 }
 
-
-
 /***********************************************************************
 *
-*  Funo: GRA Destacar Vrtice
+*  Funo: GRA Prximo vizinho
 *
 *  Descrio:
-*    Funo responsvel por destacar o vrtice do resto do grafo.
-*    Operao realizada antes de excluir o vrtice.
+*    Entrega em *pId o id do prximo vizinho. Retorna 0 quando eles
+*    acabaram.
 *
 ***********************************************************************/
-void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
+int ProximoVizinho(tpVizinhos *pVizinhos, int *pId)
 {
-   
-	tpVertice *pVertice = NULL, *pVerticeOrigem = NULL;
-	tpAresta *pAresta = NULL;
-   int numElemLista = 0;
-   LIS_tppLista pAntecessores;
-   
-   // remove corrente vai para origem
-	// Navega para o inicio da lista de origens
-	LIS_IrInicioLista(pGrafo->pOrigens);
-	//Pega o valor do primeiro vrtice de origem
-	LIS_ObterValor(pGrafo->pOrigens,(void**)&pVerticeOrigem);
-
-   // Para cada item da lista de sucessores, remover elem que aponta para o corrente
-	LIS_NumELementos(pAlvo->pSucessores, &numElemLista);
-	LIS_IrInicioLista(pAlvo->pSucessores);
-
-	while(numElemLista > 0)
-	{
-      int numElems;
-      tpAresta *pAresta;
-      LIS_ObterValor(pAlvo->pSucessores, (void**) &pAresta);
-      
-      pAntecessores = pAresta->pVertice->pAntecessores;
-
-      #ifdef _DEBUG
-         LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
-         pGrafo->totalEspacoAlocado -= espacoAlocado;
-      #endif
-
-      LIS_NumELementos(pAntecessores, &numElems);
-      LIS_IrInicioLista(pAntecessores);
-      LIS_ProcurarValor(pAntecessores, pAlvo->nome);
-      LIS_ExcluirElemento(pAntecessores);
-      
-      #ifdef _DEBUG
-         LIS_TotalEspacoAlocado(pAntecessores, &espacoAlocado);
-         pGrafo->totalEspacoAlocado += espacoAlocado;
-      #endif
+   tpAresta *pAresta;
+   tpVertice *pAntecessor;
 
-      LIS_AvancarElementoCorrente(pAlvo->pSucessores, 1);
-      numElemLista--;
+   if (pVizinhos->sentido > 0)
+   {
+      if (ADJ_AvancarIterador(&pVizinhos->iterArestas, (void**)&pAresta) != ADJ_CondRetOK)
+      {
+         return 0;
+      }
+      *pId = pAresta->pVertice->id;
+      return 1;
    }
 
-	// Para cada item da lista de anteressores, remover aresta que aponta para o corrente
-	LIS_NumELementos(pAlvo->pAntecessores,&numElemLista);
-	LIS_IrInicioLista(pAlvo->pAntecessores);
-
-	while(numElemLista > 0)
-	{
-      LIS_tppLista pSucessores;
-		int nElem = 0;
-		LIS_ObterValor(pAlvo->pAntecessores,(void**)&pVertice);
-
-      pSucessores = pVertice->pSucessores;
-
-		LIS_NumELementos(pSucessores, &nElem);
-		LIS_IrInicioLista(pSucessores);
-      
-      #ifdef _DEBUG
-         LIS_TotalEspacoAlocado(pSucessores, &espacoAlocado);
-         pGrafo->totalEspacoAlocado -= espacoAlocado;
-      #endif
-
-		while(nElem > 0)
-		{
-			LIS_ObterValor(pSucessores,(void**)&pAresta);
-
-			if(!strcmp(pAresta->pVertice->nome, pAlvo->nome))
-			{
-				LIS_ExcluirElemento(pSucessores);
-				break;
-			}
-
-			LIS_AvancarElementoCorrente(pSucessores,1);
-			nElem--;
-		}
-      
-      #ifdef _DEBUG
-         LIS_TotalEspacoAlocado(pSucessores, &espacoAlocado);
-         pGrafo->totalEspacoAlocado += espacoAlocado;
-      #endif
-
-		LIS_AvancarElementoCorrente(pAlvo->pAntecessores,1);
-		numElemLista--;
-	}
-
-   
-   #ifdef _DEBUG
-      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
-      pGrafo->totalEspacoAlocado -= espacoAlocado;
-   #endif
-
-	//Exclui elemento corrente
-	LIS_IrInicioLista(pGrafo->pVertices);
-	LIS_ProcurarValor(pGrafo->pVertices, pAlvo->nome);
-	LIS_ExcluirElemento(pGrafo->pVertices);
-   
-   #ifdef _DEBUG
-      LIS_TotalEspacoAlocado(pGrafo->pVertices, &espacoAlocado);
-      pGrafo->totalEspacoAlocado += espacoAlocado;
-   #endif
-
-	pGrafo->pCorrente = pVerticeOrigem;
+   if (LIS_AvancarIterador(&pVizinhos->iterAntecessores, (void**)&pAntecessor) != LIS_CondRetOK)
+   {
+      return 0;
+   }
+   *pId = pAntecessor->id;
+   return 1;
 }
 
 #ifdef _DEBUG
@@ -1550,11 +10876,12 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_NenhumVerticeFoiLiberado(tpGrafo *pGrafo, int *numFalhas)
    {
+      LIS_tpIterador iterVertices;
       int numVerElem = 0;
       int erroNaEstrutura = 0;
 
       LIS_NumELementos(pGrafo->pVertices, &numVerElem);
-      LIS_IrInicioLista(pGrafo->pVertices);
+      LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
 
       while(numVerElem > 0)
       {
@@ -1563,7 +10890,7 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 
          CNT_CONTAR("ver01 percorrendo vertices");
 
-         LIS_ObterValor(pGrafo->pVertices,(void**)&pVertice);
+         LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
 
          if (CED_ObterTipoEspaco(pVertice) != GRA_TipoEspacoVertice)
          {
@@ -1577,7 +10904,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
             CNT_CONTAR("ver01 vertice nao foi liberado");
          }
 
-         LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
          numVerElem--;
       }
       CNT_CONTAR("ver01 percorreu todos os vertices");
@@ -1607,10 +10933,12 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_VerticeSucessorNaoEhNulo(tpGrafo *pGrafo, int *numFalhas)
    {
+      LIS_tpIterador iterVertices;
+      ADJ_tpIterador iterAdjacentes;
       int numVerElem = 0;
 
       LIS_NumELementos(pGrafo->pVertices, &numVerElem);
-      LIS_IrInicioLista(pGrafo->pVertices);
+      LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
 
       while(numVerElem > 0)
       {
@@ -1619,13 +10947,13 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 
          CNT_CONTAR("ver02 percorrendo vertices");
 
-         LIS_ObterValor(pGrafo->pVertices,(void**)&pVertice);
+         LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
 
          if (CED_ObterTipoEspaco(pVertice) == GRA_TipoEspacoVertice)
          {
             CNT_CONTAR("ver02 vertice eh valido");
-            LIS_NumELementos(pVertice->pSucessores,&numElem);
-            LIS_IrInicioLista(pVertice->pSucessores);
+            numElem = ADJ_NumElementos(&pVertice->sucessores);
+            ADJ_IniciarIterador(&pVertice->sucessores, &iterAdjacentes);
 
             while(numElem > 0)
             {
@@ -1633,7 +10961,7 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
          
                CNT_CONTAR("ver02 percorrendo sucessores");
 
-               LIS_ObterValor(pVertice->pSucessores, (void**)&pAresta);
+               ADJ_AvancarIterador(&iterAdjacentes, (void**)&pAresta);
 
                if(CED_ObterTipoEspaco(pAresta) == GRA_TipoEspacoAresta &&
                   pAresta->pVertice == NULL)
@@ -1647,7 +10975,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
                {
                   CNT_CONTAR("ver02 vertice destino da aresta nao eh nulo");
                }
-               LIS_AvancarElementoCorrente(pVertice->pSucessores,1);
                numElem--;
             }
             CNT_CONTAR("ver02 percorreu todos os sucessores");
@@ -1657,7 +10984,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
             CNT_CONTAR("ver02 vertice nao eh valido");
          }
 
-         LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
          numVerElem--;
       }
       CNT_CONTAR("ver02 percorreu todos os vertices");
@@ -1678,9 +11004,10 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_VerticePredecessorNaoEhNulo(tpGrafo *pGrafo, int *numFalhas)
    {
+      LIS_tpIterador iterVertices, iterAdjacentes;
       int numVerElem = 0;
       LIS_NumELementos(pGrafo->pVertices, &numVerElem);
-      LIS_IrInicioLista(pGrafo->pVertices);
+      LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
 
       while(numVerElem > 0)
       {
@@ -1689,20 +11016,20 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 
          CNT_CONTAR("ver03 percorre vertices");
 
-         LIS_ObterValor(pGrafo->pVertices, (void**)&pVertice);
+         LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
       
          if (CED_ObterTipoEspaco(pVertice) == GRA_TipoEspacoVertice)
          {
             CNT_CONTAR("ver03 vertice eh valido");
             LIS_NumELementos(pVertice->pAntecessores, &numElem);
-            LIS_IrInicioLista(pVertice->pAntecessores);
+            LIS_IniciarIterador(pVertice->pAntecessores, &iterAdjacentes);
             while(numElem > 0)
             {
                tpVertice *pVerticeAnt = NULL;
 
                CNT_CONTAR("ver03 percorre antecessores");
 
-               LIS_ObterValor(pVertice->pAntecessores, (void**)&pVerticeAnt);
+               LIS_AvancarIterador(&iterAdjacentes, (void**)&pVerticeAnt);
 
                if(pVerticeAnt == NULL)
                {
@@ -1716,7 +11043,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
                   CNT_CONTAR("ver03 antecessor nao eh nulo");
                }
 
-               LIS_AvancarElementoCorrente(pVertice->pAntecessores,1);
                numElem--;
             }
             CNT_CONTAR("ver03 percorreu todos os antecessores");
@@ -1726,7 +11052,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
             CNT_CONTAR("ver03 vertice nao eh valido");
          }
 
-         LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
          numVerElem--;
       }
       CNT_CONTAR("ver03 percorreu todos os vertices");
@@ -1747,9 +11072,11 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_NaoExisteLixoNaReferenciaParaSucessor(tpGrafo *pGrafo, int *numFalhas)
    {
+      LIS_tpIterador iterVertices;
+      ADJ_tpIterador iterAdjacentes;
       int numVerElem = 0;
       LIS_NumELementos(pGrafo->pVertices,&numVerElem);
-      LIS_IrInicioLista(pGrafo->pVertices);
+      LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
 
       while(numVerElem > 0)
       {
@@ -1758,13 +11085,13 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 
          CNT_CONTAR("ver04 percorre os vertices");
 
-         LIS_ObterValor(pGrafo->pVertices,(void**)&pVertice);
+         LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
 
          if (CED_ObterTipoEspaco(pVertice) == GRA_TipoEspacoVertice)
          {
             CNT_CONTAR("ver04 vertice eh valido");
-            LIS_NumELementos(pVertice->pSucessores,&numElemSucces);
-            LIS_IrInicioLista(pVertice->pSucessores);
+            numElemSucces = ADJ_NumElementos(&pVertice->sucessores);
+            ADJ_IniciarIterador(&pVertice->sucessores, &iterAdjacentes);
 
             while(numElemSucces > 0)
             {
@@ -1773,7 +11100,7 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 
                CNT_CONTAR("ver04 percorre os sucessores");
 
-               LIS_ObterValor(pVertice->pSucessores,(void**)&pAresta);
+               ADJ_AvancarIterador(&iterAdjacentes, (void**)&pAresta);
          
                if(CED_ObterTipoEspaco(pAresta) == GRA_TipoEspacoAresta &&
                   !CED_VerificarEspaco(pAresta->pVertice,NULL))
@@ -1785,7 +11112,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
                }
                CNT_CONTAR("ver04 vertice da aresta nao eh um espaco invalido");
 
-               LIS_AvancarElementoCorrente(pVertice->pSucessores,1);
                numElemSucces--;
             }
             CNT_CONTAR("ver04 percorreu todos os sucessores");
@@ -1795,7 +11121,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
             CNT_CONTAR("ver04 vertice nao eh valido");
          }
 
-         LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
          numVerElem--;
       }
       CNT_CONTAR("ver04 percorreu todos os vertices");
@@ -1816,9 +11141,10 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_NaoExisteLixoNaReferenciaParaAntecessor(tpGrafo *pGrafo, int *numFalhas)
    {
+      LIS_tpIterador iterVertices, iterAdjacentes;
       int numVerElem = 0;
       LIS_NumELementos(pGrafo->pVertices,&numVerElem);
-      LIS_IrInicioLista(pGrafo->pVertices);
+      LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
 
       while(numVerElem > 0)
       {
@@ -1827,13 +11153,13 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 
          CNT_CONTAR("ver05 percorre os vertices");
       
-         LIS_ObterValor(pGrafo->pVertices,(void**)&pVertice);
+         LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
 
          if (CED_ObterTipoEspaco(pVertice) == GRA_TipoEspacoVertice)
          {
             CNT_CONTAR("ver05 vertice eh valido");
             LIS_NumELementos(pVertice->pAntecessores,&numElemAnt);
-            LIS_IrInicioLista(pVertice->pAntecessores);
+            LIS_IniciarIterador(pVertice->pAntecessores, &iterAdjacentes);
 
             while(numElemAnt > 0)
             {
@@ -1841,7 +11167,7 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
       
                CNT_CONTAR("ver05 percorre os antecessores");
 
-               LIS_ObterValor(pVertice->pAntecessores,(void**)&pVerticeAnt);
+               LIS_AvancarIterador(&iterAdjacentes, (void**)&pVerticeAnt);
 
                if(!CED_VerificarEspaco(pVerticeAnt,NULL))
                {
@@ -1854,7 +11180,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
                {
                   CNT_CONTAR("ver05 espaco do antecessor eh valido");
                }
-               LIS_AvancarElementoCorrente(pVertice->pAntecessores,1);
                numElemAnt--;
             }
             CNT_CONTAR("ver05 percorreu todos os antecessores");
@@ -1864,7 +11189,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
             CNT_CONTAR("ver05 vertice nao eh valido");
          }
 
-         LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
          numVerElem--;
       }
       CNT_CONTAR("ver05 percorreu todos os vertices");
@@ -1884,9 +11208,10 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_VerticesNaoPossuemConteudoNulo(tpGrafo *pGrafo, int *numFalhas)
    {
+      LIS_tpIterador iterVertices;
       int numElem = 0;
       LIS_NumELementos(pGrafo->pVertices,&numElem);
-      LIS_IrInicioLista(pGrafo->pVertices);
+      LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
 
       while(numElem > 0)
       {
@@ -1894,7 +11219,7 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 
          CNT_CONTAR("ver06 percorre vertices");
 
-         LIS_ObterValor(pGrafo->pVertices,(void**)&pVertice);
+         LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
 
          if(pVertice->pValor == NULL)
          {
@@ -1908,7 +11233,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
             CNT_CONTAR("ver06 valor do vertice nao eh null");
          }
 
-         LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
          numElem--;
       }
 
@@ -1930,16 +11254,17 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_NenhumVerticeTemConteudoComOTipoCorrompido(tpGrafo *pGrafo, int *numFalhas)
    {
+      LIS_tpIterador iterVertices;
       int numElem = 0;
       LIS_NumELementos(pGrafo->pVertices,&numElem);
-      LIS_IrInicioLista(pGrafo->pVertices);
+      LIS_IniciarIterador(pGrafo->pVertices, &iterVertices);
 
       while(numElem > 0)
       {
          tpVertice *pVertice;
          CED_tpIdTipoEspaco tipoValor;
          CNT_CONTAR("ver07 percorre vertices");
-         LIS_ObterValor(pGrafo->pVertices,(void**)&pVertice);
+         LIS_AvancarIterador(&iterVertices, (void**)&pVertice);
 
          if (CED_ObterTipoEspaco(pVertice) == GRA_TipoEspacoVertice)
          {
@@ -1961,7 +11286,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
          {
             CNT_CONTAR("ver07 vertice nao eh valido");
          }
-         LIS_AvancarElementoCorrente(pGrafo->pVertices,1);
          numElem--;
       }
 
@@ -2035,7 +11359,8 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    GRA_tpCondRet VER_NaoExisteOrigemNula(tpGrafo *pGrafo, int *numFalhas)
    {
-      LIS_tpCondRet lisCondRet = LIS_CondRetOK;
+      LIS_tpIterador iterOrigens;
+      int *pValor;
       int estaVazia;
       LIS_EstaVazia(pGrafo->pOrigens, &estaVazia);
       if (estaVazia)
@@ -2048,12 +11373,10 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
          CNT_CONTAR("ver10 se origens nao vazia");
       }
       
-      LIS_IrInicioLista(pGrafo->pOrigens);
-      while (lisCondRet == LIS_CondRetOK)
+      LIS_IniciarIterador(pGrafo->pOrigens, &iterOrigens);
+      while (LIS_AvancarIterador(&iterOrigens, (void**)&pValor) == LIS_CondRetOK)
       {
-         int *pValor;
          CNT_CONTAR("ver10 percorre origens");
-         LIS_ObterValor(pGrafo->pOrigens, (void**) &pValor);
 
          if (*pValor == NULL)
          {
@@ -2066,8 +11389,6 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
          {
             CNT_CONTAR("ver10 valor origem nao eh nula");
          }
-
-         lisCondRet = LIS_AvancarElementoCorrente(pGrafo->pOrigens, 1);
       }
       CNT_CONTAR("ver10 saiu do percorre origens");
 
@@ -2106,7 +11427,13 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
    void DET_AtribuiNullParaVerticeSucessor(tpGrafo *pGrafo)
    {
       tpAresta *pAresta = NULL;
-      LIS_ObterValor(pGrafo->pCorrente->pSucessores,(void**)&pAresta);
+      ADJ_tpIterador iterador;
+
+      // A ltima aresta; as posies podem ter vagas
+      ADJ_IniciarIterador(&pGrafo->pCorrente->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**) &pAresta) == ADJ_CondRetOK)
+      {
+      }
       pAresta->pVertice = NULL;
    }
    
@@ -2137,9 +11464,14 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
 ***********************************************************************/
    void DET_LixoNaReferenciaParaSucessor(tpGrafo *pGrafo)
    {
-      tpAresta *pAresta;
+      tpAresta *pAresta = NULL;
+      ADJ_tpIterador iterador;
 
-      LIS_ObterValor(pGrafo->pCorrente->pSucessores, (void **) &pAresta);
+      // A ltima aresta; as posies podem ter vagas
+      ADJ_IniciarIterador(&pGrafo->pCorrente->sucessores, &iterador);
+      while (ADJ_AvancarIterador(&iterador, (void**) &pAresta) == ADJ_CondRetOK)
+      {
+      }
 
       pAresta->pVertice = (tpVertice*)(EspacoLixo);
    }
@@ -2264,6 +11596,8 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
    void DET_EspalharLixosPelaEstrutura(tpGrafo *pGrafo)
    {
       tpVertice *pVertice;
+      tpAresta *pAresta;
+      ADJ_tpIterador iterador;
       LIS_AlterarValor(pGrafo->pOrigens, EspacoLixo);
       LIS_AlterarValor(pGrafo->pVertices, EspacoLixo);
       LIS_IrInicioLista(pGrafo->pVertices);
@@ -2272,7 +11606,11 @@ void DestacarVertice(tpGrafo *pGrafo, tpVertice *pAlvo)
       LIS_ObterValor(pGrafo->pVertices, (void**) &pVertice);
       pVertice->pValor = EspacoLixo;
       
-      LIS_AlterarValor(pVertice->pSucessores, EspacoLixo);
+      ADJ_IniciarIterador(&pVertice->sucessores, &iterador);
+      if (ADJ_AvancarIterador(&iterador, (void**) &pAresta) == ADJ_CondRetOK)
+      {
+         pAresta->pVertice = (tpVertice*) EspacoLixo;
+      }
    }
 
    
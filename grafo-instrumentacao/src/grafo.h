@@ -15,6 +15,31 @@
 *     Verso  Autor    Data        Observaes
 *     1.0     hg & rc  06/out/13   Preparao do mdulo para trabalhar com grafos direcionados.
 *     2.0     hg & rc  03/dez/13   Adaptao para uma estrutura auto-verificvel.
+*     3.0     rc       19/out/26   Vises de subgrafos induzidos sem cpia.
+*     3.1     rc       19/out/26   Marcadores de vrtices reutilizveis com reincio por poca.
+*     3.2     rc       19/out/26   Reordenao dos vrtices para localidade de memria.
+*     3.3     rc       19/out/26   Publicao somente leitura em memria compartilhada.
+*     3.4     rc       19/out/26   Modo persistente com registro de escrita antecipada.
+*     3.5     rc       19/out/26   ndice ordenado de nomes e listagem por prefixo e intervalo.
+*     3.6     rc       19/out/26   Nomes curtos guardados dentro do vrtice e da aresta.
+*     3.7     rc       19/out/26   Modo de chaves de largura fixa com comparao vetorial.
+*     3.8     rc       19/out/26   Valores de tamanho fixo guardados dentro do vrtice.
+*     3.9     rc       19/out/26   Destruio em lote, opcionalmente em segundo plano.
+*     3.10    rc       19/out/26   ndice dos destinos de cada vrtice.
+*     3.11    rc       19/out/26   Percurso por funes de visita, tambm em paralelo.
+*     3.12    rc       19/out/26   Consultas que no alteram o corrente das listas.
+*     3.13    rc       19/out/26   Buscas nas listas com comparao expandida pelo compilador.
+*     3.14    rc       19/out/26   Percursos retomveis, avanados em fatias de passos.
+*     3.15    rc       19/out/26   Assinaturas de mudanas, entregues em lotes ou por anel.
+*     3.16    rc       19/out/26   Ordem topolgica mantida a cada insero de aresta.
+*     3.17    rc       19/out/26   Componentes fracamente conexos por unio e busca.
+*     3.18    rc       19/out/26   PageRank e PageRank personalizado em paralelo.
+*     3.19    rc       19/out/26   Contagem de tringulos e decomposio em k-ncleos.
+*     3.20    rc       19/out/26   Caminhos restritos por expresses sobre rtulos de arestas.
+*     3.21    rc       19/out/26   Caminho mnimo entre dois vrtices por busca bidirecional.
+*     3.22    rc       19/out/26   Distncias estimadas por marcos e caminho mnimo por A*.
+*     3.23    rc       19/out/26   Listas de sucessores e de origens auto-organizveis.
+*     3.24    rc       19/out/26   Arestas de sada em adjacncias adaptveis ao grau.
 *
 *  Descrio do mdulo
 *     Implementa grafos direcionados com manipulao, ou seja,  possivel criar, inserir
@@ -28,7 +53,8 @@
 *     Os grafos possuem uma cabea encapsulando o seu estado.
 *
 *     Cada grafo armazena dados genricos.
-*     Cada vrtice do grafo possui uma referncia para o valor.
+*     Cada vrtice do grafo possui uma referncia para o valor, ou, nos
+*     grafos criados com GRA_CriarGrafoComValoresFixos, o prprio valor.
 *
 *     Esta  uma estrutura auto-verificvel.
 *
@@ -40,12 +66,53 @@
    #define GRAFO_EXT extern
 #endif
 
+#include <stddef.h>
+
 /***** Declaraes exportadas pelo mdulo *****/
 
+/* Maior tamanho dos valores guardados dentro do vrtice */
+#define GRA_MAX_TAM_VALOR 256
+
+/* Maior quantidade de tarefas de GRA_ParaCadaVerticeParalelo, GRA_PageRank e
+   GRA_ContarTriangulos */
+#define GRA_MAX_TAREFAS 64
+
+/* Maior quantidade de rtulos numa expresso de GRA_AlcancarPorExpressao */
+#define GRA_MAX_NOMES_EXPRESSAO 31
+
+/* Maior quantidade de marcos de GRA_PrepararMarcos */
+#define GRA_MAX_MARCOS 64
+
+/* Quantidade de faixas de posies de GRA_tpEstatisticasBusca */
+#define GRA_NUM_FAIXAS_BUSCA 8
+
 /* Tipo referncia para um grafo */
 
 typedef struct GRA_stGrafo * GRA_tppGrafo ;
 
+/* Tipo referncia para uma viso de subgrafo induzido */
+
+typedef struct GRA_stVisao * GRA_tppVisao ;
+
+/* Tipo referncia para um marcador de vrtices visitados */
+
+typedef struct GRA_stMarcador * GRA_tppMarcador ;
+
+/* Tipo referncia para uma publicao do grafo em memria compartilhada */
+typedef struct GRA_stPublicacao * GRA_tppPublicacao ;
+
+/* Tipo referncia para um grafo somente leitura anexado de memria compartilhada */
+typedef struct GRA_stGrafoCompartilhado * GRA_tppGrafoCompartilhado ;
+
+/* Tipo referncia para uma destruio de grafo em segundo plano */
+typedef struct GRA_stDestruicao * GRA_tppDestruicao ;
+
+/* Tipo referncia para um percurso retomvel */
+typedef struct GRA_stPercurso * GRA_tppPercurso ;
+
+/* Tipo referncia para uma assinatura das mudanas do grafo */
+typedef struct GRA_stAssinatura * GRA_tppAssinatura ;
+
 /***********************************************************************
 *
 *  Tipo de dados: GRA Condies de retorno
@@ -73,14 +140,182 @@ typedef enum {
    GRA_CondRetJaExiste,
       /* Nome do vrtice ou aresta est repetido */
 
-   GRA_CondRetFaltouMemoria
+   GRA_CondRetFaltouMemoria,
       /* Faltou memria ao tentar alocar algo */
+
+   GRA_CondRetErroSistema,
+      /* O sistema operacional recusou a operao */
+
+   GRA_CondRetParametroInvalido,
+      /* Parmetro fora dos valores aceitos pelo grafo */
+
+   GRA_CondRetCriaCiclo
+      /* A aresta fecharia um ciclo num grafo que mantm ordem topolgica */
  
 #ifdef _DEBUG
    ,GRA_CondRetErroNaEstrutura
 #endif
 } GRA_tpCondRet;
 
+/***********************************************************************
+*
+*  Tipo de dados: GRA Ordens de reordenao
+*
+*
+*  Descrio do tipo
+*     Critrios usados por GRA_Reordenar para escolher a nova ordem dos
+*     vrtices na memria.
+*
+***********************************************************************/
+
+typedef enum {
+
+   GRA_OrdemLargura,
+      /* Percurso em largura pelos sucessores, a partir das origens */
+
+   GRA_OrdemCuthillMcKeeReversa,
+      /* Cuthill-McKee reverso, ignorando o sentido das arestas */
+
+   GRA_OrdemGrau
+      /* Grau (sucessores mais antecessores) decrescente */
+
+} GRA_tpOrdem;
+
+/***********************************************************************
+*
+*  Tipo de dados: GRA Modos de percurso
+*
+*
+*  Descrio do tipo
+*     Ordem em que GRA_AvancarPercurso visita os vrtices alcanveis.
+*
+***********************************************************************/
+
+typedef enum {
+
+   GRA_PercursoEmLargura,
+      /* Por distncia crescente da origem, em nmero de arestas */
+
+   GRA_PercursoEmProfundidade
+      /* Em pr-ordem, seguindo os sucessores na ordem de insero */
+
+} GRA_tpModoPercurso;
+
+/***********************************************************************
+*
+*  Tipo de dados: GRA Tipos de mudana
+*
+*
+*  Descrio do tipo
+*     Alteraes do grafo comunicadas s assinaturas.
+*
+***********************************************************************/
+
+typedef enum {
+
+   GRA_MudancaInserirVertice,
+      /* nomeVertice foi inserido */
+
+   GRA_MudancaDestruirVertice,
+      /* nomeVertice foi destrudo. As arestas que saam dele ou chegavam
+         a ele foram destrudas junto, sem mudanas prprias */
+
+   GRA_MudancaInserirAresta,
+      /* nomeAresta foi inserida de nomeVertice para nomeDestino */
+
+   GRA_MudancaDestruirAresta,
+      /* nomeAresta, que saa de nomeVertice, foi destruda */
+
+   GRA_MudancaAlterarValor
+      /* O valor de nomeVertice foi alterado */
+
+} GRA_tpTipoMudanca;
+
+/***********************************************************************
+*
+*  Tipo de dados: GRA Mudana
+*
+*
+*  Descrio do tipo
+*     Registro de uma alterao do grafo. Os nomes so cpias guardadas
+*     pela assinatura; no so os nomes do grafo.
+*
+***********************************************************************/
+
+typedef struct {
+
+   GRA_tpTipoMudanca tipo;
+      /* O que foi alterado */
+
+   unsigned long numSequencia;
+      /* Posio da mudana entre as da assinatura, a partir de 1. Um
+         salto indica mudanas perdidas por falta de espao */
+
+   const char *nomeVertice;
+      /* Vrtice inserido, destrudo ou alterado, ou origem da aresta */
+
+   const char *nomeAresta;
+      /* Nome da aresta, ou NULL nas mudanas de vrtice */
+
+   const char *nomeDestino;
+      /* Destino da aresta inserida, ou NULL */
+
+} GRA_tpMudanca;
+
+/***********************************************************************
+*
+*  Tipo de dados: GRA Polticas de auto-organizao
+*
+*
+*  Descrio do tipo
+*     O que GRA_SeguirPelaAresta e GRA_IrParaAOrigem fazem com a aresta
+*     ou a origem achada na lista em que procuram pelo nome.
+*
+***********************************************************************/
+
+typedef enum {
+
+   GRA_AutoOrganizacaoNenhuma,
+      /* As listas ficam na ordem de insero */
+
+   GRA_AutoOrganizacaoMoverParaFrente,
+      /* O achado passa a ser o primeiro da lista */
+
+   GRA_AutoOrganizacaoTranspor
+      /* O achado troca de lugar com o anterior */
+
+} GRA_tpAutoOrganizacao;
+
+/***********************************************************************
+*
+*  Tipo de dados: GRA Estatsticas de busca
+*
+*
+*  Descrio do tipo
+*     Posies em que as buscas por nome de uma lista acharam o que
+*     procuravam, contadas a partir de 1.
+*
+***********************************************************************/
+
+typedef struct {
+
+   long numBuscas;
+      /* Quantidade de buscas */
+
+   long numAchadas;
+      /* Quantidade de buscas que acharam o nome */
+
+   long somaPosicoes;
+      /* Soma das posies das buscas que acharam; dividida por
+         numAchadas, d a posio mdia */
+
+   long vtFaixas[GRA_NUM_FAIXAS_BUSCA];
+      /* Buscas que acharam, por faixa de posio: a faixa 0  a posio
+         1, a faixa i  de 2^(i-1) + 1 a 2^i, e a ltima inclui as
+         posies maiores */
+
+} GRA_tpEstatisticasBusca;
+
 /***********************************************************************
 *
 *  $TC Tipo de dados: ARV Modos de deturpar
@@ -167,6 +402,66 @@ typedef enum {
 ***********************************************************************/
 GRA_tpCondRet GRA_CriarGrafo(GRA_tppGrafo *ppGrafo, void (*destruirValor)(void *pValor));
 
+/***********************************************************************
+*
+*  Funo: GRA Criar grafo com chaves fixas
+*
+*  Descrio
+*     Cria um grafo cujos nomes de vrtices e arestas so guardados como
+*     chaves de largura fixa, completadas com zeros. As buscas por nome
+*     nas listas de arestas e de origens comparam a chave inteira com uma
+*     nica comparao vetorial (SSE2 ou AVX2, quando disponveis), em vez
+*     de comparar caractere a caractere. Indicado para nomes do tipo
+*     identificador, de tamanho parecido.
+*
+*     Os nomes devem ter menos que larguraChave caracteres. Com largura 16
+*     a chave fica dentro do vrtice ou da aresta; com 32 ocupa um bloco
+*     prprio.
+*
+*  Parmetros
+*     ppGrafo           - Referncia usada para retorno do grafo criado.
+*     destruirValor     - Funo que destri os valores dos vrtices.
+*     larguraChave      - 16 ou 32.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetParametroInvalido  - largura diferente de 16 e 32.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CriarGrafoComChavesFixas(GRA_tppGrafo *ppGrafo,
+     void (*destruirValor)(void *pValor), int larguraChave);
+
+/***********************************************************************
+*
+*  Funo: GRA Criar grafo com valores fixos
+*
+*  Descrio
+*     Cria um grafo cujos valores tm todos tamValor bytes e so
+*     guardados dentro do prprio vrtice, logo aps os seus campos.
+*     Assim a insero faz uma alocao a menos e a leitura do valor no
+*     segue outro ponteiro. O grafo no  dono de nenhum espao externo
+*     de valor, portanto no h funo de destruio.
+*
+*     GRA_InserirVertice copia tamValor bytes de pValor, ou zera o valor
+*     se pValor for NULL; o espao de pValor continua do chamador.
+*     GRA_ObterValorCorrente retorna o endereo do valor dentro do
+*     vrtice, vlido at o vrtice ser destrudo ou o grafo reordenado.
+*     O valor  alterado com GRA_GravarValorCorrente; GRA_AlterarValorCorrente
+*     no  aceita.
+*
+*  Parmetros
+*     ppGrafo     - Referncia usada para retorno do grafo criado.
+*     tamValor    - tamanho dos valores em bytes, de 1 a GRA_MAX_TAM_VALOR.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetParametroInvalido  - tamanho fora dos limites.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CriarGrafoComValoresFixos(GRA_tppGrafo *ppGrafo, int tamValor);
+
 /***********************************************************************
 *
 *  Funo: GRA Destruir grafo
@@ -181,6 +476,9 @@ GRA_tpCondRet GRA_CriarGrafo(GRA_tppGrafo *ppGrafo, void (*destruirValor)(void *
 *
 *  Condies de retorno
 *     - GRA_CondRetOK
+*     - GRA_CondRetErroSistema  - grafo persistente cujo ltimo grupo de
+*                                 registros no pde ser confirmado. O
+*                                 grafo  destrudo mesmo assim.
 *
 *  Assertivas de entrada
 *     - Valem as assertivas estruturais do grafo direcionado.
@@ -191,6 +489,59 @@ GRA_tpCondRet GRA_CriarGrafo(GRA_tppGrafo *ppGrafo, void (*destruirValor)(void *
 ***********************************************************************/
 GRA_tpCondRet GRA_DestruirGrafo(GRA_tppGrafo *ppGrafo);
 
+/***********************************************************************
+*
+*  Funo: GRA Destruir grafo em lote
+*
+*  Descrio
+*     Destri o grafo como GRA_DestruirGrafo, mas sem desfazer vrtice a
+*     vrtice as ligaes e o ndice de nomes: os vrtices so liberados
+*     direto da tabela de identificadores, as arestas junto com eles, e
+*     os valores so entregues em vetores a destruirValores.
+*
+*     Se ppDestruicao no for NULL, a liberao  feita numa linha de
+*     execuo prpria e a funo retorna logo depois de separar o grafo
+*     das suas vises, marcadores e registro persistente. A destruio
+*     deve ser esperada com GRA_EsperarDestruicao. Se a linha no puder
+*     ser criada, ou em debug, a liberao  feita antes de retornar e
+*     *ppDestruicao recebe NULL.
+*
+*  Parmetros
+*     ppGrafo           - Referncia do grafo a ser destrudo; recebe NULL.
+*     destruirValores   - Funo que destri um vetor de numValores
+*                         valores. Se NULL, cada valor  destrudo pela
+*                         funo dada na criao do grafo. Na linha de
+*                         execuo prpria, deve poder ser chamada fora
+*                         da linha principal.
+*     ppDestruicao      - Referncia usada para retorno da destruio em
+*                         segundo plano, ou NULL para destruir j.
+*
+*  Condies de retorno
+*     - GRA_CondRetOK
+*     - GRA_CondRetErroSistema  - como em GRA_DestruirGrafo.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_DestruirGrafoEmLote(GRA_tppGrafo *ppGrafo,
+     void (*destruirValores)(void **vtValores, int numValores),
+     GRA_tppDestruicao *ppDestruicao);
+
+/***********************************************************************
+*
+*  Funo: GRA Esperar destruio
+*
+*  Descrio
+*     Espera terminar a destruio em segundo plano iniciada por
+*     GRA_DestruirGrafoEmLote. Aceita NULL.
+*
+*  Parmetros
+*     ppDestruicao  - Referncia da destruio; recebe NULL.
+*
+*  Condies de retorno
+*     - GRA_CondRetOK
+*
+***********************************************************************/
+GRA_tpCondRet GRA_EsperarDestruicao(GRA_tppDestruicao *ppDestruicao);
+
 /***********************************************************************
 *
 *  Funo: GRA Inserir vrtice
@@ -200,6 +551,11 @@ GRA_tpCondRet GRA_DestruirGrafo(GRA_tppGrafo *ppGrafo);
 *     Obs.: Nenhuma relao do novo vrtice com qualquer outro vrtice ou
 *     aresta existente, para isso  necessrio utilizar outras funes.
 *
+*     Se a insero der certo, o grafo passa a ser dono do espao de
+*     nomeVertice, alocado com malloc. Nomes de at 15 caracteres so
+*     copiados para dentro do vrtice e esse espao  liberado j na
+*     insero; os maiores so liberados com o vrtice.
+*
 *  Parmetros
 *     pGrafoParm    - ponteiro para o grafo onde deve ser inserido o vrtice
 *     nomeVertice  - nome do vrtice  ser criado.
@@ -211,6 +567,8 @@ GRA_tpCondRet GRA_DestruirGrafo(GRA_tppGrafo *ppGrafo);
 *     GRA_CondRetGrafoNaoFoiCriado
 *     GRA_CondRetJaExiste
 *     GRA_CondRetFaltouMemoria
+*     GRA_CondRetParametroInvalido  - nome longo demais para as chaves
+*                                     fixas do grafo.
 *
 *  Assertivas de entrada
 *     - Valem as assertivas estruturais do grafo direcionado.
@@ -230,6 +588,8 @@ GRA_tpCondRet GRA_InserirVertice(GRA_tppGrafo pGrafoParm, char *nomeVertice, voi
 *
 *  Descrio
 *     Insere nova aresta ligando dois vrtices  escolha.
+*     O espao de nomeAresta  tratado como o de nomeVertice em
+*     GRA_InserirVertice.
 *
 *  Parmetros
 *     pGrafoParm           - ponteiro para o grafo onde deve ser inserido a aresta
@@ -242,8 +602,16 @@ GRA_tpCondRet GRA_InserirVertice(GRA_tppGrafo pGrafoParm, char *nomeVertice, voi
 *     GRA_CondRetFaltouMemoria
 *     GRA_CondRetGrafoVazio
 *     GRA_CondRetGrafoNaoFoiCriado
-*     GRA_CondRetJaExiste
+*     GRA_CondRetJaExiste           - a origem j tem aresta com este
+*                                     nome ou, se as arestas paralelas so
+*                                     recusadas, para este destino.
 *     GRA_CondRetNaoAchou
+*     GRA_CondRetParametroInvalido  - nome longo demais para as chaves
+*                                     fixas do grafo.
+*     GRA_CondRetCriaCiclo          - o grafo mantm ordem topolgica e
+*                                     o destino alcana a origem, ou so
+*                                     o mesmo vrtice. A aresta no 
+*                                     inserida.
 *
 *  Assertivas de entrada
 *     - Valem as assertivas estruturais do grafo direcionado.
@@ -297,6 +665,7 @@ GRA_tpCondRet GRA_ObterValorCorrente(GRA_tppGrafo pGrafoParm, void **ppValor);
 *     GRA_CondRetOK
 *     GRA_CondRetGrafoVazio
 *     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - grafo com valores fixos.
 *
 *  Assertivas de entrada
 *     - Valem as assertivas estruturais do grafo direcionado.
@@ -308,6 +677,48 @@ GRA_tpCondRet GRA_ObterValorCorrente(GRA_tppGrafo pGrafoParm, void **ppValor);
 ***********************************************************************/
 GRA_tpCondRet GRA_AlterarValorCorrente(GRA_tppGrafo pGrafoParm, void *pValor);
 
+/***********************************************************************
+*
+*  Funo: GRA Ler valor fixo do vrtice corrente
+*
+*  Descrio
+*     Copia para pDestino os bytes do valor do vrtice corrente de um
+*     grafo com valores fixos.
+*
+*  Parmetros
+*     pGrafoParm - ponteiro para o grafo.
+*     pDestino   - espao com pelo menos o tamanho dos valores do grafo.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoVazio
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - grafo sem valores fixos.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_LerValorCorrente(GRA_tppGrafo pGrafoParm, void *pDestino);
+
+/***********************************************************************
+*
+*  Funo: GRA Gravar valor fixo do vrtice corrente
+*
+*  Descrio
+*     Copia os bytes de pOrigem para o valor do vrtice corrente de um
+*     grafo com valores fixos.
+*
+*  Parmetros
+*     pGrafoParm - ponteiro para o grafo.
+*     pOrigem    - novo valor, com o tamanho dos valores do grafo.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoVazio
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - grafo sem valores fixos.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_GravarValorCorrente(GRA_tppGrafo pGrafoParm, const void *pOrigem);
+
 /***********************************************************************
 *
 *  Funo: GRA Tornar o vrtice corrente uma origem
@@ -367,6 +778,8 @@ GRA_tpCondRet GRA_DeixarDeSerOrigem(GRA_tppGrafo pGrafoParm);
 *
 *  Descrio
 *     Navega com o vrtice corrente para o vrtice contendo o nome passado como argumento.
+*     Cada vrtice mantm um ndice dos destinos das suas arestas, de
+*     forma que o custo no depende da quantidade de arestas do corrente.
 *
 *  Parmetros
 *     pGrafoParm   - ponteiro para o grafo
@@ -388,12 +801,56 @@ GRA_tpCondRet GRA_DeixarDeSerOrigem(GRA_tppGrafo pGrafoParm);
 ***********************************************************************/
 GRA_tpCondRet GRA_IrParaVerticeAdjacente(GRA_tppGrafo pGrafoParm, char *nomeVertice);
 
+/***********************************************************************
+*
+*  Funo: GRA Existe aresta entre
+*
+*  Descrio
+*     Verifica se h ao menos uma aresta da origem para o destino, pelo
+*     ndice de destinos da origem. No altera o corrente.
+*
+*  Parmetros
+*     pGrafoParm   - ponteiro para o grafo
+*     nomeOrigem   - nome do vrtice de origem
+*     nomeDestino  - nome do vrtice de destino
+*
+*  Condies de retorno
+*     GRA_CondRetOK             - a aresta existe.
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou       - no h aresta ou algum dos vrtices
+*                                 no existe.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ExisteArestaEntre(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino);
+
+/***********************************************************************
+*
+*  Funo: GRA Recusar arestas paralelas
+*
+*  Descrio
+*     Define se GRA_InserirAresta deve recusar, com GRA_CondRetJaExiste,
+*     uma aresta cuja origem j tem aresta para o mesmo destino. Por
+*     padro arestas paralelas, com nomes diferentes, so aceitas. As
+*     arestas paralelas j existentes no so alteradas.
+*
+*  Parmetros
+*     pGrafoParm   - ponteiro para o grafo
+*     recusar      - diferente de 0 para recusar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_RecusarArestasParalelas(GRA_tppGrafo pGrafoParm, int recusar);
+
 /***********************************************************************
 *
 *  Funo: GRA Seguir pela aresta
 *
 *  Descrio
 *     Navega com o vrtice corrente para o vrtice apontado pela aresta contendo nome passado como argumento.
+*     A aresta achada  movida conforme GRA_DefinirAutoOrganizacao.
 *
 *  Parmetros
 *     pGrafoParm  - ponteiro para o grafo
@@ -420,7 +877,8 @@ GRA_tpCondRet GRA_SeguirPelaAresta(GRA_tppGrafo pGrafoParm, char *nomeAresta);
 *  Funo: GRA Ir para a origem
 *
 *  Descrio
-*     Navega com o vrtice corrente para um vrtice origem
+*     Navega com o vrtice corrente para um vrtice origem.
+*     A origem achada  movida conforme GRA_DefinirAutoOrganizacao.
 *
 *  Parmetros
 *     pGrafoParm   - ponteiro para o grafo
@@ -495,6 +953,1609 @@ GRA_tpCondRet GRA_DestruirVerticeCorrente(GRA_tppGrafo pGrafoParm);
 ***********************************************************************/
 GRA_tpCondRet GRA_DestruirArestaAdjacente(GRA_tppGrafo pGrafoParm, char *nomeAresta);
 
+/***********************************************************************
+*
+*  Funo: GRA Criar viso
+*
+*  Descrio
+*     Cria uma viso do subgrafo induzido por um subconjunto dos vrtices
+*     do grafo. A viso no copia vrtices, arestas ou nomes: ela apenas
+*     filtra, durante a navegao e o percurso, os vrtices do grafo pai.
+*
+*     O subconjunto pode ser definido de duas formas:
+*       - por um predicado, avaliado sob demanda para cada vrtice visitado;
+*       - por um conjunto de bits indexado pelo identificador interno do
+*         vrtice, caso o predicado seja NULL. Neste caso a viso comea
+*         vazia e os vrtices so includos com GRA_IncluirVerticeNaVisao.
+*
+*     A viso possui o seu prprio vrtice corrente, independente do
+*     corrente do grafo.
+*
+*  Parmetros
+*     pGrafoParm  - ponteiro para o grafo pai.
+*     ppVisao     - referncia usada para retorno da viso criada.
+*     pertence    - predicado que diz se um vrtice pertence  viso
+*                   (retorna diferente de 0) ou NULL para usar conjunto de bits.
+*     pContexto   - ponteiro repassado ao predicado.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*
+*  Assertivas de entrada
+*     - Valem as assertivas estruturais do grafo direcionado.
+*
+*  Assertivas de sada
+*     - Valem as assertivas estruturais do grafo direcionado.
+*     - A viso est registrada no grafo e o seu corrente  nulo.
+*     - A viso deve ser destruda antes do grafo.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CriarVisao(GRA_tppGrafo pGrafoParm, GRA_tppVisao *ppVisao,
+     int (*pertence)(char *nomeVertice, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Destruir viso
+*
+*  Descrio
+*     Destri a viso e a desregistra do grafo pai. O grafo no  alterado.
+*
+*  Parmetros
+*     ppVisao  - referncia da viso a ser destruda.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*
+***********************************************************************/
+GRA_tpCondRet GRA_DestruirVisao(GRA_tppVisao *ppVisao);
+
+/***********************************************************************
+*
+*  Funo: GRA Incluir vrtice na viso
+*
+*  Descrio
+*     Inclui o vrtice de nome dado no conjunto de bits da viso.
+*     S pode ser usada em vises criadas sem predicado.
+*
+*  Parmetros
+*     pVisaoParm   - ponteiro para a viso.
+*     nomeVertice  - nome do vrtice a incluir.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetParametroInvalido  - viso criada com predicado.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_IncluirVerticeNaVisao(GRA_tppVisao pVisaoParm, char *nomeVertice);
+
+/***********************************************************************
+*
+*  Funo: GRA Excluir vrtice da viso
+*
+*  Descrio
+*     Retira o vrtice de nome dado do conjunto de bits da viso.
+*     Se ele for o corrente da viso, a viso fica sem corrente.
+*     S pode ser usada em vises criadas sem predicado.
+*
+*  Parmetros
+*     pVisaoParm   - ponteiro para a viso.
+*     nomeVertice  - nome do vrtice a excluir.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*     GRA_CondRetParametroInvalido  - viso criada com predicado.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ExcluirVerticeDaVisao(GRA_tppVisao pVisaoParm, char *nomeVertice);
+
+/***********************************************************************
+*
+*  Funo: GRA Viso ir para vrtice
+*
+*  Descrio
+*     Torna corrente da viso o vrtice de nome dado, desde que ele
+*     pertena  viso.  o ponto de entrada para navegar na viso.
+*
+*  Parmetros
+*     pVisaoParm   - ponteiro para a viso.
+*     nomeVertice  - nome do vrtice.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*
+***********************************************************************/
+GRA_tpCondRet GRA_VisaoIrParaVertice(GRA_tppVisao pVisaoParm, char *nomeVertice);
+
+/***********************************************************************
+*
+*  Funo: GRA Viso ir para o vrtice adjacente
+*
+*  Descrio
+*     Equivalente a GRA_IrParaVerticeAdjacente, considerando apenas os
+*     sucessores do corrente da viso que pertencem  viso.
+*
+*  Parmetros
+*     pVisaoParm   - ponteiro para a viso.
+*     nomeVertice  - nome do vrtice adjacente.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio
+*     GRA_CondRetNaoAchou
+*
+***********************************************************************/
+GRA_tpCondRet GRA_VisaoIrParaVerticeAdjacente(GRA_tppVisao pVisaoParm, char *nomeVertice);
+
+/***********************************************************************
+*
+*  Funo: GRA Viso seguir pela aresta
+*
+*  Descrio
+*     Equivalente a GRA_SeguirPelaAresta, falhando se o destino da aresta
+*     no pertencer  viso.
+*
+*  Parmetros
+*     pVisaoParm  - ponteiro para a viso.
+*     nomeAresta  - nome da aresta que ir seguir.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio
+*     GRA_CondRetNaoAchou
+*
+***********************************************************************/
+GRA_tpCondRet GRA_VisaoSeguirPelaAresta(GRA_tppVisao pVisaoParm, char *nomeAresta);
+
+/***********************************************************************
+*
+*  Funo: GRA Viso obter valor corrente
+*
+*  Parmetros
+*     pVisaoParm  - ponteiro para a viso.
+*     ppValor     - ponteiro que ter o valor do corrente da viso.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio
+*
+***********************************************************************/
+GRA_tpCondRet GRA_VisaoObterValorCorrente(GRA_tppVisao pVisaoParm, void **ppValor);
+
+/***********************************************************************
+*
+*  Funo: GRA Viso percorrer em largura
+*
+*  Descrio
+*     Percorre em largura, a partir do vrtice de nome dado, os vrtices
+*     alcanveis sem sair da viso. Para cada vrtice alcanado, inclusive
+*     o inicial, chama a funo visitar. O percurso  interrompido se
+*     visitar retornar diferente de 0.
+*     Nem o corrente do grafo nem o corrente da viso so alterados.
+*     A funo visitar no deve inserir nem excluir vrtices.
+*
+*     Se for fornecido um marcador, ele no  reiniciado: vrtices j
+*     marcados no so visitados e os visitados ficam marcados ao final.
+*     Sem marcador,  usado um marcador interno do grafo.
+*
+*  Parmetros
+*     pVisaoParm   - ponteiro para a viso.
+*     nomeOrigem   - nome do vrtice inicial, que deve pertencer  viso.
+*     pMarcador    - marcador de visitados do mesmo grafo, ou NULL.
+*     visitar      - funo chamada para cada vrtice alcanado.
+*     pContexto    - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_VisaoPercorrerEmLargura(GRA_tppVisao pVisaoParm, char *nomeOrigem,
+     GRA_tppMarcador pMarcador,
+     int (*visitar)(char *nomeVertice, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Criar marcador
+*
+*  Descrio
+*     Cria um marcador de vrtices visitados para o grafo dado.
+*     O marcador guarda, para cada identificador interno de vrtice, a
+*     poca em que ele foi marcado. Um vrtice est marcado se a sua poca
+*     for a poca corrente do marcador, de forma que desmarcar todos os
+*     vrtices custa apenas o incremento da poca.
+*
+*     O mesmo marcador pode ser reutilizado em quantos percursos forem
+*     necessrios, tanto pelo cliente quanto pelos percursos do mdulo.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     ppMarcador    - referncia usada para retorno do marcador criado.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*
+*  Assertivas de sada
+*     - Nenhum vrtice est marcado.
+*     - O marcador deve ser destrudo antes do grafo; caso contrrio ele
+*        desligado do grafo e s pode ser destrudo.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CriarMarcador(GRA_tppGrafo pGrafoParm, GRA_tppMarcador *ppMarcador);
+
+/***********************************************************************
+*
+*  Funo: GRA Destruir marcador
+*
+*  Parmetros
+*     ppMarcador    - referncia do marcador a ser destrudo.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*
+***********************************************************************/
+GRA_tpCondRet GRA_DestruirMarcador(GRA_tppMarcador *ppMarcador);
+
+/***********************************************************************
+*
+*  Funo: GRA Reiniciar marcador
+*
+*  Descrio
+*     Desmarca todos os vrtices em tempo constante, avanando a poca.
+*
+*  Parmetros
+*     pMarcadorParm - ponteiro para o marcador.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ReiniciarMarcador(GRA_tppMarcador pMarcadorParm);
+
+/***********************************************************************
+*
+*  Funo: GRA Marcar vrtice
+*
+*  Parmetros
+*     pMarcadorParm - ponteiro para o marcador.
+*     nomeVertice   - nome do vrtice a marcar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_MarcarVertice(GRA_tppMarcador pMarcadorParm, char *nomeVertice);
+
+/***********************************************************************
+*
+*  Funo: GRA Vrtice est marcado
+*
+*  Parmetros
+*     pMarcadorParm - ponteiro para o marcador.
+*     nomeVertice   - nome do vrtice consultado.
+*     pResposta     - ponteiro para a resposta.
+*
+*  Retorno por referncia
+*     pResposta - 1 se o vrtice estiver marcado na poca corrente e 0 caso contrrio.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*
+***********************************************************************/
+GRA_tpCondRet GRA_VerticeEstaMarcado(GRA_tppMarcador pMarcadorParm, char *nomeVertice,
+     int *pResposta);
+
+/***********************************************************************
+*
+*  Funo: GRA Marcar corrente
+*
+*  Descrio
+*     Marca o vrtice corrente do grafo sem precisar procur-lo pelo nome.
+*     Destinada aos percursos que o cliente escreve navegando pelo grafo.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     pMarcadorParm - ponteiro para um marcador do mesmo grafo.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_MarcarCorrente(GRA_tppGrafo pGrafoParm, GRA_tppMarcador pMarcadorParm);
+
+/***********************************************************************
+*
+*  Funo: GRA Corrente est marcado
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     pMarcadorParm - ponteiro para um marcador do mesmo grafo.
+*     pResposta     - ponteiro para a resposta.
+*
+*  Retorno por referncia
+*     pResposta - 1 se o corrente estiver marcado na poca corrente e 0 caso contrrio.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CorrenteEstaMarcado(GRA_tppGrafo pGrafoParm, GRA_tppMarcador pMarcadorParm,
+     int *pResposta);
+
+/***********************************************************************
+*
+*  Funo: GRA Reordenar
+*
+*  Descrio
+*     Renumera os vrtices segundo a ordem pedida e realoca, nessa ordem,
+*     os vrtices, as arestas e as suas listas de adjacncia, de forma que
+*     vrtices prximos no percurso fiquem prximos na memria.
+*     A lista de vrtices passa a seguir a nova ordem.
+*
+*     Nomes, valores, arestas, origens, correntes, vises e marcadores
+*     so preservados. Ponteiros para a estrutura interna obtidos antes
+*     da chamada deixam de ser vlidos.
+*
+*     Em caso de falta de memria o grafo no  alterado.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     ordem         - critrio da nova ordem.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_Reordenar(GRA_tppGrafo pGrafoParm, GRA_tpOrdem ordem);
+
+/***********************************************************************
+*
+*  Funo: GRA Publicar em memria compartilhada
+*
+*  Descrio
+*     Grava no segmento de memria compartilhada de nome dado uma cpia
+*     somente leitura do grafo, que outros processos podem anexar com
+*     GRA_AnexarMemoriaCompartilhada sem copi-la.
+*
+*     A cpia no contm ponteiros: vrtices, arestas e nomes so
+*     referenciados por deslocamentos a partir do incio do segmento, e
+*     as listas de adjacncia so vetores contguos. Os vrtices seguem a
+*     ordem da lista de vrtices, de forma que GRA_Reordenar antes da
+*     publicao tambm melhora a localidade da cpia.
+*
+*     Os valores so copiados byte a byte, com o tamanho informado por
+*     tamanhoValor, e por isso no devem conter ponteiros. Se
+*     tamanhoValor for NULL os valores no so publicados.
+*
+*     Alteraes posteriores no grafo no afetam a cpia publicada.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeSegmento  - nome do segmento, sem barras.
+*     tamanhoValor  - funo que retorna o tamanho em bytes de um valor,
+*                     ou NULL.
+*     ppPublicacao  - referncia usada para retorno da publicao.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetJaExiste
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetErroSistema
+*
+*  Assertivas de sada
+*     - A publicao deve ser mantida enquanto outros processos precisarem
+*       anexar o segmento e ser retirada com GRA_RetirarPublicacao.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_PublicarMemoriaCompartilhada(GRA_tppGrafo pGrafoParm, const char *nomeSegmento,
+     size_t (*tamanhoValor)(void *pValor), GRA_tppPublicacao *ppPublicacao);
+
+/***********************************************************************
+*
+*  Funo: GRA Retirar publicao
+*
+*  Descrio
+*     Remove o nome do segmento, de forma que novos processos no o
+*     encontrem. Processos j anexados continuam usando a cpia at se
+*     desanexarem, quando a memria  liberada pelo sistema.
+*
+*  Parmetros
+*     ppPublicacao  - referncia da publicao.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*
+***********************************************************************/
+GRA_tpCondRet GRA_RetirarPublicacao(GRA_tppPublicacao *ppPublicacao);
+
+/***********************************************************************
+*
+*  Funo: GRA Anexar memria compartilhada
+*
+*  Descrio
+*     Mapeia, somente para leitura, um grafo publicado por
+*     GRA_PublicarMemoriaCompartilhada, possivelmente em outro processo.
+*     Nada  copiado: todos os processos anexados leem a mesma memria
+*     fsica. O grafo anexado tem um corrente prprio, inicialmente nulo.
+*
+*  Parmetros
+*     nomeSegmento  - nome do segmento, sem barras.
+*     ppGrafo       - referncia usada para retorno do grafo anexado.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetNaoAchou       - no h segmento com esse nome, ou ele
+*                                 no contm um grafo publicado completo.
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetErroSistema
+*
+***********************************************************************/
+GRA_tpCondRet GRA_AnexarMemoriaCompartilhada(const char *nomeSegmento,
+     GRA_tppGrafoCompartilhado *ppGrafo);
+
+/***********************************************************************
+*
+*  Funo: GRA Desanexar memria compartilhada
+*
+*  Parmetros
+*     ppGrafo       - referncia do grafo anexado.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*
+***********************************************************************/
+GRA_tpCondRet GRA_DesanexarMemoriaCompartilhada(GRA_tppGrafoCompartilhado *ppGrafo);
+
+/***********************************************************************
+*
+*  Funo: GRA Compartilhado ir para vrtice
+*
+*  Descrio
+*     Torna corrente o vrtice de nome dado, localizado por busca binria
+*     no ndice de nomes da cpia.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo anexado.
+*     nomeVertice   - nome do vrtice.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CompartilhadoIrParaVertice(GRA_tppGrafoCompartilhado pGrafoParm,
+     const char *nomeVertice);
+
+/***********************************************************************
+*
+*  Funo: GRA Compartilhado seguir pela aresta
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo anexado.
+*     nomeAresta    - nome de uma aresta que sai do corrente.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio     - no h corrente.
+*     GRA_CondRetNaoAchou
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CompartilhadoSeguirPelaAresta(GRA_tppGrafoCompartilhado pGrafoParm,
+     const char *nomeAresta);
+
+/***********************************************************************
+*
+*  Funo: GRA Compartilhado obter valor corrente
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo anexado.
+*     ppValor       - ponteiro para o retorno do valor.
+*
+*  Retorno por referncia
+*     ppValor - endereo do valor dentro do segmento, que no deve ser
+*               alterado, ou NULL se os valores no foram publicados.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio     - no h corrente.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CompartilhadoObterValorCorrente(GRA_tppGrafoCompartilhado pGrafoParm,
+     const void **ppValor);
+
+/***********************************************************************
+*
+*  Funo: GRA Compartilhado percorrer em largura
+*
+*  Descrio
+*     Percorre em largura, a partir do vrtice de nome dado, os vrtices
+*     alcanveis pelas arestas, chamando visitar para cada um, inclusive
+*     o inicial. O percurso  interrompido se visitar retornar diferente
+*     de 0. O nome e o valor passados a visitar esto dentro do segmento
+*     e no devem ser alterados. O corrente no  alterado.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo anexado.
+*     nomeOrigem    - nome do vrtice inicial.
+*     visitar       - funo chamada para cada vrtice alcanado.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CompartilhadoPercorrerEmLargura(GRA_tppGrafoCompartilhado pGrafoParm,
+     const char *nomeOrigem,
+     int (*visitar)(char *nomeVertice, void *pValor, void *pContexto), void *pContexto);
+
+
+/***********************************************************************
+*
+*  Funo: GRA Abrir grafo persistente
+*
+*  Descrio
+*     Cria um grafo cujas alteraes sobrevivem ao fim do processo,
+*     inclusive a uma queda. O estado  guardado em dois arquivos,
+*     formados pelo caminho base acrescido de um sufixo:
+*
+*        .chk  ponto de controle: o grafo inteiro num dado momento.
+*        .wal  log: as alteraes feitas depois do ponto de controle.
+*
+*     Se os arquivos existirem, o grafo  reconstrudo a partir do ponto
+*     de controle, e as alteraes do log so refeitas sobre ele. Um
+*     registro final incompleto, deixado por uma queda,  descartado.
+*
+*     A partir da, cada GRA_InserirVertice, GRA_InserirAresta,
+*     GRA_AlterarValorCorrente, GRA_TornarCorrenteUmaOrigem,
+*     GRA_DeixarDeSerOrigem, GRA_DestruirVerticeCorrente e
+*     GRA_DestruirArestaAdjacente bem-sucedida acrescenta um registro
+*     binrio ao log. Os registros so sincronizados com o disco em
+*     grupos (ver GRA_DefinirConfirmacaoEmGrupo), de forma que o custo de
+*     uma alterao fica prximo ao do grafo em memria. Uma queda pode
+*     perder as alteraes do ltimo grupo ainda no confirmado.
+*     Quando o log passa do limite, um novo ponto de controle  gravado
+*     e o log  esvaziado.
+*
+*     A navegao, as vises, os marcadores e a ordem dos vrtices no
+*     so registrados. Aps a abertura o corrente  a primeira origem
+*     ou, se no houver origens, o primeiro vrtice.
+*
+*     Os valores so gravados byte a byte com o tamanho informado por
+*     tamanhoValor e por isso no devem conter ponteiros. Na recuperao
+*     eles so recriados com malloc, portanto destruirValor deve liberar
+*     os valores com free. Se tamanhoValor for NULL os valores no so
+*     gravados e voltam nulos.
+*
+*  Parmetros
+*     ppGrafo       - referncia usada para retorno do grafo.
+*     caminhoBase   - caminho dos arquivos, sem sufixo.
+*     destruirValor - lgica de destruio dos valores, como em
+*                     GRA_CriarGrafo.
+*     tamanhoValor  - funo que retorna o tamanho em bytes de um valor,
+*                     ou NULL.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetErroSistema    - os arquivos no puderam ser lidos ou
+*                                 criados, ou no descrevem um grafo.
+*
+*  Assertivas de sada
+*     - Se as alteraes registradas no log falharem ao serem gravadas,
+*       a funo que alterou o grafo retorna GRA_CondRetErroSistema,
+*       mas a alterao em memria permanece feita.
+*     - GRA_DestruirGrafo confirma os registros pendentes e fecha o log.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_AbrirGrafoPersistente(GRA_tppGrafo *ppGrafo, const char *caminhoBase,
+     void (*destruirValor)(void *pValor), size_t (*tamanhoValor)(void *pValor));
+
+/***********************************************************************
+*
+*  Funo: GRA Gravar ponto de controle
+*
+*  Descrio
+*     Grava o grafo inteiro como novo ponto de controle e esvazia o log,
+*     o que encurta a prxima recuperao. O ponto de controle anterior
+*     s  substitudo depois que o novo estiver completo no disco.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo persistente.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou       - o grafo no  persistente.
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetErroSistema
+*
+***********************************************************************/
+GRA_tpCondRet GRA_GravarPontoDeControle(GRA_tppGrafo pGrafoParm);
+
+/***********************************************************************
+*
+*  Funo: GRA Sincronizar persistncia
+*
+*  Descrio
+*     Confirma o grupo corrente sem esperar que ele se complete: ao
+*     retornar, todas as alteraes j feitas esto no disco.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo persistente.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou       - o grafo no  persistente.
+*     GRA_CondRetErroSistema
+*
+***********************************************************************/
+GRA_tpCondRet GRA_SincronizarPersistencia(GRA_tppGrafo pGrafoParm);
+
+/***********************************************************************
+*
+*  Funo: GRA Definir confirmao em grupo
+*
+*  Descrio
+*     Ajusta o compromisso entre vazo e durabilidade do grafo
+*     persistente. Por padro, 64 registros formam um grupo e um ponto
+*     de controle  gravado quando o log chega a 4 MB.
+*
+*  Parmetros
+*     pGrafoParm               - ponteiro para o grafo persistente.
+*     registrosPorGrupo        - registros sincronizados de uma vez; com
+*                                1, cada alterao  sincronizada antes
+*                                de a funo que a fez retornar.
+*     bytesParaPontoDeControle - tamanho do log que dispara um ponto de
+*                                controle; 0 desliga os automticos.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou       - o grafo no  persistente.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_DefinirConfirmacaoEmGrupo(GRA_tppGrafo pGrafoParm, int registrosPorGrupo,
+     long bytesParaPontoDeControle);
+
+/***********************************************************************
+*
+*  Funo: GRA Listar vrtices por prefixo
+*
+*  Descrio
+*     Chama visitar para cada vrtice cujo nome comea por prefixo, em
+*     ordem crescente de nome (a de strcmp). Nomes hierrquicos, como
+*     "svc/regiao/host", permitem assim listar uma subrvore inteira.
+*     O custo  o de uma busca no ndice de nomes mais o dos vrtices
+*     listados, independente do tamanho do grafo.
+*
+*     O percurso  interrompido se visitar retornar diferente de 0.
+*     A funo visitar no deve inserir nem destruir vrtices.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     prefixo       - prefixo dos nomes; "" lista todos os vrtices.
+*     visitar       - funo chamada com o nome e o valor do vrtice.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ListarVerticesPorPrefixo(GRA_tppGrafo pGrafoParm, const char *prefixo,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Listar vrtices no intervalo
+*
+*  Descrio
+*     Como GRA_ListarVerticesPorPrefixo, para os vrtices cujo nome est
+*     entre inicio e fim, inclusive.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     inicio        - menor nome listado, ou NULL para no limitar.
+*     fim           - maior nome listado, ou NULL para no limitar.
+*     visitar       - funo chamada com o nome e o valor do vrtice.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ListarVerticesNoIntervalo(GRA_tppGrafo pGrafoParm, const char *inicio,
+   const char *fim, int (*visitar)(const char *nome, void *pValor, void *pContexto),
+   void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Para cada vrtice
+*
+*  Descrio
+*     Chama visitar para cada vrtice do grafo, na ordem dos
+*     identificadores internos, que  a de GRA_Reordenar quando ela foi
+*     usada. O percurso  interrompido se visitar retornar diferente de 0.
+*
+*     Nem o corrente do grafo nem os correntes das suas listas so lidos
+*     ou alterados, de forma que vrias linhas de execuo podem
+*     percorrer o mesmo grafo ao mesmo tempo, desde que nenhuma o altere.
+*     A funo visitar no deve inserir nem destruir vrtices ou arestas.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     visitar       - funo chamada com o nome e o valor do vrtice.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ParaCadaVertice(GRA_tppGrafo pGrafoParm,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Para cada sucessor
+*
+*  Descrio
+*     Chama visitar para cada aresta que sai do vrtice de nome dado, na
+*     ordem de insero, com o nome da aresta e o nome e o valor do
+*     vrtice destino. O percurso  interrompido se visitar retornar
+*     diferente de 0. Como em GRA_ParaCadaVertice, nada  alterado.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeVertice   - nome do vrtice de origem das arestas.
+*     visitar       - funo chamada para cada aresta.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou        - no existe vrtice com o nome dado.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ParaCadaSucessor(GRA_tppGrafo pGrafoParm, char *nomeVertice,
+   int (*visitar)(const char *nomeAresta, const char *nomeDestino, void *pValorDestino,
+                  void *pContexto),
+   void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Para cada antecessor
+*
+*  Descrio
+*     Chama visitar com o nome e o valor da origem de cada aresta que
+*     chega ao vrtice de nome dado. Uma origem com vrias arestas para
+*     o vrtice  visitada uma vez por aresta. O percurso  interrompido
+*     se visitar retornar diferente de 0. Como em GRA_ParaCadaVertice,
+*     nada  alterado.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeVertice   - nome do vrtice de destino das arestas.
+*     visitar       - funo chamada para cada aresta.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou        - no existe vrtice com o nome dado.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ParaCadaAntecessor(GRA_tppGrafo pGrafoParm, char *nomeVertice,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Para cada vrtice em paralelo
+*
+*  Descrio
+*     Divide os identificadores internos dos vrtices em numTarefas
+*     faixas contguas e visita cada faixa numa linha de execuo
+*     prpria; a primeira faixa  visitada pela linha que chamou.
+*     Retorna depois que todas as faixas foram visitadas.
+*
+*     visitar recebe tambm o nmero da tarefa, de 0 a numTarefas - 1,
+*     para que o cliente possa acumular resultados por tarefa sem
+*     sincronizao. Chamadas com nmeros diferentes podem ocorrer ao
+*     mesmo tempo; chamadas com o mesmo nmero, nunca. O grafo no deve
+*     ser alterado durante o percurso, nem por visitar nem por outra
+*     linha de execuo.
+*
+*     Se uma linha no puder ser criada, a sua faixa  visitada pela
+*     linha que chamou, com o mesmo nmero de tarefa.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     numTarefas    - quantidade de faixas, de 1 a GRA_MAX_TAREFAS.
+*     visitar       - funo chamada com o nome e o valor do vrtice.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - numTarefas fora dos limites.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ParaCadaVerticeParalelo(GRA_tppGrafo pGrafoParm, int numTarefas,
+   void (*visitar)(const char *nome, void *pValor, int tarefa, void *pContexto),
+   void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Iniciar percurso
+*
+*  Descrio
+*     Cria um percurso pelos vrtices alcanveis a partir do vrtice de
+*     nome dado, sem visitar nenhum. Os vrtices so visitados aos poucos
+*     por GRA_AvancarPercurso, de forma que um percurso longo pode ser
+*     intercalado com outras operaes, inclusive outros percursos.
+*
+*     O percurso guarda a fronteira e os vrtices j alcanados. Entre
+*     duas chamadas de GRA_AvancarPercurso o grafo pode ser alterado:
+*     vrtices excludos no so visitados, e vrtices ou arestas novos
+*     so seguidos se partirem de um vrtice ainda no visitado.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeOrigem    - nome do vrtice em que o percurso comea.
+*     modo          - ordem de visita.
+*     visitar       - funo chamada com o nome e o valor de cada vrtice
+*                     visitado. O percurso termina se ela retornar
+*                     diferente de 0. No deve inserir nem excluir
+*                     vrtices ou arestas.
+*     pContexto     - ponteiro repassado  funo visitar.
+*     ppPercurso    - referncia usada para retorno do percurso criado.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetParametroInvalido  - modo desconhecido.
+*
+*  Assertivas de sada
+*     - O percurso deve ser terminado antes da destruio do grafo; caso
+*       contrrio ele  desligado do grafo e s pode ser terminado.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_IniciarPercurso(GRA_tppGrafo pGrafoParm, char *nomeOrigem,
+   GRA_tpModoPercurso modo,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto,
+   GRA_tppPercurso *ppPercurso);
+
+/***********************************************************************
+*
+*  Funo: GRA Avanar percurso
+*
+*  Descrio
+*     Visita no mximo numPassos vrtices e retorna. Cada passo visita um
+*     vrtice e pe na fronteira os seus sucessores ainda no alcanados,
+*     de forma que o custo de uma chamada  limitado por numPassos e pelo
+*     grau de sada dos vrtices visitados.
+*
+*  Parmetros
+*     pPercursoParm - ponteiro para o percurso.
+*     numPassos     - quantidade mxima de vrtices a visitar, maior que 0.
+*     pTerminou     - ponteiro para a resposta.
+*
+*  Retorno por referncia
+*     pTerminou - 1 se no h mais vrtices a visitar, ou se visitar pediu
+*                 o fim do percurso, e 0 caso contrrio.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado  - o grafo do percurso foi destrudo.
+*     GRA_CondRetFaltouMemoria      - o vrtice seguinte no foi visitado;
+*                                     o percurso pode ser avanado de novo.
+*     GRA_CondRetParametroInvalido  - numPassos menor que 1.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_AvancarPercurso(GRA_tppPercurso pPercursoParm, int numPassos,
+   int *pTerminou);
+
+/***********************************************************************
+*
+*  Funo: GRA Terminar percurso
+*
+*  Descrio
+*     Libera o percurso, tenha ele chegado ao fim ou no.
+*
+*  Parmetros
+*     ppPercurso    - referncia do percurso a ser terminado.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*
+***********************************************************************/
+GRA_tpCondRet GRA_TerminarPercurso(GRA_tppPercurso *ppPercurso);
+
+/***********************************************************************
+*
+*  Funo: GRA Assinar mudanas
+*
+*  Descrio
+*     Registra uma assinatura que recebe, na linha que altera o grafo, as
+*     mudanas feitas a partir de agora. As mudanas so acumuladas e
+*     entregues a entregar em lotes de tamLote, na ordem em que foram
+*     feitas. Um lote incompleto  entregue por GRA_EntregarMudancas, ao
+*     cancelar a assinatura e antes de destruir o grafo.
+*
+*     Enquanto o grafo no tem assinaturas, as alteraes no pagam
+*     nada alm de um teste.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     tamLote       - quantidade de mudanas por entrega, maior que 0.
+*     entregar      - funo que recebe um vetor de numMudancas mudanas.
+*                     Os nomes s valem durante a chamada, e ela no deve
+*                     alterar o grafo.
+*     pContexto     - ponteiro repassado  funo entregar.
+*     ppAssinatura  - referncia usada para retorno da assinatura criada.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetParametroInvalido  - tamLote menor que 1 ou entregar nula.
+*
+*  Assertivas de sada
+*     - A assinatura deve ser cancelada antes da destruio do grafo; caso
+*       contrrio ela  desligada do grafo e s pode ser cancelada.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_AssinarMudancas(GRA_tppGrafo pGrafoParm, int tamLote,
+   void (*entregar)(const GRA_tpMudanca *vtMudancas, int numMudancas, void *pContexto),
+   void *pContexto, GRA_tppAssinatura *ppAssinatura);
+
+/***********************************************************************
+*
+*  Funo: GRA Assinar mudanas em anel
+*
+*  Descrio
+*     Registra uma assinatura cujas mudanas so postas num anel sem
+*     trava, de onde outra linha de execuo as retira com
+*     GRA_ConsumirMudancas. A linha que altera o grafo nunca espera: se o
+*     anel estiver cheio, a mudana  perdida, e o consumidor percebe o
+*     salto no nmero de sequncia.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     capacidade    - quantidade mnima de mudanas no anel, maior que 0.
+*     ppAssinatura  - referncia usada para retorno da assinatura criada.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetParametroInvalido  - capacidade menor que 1.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_AssinarMudancasEmAnel(GRA_tppGrafo pGrafoParm, int capacidade,
+   GRA_tppAssinatura *ppAssinatura);
+
+/***********************************************************************
+*
+*  Funo: GRA Entregar mudanas
+*
+*  Descrio
+*     Entrega j o lote incompleto de uma assinatura sncrona.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - a assinatura  em anel.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_EntregarMudancas(GRA_tppAssinatura pAssinaturaParm);
+
+/***********************************************************************
+*
+*  Funo: GRA Consumir mudanas
+*
+*  Descrio
+*     Retira do anel at maxMudancas mudanas, as mais antigas primeiro.
+*     Deve ser chamada por uma s linha de execuo, que pode ser
+*     diferente da que altera o grafo. Os nomes valem at a prxima
+*     chamada. Continua funcionando depois da destruio do grafo, para
+*     que o consumidor esvazie o anel.
+*
+*  Parmetros
+*     pAssinaturaParm - ponteiro para uma assinatura em anel.
+*     vtMudancas      - vetor que recebe as mudanas.
+*     maxMudancas     - tamanho do vetor, maior que 0.
+*     pNumMudancas    - ponteiro para a quantidade retirada, 0 se nenhuma.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - assinatura sncrona ou maxMudancas
+*                                     menor que 1.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ConsumirMudancas(GRA_tppAssinatura pAssinaturaParm,
+   GRA_tpMudanca *vtMudancas, int maxMudancas, int *pNumMudancas);
+
+/***********************************************************************
+*
+*  Funo: GRA Cancelar assinatura
+*
+*  Descrio
+*     Entrega o lote incompleto, se houver, e libera a assinatura. Numa
+*     assinatura em anel, o consumidor j deve ter parado.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CancelarAssinatura(GRA_tppAssinatura *ppAssinatura);
+
+/***********************************************************************
+*
+*  Funo: GRA Manter ordem topolgica
+*
+*  Descrio
+*     Liga ou desliga a manuteno de uma ordem topolgica dos vrtices,
+*     em que toda aresta vai de um vrtice a outro posterior.
+*
+*     Ao ligar, a ordem  calculada em O(V + E). A partir da
+*     GRA_InserirAresta recusa as arestas que fechariam um ciclo e, para
+*     as demais, s reordena os vrtices entre o destino e a origem que
+*     esto ligados a eles, sem percorrer o resto do grafo. Um vrtice
+*     inserido entra ao fim da ordem, e destruies no a alteram.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     manter        - diferente de 0 para manter a ordem.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*     GRA_CondRetCriaCiclo          - o grafo j tem um ciclo; a ordem
+*                                     no passa a ser mantida.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ManterOrdemTopologica(GRA_tppGrafo pGrafoParm, int manter);
+
+/***********************************************************************
+*
+*  Funo: GRA Para cada vrtice em ordem topolgica
+*
+*  Descrio
+*     Chama visitar para cada vrtice do grafo, na ordem topolgica
+*     mantida. O percurso  interrompido se visitar retornar diferente
+*     de 0. A funo visitar no deve alterar o grafo.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     visitar       - funo chamada com o nome e o valor do vrtice.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - o grafo no mantm ordem topolgica.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ParaCadaVerticeEmOrdemTopologica(GRA_tppGrafo pGrafoParm,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Mesmo componente
+*
+*  Descrio
+*     Verifica se dois vrtices esto no mesmo componente fracamente
+*     conexo, isto , se h caminho entre eles ignorando a direo das
+*     arestas.
+*
+*     Os componentes so montados na primeira consulta, em O(V + E), e a
+*     partir da mantidos por unio e busca a cada insero, de forma que
+*     a consulta custa quase O(1). A destruio de uma aresta ou vrtice
+*     s marca o seu componente, que  recalculado, percorrendo apenas os
+*     seus membros, quando for consultado.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeVertice1  - nome de um dos vrtices.
+*     nomeVertice2  - nome do outro vrtice.
+*     pMesmo        - recebe 1 se esto no mesmo componente, 0 se no.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou           - algum dos vrtices no existe.
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_MesmoComponente(GRA_tppGrafo pGrafoParm, char *nomeVertice1,
+   char *nomeVertice2, int *pMesmo);
+
+/***********************************************************************
+*
+*  Funo: GRA Nmero de componentes
+*
+*  Descrio
+*     Obtm a quantidade de componentes fracamente conexos do grafo.
+*     Os componentes marcados por destruies desde a consulta anterior
+*     so recalculados; sem destruies, a consulta custa O(1).
+*
+*  Parmetros
+*     pGrafoParm      - ponteiro para o grafo.
+*     pNumComponentes - recebe a quantidade, 0 num grafo vazio.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_NumeroComponentes(GRA_tppGrafo pGrafoParm, int *pNumComponentes);
+
+/***********************************************************************
+*
+*  Funo: GRA PageRank
+*
+*  Descrio
+*     Calcula o PageRank dos vrtices e chama visitar para cada um, na
+*     ordem de GRA_ParaCadaVertice. Os ranks somam 1.
+*
+*     A cada iterao o rank de um vrtice  recalculado a partir dos
+*     ranks dos seus antecessores, divididos pelos graus de sada deles;
+*     o rank de vrtices sem sucessores  redistribudo como o salto.
+*     Com probabilidade 1 - amortecimento o percurso salta para qualquer
+*     vrtice, com a mesma chance. As iteraes param quando a soma das
+*     diferenas entre duas iteraes no passa de tolerancia, ou depois
+*     de maxIteracoes.
+*
+*     Os antecessores so copiados, antes das iteraes, para vetores
+*     contguos indexados por id, e cada iterao  dividida em numTarefas
+*     faixas de ids com quantidades parecidas de arestas, calculadas em
+*     linhas de execuo prprias. O resultado no depende de numTarefas.
+*     O grafo no deve ser alterado durante o clculo.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     amortecimento - chance de seguir uma aresta, em [0, 1). Usual: 0,85.
+*     tolerancia    - critrio de parada, no negativo.
+*     maxIteracoes  - maior quantidade de iteraes, a partir de 1.
+*     numTarefas    - quantidade de faixas, de 1 a GRA_MAX_TAREFAS.
+*     visitar       - funo chamada com o nome e o rank do vrtice.
+*     pContexto     - ponteiro repassado  funo visitar.
+*     pNumIteracoes - recebe a quantidade de iteraes feitas, igual a
+*                     maxIteracoes se no houve convergncia. Pode ser NULL.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetGrafoVazio
+*     GRA_CondRetParametroInvalido
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_PageRank(GRA_tppGrafo pGrafoParm, double amortecimento,
+   double tolerancia, int maxIteracoes, int numTarefas,
+   void (*visitar)(const char *nome, double rank, void *pContexto), void *pContexto,
+   int *pNumIteracoes);
+
+/***********************************************************************
+*
+*  Funo: GRA PageRank personalizado
+*
+*  Descrio
+*     Como GRA_PageRank, mas o salto leva s s origens do grafo, com a
+*     mesma chance para cada uma. Mede a importncia dos vrtices vista
+*     a partir das origens: vrtices que no so alcanados a partir
+*     delas tm rank 0.
+*
+*  Condies de retorno
+*     As de GRA_PageRank, e
+*     GRA_CondRetNaoAchou  - o grafo no tem origens.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_PageRankPersonalizado(GRA_tppGrafo pGrafoParm, double amortecimento,
+   double tolerancia, int maxIteracoes, int numTarefas,
+   void (*visitar)(const char *nome, double rank, void *pContexto), void *pContexto,
+   int *pNumIteracoes);
+
+/***********************************************************************
+*
+*  Funo: GRA Contar tringulos
+*
+*  Descrio
+*     Conta os tringulos de que cada vrtice participa e chama visitar
+*     para cada vrtice, na ordem de GRA_ParaCadaVertice. O grafo 
+*     visto como no direcionado e simples: o sentido das arestas, as
+*     arestas paralelas e os laos so desconsiderados.
+*
+*     Os vizinhos de cada vrtice so copiados para vetores de ids
+*     ordenados, e os tringulos de um vrtice so contados pela
+*     interseo dos seus vizinhos com os de cada vizinho. Os vrtices
+*     so divididos em numTarefas faixas, contadas em linhas de execuo
+*     prprias. O grafo no deve ser alterado durante a contagem.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     numTarefas    - quantidade de faixas, de 1 a GRA_MAX_TAREFAS.
+*     visitar       - funo chamada com o nome do vrtice e a quantidade
+*                     de tringulos dele. Pode ser NULL.
+*     pContexto     - ponteiro repassado  funo visitar.
+*     pTotal        - recebe a quantidade de tringulos do grafo. Pode
+*                     ser NULL.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - numTarefas fora dos limites.
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ContarTriangulos(GRA_tppGrafo pGrafoParm, int numTarefas,
+   void (*visitar)(const char *nome, long numTriangulos, void *pContexto), void *pContexto,
+   long *pTotal);
+
+/***********************************************************************
+*
+*  Funo: GRA Decomposio em k-ncleos
+*
+*  Descrio
+*     Calcula o ncleo de cada vrtice, o maior k tal que o vrtice
+*     pertence a um subgrafo em que todos os vrtices tm pelo menos k
+*     vizinhos, e chama visitar para cada vrtice, na ordem de
+*     GRA_ParaCadaVertice. O grafo  visto como em GRA_ContarTriangulos.
+*
+*     Os vrtices so retirados em ordem de grau, mantida em baldes, de
+*     forma que o custo  proporcional  quantidade de vrtices mais a
+*     de arestas.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     visitar       - funo chamada com o nome e o ncleo do vrtice.
+*                     Pode ser NULL.
+*     pContexto     - ponteiro repassado  funo visitar.
+*     pMaiorNucleo  - recebe o maior ncleo, 0 num grafo vazio. Pode ser
+*                     NULL.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_DecomposicaoKCore(GRA_tppGrafo pGrafoParm,
+   void (*visitar)(const char *nome, int nucleo, void *pContexto), void *pContexto,
+   int *pMaiorNucleo);
+
+/***********************************************************************
+*
+*  Funo: GRA Alcanar por expresso
+*
+*  Descrio
+*     Chama visitar para cada vrtice alcanvel a partir de nomeOrigem
+*     por um caminho cujos rtulos formam uma palavra da expresso. O
+*     rtulo de uma aresta  o seu nome at o primeiro ':', ou o nome
+*     inteiro, de forma que "possui:1" e "possui:2" tm o rtulo
+*     "possui". Na expresso, espaos so ignorados e
+*
+*        a / b     a seguido de b;
+*        a | b     a ou b;
+*        a*        a repetido zero ou mais vezes;
+*        a+        a repetido uma ou mais vezes;
+*        a?        a zero ou uma vez;
+*
+*     e parnteses agrupam. Os operadores de repetio tm precedncia
+*     sobre '/', que tem precedncia sobre '|'. Por exemplo,
+*     "possui+/(depende|usa)?".
+*
+*     A expresso  compilada num autmato, e o percurso  em largura
+*     pelos pares de vrtice e estado. As expresses compiladas mais
+*     recentes ficam guardadas no grafo. De um vrtice s so
+*     percorridas as arestas com os rtulos que o autmato pode seguir:
+*     a primeira chamada agrupa por rtulo as arestas de todos os
+*     vrtices, em O(V + E), e da em diante os grupos acompanham as
+*     inseres e excluses de arestas, com uma busca a mais em cada.
+*     Os grupos custam, por vrtice, um grupo por rtulo distinto, e
+*     por aresta, um ponteiro a mais na adjacncia do seu grupo; entram
+*     na conta de GRA_ObterEspacoDosSucessores. GRA_Reordenar os
+*     descarta, e a chamada seguinte os monta de novo.
+*
+*     Cada vrtice  visitado uma vez, em ordem de distncia, quando 
+*     alcanado pela primeira vez num estado final. A origem  visitada
+*     primeiro se a expresso aceita o caminho vazio. O grafo no deve
+*     ser alterado durante o percurso.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeOrigem    - nome do vrtice de onde os caminhos partem.
+*     expressao     - expresso sobre os rtulos das arestas, com at
+*                     GRA_MAX_NOMES_EXPRESSAO rtulos.
+*     visitar       - funo chamada com o nome e o valor de cada
+*                     vrtice. Se retornar diferente de 0, o percurso
+*                     termina.
+*     pContexto     - ponteiro repassado  funo visitar.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou           - no existe vrtice com nomeOrigem.
+*     GRA_CondRetParametroInvalido  - a expresso  mal formada ou tem
+*                                     rtulos demais.
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_AlcancarPorExpressao(GRA_tppGrafo pGrafoParm, char *nomeOrigem,
+   const char *expressao,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: GRA Caminho entre
+*
+*  Descrio
+*     Procura um caminho com a menor quantidade de arestas de nomeOrigem
+*     a nomeDestino, seguindo o sentido das arestas, e chama visitar
+*     para cada vrtice do caminho, da origem ao destino.
+*
+*     A busca  em largura a partir das duas pontas ao mesmo tempo: da
+*     origem pelos sucessores e do destino pelos antecessores. A cada
+*     passo  expandido um nvel inteiro da ponta com a menor fronteira,
+*     e a busca termina quando uma ponta alcana um vrtice da outra,
+*     de forma que s  explorada a vizinhana das duas pontas. O grafo
+*     no deve ser alterado durante as visitas.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeOrigem    - nome do primeiro vrtice do caminho.
+*     nomeDestino   - nome do ltimo vrtice do caminho.
+*     visitar       - funo chamada com o nome e o valor de cada vrtice
+*                     do caminho. Se retornar diferente de 0, as visitas
+*                     terminam. Pode ser NULL.
+*     pContexto     - ponteiro repassado  funo visitar.
+*     pComprimento  - recebe a quantidade de arestas do caminho, 0 se a
+*                     origem  o destino ou -1 se no h caminho. Pode
+*                     ser NULL.
+*
+*  Condies de retorno
+*     GRA_CondRetOK                 - tambm quando no h caminho.
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou           - no existe vrtice com nomeOrigem
+*                                     ou com nomeDestino.
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CaminhoEntre(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto,
+   int *pComprimento);
+
+/***********************************************************************
+*
+*  Funo: GRA Preparar marcos
+*
+*  Descrio
+*     Escolhe numMarcos marcos e calcula, por buscas em largura, a
+*     distncia de cada marco at cada vrtice e de cada vrtice at
+*     cada marco. Os marcos so as origens, na ordem em que se tornaram
+*     origens, e depois os vrtices com mais sucessores e antecessores.
+*
+*     As distncias servem a GRA_EstimarDistancia e a
+*     GRA_CaminhoPorMarcos. Elas so descartadas quando uma aresta 
+*     inserida ou destruda, quando um vrtice  destrudo e quando o
+*     grafo  reordenado, e calculadas de novo, com a mesma quantidade
+*     de marcos, na prxima consulta. Sem esta funo, as consultas
+*     usam 8 marcos.
+*
+*     Ocupa 2 * numMarcos inteiros por vrtice, e o clculo custa
+*     2 * numMarcos buscas em largura pelo grafo inteiro.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     numMarcos     - quantidade de marcos, de 1 a GRA_MAX_MARCOS. Se o
+*                     grafo tiver menos vrtices, todos so marcos.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - numMarcos fora dos limites.
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_PrepararMarcos(GRA_tppGrafo pGrafoParm, int numMarcos);
+
+/***********************************************************************
+*
+*  Funo: GRA Estimar distncia
+*
+*  Descrio
+*     Obtm limites para a quantidade de arestas do caminho mnimo de
+*     nomeOrigem a nomeDestino pela desigualdade triangular com cada
+*     marco (ver GRA_PrepararMarcos), sem percorrer o grafo: o custo 
+*     proporcional  quantidade de marcos, salvo quando as distncias
+*     precisam ser calculadas.
+*
+*  Parmetros
+*     pGrafoParm    - ponteiro para o grafo.
+*     nomeOrigem    - nome do primeiro vrtice do caminho.
+*     nomeDestino   - nome do ltimo vrtice do caminho.
+*     pInferior     - recebe um limite inferior da distncia, ou -1 se
+*                     os marcos garantem que no h caminho.
+*     pSuperior     - recebe o comprimento do menor caminho que passa
+*                     por um marco, ou -1 se nenhum passa.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetNaoAchou           - no existe vrtice com nomeOrigem
+*                                     ou com nomeDestino.
+*     GRA_CondRetFaltouMemoria
+*
+***********************************************************************/
+GRA_tpCondRet GRA_EstimarDistancia(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino,
+   int *pInferior, int *pSuperior);
+
+/***********************************************************************
+*
+*  Funo: GRA Caminho por marcos
+*
+*  Descrio
+*     Como GRA_CaminhoEntre, mas a busca  A* a partir da origem, usando
+*     como estimativa o limite inferior de GRA_EstimarDistancia at o
+*     destino. Os vrtices mais prximos do destino, segundo os marcos,
+*     so expandidos primeiro, e os vrtices de onde os marcos garantem
+*     que o destino no  alcanvel no so expandidos.
+*
+*  Parmetros
+*     Os de GRA_CaminhoEntre.
+*
+*  Condies de retorno
+*     As de GRA_CaminhoEntre.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_CaminhoPorMarcos(GRA_tppGrafo pGrafoParm, char *nomeOrigem, char *nomeDestino,
+   int (*visitar)(const char *nome, void *pValor, void *pContexto), void *pContexto,
+   int *pComprimento);
+
+/***********************************************************************
+*
+*  Funo: GRA Definir auto-organizao
+*
+*  Descrio
+*     Define a poltica aplicada pelas buscas por nome de
+*     GRA_SeguirPelaAresta, na lista de sucessores do corrente, e de
+*     GRA_IrParaAOrigem, na lista de origens. Quando poucas arestas e
+*     origens recebem a maior parte dos acessos, elas passam a ser
+*     achadas nos primeiros elementos. As demais buscas no so
+*     afetadas: as de vrtices e de destinos usam ndices. Nos vrtices
+*     com muitas arestas a busca de GRA_SeguirPelaAresta  feita por
+*     espalhamento e no depende da posio, mas a ordem  mantida do
+*     mesmo jeito.
+*
+*     A poltica muda a ordem em que os sucessores e as origens so
+*     percorridos, e a ordem anterior no  restaurada quando ela 
+*     desligada. Com a poltica ligada, as duas funes de navegao
+*     alteram as listas e no podem ser chamadas durante percursos das
+*     mesmas listas nem em paralelo.
+*
+*  Parmetros
+*     pGrafoParm       - ponteiro para o grafo.
+*     autoOrganizacao  - poltica das prximas buscas. Os grafos so
+*                        criados com GRA_AutoOrganizacaoNenhuma.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*     GRA_CondRetParametroInvalido  - poltica desconhecida.
+*
+***********************************************************************/
+GRA_tpCondRet GRA_DefinirAutoOrganizacao(GRA_tppGrafo pGrafoParm,
+   GRA_tpAutoOrganizacao autoOrganizacao);
+
+/***********************************************************************
+*
+*  Funo: GRA Obter estatsticas de busca
+*
+*  Descrio
+*     Obtm as posies em que foram achadas as arestas procuradas por
+*     GRA_SeguirPelaAresta e as origens procuradas por
+*     GRA_IrParaAOrigem, desde a criao do grafo ou desde a ltima
+*     chamada de GRA_ZerarEstatisticasDeBusca. As estatsticas so
+*     contadas com ou sem auto-organizao, para que as polticas
+*     possam ser comparadas.
+*
+*  Parmetros
+*     pGrafoParm   - ponteiro para o grafo.
+*     pArestas     - recebe as estatsticas das arestas, se no NULL.
+*     pOrigens     - recebe as estatsticas das origens, se no NULL.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ObterEstatisticasDeBusca(GRA_tppGrafo pGrafoParm,
+   GRA_tpEstatisticasBusca *pArestas, GRA_tpEstatisticasBusca *pOrigens);
+
+/***********************************************************************
+*
+*  Funo: GRA Zerar estatsticas de busca
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ZerarEstatisticasDeBusca(GRA_tppGrafo pGrafoParm);
+
+/***********************************************************************
+*
+*  Funo: GRA Obter espao dos sucessores
+*
+*  Descrio
+*     Obtm os bytes ocupados pelas adjacncias que guardam as arestas
+*     que saem dos vrtices e os que as mesmas arestas ocupariam em
+*     listas de lista.h, uma por vrtice. Nas duas contas entram os
+*     bytes do vrtice que apontam para as arestas, mas no as prprias
+*     arestas nem o controle do malloc. Depois da primeira
+*     GRA_AlcancarPorExpressao, as adjacncias incluem tambm os grupos
+*     das arestas por rtulo, que as listas no tm.
+*
+*     A maioria dos vrtices tem poucas arestas, guardadas dentro do
+*     prprio vrtice; as listas custam uma cabea por vrtice e um
+*     elemento por aresta.
+*
+*  Parmetros
+*     pGrafoParm       - ponteiro para o grafo.
+*     pEspaco          - recebe os bytes das adjacncias, se no NULL.
+*     pEspacoEmListas  - recebe os bytes das listas, se no NULL.
+*
+*  Condies de retorno
+*     GRA_CondRetOK
+*     GRA_CondRetGrafoNaoFoiCriado
+*
+***********************************************************************/
+GRA_tpCondRet GRA_ObterEspacoDosSucessores(GRA_tppGrafo pGrafoParm, size_t *pEspaco,
+   size_t *pEspacoEmListas);
+
 
 #ifdef _DEBUG
 
@@ -0,0 +1,899 @@
+/***************************************************************************
+*  Mdulo de implementao: IND  ndice ordenado de chaves
+*
+*  Arquivo gerado:              indice.c
+*  Letras identificadoras:      IND
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*     1.1     rc       19/out/26   Substituio do endereo de uma chave.
+*
+***************************************************************************/
+
+#include   <stdlib.h>
+#include   <string.h>
+
+#define INDICE_OWN
+#include "indice.h"
+#undef INDICE_OWN
+
+/* Mximo de chaves por n; o vetor de prefixos ocupa duas linhas de cache */
+#define MAX_CHAVES 15
+
+/* Mnimo de chaves de um n que no  a raiz */
+#define MIN_CHAVES 7
+
+/* Primeiros 8 bytes de uma chave, em ordem big-endian, completados com 0 */
+typedef unsigned long long tpPrefixo;
+
+/***********************************************************************
+*  Tipo de dados: IND N da rvore
+*
+*  Os vetores tm uma posio a mais que o mximo para que a insero
+*  possa transbordar o n antes de dividi-lo.
+***********************************************************************/
+
+typedef struct tgNo {
+
+   tpPrefixo vtPrefixos[MAX_CHAVES + 1];
+   /* Prefixos das chaves, consultados antes delas na busca */
+
+   int numChaves;
+   /* Quantidade de chaves no n */
+
+   int ehFolha;
+   /* 1 se o n  folha */
+
+   const char *vtChaves[MAX_CHAVES + 1];
+   /* Chaves, em ordem. Num n interno a chave i  a menor chave da
+      subrvore i + 1 */
+
+   void *vtPonteiros[MAX_CHAVES + 2];
+   /* Na folha, os valores das chaves; no n interno, os filhos */
+
+   struct tgNo *pProxima;
+   /* Na folha, a folha seguinte em ordem; na reserva, o prximo n livre */
+
+} tpNo;
+
+/***********************************************************************
+*  Tipo de dados: IND Descritor do ndice
+***********************************************************************/
+
+typedef struct IND_stIndice {
+
+   tpNo *pRaiz;
+   /* Raiz da rvore, que  uma folha vazia no ndice vazio */
+
+   int altura;
+   /* Quantidade de nveis da rvore, 1 quando a raiz  folha */
+
+   int numChaves;
+   /* Quantidade de chaves no ndice */
+
+   tpNo *pReserva;
+   /* Ns j alocados para as divises da prxima insero */
+
+   int numReserva;
+   /* Quantidade de ns na reserva */
+
+} tpIndice;
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+   static tpPrefixo CalcularPrefixo(const char *chave);
+   static int CompararChaves(tpPrefixo prefixo1, const char *chave1,
+                             tpPrefixo prefixo2, const char *chave2);
+   static int ProcurarPosicao(tpNo *pNo, tpPrefixo prefixo, const char *chave, int *pAchou);
+   static tpNo * ProcurarFolha(tpIndice *pIndice, tpPrefixo prefixo, const char *chave,
+                               int *pPosicao, int *pAchou);
+   static int GarantirReserva(tpIndice *pIndice, int numNos);
+   static tpNo * ObterNoDaReserva(tpIndice *pIndice, int ehFolha);
+   static tpNo * InserirEmNo(tpIndice *pIndice, tpNo *pNo, tpPrefixo prefixo,
+                             const char *chave, void *pValor, int *pJaExiste,
+                             tpPrefixo *pPrefixoSeparador, const char **pChaveSeparador);
+   static tpNo * DividirNo(tpIndice *pIndice, tpNo *pNo,
+                           tpPrefixo *pPrefixoSeparador, const char **pChaveSeparador);
+   static int ExcluirDeNo(tpNo *pNo, tpPrefixo prefixo, const char *chave);
+   static void RebalancearFilho(tpNo *pNo, int iFilho);
+   static void RemoverDoNo(tpNo *pNo, int iChave, int iPonteiro);
+   static void LiberarNos(tpNo *pNo);
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: IND Criar ndice
+******/
+IND_tpCondRet IND_CriarIndice(IND_tppIndice *ppIndice)
+{
+   tpIndice *pIndice = (tpIndice*) malloc(sizeof(tpIndice));
+
+   if (pIndice == NULL)
+   {
+      return IND_CondRetFaltouMemoria;
+   }
+
+   pIndice->pReserva = NULL;
+   pIndice->numReserva = 0;
+   if (!GarantirReserva(pIndice, 1))
+   {
+      free(pIndice);
+      return IND_CondRetFaltouMemoria;
+   }
+
+   pIndice->pRaiz = ObterNoDaReserva(pIndice, 1);
+   pIndice->pRaiz->pProxima = NULL;
+   pIndice->altura = 1;
+   pIndice->numChaves = 0;
+
+   *ppIndice = pIndice;
+
+   return IND_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: IND Destruir ndice
+******/
+void IND_DestruirIndice(IND_tppIndice pIndice)
+{
+   tpNo *pNo;
+
+   if (pIndice == NULL)
+   {
+      return;
+   }
+
+   LiberarNos(pIndice->pRaiz);
+   while (pIndice->pReserva != NULL)
+   {
+      pNo = pIndice->pReserva;
+      pIndice->pReserva = pNo->pProxima;
+      free(pNo);
+   }
+
+   free(pIndice);
+}
+
+/***************************************************************************
+*  Funo: IND Inserir
+******/
+IND_tpCondRet IND_Inserir(IND_tppIndice pIndice, const char *chave, void *pValor)
+{
+   tpPrefixo prefixo = CalcularPrefixo(chave);
+   tpPrefixo prefixoSeparador;
+   const char *chaveSeparador;
+   tpNo *pNovo;
+   tpNo *pRaiz;
+   int jaExiste = 0;
+
+   // Cada nvel pode se dividir, e a raiz dividida exige uma nova raiz;
+   // com os ns reservados antes, a insero no falha pela metade
+   if (!GarantirReserva(pIndice, pIndice->altura + 1))
+   {
+      return IND_CondRetFaltouMemoria;
+   }
+
+   pNovo = InserirEmNo(pIndice, pIndice->pRaiz, prefixo, chave, pValor, &jaExiste,
+                       &prefixoSeparador, &chaveSeparador);
+   if (jaExiste)
+   {
+      return IND_CondRetJaExiste;
+   }
+
+   if (pNovo != NULL)
+   {
+      pRaiz = ObterNoDaReserva(pIndice, 0);
+      pRaiz->numChaves = 1;
+      pRaiz->vtPrefixos[0] = prefixoSeparador;
+      pRaiz->vtChaves[0] = chaveSeparador;
+      pRaiz->vtPonteiros[0] = pIndice->pRaiz;
+      pRaiz->vtPonteiros[1] = pNovo;
+      pIndice->pRaiz = pRaiz;
+      pIndice->altura++;
+   }
+
+   pIndice->numChaves++;
+
+   return IND_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: IND Excluir
+******/
+IND_tpCondRet IND_Excluir(IND_tppIndice pIndice, const char *chave)
+{
+   tpNo *pRaiz = pIndice->pRaiz;
+
+   if (!ExcluirDeNo(pRaiz, CalcularPrefixo(chave), chave))
+   {
+      return IND_CondRetNaoAchou;
+   }
+
+   if (!pRaiz->ehFolha && pRaiz->numChaves == 0)
+   {
+      pIndice->pRaiz = (tpNo*) pRaiz->vtPonteiros[0];
+      pIndice->altura--;
+      free(pRaiz);
+   }
+
+   pIndice->numChaves--;
+
+   return IND_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: IND Procurar
+******/
+IND_tpCondRet IND_Procurar(IND_tppIndice pIndice, const char *chave, void **ppValor)
+{
+   tpNo *pFolha;
+   int posicao;
+   int achou;
+
+   pFolha = ProcurarFolha(pIndice, CalcularPrefixo(chave), chave, &posicao, &achou);
+   if (!achou)
+   {
+      return IND_CondRetNaoAchou;
+   }
+
+   if (ppValor != NULL)
+   {
+      *ppValor = pFolha->vtPonteiros[posicao];
+   }
+
+   return IND_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: IND Alterar valor
+******/
+IND_tpCondRet IND_AlterarValor(IND_tppIndice pIndice, const char *chave, void *pValor)
+{
+   tpNo *pFolha;
+   int posicao;
+   int achou;
+
+   pFolha = ProcurarFolha(pIndice, CalcularPrefixo(chave), chave, &posicao, &achou);
+   if (!achou)
+   {
+      return IND_CondRetNaoAchou;
+   }
+
+   pFolha->vtPonteiros[posicao] = pValor;
+
+   return IND_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: IND Substituir
+******/
+IND_tpCondRet IND_Substituir(IND_tppIndice pIndice, const char *chave,
+                             const char *novaChave, void *pValor)
+{
+   tpPrefixo prefixo = CalcularPrefixo(chave);
+   tpNo *pNo = pIndice->pRaiz;
+   int posicao;
+   int achou;
+
+   // A chave pode tambm ser o separador de um n interno do caminho
+   while (!pNo->ehFolha)
+   {
+      posicao = ProcurarPosicao(pNo, prefixo, chave, &achou);
+      if (achou)
+      {
+         pNo->vtChaves[posicao] = novaChave;
+         posicao++;
+      }
+      pNo = (tpNo*) pNo->vtPonteiros[posicao];
+   }
+
+   posicao = ProcurarPosicao(pNo, prefixo, chave, &achou);
+   if (!achou)
+   {
+      return IND_CondRetNaoAchou;
+   }
+
+   pNo->vtChaves[posicao] = novaChave;
+   pNo->vtPonteiros[posicao] = pValor;
+
+   return IND_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: IND Nmero de chaves
+******/
+int IND_NumChaves(IND_tppIndice pIndice)
+{
+   return pIndice->numChaves;
+}
+
+/***************************************************************************
+*  Funo: IND Percorrer intervalo
+******/
+void IND_PercorrerIntervalo(IND_tppIndice pIndice, const char *inicio, const char *fim,
+   int (*visitar)(const char *chave, void *pValor, void *pContexto), void *pContexto)
+{
+   tpPrefixo prefixoFim = fim != NULL ? CalcularPrefixo(fim) : 0;
+   tpNo *pFolha;
+   int i;
+   int achou;
+
+   if (inicio != NULL)
+   {
+      pFolha = ProcurarFolha(pIndice, CalcularPrefixo(inicio), inicio, &i, &achou);
+   }
+   else
+   {
+      pFolha = pIndice->pRaiz;
+      while (!pFolha->ehFolha)
+      {
+         pFolha = (tpNo*) pFolha->vtPonteiros[0];
+      }
+      i = 0;
+   }
+
+   for (; pFolha != NULL; pFolha = pFolha->pProxima, i = 0)
+   {
+      for (; i < pFolha->numChaves; i++)
+      {
+         if (fim != NULL &&
+             CompararChaves(pFolha->vtPrefixos[i], pFolha->vtChaves[i], prefixoFim, fim) > 0)
+         {
+            return;
+         }
+         if (visitar(pFolha->vtChaves[i], pFolha->vtPonteiros[i], pContexto) != 0)
+         {
+            return;
+         }
+      }
+   }
+}
+
+/***************************************************************************
+*  Funo: IND Percorrer prefixo
+******/
+void IND_PercorrerPrefixo(IND_tppIndice pIndice, const char *prefixo,
+   int (*visitar)(const char *chave, void *pValor, void *pContexto), void *pContexto)
+{
+   size_t tamanho = strlen(prefixo);
+   tpNo *pFolha;
+   int i;
+   int achou;
+
+   pFolha = ProcurarFolha(pIndice, CalcularPrefixo(prefixo), prefixo, &i, &achou);
+
+   // As chaves com o prefixo so contguas e comeam na menor chave >= prefixo
+   for (; pFolha != NULL; pFolha = pFolha->pProxima, i = 0)
+   {
+      for (; i < pFolha->numChaves; i++)
+      {
+         if (strncmp(pFolha->vtChaves[i], prefixo, tamanho) != 0)
+         {
+            return;
+         }
+         if (visitar(pFolha->vtChaves[i], pFolha->vtPonteiros[i], pContexto) != 0)
+         {
+            return;
+         }
+      }
+   }
+}
+
+/*****  Cdigo das funes encapsuladas no mdulo  *****/
+
+/***********************************************************************
+*
+*  Funo: IND Calcular prefixo
+*
+*  Descrio:
+*    Empacota os 8 primeiros bytes da chave num inteiro, o primeiro
+*    byte no mais significativo e com zeros depois do fim da chave.
+*    A ordem dos inteiros  a mesma de strcmp entre as chaves.
+*
+***********************************************************************/
+tpPrefixo CalcularPrefixo(const char *chave)
+{
+   tpPrefixo prefixo = 0;
+   int i;
+
+   for (i = 0; i < 8; i++)
+   {
+      prefixo <<= 8;
+      if (*chave != '\0')
+      {
+         prefixo |= (unsigned char) *chave;
+         chave++;
+      }
+   }
+
+   return prefixo;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Comparar chaves
+*
+*  Descrio:
+*    Compara duas chaves como strcmp, usando os prefixos quando eles
+*    bastam. Prefixos iguais cujo ltimo byte  0 so de chaves iguais.
+*
+***********************************************************************/
+int CompararChaves(tpPrefixo prefixo1, const char *chave1,
+                   tpPrefixo prefixo2, const char *chave2)
+{
+   if (prefixo1 != prefixo2)
+   {
+      return prefixo1 < prefixo2 ? -1 : 1;
+   }
+
+   if ((prefixo1 & 0xFF) == 0)
+   {
+      return 0;
+   }
+
+   return strcmp(chave1 + 8, chave2 + 8);
+}
+
+/***********************************************************************
+*
+*  Funo: IND Procurar posio
+*
+*  Descrio:
+*    Retorna a posio da primeira chave do n maior ou igual  chave
+*    dada, ou numChaves se no houver. Em *pAchou retorna se ela 
+*    igual. A busca  sequencial sobre o vetor de prefixos, que o
+*    processador l adiantado; o ponteiro da chave s  seguido quando
+*    os prefixos empatam.
+*
+***********************************************************************/
+int ProcurarPosicao(tpNo *pNo, tpPrefixo prefixo, const char *chave, int *pAchou)
+{
+   int i;
+   int comparacao;
+
+   for (i = 0; i < pNo->numChaves; i++)
+   {
+      if (pNo->vtPrefixos[i] < prefixo)
+      {
+         continue;
+      }
+      if (pNo->vtPrefixos[i] > prefixo)
+      {
+         break;
+      }
+      comparacao = CompararChaves(prefixo, pNo->vtChaves[i], prefixo, chave);
+      if (comparacao >= 0)
+      {
+         *pAchou = comparacao == 0;
+         return i;
+      }
+   }
+
+   *pAchou = 0;
+
+   return i;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Procurar folha
+*
+*  Descrio:
+*    Desce da raiz at a folha em que a chave est ou estaria. Retorna
+*    a folha e, em *pPosicao, a posio da primeira chave maior ou igual
+*     dada. Se essa posio for o fim da folha, avana para a folha
+*    seguinte, de forma que a posio retornada  sempre a de uma chave
+*    quando ela existe.
+*
+***********************************************************************/
+tpNo * ProcurarFolha(tpIndice *pIndice, tpPrefixo prefixo, const char *chave,
+                     int *pPosicao, int *pAchou)
+{
+   tpNo *pNo = pIndice->pRaiz;
+   int posicao;
+   int achou;
+
+   while (!pNo->ehFolha)
+   {
+      posicao = ProcurarPosicao(pNo, prefixo, chave, &achou);
+      pNo = (tpNo*) pNo->vtPonteiros[achou ? posicao + 1 : posicao];
+   }
+
+   posicao = ProcurarPosicao(pNo, prefixo, chave, pAchou);
+   if (posicao == pNo->numChaves && pNo->pProxima != NULL)
+   {
+      pNo = pNo->pProxima;
+      posicao = 0;
+   }
+
+   *pPosicao = posicao;
+
+   return pNo;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Garantir reserva
+*
+*  Descrio:
+*    Aloca ns at que a reserva tenha pelo menos numNos. Retorna 0 se
+*    faltar memria; os ns j alocados ficam na reserva.
+*
+***********************************************************************/
+int GarantirReserva(tpIndice *pIndice, int numNos)
+{
+   tpNo *pNo;
+
+   while (pIndice->numReserva < numNos)
+   {
+      pNo = (tpNo*) malloc(sizeof(tpNo));
+      if (pNo == NULL)
+      {
+         return 0;
+      }
+      pNo->pProxima = pIndice->pReserva;
+      pIndice->pReserva = pNo;
+      pIndice->numReserva++;
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Obter n da reserva
+*
+*  Descrio:
+*    Retira um n vazio da reserva, que no pode estar vazia.
+*
+***********************************************************************/
+tpNo * ObterNoDaReserva(tpIndice *pIndice, int ehFolha)
+{
+   tpNo *pNo = pIndice->pReserva;
+
+   pIndice->pReserva = pNo->pProxima;
+   pIndice->numReserva--;
+
+   pNo->numChaves = 0;
+   pNo->ehFolha = ehFolha;
+   pNo->pProxima = NULL;
+
+   return pNo;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Inserir em n
+*
+*  Descrio:
+*    Insere a chave na subrvore de pNo. Se pNo transbordar,  dividido
+*    e a funo retorna o novo n  sua direita, com a chave que o
+*    separa de pNo em *pPrefixoSeparador e *pChaveSeparador; seno
+*    retorna NULL. Se a chave j existir, nada muda e *pJaExiste
+*    recebe 1.
+*
+***********************************************************************/
+tpNo * InserirEmNo(tpIndice *pIndice, tpNo *pNo, tpPrefixo prefixo,
+                   const char *chave, void *pValor, int *pJaExiste,
+                   tpPrefixo *pPrefixoSeparador, const char **pChaveSeparador)
+{
+   tpNo *pNovo;
+   int posicao;
+   int achou;
+   int n = pNo->numChaves;
+
+   posicao = ProcurarPosicao(pNo, prefixo, chave, &achou);
+
+   if (pNo->ehFolha)
+   {
+      if (achou)
+      {
+         *pJaExiste = 1;
+         return NULL;
+      }
+
+      memmove(&pNo->vtPrefixos[posicao + 1], &pNo->vtPrefixos[posicao],
+              (n - posicao) * sizeof(tpPrefixo));
+      memmove(&pNo->vtChaves[posicao + 1], &pNo->vtChaves[posicao],
+              (n - posicao) * sizeof(const char*));
+      memmove(&pNo->vtPonteiros[posicao + 1], &pNo->vtPonteiros[posicao],
+              (n - posicao) * sizeof(void*));
+      pNo->vtPrefixos[posicao] = prefixo;
+      pNo->vtChaves[posicao] = chave;
+      pNo->vtPonteiros[posicao] = pValor;
+   }
+   else
+   {
+      if (achou)
+      {
+         *pJaExiste = 1;
+         return NULL;
+      }
+
+      pNovo = InserirEmNo(pIndice, (tpNo*) pNo->vtPonteiros[posicao], prefixo, chave, pValor,
+                          pJaExiste, pPrefixoSeparador, pChaveSeparador);
+      if (pNovo == NULL)
+      {
+         return NULL;
+      }
+
+      // O filho foi dividido: o separador entra na posio dele e o novo
+      // n fica logo  direita
+      memmove(&pNo->vtPrefixos[posicao + 1], &pNo->vtPrefixos[posicao],
+              (n - posicao) * sizeof(tpPrefixo));
+      memmove(&pNo->vtChaves[posicao + 1], &pNo->vtChaves[posicao],
+              (n - posicao) * sizeof(const char*));
+      memmove(&pNo->vtPonteiros[posicao + 2], &pNo->vtPonteiros[posicao + 1],
+              (n - posicao) * sizeof(void*));
+      pNo->vtPrefixos[posicao] = *pPrefixoSeparador;
+      pNo->vtChaves[posicao] = *pChaveSeparador;
+      pNo->vtPonteiros[posicao + 1] = pNovo;
+   }
+
+   pNo->numChaves++;
+   if (pNo->numChaves <= MAX_CHAVES)
+   {
+      return NULL;
+   }
+
+   return DividirNo(pIndice, pNo, pPrefixoSeparador, pChaveSeparador);
+}
+
+/***********************************************************************
+*
+*  Funo: IND Dividir n
+*
+*  Descrio:
+*    Divide um n que transbordou, movendo a metade direita para um n
+*    da reserva. Na folha o separador  a primeira chave do novo n e
+*    continua nele; no n interno o separador sobe e sai dos dois.
+*
+***********************************************************************/
+tpNo * DividirNo(tpIndice *pIndice, tpNo *pNo,
+                 tpPrefixo *pPrefixoSeparador, const char **pChaveSeparador)
+{
+   tpNo *pNovo = ObterNoDaReserva(pIndice, pNo->ehFolha);
+   int meio = (MAX_CHAVES + 1) / 2;
+   int inicio;
+
+   if (pNo->ehFolha)
+   {
+      inicio = meio;
+      memcpy(pNovo->vtPonteiros, &pNo->vtPonteiros[inicio],
+             (pNo->numChaves - inicio) * sizeof(void*));
+      pNovo->pProxima = pNo->pProxima;
+      pNo->pProxima = pNovo;
+   }
+   else
+   {
+      inicio = meio + 1;
+      memcpy(pNovo->vtPonteiros, &pNo->vtPonteiros[inicio],
+             (pNo->numChaves - inicio + 1) * sizeof(void*));
+   }
+
+   memcpy(pNovo->vtPrefixos, &pNo->vtPrefixos[inicio],
+          (pNo->numChaves - inicio) * sizeof(tpPrefixo));
+   memcpy(pNovo->vtChaves, &pNo->vtChaves[inicio],
+          (pNo->numChaves - inicio) * sizeof(const char*));
+   pNovo->numChaves = pNo->numChaves - inicio;
+
+   *pPrefixoSeparador = pNo->vtPrefixos[meio];
+   *pChaveSeparador = pNo->vtChaves[meio];
+   pNo->numChaves = meio;
+
+   return pNovo;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Excluir de n
+*
+*  Descrio:
+*    Exclui a chave da subrvore de pNo. Retorna 0 se ela no estava l.
+*    Os filhos que ficam com menos que o mnimo so rebalanceados, mas
+*    pNo pode ficar abaixo do mnimo; quem o contm o rebalanceia.
+*
+*    Cada separador  mantido igual  menor chave da subrvore  sua
+*    direita, por isso nenhum separador aponta para uma chave excluda,
+*    que o cliente pode liberar em seguida.
+*
+***********************************************************************/
+int ExcluirDeNo(tpNo *pNo, tpPrefixo prefixo, const char *chave)
+{
+   tpNo *pFilho;
+   tpNo *pMenor;
+   int posicao;
+   int achou;
+
+   posicao = ProcurarPosicao(pNo, prefixo, chave, &achou);
+
+   if (pNo->ehFolha)
+   {
+      if (!achou)
+      {
+         return 0;
+      }
+      RemoverDoNo(pNo, posicao, posicao);
+      return 1;
+   }
+
+   if (achou)
+   {
+      posicao++;
+   }
+
+   pFilho = (tpNo*) pNo->vtPonteiros[posicao];
+   if (!ExcluirDeNo(pFilho, prefixo, chave))
+   {
+      return 0;
+   }
+
+   if (posicao > 0)
+   {
+      pMenor = pFilho;
+      while (!pMenor->ehFolha)
+      {
+         pMenor = (tpNo*) pMenor->vtPonteiros[0];
+      }
+      pNo->vtPrefixos[posicao - 1] = pMenor->vtPrefixos[0];
+      pNo->vtChaves[posicao - 1] = pMenor->vtChaves[0];
+   }
+
+   if (pFilho->numChaves < MIN_CHAVES)
+   {
+      RebalancearFilho(pNo, posicao);
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Rebalancear filho
+*
+*  Descrio:
+*    Recompe o filho iFilho de pNo, que ficou com uma chave a menos que
+*    o mnimo, tomando uma chave emprestada de um irmo que tenha folga
+*    ou, se nenhum tiver, fundindo-o com um irmo.
+*
+***********************************************************************/
+void RebalancearFilho(tpNo *pNo, int iFilho)
+{
+   tpNo *pFilho = (tpNo*) pNo->vtPonteiros[iFilho];
+   tpNo *pEsquerdo = iFilho > 0 ? (tpNo*) pNo->vtPonteiros[iFilho - 1] : NULL;
+   tpNo *pDireito = iFilho < pNo->numChaves ? (tpNo*) pNo->vtPonteiros[iFilho + 1] : NULL;
+   int n = pFilho->numChaves;
+   int ultimo;
+
+   if (pEsquerdo != NULL && pEsquerdo->numChaves > MIN_CHAVES)
+   {
+      ultimo = pEsquerdo->numChaves - 1;
+      memmove(&pFilho->vtPrefixos[1], &pFilho->vtPrefixos[0], n * sizeof(tpPrefixo));
+      memmove(&pFilho->vtChaves[1], &pFilho->vtChaves[0], n * sizeof(const char*));
+      if (pFilho->ehFolha)
+      {
+         memmove(&pFilho->vtPonteiros[1], &pFilho->vtPonteiros[0], n * sizeof(void*));
+         pFilho->vtPrefixos[0] = pEsquerdo->vtPrefixos[ultimo];
+         pFilho->vtChaves[0] = pEsquerdo->vtChaves[ultimo];
+         pFilho->vtPonteiros[0] = pEsquerdo->vtPonteiros[ultimo];
+      }
+      else
+      {
+         memmove(&pFilho->vtPonteiros[1], &pFilho->vtPonteiros[0], (n + 1) * sizeof(void*));
+         pFilho->vtPrefixos[0] = pNo->vtPrefixos[iFilho - 1];
+         pFilho->vtChaves[0] = pNo->vtChaves[iFilho - 1];
+         pFilho->vtPonteiros[0] = pEsquerdo->vtPonteiros[ultimo + 1];
+      }
+      pNo->vtPrefixos[iFilho - 1] = pEsquerdo->vtPrefixos[ultimo];
+      pNo->vtChaves[iFilho - 1] = pEsquerdo->vtChaves[ultimo];
+      pEsquerdo->numChaves--;
+      pFilho->numChaves++;
+      return;
+   }
+
+   if (pDireito != NULL && pDireito->numChaves > MIN_CHAVES)
+   {
+      if (pFilho->ehFolha)
+      {
+         pFilho->vtPrefixos[n] = pDireito->vtPrefixos[0];
+         pFilho->vtChaves[n] = pDireito->vtChaves[0];
+         pFilho->vtPonteiros[n] = pDireito->vtPonteiros[0];
+         RemoverDoNo(pDireito, 0, 0);
+         pNo->vtPrefixos[iFilho] = pDireito->vtPrefixos[0];
+         pNo->vtChaves[iFilho] = pDireito->vtChaves[0];
+      }
+      else
+      {
+         pFilho->vtPrefixos[n] = pNo->vtPrefixos[iFilho];
+         pFilho->vtChaves[n] = pNo->vtChaves[iFilho];
+         pFilho->vtPonteiros[n + 1] = pDireito->vtPonteiros[0];
+         pNo->vtPrefixos[iFilho] = pDireito->vtPrefixos[0];
+         pNo->vtChaves[iFilho] = pDireito->vtChaves[0];
+         RemoverDoNo(pDireito, 0, 0);
+      }
+      pFilho->numChaves++;
+      return;
+   }
+
+   // Nenhum irmo tem folga: funde o par (esquerdo, direito) no esquerdo
+   if (pEsquerdo == NULL)
+   {
+      pEsquerdo = pFilho;
+      pFilho = pDireito;
+      iFilho++;
+   }
+
+   n = pEsquerdo->numChaves;
+   if (pEsquerdo->ehFolha)
+   {
+      memcpy(&pEsquerdo->vtPrefixos[n], pFilho->vtPrefixos, pFilho->numChaves * sizeof(tpPrefixo));
+      memcpy(&pEsquerdo->vtChaves[n], pFilho->vtChaves, pFilho->numChaves * sizeof(const char*));
+      memcpy(&pEsquerdo->vtPonteiros[n], pFilho->vtPonteiros, pFilho->numChaves * sizeof(void*));
+      pEsquerdo->numChaves = n + pFilho->numChaves;
+      pEsquerdo->pProxima = pFilho->pProxima;
+   }
+   else
+   {
+      pEsquerdo->vtPrefixos[n] = pNo->vtPrefixos[iFilho - 1];
+      pEsquerdo->vtChaves[n] = pNo->vtChaves[iFilho - 1];
+      memcpy(&pEsquerdo->vtPrefixos[n + 1], pFilho->vtPrefixos, pFilho->numChaves * sizeof(tpPrefixo));
+      memcpy(&pEsquerdo->vtChaves[n + 1], pFilho->vtChaves, pFilho->numChaves * sizeof(const char*));
+      memcpy(&pEsquerdo->vtPonteiros[n + 1], pFilho->vtPonteiros,
+             (pFilho->numChaves + 1) * sizeof(void*));
+      pEsquerdo->numChaves = n + 1 + pFilho->numChaves;
+   }
+
+   RemoverDoNo(pNo, iFilho - 1, iFilho);
+   free(pFilho);
+}
+
+/***********************************************************************
+*
+*  Funo: IND Remover do n
+*
+*  Descrio:
+*    Retira do n a chave iChave e o ponteiro iPonteiro, deslocando os
+*    seguintes.
+*
+***********************************************************************/
+void RemoverDoNo(tpNo *pNo, int iChave, int iPonteiro)
+{
+   int numPonteiros = pNo->ehFolha ? pNo->numChaves : pNo->numChaves + 1;
+
+   memmove(&pNo->vtPrefixos[iChave], &pNo->vtPrefixos[iChave + 1],
+           (pNo->numChaves - iChave - 1) * sizeof(tpPrefixo));
+   memmove(&pNo->vtChaves[iChave], &pNo->vtChaves[iChave + 1],
+           (pNo->numChaves - iChave - 1) * sizeof(const char*));
+   memmove(&pNo->vtPonteiros[iPonteiro], &pNo->vtPonteiros[iPonteiro + 1],
+           (numPonteiros - iPonteiro - 1) * sizeof(void*));
+   pNo->numChaves--;
+}
+
+/***********************************************************************
+*
+*  Funo: IND Liberar ns
+*
+*  Descrio:
+*    Libera a subrvore de pNo.
+*
+***********************************************************************/
+void LiberarNos(tpNo *pNo)
+{
+   int i;
+
+   if (!pNo->ehFolha)
+   {
+      for (i = 0; i <= pNo->numChaves; i++)
+      {
+         LiberarNos((tpNo*) pNo->vtPonteiros[i]);
+      }
+   }
+
+   free(pNo);
+}
+
+/********** Fim do mdulo de implementao: IND  ndice ordenado de chaves **********/
@@ -0,0 +1,211 @@
+#if ! defined( INDICE_ )
+#define INDICE_
+/***************************************************************************
+*
+*  Mdulo de definio: IND  ndice ordenado de chaves
+*
+*  Arquivo gerado:              indice.h
+*  Letras identificadoras:      IND
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*     1.1     rc       19/out/26   Substituio do endereo de uma chave.
+*
+*  Descrio do mdulo
+*     Implementa uma rvore B+ que associa chaves do tipo string a
+*     valores genricos, mantendo as chaves em ordem (a de strcmp).
+*     Alm da busca, insero e excluso em tempo logartmico, permite
+*     percorrer em ordem as chaves de um intervalo ou com um prefixo
+*     dado, custando apenas a descida at a primeira chave e a leitura
+*     das chaves percorridas.
+*
+*     Os ns guardam at 15 chaves. Cada n mantm, num vetor contguo
+*      parte, os 8 primeiros bytes de cada chave como um inteiro, de
+*     forma que a busca dentro do n compara inteiros em duas linhas de
+*     cache e s segue o ponteiro da chave quando os 8 primeiros bytes
+*     empatam.
+*
+*     O ndice no copia as chaves: cada chave deve permanecer vlida e
+*     inalterada enquanto estiver no ndice.
+*
+***************************************************************************/
+
+#if defined( INDICE_OWN )
+   #define INDICE_EXT
+#else
+   #define INDICE_EXT extern
+#endif
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/* Tipo referncia para um ndice */
+typedef struct IND_stIndice * IND_tppIndice ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: IND Condies de retorno
+*
+***********************************************************************/
+
+   typedef enum {
+
+         IND_CondRetOK ,
+               /* Concluiu corretamente */
+
+         IND_CondRetJaExiste ,
+               /* A chave j est no ndice */
+
+         IND_CondRetNaoAchou ,
+               /* A chave no est no ndice */
+
+         IND_CondRetFaltouMemoria
+               /* Faltou memria */
+
+   } IND_tpCondRet ;
+
+
+/***********************************************************************
+*
+*  Funo: IND Criar ndice
+*
+*  Condies de retorno
+*     IND_CondRetOK
+*     IND_CondRetFaltouMemoria
+*
+***********************************************************************/
+   IND_tpCondRet IND_CriarIndice(IND_tppIndice *ppIndice);
+
+/***********************************************************************
+*
+*  Funo: IND Destruir ndice
+*
+*  Descrio
+*     Libera o ndice. As chaves e os valores no so liberados.
+*
+***********************************************************************/
+   void IND_DestruirIndice(IND_tppIndice pIndice);
+
+/***********************************************************************
+*
+*  Funo: IND Inserir
+*
+*  Parmetros
+*     pIndice   - ndice.
+*     chave     - chave, que no  copiada.
+*     pValor    - valor associado  chave.
+*
+*  Condies de retorno
+*     IND_CondRetOK
+*     IND_CondRetJaExiste
+*     IND_CondRetFaltouMemoria  - o ndice no foi alterado.
+*
+***********************************************************************/
+   IND_tpCondRet IND_Inserir(IND_tppIndice pIndice, const char *chave, void *pValor);
+
+/***********************************************************************
+*
+*  Funo: IND Excluir
+*
+*  Descrio
+*     Retira a chave do ndice. No aloca memria, portanto no falha
+*     por falta dela.
+*
+*  Condies de retorno
+*     IND_CondRetOK
+*     IND_CondRetNaoAchou
+*
+***********************************************************************/
+   IND_tpCondRet IND_Excluir(IND_tppIndice pIndice, const char *chave);
+
+/***********************************************************************
+*
+*  Funo: IND Procurar
+*
+*  Parmetros
+*     pIndice   - ndice.
+*     chave     - chave procurada.
+*     ppValor   - ponteiro para o retorno do valor associado, ou NULL.
+*
+*  Condies de retorno
+*     IND_CondRetOK
+*     IND_CondRetNaoAchou
+*
+***********************************************************************/
+   IND_tpCondRet IND_Procurar(IND_tppIndice pIndice, const char *chave, void **ppValor);
+
+/***********************************************************************
+*
+*  Funo: IND Alterar valor
+*
+*  Descrio
+*     Troca o valor associado a uma chave que j est no ndice.
+*
+*  Condies de retorno
+*     IND_CondRetOK
+*     IND_CondRetNaoAchou
+*
+***********************************************************************/
+   IND_tpCondRet IND_AlterarValor(IND_tppIndice pIndice, const char *chave, void *pValor);
+
+/***********************************************************************
+*
+*  Funo: IND Substituir
+*
+*  Descrio
+*     Troca o ponteiro de uma chave que j est no ndice por outro, com
+*     o mesmo contedo, e o valor associado a ela. Usada quando a chave
+*     muda de endereo. No aloca memria.
+*
+*  Condies de retorno
+*     IND_CondRetOK
+*     IND_CondRetNaoAchou
+*
+***********************************************************************/
+   IND_tpCondRet IND_Substituir(IND_tppIndice pIndice, const char *chave,
+                                const char *novaChave, void *pValor);
+
+/***********************************************************************
+*
+*  Funo: IND Nmero de chaves
+*
+***********************************************************************/
+   int IND_NumChaves(IND_tppIndice pIndice);
+
+/***********************************************************************
+*
+*  Funo: IND Percorrer intervalo
+*
+*  Descrio
+*     Chama visitar, em ordem crescente, para cada chave entre inicio e
+*     fim, inclusive. Um limite NULL no restringe o intervalo. O
+*     percurso  interrompido se visitar retornar diferente de 0.
+*     A funo visitar no deve inserir nem excluir chaves.
+*
+***********************************************************************/
+   void IND_PercorrerIntervalo(IND_tppIndice pIndice, const char *inicio, const char *fim,
+      int (*visitar)(const char *chave, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: IND Percorrer prefixo
+*
+*  Descrio
+*     Como IND_PercorrerIntervalo, para as chaves que comeam por
+*     prefixo. O prefixo vazio seleciona todas as chaves.
+*
+***********************************************************************/
+   void IND_PercorrerPrefixo(IND_tppIndice pIndice, const char *prefixo,
+      int (*visitar)(const char *chave, void *pValor, void *pContexto), void *pContexto);
+
+/***********************************************************************/
+#undef INDICE_EXT
+
+/********** Fim do mdulo de definio: IND  ndice ordenado de chaves **********/
+
+#else
+#endif
@@ -14,6 +14,12 @@
 *     2.0     rc    15/set/2013 Implementao e adaptao do restante das funes para trabalhar somente com o tipo char.
 *     3.0     hg    10/out/2013 Adaptao do mdulo para trabalhar com uma lista cujos valores tero um tipo qualquer.
 *     4.0     hg    03/dez/2013 Instrumentao para a estrutura saber o total de espao alocado por ela.
+*     4.1     rc    19/out/2026 Destruio da lista sem destruir os valores.
+*     4.2     rc    19/out/2026 Percurso da lista sem uso do elemento corrente.
+*     4.3     rc    19/out/2026 Busca e iterador externo que no alteram a lista.
+*     4.4     rc    19/out/2026 Elemento exposto em listaesp.h para buscas especializadas.
+*     4.5     rc    19/out/2026 Listas auto-organizveis por mover para a frente ou transpor.
+*     4.6     rc    19/out/2026 Tamanho da cabea, para medies de espao.
 *
 *  Assertivas estruturais da lista
 *    Referncias entre os elementos
@@ -39,22 +45,16 @@
 #include "lista.h"
 #undef LISTA_OWN
 
+#include "listaesp.h"
+
 /***********************************************************************
 *  Tipo de dados: LIS Elemento da lista
+*
+*  Definido em listaesp.h, para que as buscas especializadas percorram
+*  os elementos sem chamar o mdulo a cada passo.
 ***********************************************************************/
 
-typedef struct stElemLista {
-
-   void * pValor ;
-   /* valor contido no elemento */
-
-   struct stElemLista * pAnt ;
-   /* Ponteiro para o elemento predecessor */
-
-   struct stElemLista * pProx ;
-   /* Ponteiro para o elemento sucessor */
-
-} tpElemLista ;
+typedef LIS_tpElemLista tpElemLista ;
 
 /***********************************************************************
 *  Tipo de dados: LIS Descritor da cabea de lista
@@ -80,6 +80,9 @@ typedef struct LIS_stLista {
    int (*compararValores)(void * pValor1 , void * pValor2);
    /* Lgica responsvel por comparar dois valores */
 
+   LIS_tpAutoOrganizacao autoOrganizacao ;
+   /* O que as buscas fazem com o elemento achado */
+
 #ifdef _DEBUG
    unsigned long totalEspacoAlocado;
    /* Tamanho em bytes de todo espao alocado para o armazenamento da lista */
@@ -118,6 +121,7 @@ LIS_tpCondRet LIS_CriarLista(LIS_tppLista *ppLista,
 
    pLista->destruirValor = destruirValor;
    pLista->compararValores = compararValores;
+   pLista->autoOrganizacao = LIS_AutoOrganizacaoNenhuma;
 
 #ifdef _DEBUG
    pLista->totalEspacoAlocado = _msize(pLista);
@@ -140,6 +144,16 @@ LIS_tpCondRet LIS_DestruirLista(LIS_tppLista pLista)
    return LIS_CondRetOK;
 }
 
+/***************************************************************************
+*  Funo: LIS Destruir lista sem valores
+*  ****/
+LIS_tpCondRet LIS_DestruirListaSemValores(LIS_tppLista pLista)
+{
+   pLista->destruirValor = NULL;
+
+   return LIS_DestruirLista(pLista);
+}
+
 /***************************************************************************
 *  Funo: LIS Esvaziar lista
 *  ****/
@@ -423,6 +437,7 @@ LIS_tpCondRet LIS_ProcurarValor(LIS_tppLista pLista,
       if (pLista->compararValores(pElem->pValor, pValor) == 0)
       {
          pLista->pElemCorr = pElem;
+         LIS_AutoOrganizar(pLista, pElem);
          return LIS_CondRetOK;
       }
    }
@@ -431,6 +446,168 @@ LIS_tpCondRet LIS_ProcurarValor(LIS_tppLista pLista,
 
 }
 
+/***************************************************************************
+*  Funo: LIS Definir auto-organizao
+*  ****/
+LIS_tpCondRet LIS_DefinirAutoOrganizacao(LIS_tppLista pLista,
+   LIS_tpAutoOrganizacao autoOrganizacao)
+{
+   pLista->autoOrganizacao = autoOrganizacao;
+
+   return LIS_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: LIS Para cada elemento
+*  ****/
+LIS_tpCondRet LIS_ParaCadaElemento(LIS_tppLista pLista,
+   int (*processar)(void *pValor, void *pContexto), void *pContexto)
+{
+   const tpElemLista *pElem;
+
+   for ( pElem  = pLista->pOrigemLista ;
+      pElem != NULL ;
+      pElem  = pElem->pProx )
+   {
+      if (processar(pElem->pValor, pContexto))
+      {
+         break;
+      }
+   }
+
+   return LIS_CondRetOK;
+
+}
+
+/***************************************************************************
+*  Funo: LIS Procurar valor sem alterar a lista
+*  ****/
+LIS_tpCondRet LIS_ProcurarValorConst(LIS_tppLista pLista, void *pValor,
+   void **ppValorAchado)
+{
+   const tpElemLista *pElem;
+
+   if (pLista->pOrigemLista == NULL)
+   {
+      return LIS_CondRetListaVazia;
+   }
+
+   for ( pElem  = pLista->pOrigemLista ;
+      pElem != NULL ;
+      pElem  = pElem->pProx )
+   {
+      if (pLista->compararValores(pElem->pValor, pValor) == 0)
+      {
+         if (ppValorAchado != NULL)
+         {
+            *ppValorAchado = pElem->pValor;
+         }
+         return LIS_CondRetOK;
+      }
+   }
+
+   return LIS_CondRetNaoAchou;
+
+}
+
+/***************************************************************************
+*  Funo: LIS Obter primeiro elemento
+*  ****/
+const LIS_tpElemLista * LIS_ObterPrimeiroElemento(LIS_tppLista pLista)
+{
+   return pLista->pOrigemLista;
+}
+
+/***************************************************************************
+*  Funo: LIS Ir para elemento
+*  ****/
+int LIS_IrParaElemento(LIS_tppLista pLista, const LIS_tpElemLista *pElem)
+{
+   if (pElem == NULL)
+   {
+      return 0;
+   }
+
+   pLista->pElemCorr = (tpElemLista*) pElem;
+
+   return 1;
+}
+
+/***************************************************************************
+*  Funo: LIS Auto-organizar
+*  ****/
+void LIS_AutoOrganizar(LIS_tppLista pLista, const LIS_tpElemLista *pElemParm)
+{
+   tpElemLista *pElem = (tpElemLista*) pElemParm;
+   tpElemLista *pSeguinte;
+
+   if (pElem == NULL || pElem->pAnt == NULL ||
+       pLista->autoOrganizacao == LIS_AutoOrganizacaoNenhuma)
+   {
+      return;
+   }
+
+   // pSeguinte  o elemento que ficar logo depois de pElem
+   pSeguinte = pLista->autoOrganizacao == LIS_AutoOrganizacaoMoverParaFrente ?
+               pLista->pOrigemLista : pElem->pAnt;
+
+   pElem->pAnt->pProx = pElem->pProx;
+   if (pElem->pProx != NULL)
+   {
+      pElem->pProx->pAnt = pElem->pAnt;
+   }
+   else
+   {
+      pLista->pFimLista = pElem->pAnt;
+   }
+
+   pElem->pAnt = pSeguinte->pAnt;
+   pElem->pProx = pSeguinte;
+   if (pSeguinte->pAnt != NULL)
+   {
+      pSeguinte->pAnt->pProx = pElem;
+   }
+   else
+   {
+      pLista->pOrigemLista = pElem;
+   }
+   pSeguinte->pAnt = pElem;
+}
+
+/***************************************************************************
+*  Funo: LIS Tamanho da cabea
+*  ****/
+size_t LIS_TamanhoCabeca(void)
+{
+   return sizeof(LIS_tpLista);
+}
+
+/***************************************************************************
+*  Funo: LIS Iniciar iterador
+*  ****/
+void LIS_IniciarIterador(LIS_tppLista pLista, LIS_tpIterador *pIterador)
+{
+   pIterador->pProx = pLista->pOrigemLista;
+}
+
+/***************************************************************************
+*  Funo: LIS Avanar iterador
+*  ****/
+LIS_tpCondRet LIS_AvancarIterador(LIS_tpIterador *pIterador, void **ppValor)
+{
+   const tpElemLista *pElem = (const tpElemLista*) pIterador->pProx;
+
+   if (pElem == NULL)
+   {
+      return LIS_CondRetFimLista;
+   }
+
+   *ppValor = pElem->pValor;
+   pIterador->pProx = pElem->pProx;
+
+   return LIS_CondRetOK;
+}
+
 /***************************************************************************
 *  Funo: LIS Esta Vazia
 *  ****/
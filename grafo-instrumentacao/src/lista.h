@@ -17,6 +17,11 @@
 *     2.0     rc    15/set/2013 Implementao e adaptao do restante das funes para trabalhar somente com o tipo char.
 *     3.0     hg    10/out/2013 Adaptao do mdulo para trabalhar com uma lista cujos valores tero um tipo qualquer.
 *     4.0     hg    03/dez/2013 Instrumentao para a estrutura saber o total de espao alocado por ela.
+*     4.1     rc    19/out/2026 Destruio da lista sem destruir os valores.
+*     4.2     rc    19/out/2026 Percurso da lista sem uso do elemento corrente.
+*     4.3     rc    19/out/2026 Busca e iterador externo que no alteram a lista.
+*     4.4     rc    19/out/2026 Elemento exposto em listaesp.h para buscas especializadas.
+*     4.5     rc    19/out/2026 Listas auto-organizveis por mover para a frente ou transpor.
 *
 *  Descrio do mdulo
 *     Implementa listas genricas duplamente encadeadas com manipulao,
@@ -30,6 +35,10 @@
 *     Cada lista armazena dados genricos.
 *     Cada elemento da lista possui uma referncia para o valor.
 *
+*     As buscas desta interface comparam os valores pela funo dada na
+*     criao da lista. Mdulos que precisam de buscas mais rpidas podem
+*     gerar buscas especializadas com listaesp.h.
+*
 ***************************************************************************/
  
 #if defined( LISTA_OWN )
@@ -44,6 +53,25 @@
 typedef struct LIS_stLista * LIS_tppLista ;
 
 
+/***********************************************************************
+*
+*  Tipo de dados: LIS Iterador
+*
+*  Descrio do tipo
+*     Posio de um percurso da lista guardada fora dela, de forma que
+*     vrios percursos podem ser feitos ao mesmo tempo sem alterar o
+*     elemento corrente. O campo  de uso exclusivo do mdulo.
+*
+***********************************************************************/
+
+   typedef struct {
+
+         const void * pProx ;
+               /* Prximo elemento a ser entregue, ou NULL no fim */
+
+   } LIS_tpIterador ;
+
+
 /***********************************************************************
 *
 *  Tipo de dados: LIS Condies de retorno
@@ -74,6 +102,31 @@ typedef struct LIS_stLista * LIS_tppLista ;
    } LIS_tpCondRet ;
 
 
+/***********************************************************************
+*
+*  Tipo de dados: LIS Polticas de auto-organizao
+*
+*
+*  Descrio do tipo
+*     O que  feito com o elemento achado por LIS_ProcurarValor, para
+*     que os valores mais procurados fiquem no incio da lista.
+*
+***********************************************************************/
+
+   typedef enum {
+
+         LIS_AutoOrganizacaoNenhuma ,
+               /* A ordem da lista no  alterada pelas buscas */
+
+         LIS_AutoOrganizacaoMoverParaFrente ,
+               /* O elemento achado passa a ser o primeiro da lista */
+
+         LIS_AutoOrganizacaoTranspor
+               /* O elemento achado troca de lugar com o anterior */
+
+   } LIS_tpAutoOrganizacao ;
+
+
 /***********************************************************************
 *
 *  Funo: LIS Criar lista
@@ -142,6 +195,24 @@ typedef struct LIS_stLista * LIS_tppLista ;
 ***********************************************************************/
    LIS_tpCondRet LIS_DestruirLista(LIS_tppLista pLista) ;
 
+/***********************************************************************
+*
+*  Funo: LIS Destruir lista sem valores
+*
+*  Descrio
+*     Destri a lista sem chamar a funo de destruio dos valores, que
+*     continuam pertencendo a quem os inseriu. Usada quando os valores
+*     j foram, ou sero, destrudos de outra forma.
+*
+*  Parmetros
+*     pLista  - Referncia da lista a ser destruida.
+*
+*  Condies de retorno
+*     - LIS_CondRetOK
+*
+***********************************************************************/
+   LIS_tpCondRet LIS_DestruirListaSemValores(LIS_tppLista pLista) ;
+
 /***********************************************************************
 *
 *  Funo: LIS Esvaziar lista
@@ -407,12 +478,134 @@ typedef struct LIS_stLista * LIS_tppLista ;
 *  Assertivas de sada
 *     - Valem as assertivas estruturais da lista duplamente encadeada com cabea.
 *     - Se valor for encontrado ento o corrente ser o elemento que contm este valor.
+*       O elemento  movido conforme a poltica de LIS_DefinirAutoOrganizacao.
 *     - Se valor no for encontrado ento o corrente permanece o mesmo.
 *
 ***********************************************************************/
    LIS_tpCondRet LIS_ProcurarValor(LIS_tppLista pLista,
                                     void *pValor);
 
+/***********************************************************************
+*
+*  Funo: LIS Definir auto-organizao
+*
+*  Descrio
+*     Define o que LIS_ProcurarValor faz com o elemento achado. Com
+*     acessos concentrados em poucos valores, mover para a frente deixa
+*     os mais procurados nos primeiros elementos logo aps o primeiro
+*     acesso; transpor os aproxima do incio aos poucos e  menos
+*     sensvel a acessos isolados. A ordem anterior no  restaurada
+*     quando a poltica volta a ser LIS_AutoOrganizacaoNenhuma.
+*
+*     Com a poltica ligada, as buscas alteram a lista: os iteradores
+*     abertos deixam de valer, e buscas simultneas na mesma lista
+*     precisam de trava. As listas so criadas sem poltica.
+*
+*  Parmetros
+*     pLista           - ponteiro para a lista.
+*     autoOrganizacao  - poltica usada nas prximas buscas.
+*
+*  Condies de retorno
+*     LIS_CondRetOK
+*
+***********************************************************************/
+   LIS_tpCondRet LIS_DefinirAutoOrganizacao(LIS_tppLista pLista,
+                                            LIS_tpAutoOrganizacao autoOrganizacao);
+
+/***********************************************************************
+*
+*  Funo: LIS Para cada elemento
+*
+*  Descrio
+*     Chama processar para o valor de cada elemento, do incio para o
+*     fim da lista, at que processar retorne diferente de 0.
+*     O elemento corrente no  lido nem alterado, de forma que vrios
+*     percursos podem ser feitos ao mesmo tempo sobre a mesma lista,
+*     desde que ela no seja alterada enquanto isso.
+*
+*  Parmetros
+*     pLista     - ponteiro para a lista percorrida.
+*     processar  - funo chamada com o valor e o contexto.
+*     pContexto  - ponteiro repassado  funo processar.
+*
+*  Condies de retorno
+*     LIS_CondRetOK
+*
+*  Assertivas de entrada
+*     - Valem as assertivas estruturais da lista duplamente encadeada com cabea.
+*     - processar no insere nem exclui elementos da lista.
+*
+*  Assertivas de sada
+*     - Valem as assertivas estruturais da lista duplamente encadeada com cabea.
+*     - O corrente permanece o mesmo.
+*
+***********************************************************************/
+   LIS_tpCondRet LIS_ParaCadaElemento(LIS_tppLista pLista,
+                                      int (*processar)(void *pValor, void *pContexto),
+                                      void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: LIS Procurar valor sem alterar a lista
+*
+*  Descrio
+*     Procura, a partir do incio da lista, o primeiro elemento cujo
+*     valor  igual a pValor segundo a funo de comparao da lista.
+*     Ao contrrio de LIS_ProcurarValor, o elemento corrente no  lido
+*     nem alterado.
+*
+*  Parmetros
+*     pLista         - ponteiro para a lista onde procura.
+*     pValor         - valor procurado, repassado  comparao.
+*     ppValorAchado  - recebe o valor do elemento achado, ou NULL.
+*
+*  Condies de retorno
+*     LIS_CondRetOK
+*     LIS_CondRetNaoAchou
+*     LIS_CondRetListaVazia
+*
+*  Assertivas de entrada
+*     - Valem as assertivas estruturais da lista duplamente encadeada com cabea.
+*
+*  Assertivas de sada
+*     - Valem as assertivas estruturais da lista duplamente encadeada com cabea.
+*     - O corrente permanece o mesmo.
+*
+***********************************************************************/
+   LIS_tpCondRet LIS_ProcurarValorConst(LIS_tppLista pLista, void *pValor,
+                                        void **ppValorAchado);
+
+/***********************************************************************
+*
+*  Funo: LIS Iniciar iterador
+*
+*  Descrio
+*     Posiciona o iterador no primeiro elemento da lista.
+*     O iterador continua vlido enquanto a lista no for alterada.
+*
+***********************************************************************/
+   void LIS_IniciarIterador(LIS_tppLista pLista, LIS_tpIterador *pIterador);
+
+/***********************************************************************
+*
+*  Funo: LIS Avanar iterador
+*
+*  Descrio
+*     Entrega o valor do elemento em que o iterador est e o avana
+*     para o seguinte.
+*
+*  Parmetros
+*     pIterador  - iterador iniciado por LIS_IniciarIterador.
+*     ppValor    - recebe o valor do elemento.
+*
+*  Condies de retorno
+*     LIS_CondRetOK
+*     LIS_CondRetFimLista  - todos os elementos j foram entregues;
+*                            ppValor no  alterado.
+*
+***********************************************************************/
+   LIS_tpCondRet LIS_AvancarIterador(LIS_tpIterador *pIterador, void **ppValor);
+
 /***********************************************************************
 *
 *  Funo: LIS Esta Vazia
@@ -0,0 +1,199 @@
+#if ! defined( LISTAESP_ )
+#define LISTAESP_
+/***************************************************************************
+*
+*  Mdulo de definio: LIS  Buscas especializadas por tipo na lista
+*
+*  Arquivo gerado:              listaesp.h
+*  Letras identificadoras:      LIS
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*     1.1     rc       19/out/26   Buscas que contam a posio e auto-organizao.
+*     1.2     rc       19/out/26   Tamanho da cabea, para medies de espao.
+*
+*  Descrio do mdulo
+*     As buscas de lista.h chamam, a cada elemento, a funo de comparao
+*     guardada na cabea da lista. Por ser uma chamada indireta, o
+*     compilador no a pode expandir dentro do lao.
+*
+*     Este arquivo expe o elemento da lista a quem precisa de buscas
+*     rpidas e define a macro LIS_DEFINIR_BUSCA, que gera, no mdulo que
+*     a usa, funes de busca em que o tipo do valor, o tipo da chave e a
+*     comparao so fixos. A comparao  uma chamada direta a uma
+*     funo do prprio mdulo, que o compilador pode expandir no lao.
+*
+*     As listas continuam sendo criadas e alteradas por lista.h; as
+*     funes geradas s as leem. Para excluir o elemento achado, ele 
+*     tornado corrente por LIS_IrParaElemento.
+*
+*     Exemplo, num mdulo que guarda arestas em listas:
+*
+*        static int ArestaTemNome(tpAresta *pAresta, const char *nome);
+*        LIS_DEFINIR_BUSCA(Aresta, tpAresta, const char *, ArestaTemNome)
+*
+*     gera LIS_ProcurarAresta(pLista, nome), que retorna o elemento da
+*     primeira aresta com o nome, ou NULL. LIS_VALOR_ELEMENTO obtm a
+*     aresta, e LIS_IrParaElemento torna o elemento corrente.
+*
+*     LIS_DEFINIR_BUSCA_CONTADA gera buscas que tambm informam a
+*     posio do elemento achado; com LIS_AutoOrganizar, o elemento
+*     achado  movido como numa busca de LIS_ProcurarValor.
+*
+***************************************************************************/
+
+#include <stddef.h>
+
+#include "lista.h"
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/***********************************************************************
+*
+*  Tipo de dados: LIS Elemento da lista
+*
+*  Descrio do tipo
+*     Elemento usado por lista.c. Os campos s devem ser lidos fora dela.
+*
+***********************************************************************/
+
+   typedef struct LIS_stElemLista {
+
+         void * pValor ;
+               /* Valor contido no elemento */
+
+         struct LIS_stElemLista * pAnt ;
+               /* Ponteiro para o elemento predecessor */
+
+         struct LIS_stElemLista * pProx ;
+               /* Ponteiro para o elemento sucessor */
+
+   } LIS_tpElemLista ;
+
+
+/***********************************************************************
+*
+*  Funo: LIS Obter primeiro elemento
+*
+*  Descrio
+*     Retorna o primeiro elemento da lista, ou NULL se ela est vazia.
+*     O elemento corrente no  alterado.
+*
+***********************************************************************/
+   const LIS_tpElemLista * LIS_ObterPrimeiroElemento(LIS_tppLista pLista);
+
+/***********************************************************************
+*
+*  Funo: LIS Ir para elemento
+*
+*  Descrio
+*     Torna corrente o elemento dado, que deve pertencer  lista, e
+*     retorna 1. Se pElem for NULL a lista no  alterada e retorna 0,
+*     de forma que o resultado de uma busca pode ser passado direto.
+*
+***********************************************************************/
+   int LIS_IrParaElemento(LIS_tppLista pLista, const LIS_tpElemLista *pElem);
+
+/***********************************************************************
+*
+*  Funo: LIS Auto-organizar
+*
+*  Descrio
+*     Move o elemento dado, que deve pertencer  lista, conforme a
+*     poltica de LIS_DefinirAutoOrganizacao, como se ele tivesse sido
+*     achado por LIS_ProcurarValor. O elemento corrente continua o
+*     mesmo. Se pElem for NULL ou a lista no tiver poltica, nada 
+*     feito.
+*
+***********************************************************************/
+   void LIS_AutoOrganizar(LIS_tppLista pLista, const LIS_tpElemLista *pElem);
+
+/***********************************************************************
+*
+*  Funo: LIS Tamanho da cabea
+*
+*  Descrio
+*     Retorna o tamanho da cabea de uma lista, alocada por
+*     LIS_CriarLista. Com sizeof(LIS_tpElemLista) por elemento, permite
+*     estimar o espao de listas sem percorr-las.
+*
+***********************************************************************/
+   size_t LIS_TamanhoCabeca(void);
+
+/***********************************************************************
+*
+*  Macro: LIS Definir busca
+*
+*  Descrio
+*     Gera a funo esttica LIS_Procurar<Nome>, que retorna o primeiro
+*     elemento cujo valor corresponde  chave, ou NULL, sem alterar a
+*     lista. Os valores so do tipo TipoValor. Igual recebe um
+*     TipoValor * e uma TipoChave e retorna diferente de 0 se o valor
+*     corresponde  chave; deve ser declarada antes do uso da macro.
+*
+***********************************************************************/
+#define LIS_DEFINIR_BUSCA( Nome , TipoValor , TipoChave , Igual )            \
+                                                                             \
+   static const LIS_tpElemLista * LIS_Procurar##Nome(LIS_tppLista pLista,   \
+                                                     TipoChave chave)        \
+   {                                                                         \
+      const LIS_tpElemLista *pElem;                                          \
+                                                                             \
+      for (pElem = LIS_ObterPrimeiroElemento(pLista);                        \
+           pElem != NULL;                                                    \
+           pElem = pElem->pProx)                                             \
+      {                                                                      \
+         if (Igual((TipoValor*) pElem->pValor, chave))                       \
+         {                                                                   \
+            return pElem;                                                    \
+         }                                                                   \
+      }                                                                      \
+                                                                             \
+      return NULL;                                                           \
+   }
+
+/***********************************************************************
+*
+*  Macro: LIS Definir busca contada
+*
+*  Descrio
+*     Como LIS_DEFINIR_BUSCA, mas gera LIS_Procurar<Nome>Contando, que
+*     recebe tambm pPosicao. Ela recebe a posio do elemento achado,
+*     a partir de 1, ou, se nenhum foi achado, a quantidade de elementos
+*     da lista.
+*
+***********************************************************************/
+#define LIS_DEFINIR_BUSCA_CONTADA( Nome , TipoValor , TipoChave , Igual )    \
+                                                                             \
+   static const LIS_tpElemLista * LIS_Procurar##Nome##Contando(              \
+      LIS_tppLista pLista, TipoChave chave, int *pPosicao)                   \
+   {                                                                         \
+      const LIS_tpElemLista *pElem;                                          \
+      int posicao = 0;                                                       \
+                                                                             \
+      for (pElem = LIS_ObterPrimeiroElemento(pLista);                        \
+           pElem != NULL;                                                    \
+           pElem = pElem->pProx)                                             \
+      {                                                                      \
+         posicao++;                                                          \
+         if (Igual((TipoValor*) pElem->pValor, chave))                       \
+         {                                                                   \
+            break;                                                           \
+         }                                                                   \
+      }                                                                      \
+                                                                             \
+      *pPosicao = posicao;                                                   \
+      return pElem;                                                          \
+   }
+
+/* Valor do elemento retornado por uma busca, ou NULL se ela no achou */
+#define LIS_VALOR_ELEMENTO( pElem ) ( (pElem) == NULL ? NULL : (pElem)->pValor )
+
+/********** Fim do mdulo de definio: LIS  Buscas especializadas por tipo na lista **********/
+
+#else
+#endif
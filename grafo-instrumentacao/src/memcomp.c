@@ -0,0 +1,287 @@
+/***************************************************************************
+*  Mdulo de implementao: MCO  Segmentos de memria compartilhada
+*
+*  Arquivo gerado:              memcomp.c
+*  Letras identificadoras:      MCO
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+***************************************************************************/
+
+#include   <stdio.h>
+#include   <stdlib.h>
+#include   <string.h>
+
+#ifdef _WIN32
+   #include   <windows.h>
+#else
+   #include   <errno.h>
+   #include   <fcntl.h>
+   #include   <unistd.h>
+   #include   <sys/mman.h>
+   #include   <sys/stat.h>
+#endif
+
+#define MEMCOMP_OWN
+#include "memcomp.h"
+#undef MEMCOMP_OWN
+
+#define MAX_CHARS_NOME_SEGMENTO 250
+
+/***********************************************************************
+*  Tipo de dados: MCO Descritor de segmento
+***********************************************************************/
+
+typedef struct MCO_stSegmento {
+
+   void *pBase;
+   /* Endereo do mapeamento neste processo */
+
+   size_t tamanho;
+   /* Tamanho do mapeamento em bytes */
+
+#ifdef _WIN32
+   HANDLE hMapeamento;
+   /* Mapeamento nomeado, que existe enquanto houver um handle aberto */
+#else
+   char nome[MAX_CHARS_NOME_SEGMENTO + 2];
+   /* Nome POSIX, com a barra inicial, usado na remoo */
+#endif
+
+} tpSegmento;
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+#ifndef _WIN32
+   static int MontarNome(const char *nome, char *nomePosix);
+#endif
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: MCO Criar segmento
+******/
+MCO_tpCondRet MCO_CriarSegmento(const char *nome, size_t tamanho,
+                                MCO_tppSegmento *ppSegmento)
+{
+   tpSegmento *pSegmento = (tpSegmento*) malloc(sizeof(tpSegmento));
+#ifndef _WIN32
+   int descritor;
+#endif
+
+   if (pSegmento == NULL)
+   {
+      return MCO_CondRetFaltouMemoria;
+   }
+
+#ifdef _WIN32
+   pSegmento->hMapeamento = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+      (DWORD) ((unsigned long long) tamanho >> 32), (DWORD) tamanho, nome);
+   if (pSegmento->hMapeamento == NULL)
+   {
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+   if (GetLastError() == ERROR_ALREADY_EXISTS)
+   {
+      CloseHandle(pSegmento->hMapeamento);
+      free(pSegmento);
+      return MCO_CondRetJaExiste;
+   }
+
+   pSegmento->pBase = MapViewOfFile(pSegmento->hMapeamento, FILE_MAP_WRITE, 0, 0, tamanho);
+   if (pSegmento->pBase == NULL)
+   {
+      CloseHandle(pSegmento->hMapeamento);
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+#else
+   if (!MontarNome(nome, pSegmento->nome))
+   {
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+
+   descritor = shm_open(pSegmento->nome, O_RDWR | O_CREAT | O_EXCL, 0644);
+   if (descritor < 0)
+   {
+      free(pSegmento);
+      return errno == EEXIST ? MCO_CondRetJaExiste : MCO_CondRetErroSistema;
+   }
+
+   if (ftruncate(descritor, (off_t) tamanho) != 0)
+   {
+      close(descritor);
+      shm_unlink(pSegmento->nome);
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+
+   pSegmento->pBase = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, descritor, 0);
+   close(descritor);
+   if (pSegmento->pBase == MAP_FAILED)
+   {
+      shm_unlink(pSegmento->nome);
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+#endif
+
+   pSegmento->tamanho = tamanho;
+   *ppSegmento = pSegmento;
+
+   return MCO_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: MCO Abrir segmento
+******/
+MCO_tpCondRet MCO_AbrirSegmento(const char *nome, MCO_tppSegmento *ppSegmento)
+{
+   tpSegmento *pSegmento = (tpSegmento*) malloc(sizeof(tpSegmento));
+#ifdef _WIN32
+   MEMORY_BASIC_INFORMATION informacao;
+#else
+   struct stat estado;
+   int descritor;
+#endif
+
+   if (pSegmento == NULL)
+   {
+      return MCO_CondRetFaltouMemoria;
+   }
+
+#ifdef _WIN32
+   pSegmento->hMapeamento = OpenFileMappingA(FILE_MAP_READ, FALSE, nome);
+   if (pSegmento->hMapeamento == NULL)
+   {
+      free(pSegmento);
+      return MCO_CondRetNaoAchou;
+   }
+
+   pSegmento->pBase = MapViewOfFile(pSegmento->hMapeamento, FILE_MAP_READ, 0, 0, 0);
+   if (pSegmento->pBase == NULL ||
+       VirtualQuery(pSegmento->pBase, &informacao, sizeof(informacao)) == 0)
+   {
+      if (pSegmento->pBase != NULL)
+      {
+         UnmapViewOfFile(pSegmento->pBase);
+      }
+      CloseHandle(pSegmento->hMapeamento);
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+
+   // O tamanho da regio  arredondado para pginas; o contedo guarda o exato
+   pSegmento->tamanho = informacao.RegionSize;
+#else
+   if (!MontarNome(nome, pSegmento->nome))
+   {
+      free(pSegmento);
+      return MCO_CondRetNaoAchou;
+   }
+
+   descritor = shm_open(pSegmento->nome, O_RDONLY, 0);
+   if (descritor < 0)
+   {
+      free(pSegmento);
+      return errno == ENOENT ? MCO_CondRetNaoAchou : MCO_CondRetErroSistema;
+   }
+
+   if (fstat(descritor, &estado) != 0 || estado.st_size == 0)
+   {
+      close(descritor);
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+
+   pSegmento->tamanho = (size_t) estado.st_size;
+   pSegmento->pBase = mmap(NULL, pSegmento->tamanho, PROT_READ, MAP_SHARED, descritor, 0);
+   close(descritor);
+   if (pSegmento->pBase == MAP_FAILED)
+   {
+      free(pSegmento);
+      return MCO_CondRetErroSistema;
+   }
+#endif
+
+   *ppSegmento = pSegmento;
+
+   return MCO_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: MCO Obter endereo
+******/
+void * MCO_ObterEndereco(MCO_tppSegmento pSegmento, size_t *pTamanho)
+{
+   if (pTamanho != NULL)
+   {
+      *pTamanho = pSegmento->tamanho;
+   }
+
+   return pSegmento->pBase;
+}
+
+/***************************************************************************
+*  Funo: MCO Fechar segmento
+******/
+void MCO_FecharSegmento(MCO_tppSegmento pSegmento, int remover)
+{
+   if (pSegmento == NULL)
+   {
+      return;
+   }
+
+#ifdef _WIN32
+   // Em Windows o nome some junto com o ltimo handle; remover no se aplica
+   UnmapViewOfFile(pSegmento->pBase);
+   CloseHandle(pSegmento->hMapeamento);
+#else
+   munmap(pSegmento->pBase, pSegmento->tamanho);
+   if (remover)
+   {
+      shm_unlink(pSegmento->nome);
+   }
+#endif
+
+   free(pSegmento);
+}
+
+/*****  Cdigo das funes encapsuladas no mdulo  *****/
+
+#ifndef _WIN32
+
+/***********************************************************************
+*
+*  Funo: MCO Montar nome
+*
+*  Descrio:
+*    Acrescenta a barra inicial exigida pelo shm_open. Retorna 0 se o
+*    nome for vazio, longo demais ou contiver outra barra.
+*
+***********************************************************************/
+int MontarNome(const char *nome, char *nomePosix)
+{
+   size_t tamanho = strlen(nome);
+
+   if (tamanho == 0 || tamanho > MAX_CHARS_NOME_SEGMENTO || strchr(nome, '/') != NULL)
+   {
+      return 0;
+   }
+
+   nomePosix[0] = '/';
+   memcpy(nomePosix + 1, nome, tamanho + 1);
+
+   return 1;
+}
+
+#endif
+
+/********** Fim do mdulo de implementao: MCO  Segmentos de memria compartilhada **********/
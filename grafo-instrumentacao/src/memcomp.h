@@ -0,0 +1,146 @@
+#if ! defined( MEMCOMP_ )
+#define MEMCOMP_
+/***************************************************************************
+*
+*  Mdulo de definio: MCO  Segmentos de memria compartilhada
+*
+*  Arquivo gerado:              memcomp.h
+*  Letras identificadoras:      MCO
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+*  Descrio do mdulo
+*     Isola as chamadas do sistema operacional que criam, abrem e removem
+*     segmentos nomeados de memria compartilhada entre processos.
+*     Em sistemas POSIX usa shm_open e mmap; em Windows usa mapeamentos
+*     de arquivo nomeados (CreateFileMapping e MapViewOfFile).
+*
+*     Em POSIX o segmento existe at ser removido, mesmo que nenhum
+*     processo o tenha aberto. Em Windows ele existe enquanto algum
+*     processo o mantiver aberto, por isso quem o cria deve mant-lo
+*     aberto enquanto ele tiver de ser encontrado por outros processos.
+*
+*     O endereo em que o segmento  mapeado varia de processo para
+*     processo, portanto o contedo no deve conter ponteiros.
+*
+***************************************************************************/
+
+#if defined( MEMCOMP_OWN )
+   #define MEMCOMP_EXT
+#else
+   #define MEMCOMP_EXT extern
+#endif
+
+#include <stddef.h>
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/* Tipo referncia para um segmento aberto por este processo */
+typedef struct MCO_stSegmento * MCO_tppSegmento ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: MCO Condies de retorno
+*
+***********************************************************************/
+
+   typedef enum {
+
+         MCO_CondRetOK ,
+               /* Concluiu corretamente */
+
+         MCO_CondRetJaExiste ,
+               /* J existe um segmento com o nome dado */
+
+         MCO_CondRetNaoAchou ,
+               /* No existe segmento com o nome dado */
+
+         MCO_CondRetFaltouMemoria ,
+               /* Faltou memria para o descritor do segmento */
+
+         MCO_CondRetErroSistema
+               /* O sistema operacional recusou a operao */
+
+   } MCO_tpCondRet ;
+
+
+/***********************************************************************
+*
+*  Funo: MCO Criar segmento
+*
+*  Descrio
+*     Cria um segmento com o nome e tamanho dados e o mapeia para
+*     leitura e escrita, preenchido com zeros.
+*
+*  Parmetros
+*     nome          - nome do segmento, sem barras.
+*     tamanho       - tamanho em bytes.
+*     ppSegmento    - referncia usada para retorno do segmento.
+*
+*  Condies de retorno
+*     MCO_CondRetOK
+*     MCO_CondRetJaExiste
+*     MCO_CondRetFaltouMemoria
+*     MCO_CondRetErroSistema
+*
+***********************************************************************/
+   MCO_tpCondRet MCO_CriarSegmento(const char *nome, size_t tamanho,
+                                   MCO_tppSegmento *ppSegmento);
+
+/***********************************************************************
+*
+*  Funo: MCO Abrir segmento
+*
+*  Descrio
+*     Abre um segmento existente e o mapeia somente para leitura.
+*
+*  Parmetros
+*     nome          - nome do segmento, sem barras.
+*     ppSegmento    - referncia usada para retorno do segmento.
+*
+*  Condies de retorno
+*     MCO_CondRetOK
+*     MCO_CondRetNaoAchou
+*     MCO_CondRetFaltouMemoria
+*     MCO_CondRetErroSistema
+*
+***********************************************************************/
+   MCO_tpCondRet MCO_AbrirSegmento(const char *nome, MCO_tppSegmento *ppSegmento);
+
+/***********************************************************************
+*
+*  Funo: MCO Obter endereo
+*
+*  Descrio
+*     Retorna o endereo em que o segmento est mapeado neste processo
+*     e o seu tamanho.
+*
+***********************************************************************/
+   void * MCO_ObterEndereco(MCO_tppSegmento pSegmento, size_t *pTamanho);
+
+/***********************************************************************
+*
+*  Funo: MCO Fechar segmento
+*
+*  Descrio
+*     Desfaz o mapeamento e libera o descritor. Se remover for diferente
+*     de 0, remove tambm o nome do segmento, de forma que novas
+*     aberturas no o encontrem; processos que j o abriram continuam
+*     podendo us-lo.
+*
+***********************************************************************/
+   void MCO_FecharSegmento(MCO_tppSegmento pSegmento, int remover);
+
+/***********************************************************************/
+#undef MEMCOMP_EXT
+
+/********** Fim do mdulo de definio: MCO  Segmentos de memria compartilhada **********/
+
+#else
+#endif
@@ -0,0 +1,136 @@
+/***************************************************************************
+*  Mdulo de implementao: TAR  Tarefas em segundo plano
+*
+*  Arquivo gerado:              tarefa.c
+*  Letras identificadoras:      TAR
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+***************************************************************************/
+
+#include   <stdlib.h>
+
+#ifdef _WIN32
+   #include   <windows.h>
+#else
+   #include   <pthread.h>
+#endif
+
+#define TAREFA_OWN
+#include "tarefa.h"
+#undef TAREFA_OWN
+
+/***********************************************************************
+*  Tipo de dados: TAR Descritor de tarefa
+***********************************************************************/
+
+typedef struct TAR_stTarefa {
+
+   void (*executar)(void *pContexto);
+   /* Funo executada pela tarefa */
+
+   void *pContexto;
+   /* Ponteiro repassado  funo */
+
+#ifdef _WIN32
+   HANDLE hLinha;
+   /* Linha de execuo da tarefa */
+#else
+   pthread_t linha;
+   /* Linha de execuo da tarefa */
+#endif
+
+} tpTarefa;
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+#ifdef _WIN32
+   static DWORD WINAPI ExecutarTarefa(LPVOID pVazio);
+#else
+   static void * ExecutarTarefa(void *pVazio);
+#endif
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: TAR Iniciar tarefa
+******/
+TAR_tpCondRet TAR_IniciarTarefa(TAR_tppTarefa *ppTarefa,
+                                void (*executar)(void *pContexto), void *pContexto)
+{
+   tpTarefa *pTarefa = (tpTarefa*) malloc(sizeof(tpTarefa));
+
+   *ppTarefa = NULL;
+   if (pTarefa == NULL)
+   {
+      return TAR_CondRetFaltouMemoria;
+   }
+
+   pTarefa->executar = executar;
+   pTarefa->pContexto = pContexto;
+
+#ifdef _WIN32
+   pTarefa->hLinha = CreateThread(NULL, 0, ExecutarTarefa, pTarefa, 0, NULL);
+   if (pTarefa->hLinha == NULL)
+#else
+   if (pthread_create(&pTarefa->linha, NULL, ExecutarTarefa, pTarefa) != 0)
+#endif
+   {
+      free(pTarefa);
+      return TAR_CondRetErroSistema;
+   }
+
+   *ppTarefa = pTarefa;
+
+   return TAR_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: TAR Esperar tarefa
+******/
+void TAR_EsperarTarefa(TAR_tppTarefa pTarefa)
+{
+   if (pTarefa == NULL)
+   {
+      return;
+   }
+
+#ifdef _WIN32
+   WaitForSingleObject(pTarefa->hLinha, INFINITE);
+   CloseHandle(pTarefa->hLinha);
+#else
+   pthread_join(pTarefa->linha, NULL);
+#endif
+
+   free(pTarefa);
+}
+
+/*****  Cdigo das funes encapsuladas no mdulo  *****/
+
+/***********************************************************************
+*
+*  Funo: TAR Executar tarefa
+*
+*  Descrio:
+*    Ponto de entrada da linha de execuo, na conveno de cada sistema.
+*
+***********************************************************************/
+#ifdef _WIN32
+DWORD WINAPI ExecutarTarefa(LPVOID pVazio)
+#else
+void * ExecutarTarefa(void *pVazio)
+#endif
+{
+   tpTarefa *pTarefa = (tpTarefa*) pVazio;
+
+   pTarefa->executar(pTarefa->pContexto);
+
+   return 0;
+}
+
+/********** Fim do mdulo de implementao: TAR  Tarefas em segundo plano **********/
@@ -0,0 +1,96 @@
+#if ! defined( TAREFA_ )
+#define TAREFA_
+/***************************************************************************
+*
+*  Mdulo de definio: TAR  Tarefas em segundo plano
+*
+*  Arquivo gerado:              tarefa.h
+*  Letras identificadoras:      TAR
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+*  Descrio do mdulo
+*     Isola as chamadas do sistema operacional que executam uma funo
+*     numa linha de execuo (thread) prpria e esperam o seu trmino.
+*     Em sistemas POSIX usa pthreads; em Windows usa CreateThread.
+*
+*     O mdulo no sincroniza os dados usados pela funo: quem inicia a
+*     tarefa no deve toc-los at esper-la.
+*
+***************************************************************************/
+
+#if defined( TAREFA_OWN )
+   #define TAREFA_EXT
+#else
+   #define TAREFA_EXT extern
+#endif
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/* Tipo referncia para uma tarefa iniciada */
+typedef struct TAR_stTarefa * TAR_tppTarefa ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: TAR Condies de retorno
+*
+***********************************************************************/
+
+   typedef enum {
+
+         TAR_CondRetOK ,
+               /* Concluiu corretamente */
+
+         TAR_CondRetFaltouMemoria ,
+               /* Faltou memria para o descritor da tarefa */
+
+         TAR_CondRetErroSistema
+               /* O sistema operacional recusou a criao da linha */
+
+   } TAR_tpCondRet ;
+
+
+/***********************************************************************
+*
+*  Funo: TAR Iniciar tarefa
+*
+*  Descrio
+*     Executa executar(pContexto) numa nova linha de execuo.
+*
+*  Parmetros
+*     ppTarefa      - referncia usada para retorno da tarefa.
+*     executar      - funo executada pela tarefa.
+*     pContexto     - ponteiro repassado  funo.
+*
+*  Condies de retorno
+*     TAR_CondRetOK
+*     TAR_CondRetFaltouMemoria
+*     TAR_CondRetErroSistema
+*
+***********************************************************************/
+   TAR_tpCondRet TAR_IniciarTarefa(TAR_tppTarefa *ppTarefa,
+                                   void (*executar)(void *pContexto), void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: TAR Esperar tarefa
+*
+*  Descrio
+*     Espera a funo da tarefa retornar e libera o descritor.
+*
+***********************************************************************/
+   void TAR_EsperarTarefa(TAR_tppTarefa pTarefa);
+
+/***********************************************************************/
+#undef TAREFA_EXT
+
+/********** Fim do mdulo de definio: TAR  Tarefas em segundo plano **********/
+
+#else
+#endif
@@ -15,7 +15,13 @@
 
 
 static const char *CRIAR_GRAFO_CMD      = "=criarGrafo"       ;
+static const char *CRIAR_GRAFO_CHV_CMD  = "=criarGrafoChaves" ;
+static const char *CRIAR_GRAFO_VAL_CMD  = "=criarGrafoValores";
+static const char *LER_VALOR_CMD        = "=lerValor"         ;
+static const char *GRAVAR_VALOR_CMD     = "=gravarValor"      ;
 static const char *DESTRUIR_GRAFO_CMD   = "=destruirGrafo"    ;
+static const char *DESTRUIR_LOTE_CMD    = "=destruirEmLote"   ;
+static const char *ESPERAR_DESTR_CMD    = "=esperarDestruicao";
 static const char *INS_VERT_CMD         = "=insVertice"       ;
 static const char *INS_ARESTA_CMD       = "=insAresta"        ;
 static const char *OBTER_VALOR_CMD      = "=obterValor"       ;
@@ -24,10 +30,75 @@ static const char *EXC_VERT_CMD         = "=excluirVertice"   ;
 static const char *IR_ORIGEM_CMD        = "=irOrigem"         ;
 static const char *IR_VERTICE_CMD       = "=irVertice"        ;
 static const char *IR_ARESTA_CMD        = "=irPelaAresta"     ;
+static const char *EXISTE_ARESTA_CMD    = "=existeAresta"     ;
+static const char *RECUSAR_PARAL_CMD    = "=recusarParalelas" ;
 static const char *DESTRUIR_VERT_CMD    = "=destruirCorr"     ;
 static const char *DESTRUIR_ARESTA_CMD  = "=destruirAresta"   ;
 static const char *TORNAR_ORIGEM_CMD    = "=tornarOrigem"     ;
 static const char *DEIXAR_ORIGEM_CMD    = "=deixarOrigem"     ;
+static const char *CRIAR_VISAO_CMD      = "=criarVisao"       ;
+static const char *CRIAR_VISAO_PRED_CMD = "=criarVisaoPred"   ;
+static const char *DESTRUIR_VISAO_CMD   = "=destruirVisao"    ;
+static const char *INCLUIR_VISAO_CMD    = "=incluirNaVisao"   ;
+static const char *EXCLUIR_VISAO_CMD    = "=excluirDaVisao"   ;
+static const char *VISAO_IR_VERT_CMD    = "=visaoIrVertice"   ;
+static const char *VISAO_IR_ADJ_CMD     = "=visaoIrAdjacente" ;
+static const char *VISAO_IR_ARESTA_CMD  = "=visaoIrPelaAresta";
+static const char *VISAO_OBTER_CMD      = "=visaoObterValor"  ;
+static const char *VISAO_PERCORRER_CMD  = "=visaoPercorrer"   ;
+static const char *VISAO_PERC_MARC_CMD  = "=visaoPercMarcado" ;
+static const char *CRIAR_MARCADOR_CMD   = "=criarMarcador"    ;
+static const char *DESTRUIR_MARC_CMD    = "=destruirMarcador" ;
+static const char *REINICIAR_MARC_CMD   = "=reiniciarMarcador";
+static const char *MARCAR_VERT_CMD      = "=marcarVertice"    ;
+static const char *VERT_MARCADO_CMD     = "=vertEstaMarcado"  ;
+static const char *MARCAR_CORR_CMD      = "=marcarCorrente"   ;
+static const char *CORR_MARCADO_CMD     = "=corrEstaMarcado"  ;
+static const char *REORDENAR_CMD        = "=reordenar"        ;
+static const char *PUBLICAR_CMD         = "=publicar"         ;
+static const char *RETIRAR_PUBL_CMD     = "=retirarPublicacao";
+static const char *ANEXAR_CMD           = "=anexar"           ;
+static const char *DESANEXAR_CMD        = "=desanexar"        ;
+static const char *COMP_IR_VERT_CMD     = "=compIrVertice"    ;
+static const char *COMP_IR_ARESTA_CMD   = "=compIrPelaAresta" ;
+static const char *COMP_OBTER_CMD       = "=compObterValor"   ;
+static const char *COMP_PERCORRER_CMD   = "=compPercorrer"    ;
+static const char *ABRIR_PERSIST_CMD    = "=abrirPersistente" ;
+static const char *PONTO_CONTROLE_CMD   = "=pontoDeControle"  ;
+static const char *SINCRONIZAR_CMD      = "=sincronizar"      ;
+static const char *CONFIRMACAO_CMD      = "=confirmacaoEmGrupo";
+static const char *TRUNCAR_LOG_CMD      = "=truncarLog"       ;
+static const char *REMOVER_PERSIST_CMD  = "=removerPersistente";
+static const char *LISTAR_PREFIXO_CMD   = "=listarPrefixo"    ;
+static const char *LISTAR_INTERVALO_CMD = "=listarIntervalo"  ;
+static const char *PARA_CADA_VERT_CMD   = "=paraCadaVertice"  ;
+static const char *PARA_CADA_SUC_CMD    = "=paraCadaSucessor" ;
+static const char *PARA_CADA_ANT_CMD    = "=paraCadaAntecessor";
+static const char *PARA_CADA_PAR_CMD    = "=paraCadaParalelo" ;
+static const char *INICIAR_PERC_CMD     = "=iniciarPercurso"  ;
+static const char *AVANCAR_PERC_CMD     = "=avancarPercurso"  ;
+static const char *TERMINAR_PERC_CMD    = "=terminarPercurso" ;
+static const char *ASSINAR_CMD          = "=assinarMudancas"  ;
+static const char *ASSINAR_ANEL_CMD     = "=assinarMudancasAnel";
+static const char *ENTREGAR_CMD         = "=entregarMudancas" ;
+static const char *CONSUMIR_CMD         = "=consumirMudancas" ;
+static const char *CANCELAR_ASSIN_CMD   = "=cancelarAssinatura";
+static const char *MANTER_ORDEM_CMD     = "=manterOrdemTopologica";
+static const char *ORDEM_TOPOL_CMD      = "=ordemTopologica"  ;
+static const char *MESMO_COMP_CMD       = "=mesmoComponente"  ;
+static const char *NUM_COMP_CMD         = "=numComponentes"   ;
+static const char *PAGERANK_CMD         = "=pageRank"         ;
+static const char *TRIANGULOS_CMD       = "=contarTriangulos" ;
+static const char *KCORE_CMD            = "=kCore"            ;
+static const char *ALCANCAR_EXPR_CMD    = "=alcancarPorExpressao";
+static const char *CAMINHO_ENTRE_CMD    = "=caminhoEntre"     ;
+static const char *CAMINHO_MARCOS_CMD   = "=caminhoPorMarcos" ;
+static const char *PREPARAR_MARCOS_CMD  = "=prepararMarcos"   ;
+static const char *ESTIMAR_DIST_CMD     = "=estimarDistancia" ;
+static const char *AUTO_ORGANIZAR_CMD   = "=autoOrganizar"    ;
+static const char *ESTAT_BUSCA_CMD      = "=estatisticasBusca";
+static const char *ZERAR_ESTAT_CMD      = "=zerarEstatisticasBusca";
+static const char *ESPACO_SUC_CMD       = "=espacoSucessores" ;
 
 #ifdef _DEBUG
 static const char *DETURPAR_CMD         = "=deturpar"         ;
@@ -35,17 +106,45 @@ static const char *VERIFICAR_CMD        = "=verificar"        ;
 
 #endif
 
-#define MAX_CHARS_NOME 3
+#define MAX_CHARS_NOME 39
+#define MAX_CHARS_SEGMENTO 63
+#define MAX_CHARS_CAMINHO 63
+#define MAX_CHARS_LISTAGEM 63
 #define SIMBOLO_PARA_NULL "!N!"
 
 #define DIM_VT_GRAFO   10
 
 static GRA_tppGrafo pGrafo = NULL;
+static int valoresFixos = 0;
+static GRA_tppVisao pVisao = NULL;
+static GRA_tppMarcador pMarcador = NULL;
+static GRA_tppPublicacao pPublicacao = NULL;
+static GRA_tppGrafoCompartilhado pCompartilhado = NULL;
+static GRA_tppDestruicao pDestruicao = NULL;
+static GRA_tppPercurso pPercurso = NULL;
+static char percorridos[MAX_CHARS_LISTAGEM * 2 + 2];
+static GRA_tppAssinatura pAssinatura = NULL;
+static GRA_tppAssinatura pAssinaturaAnel = NULL;
+static char entregues[MAX_CHARS_LISTAGEM * 2 + 2];
 
 /*****Prottipos das funes encapuladas no mdulo *****/
 
    static void DestruirValor(void *pValor);
+   static void DestruirValores(void **vtValores, int numValores);
    static char* AlocarEspacoParaNome();
+   static int ContarVisitados(char *nomeVertice, void *pValor, void *pContexto);
+   static int PertencerSempre(char *nomeVertice, void *pValor, void *pContexto);
+   static size_t TamanhoValor(void *pValor);
+   static char * MontarCaminho(const char *caminhoBase, const char *sufixo);
+   static int AcrescentarNome(const char *nome, void *pValor, void *pContexto);
+   static int AcrescentarAresta(const char *nomeAresta, const char *nomeDestino,
+                                void *pValorDestino, void *pContexto);
+   static void ContarPorTarefa(const char *nome, void *pValor, int tarefa, void *pContexto);
+   static void AcrescentarMudanca(char *listados, const GRA_tpMudanca *pMudanca);
+   static void AcrescentarLote(const GRA_tpMudanca *vtMudancas, int numMudancas, void *pContexto);
+   static void AcrescentarRank(const char *nome, double rank, void *pContexto);
+   static void AcrescentarQuantidade(const char *nome, long quantidade, void *pContexto);
+   static void AcrescentarNucleo(const char *nome, int nucleo, void *pContexto);
 
 /***** Cdigo das funes exportadas pelo mdulo  *****/
 
@@ -57,7 +156,13 @@ static GRA_tppGrafo pGrafo = NULL;
 *    Comandos disponveis:
 *
 *    =criarGrafo                   CondRetEsp
+*    =criarGrafoChaves             largura CondRetEsp
+*    =criarGrafoValores            tamanho CondRetEsp
+*    =lerValor                     string CondRetEsp
+*    =gravarValor                  string CondRetEsp
 *    =destruirGrafo                CondRetEsp
+*    =destruirEmLote               EmSegundoPlano CondRetEsp
+*    =esperarDestruicao            CondRetEsp
 *    =insVertice                   nome valor   CondRetEsp
 *    =insAresta                    nome vertice CondRetEsp
 *    =obterValor                   string CondRetEsp
@@ -66,7 +171,48 @@ static GRA_tppGrafo pGrafo = NULL;
 *    =irOrigem                     nome CondRetEsp
 *    =irVertice                    nome CondRetEsp
 *    =irPelaAresta                 nome CondRetEsp
+*    =existeAresta                 origem destino CondRetEsp
+*    =recusarParalelas             recusar CondRetEsp
 *    =destruirCorr                 CondRetEsp
+*    =criarVisao                   CondRetEsp
+*    =criarVisaoPred               CondRetEsp
+*    =destruirVisao                CondRetEsp
+*    =incluirNaVisao               nome CondRetEsp
+*    =excluirDaVisao               nome CondRetEsp
+*    =visaoIrVertice               nome CondRetEsp
+*    =visaoIrAdjacente             nome CondRetEsp
+*    =visaoIrPelaAresta            nome CondRetEsp
+*    =visaoObterValor              string CondRetEsp
+*    =visaoPercorrer               nome QntVisitadosEsperada CondRetEsp
+*    =visaoPercMarcado             nome QntVisitadosEsperada CondRetEsp
+*    =criarMarcador                CondRetEsp
+*    =destruirMarcador             CondRetEsp
+*    =reiniciarMarcador            CondRetEsp
+*    =marcarVertice                nome CondRetEsp
+*    =vertEstaMarcado              nome RespostaEsperada CondRetEsp
+*    =marcarCorrente               CondRetEsp
+*    =corrEstaMarcado              RespostaEsperada CondRetEsp
+*    =reordenar                    IdOrdem CondRetEsp
+*    =publicar                     segmento CondRetEsp
+*    =retirarPublicacao            CondRetEsp
+*    =anexar                       segmento CondRetEsp
+*    =desanexar                    CondRetEsp
+*    =compIrVertice                nome CondRetEsp
+*    =compIrPelaAresta             nome CondRetEsp
+*    =compObterValor               string CondRetEsp
+*    =compPercorrer                nome QntVisitadosEsperada CondRetEsp
+*    =abrirPersistente             caminho CondRetEsp
+*    =pontoDeControle              CondRetEsp
+*    =sincronizar                  CondRetEsp
+*    =confirmacaoEmGrupo           QntRegistros QntBytes CondRetEsp
+*    =truncarLog                   caminho QntBytes
+*    =removerPersistente           caminho
+*    =listarPrefixo                prefixo NomesEsperados CondRetEsp
+*    =listarIntervalo              inicio fim NomesEsperados CondRetEsp
+*    =paraCadaVertice              NomesEsperados CondRetEsp
+*    =paraCadaSucessor             nome ArestasEsperadas CondRetEsp
+*    =paraCadaAntecessor           nome NomesEsperados CondRetEsp
+*    =paraCadaParalelo             QntTarefas QntVerticesEsperada CondRetEsp
 *    =deturpar                     IdModoDeturpacao
 *    =verificar                    QntFalhasEsperadas
 *
@@ -97,6 +243,7 @@ static GRA_tppGrafo pGrafo = NULL;
             }
 
             CondRet = GRA_CriarGrafo(&pGrafo, DestruirValor);
+            valoresFixos = 0;
 
             if(CondRet ==  GRA_CondRetOK)
             {
@@ -108,6 +255,80 @@ static GRA_tppGrafo pGrafo = NULL;
 
          }
 
+     /* Testar Criar grafo com chaves fixas */
+
+         else if (strcmp(ComandoTeste, CRIAR_GRAFO_CHV_CMD) == 0)
+         {
+            int largura = 0;
+
+            numLidos = LER_LerParametros("ii", &largura, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_CriarGrafoComChavesFixas(&pGrafo, DestruirValor, largura);
+            valoresFixos = 0;
+
+            return TST_CompararInt(CondRetEsp, CondRet,
+                                   "Condio de retorno errada ao criar grafo com chaves fixas.");
+
+         }
+
+     /* Testar Criar grafo com valores fixos */
+
+         else if (strcmp(ComandoTeste, CRIAR_GRAFO_VAL_CMD) == 0)
+         {
+            int tamValor = 0;
+
+            numLidos = LER_LerParametros("ii", &tamValor, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_CriarGrafoComValoresFixos(&pGrafo, tamValor);
+            valoresFixos = 1;
+
+            return TST_CompararInt(CondRetEsp, CondRet,
+                                   "Condio de retorno errada ao criar grafo com valores fixos.");
+
+         }
+
+     /* Testar Ler e Gravar valor fixo do vrtice corrente */
+
+         else if (strcmp(ComandoTeste, LER_VALOR_CMD) == 0 ||
+                  strcmp(ComandoTeste, GRAVAR_VALOR_CMD) == 0)
+         {
+            char valor[MAX_CHARS_NOME + 1];
+            char valorObtido[MAX_CHARS_NOME + 1];
+
+            memset(valor, 0, sizeof(valor));
+            numLidos = LER_LerParametros("si", valor, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, GRAVAR_VALOR_CMD) == 0)
+            {
+               CondRet = GRA_GravarValorCorrente(pGrafo, valor);
+               return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao gravar o valor.");
+            }
+
+            valorObtido[0] = 0;
+            CondRet = GRA_LerValorCorrente(pGrafo, valorObtido);
+            if (CondRet != TST_CondRetOK || CondRetEsp != TST_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao ler o valor.");
+            }
+
+            return TST_CompararString(valor, valorObtido, "Valor lido errado.");
+         }
+
      /*Testar Destruir grafo */
 
          else if (strcmp(ComandoTeste, DESTRUIR_GRAFO_CMD) == 0)
@@ -125,6 +346,49 @@ static GRA_tppGrafo pGrafo = NULL;
             return TST_CompararInt(CondRetEsp, CondRet, "Erro ao destruir grafo");
 
          }
+
+     /* Testar Destruir grafo em lote */
+
+         else if (strcmp(ComandoTeste, DESTRUIR_LOTE_CMD) == 0)
+         {
+            int emSegundoPlano = 0;
+
+            numLidos = LER_LerParametros("ii", &emSegundoPlano, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_DestruirGrafoEmLote(&pGrafo, DestruirValores,
+                                              emSegundoPlano ? &pDestruicao : NULL);
+
+            if (CondRet == TST_CondRetOK && pGrafo != NULL)
+            {
+               return TST_NotificarFalha("O grafo no foi anulado na destruio em lote.");
+            }
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Erro ao destruir grafo em lote");
+
+         }
+
+     /* Testar Esperar destruio */
+
+         else if (strcmp(ComandoTeste, ESPERAR_DESTR_CMD) == 0)
+         {
+
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_EsperarDestruicao(&pDestruicao);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Erro ao esperar a destruio");
+
+         }
      
       /*Testar inserir vertice */
 
@@ -147,6 +411,11 @@ static GRA_tppGrafo pGrafo = NULL;
                free(pDado);
                free(nome);
             }
+            else if (valoresFixos)
+            {
+               // O grafo copiou o valor para dentro do vrtice
+               free(pDado);
+            }
 
             return TST_CompararInt(CondRetEsp, CondRet, "Condicao de retorno errada ao inserir vrtice.");
          }
@@ -251,123 +520,221 @@ static GRA_tppGrafo pGrafo = NULL;
          }
 
 
-       /*Testar tornar corrente uma origem */
+       /* Testar existe aresta entre */
 
-         else if (strcmp(ComandoTeste, TORNAR_ORIGEM_CMD) == 0)
+         else if (strcmp(ComandoTeste, EXISTE_ARESTA_CMD) == 0)
          {
-            numLidos = LER_LerParametros("i", &CondRetEsp);
+            char nomeOrigem[MAX_CHARS_NOME + 1], nomeDestino[MAX_CHARS_NOME + 1];
 
-            if (numLidos != 1)
+            numLidos = LER_LerParametros("ssi", nomeOrigem, nomeDestino, &CondRetEsp);
+
+            if (numLidos != 3)
             {
                return TST_CondRetParm;
             }
 
-            CondRet = GRA_TornarCorrenteUmaOrigem(pGrafo);
+            CondRet = GRA_ExisteArestaEntre(pGrafo, nomeOrigem, nomeDestino);
 
-            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao tornar o corrente uma origem.");
+            return TST_CompararInt(CondRetEsp, CondRet, "Resposta errada sobre a existncia da aresta.");
          }
 
+       /* Testar recusar arestas paralelas */
 
-       /*Testar tornar corrente uma origem */
-
-         else if (strcmp(ComandoTeste, DEIXAR_ORIGEM_CMD) == 0)
+         else if (strcmp(ComandoTeste, RECUSAR_PARAL_CMD) == 0)
          {
-            numLidos = LER_LerParametros("i", &CondRetEsp);
+            int recusar = 0;
 
-            if (numLidos != 1)
+            numLidos = LER_LerParametros("ii", &recusar, &CondRetEsp);
+
+            if (numLidos != 2)
             {
                return TST_CondRetParm;
             }
 
-            CondRet = GRA_DeixarDeSerOrigem(pGrafo);
+            CondRet = GRA_RecusarArestasParalelas(pGrafo, recusar);
 
-            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro remover uma origem.");
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao recusar arestas paralelas.");
          }
 
+       /* Testar manter ordem topolgica */
 
-        /*Testar seguir pela aresta */
-
-       else if (strcmp(ComandoTeste, IR_ARESTA_CMD) == 0)
+         else if (strcmp(ComandoTeste, MANTER_ORDEM_CMD) == 0)
          {
-            char *nomeDaAresta = AlocarEspacoParaNome();
+            int manter = 0;
 
-            numLidos = LER_LerParametros("si", nomeDaAresta, &CondRetEsp);
+            numLidos = LER_LerParametros("ii", &manter, &CondRetEsp);
 
             if (numLidos != 2)
             {
                return TST_CondRetParm;
             }
 
-            CondRet = GRA_SeguirPelaAresta(pGrafo, nomeDaAresta);
+            CondRet = GRA_ManterOrdemTopologica(pGrafo, manter);
 
-            free(nomeDaAresta);
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao manter a ordem topolgica.");
+         }
 
-            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao ir para vrtice adjacente.");
+       /* Testar mesmo componente */
+
+         else if (strcmp(ComandoTeste, MESMO_COMP_CMD) == 0)
+         {
+            char nome1[MAX_CHARS_NOME + 1], nome2[MAX_CHARS_NOME + 1];
+            int mesmoEsperado = 0, mesmo = -1;
+            GRA_tpCondRet graCondRet;
+
+            numLidos = LER_LerParametros("ssii", nome1, nome2, &mesmoEsperado, &CondRetEsp);
+
+            if (numLidos != 4)
+            {
+               return TST_CondRetParm;
+            }
+
+            graCondRet = GRA_MesmoComponente(pGrafo, nome1, nome2, &mesmo);
+
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao comparar os componentes.");
+            }
+
+            return TST_CompararInt(mesmoEsperado, mesmo, "Componentes diferentes do esperado.");
          }
 
-       /*Testar ir vertice adjacente */
+       /* Testar nmero de componentes */
 
-       else if (strcmp(ComandoTeste, IR_VERTICE_CMD) == 0)
+         else if (strcmp(ComandoTeste, NUM_COMP_CMD) == 0)
          {
-            char *nomeVertice = AlocarEspacoParaNome();
+            int numEsperado = 0, numComponentes = -1;
+            GRA_tpCondRet graCondRet;
 
-            numLidos = LER_LerParametros("si", nomeVertice, &CondRetEsp);
+            numLidos = LER_LerParametros("ii", &numEsperado, &CondRetEsp);
 
             if (numLidos != 2)
             {
                return TST_CondRetParm;
             }
 
-            CondRet = GRA_IrParaVerticeAdjacente(pGrafo, nomeVertice);
+            graCondRet = GRA_NumeroComponentes(pGrafo, &numComponentes);
 
-            free(nomeVertice);
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao contar os componentes.");
+            }
 
-            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao ir para vrtice adjacente.");
+            return TST_CompararInt(numEsperado, numComponentes, "Quantidade de componentes errada.");
          }
 
-        /*Testar ir para origem */
+       /* Testar preparar marcos */
 
-       else if (strcmp(ComandoTeste, IR_ORIGEM_CMD) == 0)
+         else if (strcmp(ComandoTeste, PREPARAR_MARCOS_CMD) == 0)
          {
-            char *nomeVertice = AlocarEspacoParaNome();
+            int numMarcos = 0;
 
-            numLidos = LER_LerParametros("si", nomeVertice, &CondRetEsp);
+            numLidos = LER_LerParametros("ii", &numMarcos, &CondRetEsp);
 
             if (numLidos != 2)
             {
                return TST_CondRetParm;
             }
 
-            CondRet = GRA_IrParaAOrigem(pGrafo, nomeVertice);
+            CondRet = GRA_PrepararMarcos(pGrafo, numMarcos);
 
-            free(nomeVertice);
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao preparar os marcos.");
+         }
 
-            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao ir para origem.");
+       /* Testar estimar distncia */
+
+         else if (strcmp(ComandoTeste, ESTIMAR_DIST_CMD) == 0)
+         {
+            char nome1[MAX_CHARS_NOME + 1], nome2[MAX_CHARS_NOME + 1];
+            int inferiorEsperado = 0, superiorEsperado = 0, inferior = -2, superior = -2;
+            GRA_tpCondRet graCondRet;
+
+            numLidos = LER_LerParametros("ssiii", nome1, nome2, &inferiorEsperado,
+                                         &superiorEsperado, &CondRetEsp);
+
+            if (numLidos != 5)
+            {
+               return TST_CondRetParm;
+            }
+
+            graCondRet = GRA_EstimarDistancia(pGrafo, nome1, nome2, &inferior, &superior);
+
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao estimar a distncia.");
+            }
+
+            CondRet = TST_CompararInt(inferiorEsperado, inferior, "Limite inferior diferente do esperado.");
+            if (CondRet != TST_CondRetOK)
+            {
+               return CondRet;
+            }
+
+            return TST_CompararInt(superiorEsperado, superior, "Limite superior diferente do esperado.");
          }
 
-         /*Testar ir destruir aresta adjacente */
+       /* Testar definir auto-organizao */
 
-       else if (strcmp(ComandoTeste, DESTRUIR_ARESTA_CMD) == 0)
+         else if (strcmp(ComandoTeste, AUTO_ORGANIZAR_CMD) == 0)
          {
-            char *nomeAresta = AlocarEspacoParaNome();
+            int politica = -1;
 
-            numLidos = LER_LerParametros("si", nomeAresta, &CondRetEsp);
+            numLidos = LER_LerParametros("ii", &politica, &CondRetEsp);
 
             if (numLidos != 2)
             {
                return TST_CondRetParm;
             }
 
-            CondRet = GRA_DestruirArestaAdjacente(pGrafo, nomeAresta);
+            CondRet = GRA_DefinirAutoOrganizacao(pGrafo, (GRA_tpAutoOrganizacao) politica);
 
-            free(nomeAresta);
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao definir a auto-organizao.");
+         }
 
-            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao destruir aresta adjacente.");
+       /* Testar obter estatsticas de busca */
+
+         else if (strcmp(ComandoTeste, ESTAT_BUSCA_CMD) == 0)
+         {
+            GRA_tpEstatisticasBusca arestas, origens;
+            int vtEsperados[6], i;
+            long vtObtidos[6];
+
+            numLidos = LER_LerParametros("iiiiii", &vtEsperados[0], &vtEsperados[1], &vtEsperados[2],
+                                         &vtEsperados[3], &vtEsperados[4], &vtEsperados[5]);
+
+            if (numLidos != 6)
+            {
+               return TST_CondRetParm;
+            }
+
+            if (GRA_ObterEstatisticasDeBusca(pGrafo, &arestas, &origens) != GRA_CondRetOK)
+            {
+               return TST_NotificarFalha("Ocorreu um erro ao obter as estatsticas de busca.");
+            }
+
+            vtObtidos[0] = arestas.numBuscas;
+            vtObtidos[1] = arestas.numAchadas;
+            vtObtidos[2] = arestas.somaPosicoes;
+            vtObtidos[3] = origens.numBuscas;
+            vtObtidos[4] = origens.numAchadas;
+            vtObtidos[5] = origens.somaPosicoes;
+
+            for (i = 0; i < 6; i++)
+            {
+               CondRet = TST_CompararInt(vtEsperados[i], (int) vtObtidos[i],
+                                         "Estatstica de busca diferente da esperada.");
+               if (CondRet != TST_CondRetOK)
+               {
+                  return CondRet;
+               }
+            }
+
+            return TST_CondRetOK;
          }
 
-          /*Testar ir destruir aresta adjacente */
+       /* Testar zerar estatsticas de busca */
 
-       else if (strcmp(ComandoTeste, DESTRUIR_VERT_CMD) == 0)
+         else if (strcmp(ComandoTeste, ZERAR_ESTAT_CMD) == 0)
          {
             numLidos = LER_LerParametros("i", &CondRetEsp);
 
@@ -376,69 +743,1524 @@ static GRA_tppGrafo pGrafo = NULL;
                return TST_CondRetParm;
             }
 
-            CondRet = GRA_DestruirVerticeCorrente(pGrafo);
+            CondRet = GRA_ZerarEstatisticasDeBusca(pGrafo);
 
-            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao destruir vertice corrente.");
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao zerar as estatsticas de busca.");
          }
 
-       /* Deturpar o grafo */
-      #ifdef _DEBUG
+       /* Testar obter espao dos sucessores */
 
-         else if ( strcmp( ComandoTeste , DETURPAR_CMD ) == 0 )
+         else if (strcmp(ComandoTeste, ESPACO_SUC_CMD) == 0)
          {
-            GRA_tpModosDeturpacao modoDeturpacao;
-            numLidos = LER_LerParametros("i", &modoDeturpacao) ;
+            size_t espaco = 0, espacoEmListas = 0;
+            GRA_tpCondRet graCondRet;
 
-            if ( numLidos != 1 )
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
             {
-               return TST_CondRetParm ;
+               return TST_CondRetParm;
             }
 
-            GRA_Deturpar(pGrafo, modoDeturpacao);
+            graCondRet = GRA_ObterEspacoDosSucessores(pGrafo, &espaco, &espacoEmListas);
 
-            return TST_CondRetOK ;
+            if (graCondRet == GRA_CondRetOK && (espaco == 0 || espacoEmListas == 0))
+            {
+               return TST_NotificarFalha("Espao dos sucessores no foi contado.");
+            }
 
-         } /* fim ativa: Deturpar o grafo */
+            return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao obter o espao dos sucessores.");
+         }
 
-       /* Verifica o grafo */
+       /* Testar PageRank */
 
-         else if ( strcmp( ComandoTeste , VERIFICAR_CMD ) == 0 )
+         else if (strcmp(ComandoTeste, PAGERANK_CMD) == 0)
          {
-            GRA_tpCondRet condRetEsperado;
-            int numFalhasEsperadas = 0, numFalhasObtidas = 0;
-            numLidos = LER_LerParametros("i", &numFalhasEsperadas) ;
+            char esperados[MAX_CHARS_LISTAGEM + 1];
+            char listados[MAX_CHARS_LISTAGEM * 2 + 2] = "";
+            int personalizado = 0, numTarefas = 0;
+            GRA_tpCondRet graCondRet;
 
-            if( numLidos != 1 )
+            numLidos = LER_LerParametros("iisi", &personalizado, &numTarefas, esperados, &CondRetEsp);
+
+            if (numLidos != 4)
             {
-               return TST_CondRetParm ;
+               return TST_CondRetParm;
             }
-            
-            GRA_Verificar(pGrafo,&numFalhasObtidas);
 
-            return TST_CompararInt(numFalhasEsperadas, numFalhasObtidas, "Encontrado um erro na verificacao");
+            if (personalizado)
+            {
+               graCondRet = GRA_PageRankPersonalizado(pGrafo, 0.85, 1e-9, 200, numTarefas,
+                                                      AcrescentarRank, listados, NULL);
+            }
+            else
+            {
+               graCondRet = GRA_PageRank(pGrafo, 0.85, 1e-9, 200, numTarefas,
+                                         AcrescentarRank, listados, NULL);
+            }
 
-         } /* fim ativa: Verifica o grafo */
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao calcular o PageRank.");
+            }
 
-       
-      #endif
+            return TST_CompararString(esperados, listados, "Ranks diferentes do esperado.");
+         }
 
-      return TST_CondRetNaoConhec;
+       /* Testar contagem de tringulos e decomposio em k-ncleos */
 
-   }
+         else if (strcmp(ComandoTeste, TRIANGULOS_CMD) == 0 ||
+                  strcmp(ComandoTeste, KCORE_CMD) == 0)
+         {
+            char esperados[MAX_CHARS_LISTAGEM + 1];
+            char listados[MAX_CHARS_LISTAGEM * 2 + 2] = "";
+            int numTarefas = 0, totalEsperado = 0, maiorNucleo = -1;
+            long total = -1;
+            GRA_tpCondRet graCondRet;
 
+            if (strcmp(ComandoTeste, TRIANGULOS_CMD) == 0)
+            {
+               numLidos = LER_LerParametros("isii", &numTarefas, esperados, &totalEsperado, &CondRetEsp);
 
-/***** Cdigo das funes encapsuladas no mdulo  *****/
+               if (numLidos != 4)
+               {
+                  return TST_CondRetParm;
+               }
 
+               graCondRet = GRA_ContarTriangulos(pGrafo, numTarefas, AcrescentarQuantidade,
+                                                 listados, &total);
+            }
+            else
+            {
+               numLidos = LER_LerParametros("sii", esperados, &totalEsperado, &CondRetEsp);
 
-/***********************************************************************
-*
-* Funo: TGRA -Destruir valor
-*
-***********************************************************************/
+               if (numLidos != 3)
+               {
+                  return TST_CondRetParm;
+               }
 
-   void DestruirValor(void *pValor)
-   {
-      free(pValor);
+               graCondRet = GRA_DecomposicaoKCore(pGrafo, AcrescentarNucleo, listados, &maiorNucleo);
+               total = maiorNucleo;
+            }
+
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao analisar os vizinhos.");
+            }
+
+            if (TST_CompararString(esperados, listados, "Quantidades por vrtice diferentes do esperado.") != TST_CondRetOK)
+            {
+               return TST_CondRetErro;
+            }
+
+            return TST_CompararInt(totalEsperado, (int) total, "Total diferente do esperado.");
+         }
+
+
+       /*Testar tornar corrente uma origem */
+
+         else if (strcmp(ComandoTeste, TORNAR_ORIGEM_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_TornarCorrenteUmaOrigem(pGrafo);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao tornar o corrente uma origem.");
+         }
+
+
+       /*Testar tornar corrente uma origem */
+
+         else if (strcmp(ComandoTeste, DEIXAR_ORIGEM_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_DeixarDeSerOrigem(pGrafo);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro remover uma origem.");
+         }
+
+
+        /*Testar seguir pela aresta */
+
+       else if (strcmp(ComandoTeste, IR_ARESTA_CMD) == 0)
+         {
+            char *nomeDaAresta = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nomeDaAresta, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_SeguirPelaAresta(pGrafo, nomeDaAresta);
+
+            free(nomeDaAresta);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao ir para vrtice adjacente.");
+         }
+
+       /*Testar ir vertice adjacente */
+
+       else if (strcmp(ComandoTeste, IR_VERTICE_CMD) == 0)
+         {
+            char *nomeVertice = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nomeVertice, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_IrParaVerticeAdjacente(pGrafo, nomeVertice);
+
+            free(nomeVertice);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao ir para vrtice adjacente.");
+         }
+
+        /*Testar ir para origem */
+
+       else if (strcmp(ComandoTeste, IR_ORIGEM_CMD) == 0)
+         {
+            char *nomeVertice = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nomeVertice, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_IrParaAOrigem(pGrafo, nomeVertice);
+
+            free(nomeVertice);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao ir para origem.");
+         }
+
+         /*Testar ir destruir aresta adjacente */
+
+       else if (strcmp(ComandoTeste, DESTRUIR_ARESTA_CMD) == 0)
+         {
+            char *nomeAresta = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nomeAresta, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_DestruirArestaAdjacente(pGrafo, nomeAresta);
+
+            free(nomeAresta);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao destruir aresta adjacente.");
+         }
+
+          /*Testar ir destruir aresta adjacente */
+
+       else if (strcmp(ComandoTeste, DESTRUIR_VERT_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_DestruirVerticeCorrente(pGrafo);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao destruir vertice corrente.");
+         }
+
+       /*Testar criar viso */
+
+       else if (strcmp(ComandoTeste, CRIAR_VISAO_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_CriarVisao(pGrafo, &pVisao, NULL, NULL);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao criar viso.");
+         }
+
+       /*Testar criar viso com predicado */
+
+       else if (strcmp(ComandoTeste, CRIAR_VISAO_PRED_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_CriarVisao(pGrafo, &pVisao, PertencerSempre, NULL);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao criar viso com predicado.");
+         }
+
+       /*Testar destruir viso */
+
+       else if (strcmp(ComandoTeste, DESTRUIR_VISAO_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_DestruirVisao(&pVisao);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao destruir viso.");
+         }
+
+       /*Testar incluir e excluir vrtice da viso */
+
+       else if (strcmp(ComandoTeste, INCLUIR_VISAO_CMD) == 0 ||
+                strcmp(ComandoTeste, EXCLUIR_VISAO_CMD) == 0)
+         {
+            char *nomeVertice = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nomeVertice, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               free(nomeVertice);
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, INCLUIR_VISAO_CMD) == 0)
+            {
+               CondRet = GRA_IncluirVerticeNaVisao(pVisao, nomeVertice);
+            }
+            else
+            {
+               CondRet = GRA_ExcluirVerticeDaVisao(pVisao, nomeVertice);
+            }
+
+            free(nomeVertice);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao alterar os vrtices da viso.");
+         }
+
+       /*Testar navegao na viso */
+
+       else if (strcmp(ComandoTeste, VISAO_IR_VERT_CMD) == 0 ||
+                strcmp(ComandoTeste, VISAO_IR_ADJ_CMD) == 0 ||
+                strcmp(ComandoTeste, VISAO_IR_ARESTA_CMD) == 0)
+         {
+            char *nome = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nome, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               free(nome);
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, VISAO_IR_VERT_CMD) == 0)
+            {
+               CondRet = GRA_VisaoIrParaVertice(pVisao, nome);
+            }
+            else if (strcmp(ComandoTeste, VISAO_IR_ADJ_CMD) == 0)
+            {
+               CondRet = GRA_VisaoIrParaVerticeAdjacente(pVisao, nome);
+            }
+            else
+            {
+               CondRet = GRA_VisaoSeguirPelaAresta(pVisao, nome);
+            }
+
+            free(nome);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao navegar na viso.");
+         }
+
+       /*Testar obter valor do corrente da viso */
+
+       else if (strcmp(ComandoTeste, VISAO_OBTER_CMD) == 0)
+         {
+            char *pDadoEsperado = AlocarEspacoParaNome();
+            char *pDadoObtido;
+
+            numLidos = LER_LerParametros("si", pDadoEsperado, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               free(pDadoEsperado);
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_VisaoObterValorCorrente(pVisao, (void**) &pDadoObtido);
+
+            if (CondRetEsp == TST_CondRetOK && CondRet == TST_CondRetOK)
+            {
+               CondRet = TST_CompararString(pDadoEsperado, pDadoObtido, "Valor do corrente da viso errado.");
+               free(pDadoEsperado);
+               return CondRet;
+            }
+
+            free(pDadoEsperado);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao obter valor da viso.");
+         }
+
+       /*Testar percorrer a viso em largura */
+
+       else if (strcmp(ComandoTeste, VISAO_PERCORRER_CMD) == 0 ||
+                strcmp(ComandoTeste, VISAO_PERC_MARC_CMD) == 0)
+         {
+            char *nomeVertice = AlocarEspacoParaNome();
+            int numEsperado = -1, numVisitados = 0;
+
+            numLidos = LER_LerParametros("sii", nomeVertice, &numEsperado, &CondRetEsp);
+
+            if (numLidos != 3)
+            {
+               free(nomeVertice);
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, VISAO_PERCORRER_CMD) == 0)
+            {
+               CondRet = GRA_VisaoPercorrerEmLargura(pVisao, nomeVertice, NULL,
+                            ContarVisitados, &numVisitados);
+            }
+            else
+            {
+               CondRet = GRA_VisaoPercorrerEmLargura(pVisao, nomeVertice, pMarcador,
+                            ContarVisitados, &numVisitados);
+            }
+
+            free(nomeVertice);
+
+            if (CondRet != CondRetEsp)
+            {
+               return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao percorrer a viso.");
+            }
+
+            return TST_CompararInt(numEsperado, numVisitados, "Quantidade de vrtices visitados na viso errada.");
+         }
+
+       /*Testar criar, destruir e reiniciar marcador */
+
+       else if (strcmp(ComandoTeste, CRIAR_MARCADOR_CMD) == 0 ||
+                strcmp(ComandoTeste, DESTRUIR_MARC_CMD) == 0 ||
+                strcmp(ComandoTeste, REINICIAR_MARC_CMD) == 0 ||
+                strcmp(ComandoTeste, MARCAR_CORR_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, CRIAR_MARCADOR_CMD) == 0)
+            {
+               CondRet = GRA_CriarMarcador(pGrafo, &pMarcador);
+            }
+            else if (strcmp(ComandoTeste, DESTRUIR_MARC_CMD) == 0)
+            {
+               CondRet = GRA_DestruirMarcador(&pMarcador);
+            }
+            else if (strcmp(ComandoTeste, REINICIAR_MARC_CMD) == 0)
+            {
+               CondRet = GRA_ReiniciarMarcador(pMarcador);
+            }
+            else
+            {
+               CondRet = GRA_MarcarCorrente(pGrafo, pMarcador);
+            }
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao operar o marcador.");
+         }
+
+       /*Testar marcar vrtice */
+
+       else if (strcmp(ComandoTeste, MARCAR_VERT_CMD) == 0)
+         {
+            char *nomeVertice = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nomeVertice, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               free(nomeVertice);
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_MarcarVertice(pMarcador, nomeVertice);
+
+            free(nomeVertice);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao marcar vrtice.");
+         }
+
+       /*Testar consulta de marca */
+
+       else if (strcmp(ComandoTeste, VERT_MARCADO_CMD) == 0 ||
+                strcmp(ComandoTeste, CORR_MARCADO_CMD) == 0)
+         {
+            char *nomeVertice = AlocarEspacoParaNome();
+            int respostaEsperada = -1, resposta = -1;
+
+            if (strcmp(ComandoTeste, VERT_MARCADO_CMD) == 0)
+            {
+               numLidos = LER_LerParametros("sii", nomeVertice, &respostaEsperada, &CondRetEsp) - 1;
+            }
+            else
+            {
+               numLidos = LER_LerParametros("ii", &respostaEsperada, &CondRetEsp);
+            }
+
+            if (numLidos != 2)
+            {
+               free(nomeVertice);
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, VERT_MARCADO_CMD) == 0)
+            {
+               CondRet = GRA_VerticeEstaMarcado(pMarcador, nomeVertice, &resposta);
+            }
+            else
+            {
+               CondRet = GRA_CorrenteEstaMarcado(pGrafo, pMarcador, &resposta);
+            }
+
+            free(nomeVertice);
+
+            if (CondRet != CondRetEsp || CondRet != TST_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao consultar a marca.");
+            }
+
+            return TST_CompararInt(respostaEsperada, resposta, "Marca do vrtice errada.");
+         }
+
+       /*Testar reordenar */
+
+       else if (strcmp(ComandoTeste, REORDENAR_CMD) == 0)
+         {
+            int ordem = -1;
+
+            numLidos = LER_LerParametros("ii", &ordem, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_Reordenar(pGrafo, (GRA_tpOrdem) ordem);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao reordenar o grafo.");
+         }
+
+       /*Testar publicar e anexar memria compartilhada */
+
+       else if (strcmp(ComandoTeste, PUBLICAR_CMD) == 0 ||
+                strcmp(ComandoTeste, ANEXAR_CMD) == 0)
+         {
+            char nomeSegmento[MAX_CHARS_SEGMENTO + 1];
+
+            numLidos = LER_LerParametros("si", nomeSegmento, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, PUBLICAR_CMD) == 0)
+            {
+               CondRet = GRA_PublicarMemoriaCompartilhada(pGrafo, nomeSegmento, TamanhoValor, &pPublicacao);
+            }
+            else
+            {
+               CondRet = GRA_AnexarMemoriaCompartilhada(nomeSegmento, &pCompartilhado);
+            }
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro na memria compartilhada.");
+         }
+
+       /*Testar retirar publicao e desanexar */
+
+       else if (strcmp(ComandoTeste, RETIRAR_PUBL_CMD) == 0 ||
+                strcmp(ComandoTeste, DESANEXAR_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, RETIRAR_PUBL_CMD) == 0)
+            {
+               CondRet = GRA_RetirarPublicacao(&pPublicacao);
+            }
+            else
+            {
+               CondRet = GRA_DesanexarMemoriaCompartilhada(&pCompartilhado);
+            }
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao liberar a memria compartilhada.");
+         }
+
+       /*Testar navegao no grafo compartilhado */
+
+       else if (strcmp(ComandoTeste, COMP_IR_VERT_CMD) == 0 ||
+                strcmp(ComandoTeste, COMP_IR_ARESTA_CMD) == 0)
+         {
+            char *nome = AlocarEspacoParaNome();
+
+            numLidos = LER_LerParametros("si", nome, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               free(nome);
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, COMP_IR_VERT_CMD) == 0)
+            {
+               CondRet = GRA_CompartilhadoIrParaVertice(pCompartilhado, nome);
+            }
+            else
+            {
+               CondRet = GRA_CompartilhadoSeguirPelaAresta(pCompartilhado, nome);
+            }
+
+            free(nome);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao navegar no grafo compartilhado.");
+         }
+
+       /*Testar obter valor do grafo compartilhado */
+
+       else if (strcmp(ComandoTeste, COMP_OBTER_CMD) == 0)
+         {
+            char *pDadoEsperado = AlocarEspacoParaNome();
+            const void *pDadoObtido = NULL;
+
+            numLidos = LER_LerParametros("si", pDadoEsperado, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               free(pDadoEsperado);
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_CompartilhadoObterValorCorrente(pCompartilhado, &pDadoObtido);
+
+            if (CondRetEsp == TST_CondRetOK && CondRet == TST_CondRetOK)
+            {
+               CondRet = TST_CompararString(pDadoEsperado, (char*) pDadoObtido, "Valor do grafo compartilhado errado.");
+               free(pDadoEsperado);
+               return CondRet;
+            }
+
+            free(pDadoEsperado);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao obter valor compartilhado.");
+         }
+
+       /*Testar percorrer o grafo compartilhado */
+
+       else if (strcmp(ComandoTeste, COMP_PERCORRER_CMD) == 0)
+         {
+            char *nomeVertice = AlocarEspacoParaNome();
+            int numEsperado = -1, numVisitados = 0;
+
+            numLidos = LER_LerParametros("sii", nomeVertice, &numEsperado, &CondRetEsp);
+
+            if (numLidos != 3)
+            {
+               free(nomeVertice);
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_CompartilhadoPercorrerEmLargura(pCompartilhado, nomeVertice,
+                         ContarVisitados, &numVisitados);
+
+            free(nomeVertice);
+
+            if (CondRet != CondRetEsp)
+            {
+               return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao percorrer o grafo compartilhado.");
+            }
+
+            return TST_CompararInt(numEsperado, numVisitados, "Quantidade de vrtices compartilhados visitados errada.");
+         }
+
+       /*Testar abrir grafo persistente */
+
+       else if (strcmp(ComandoTeste, ABRIR_PERSIST_CMD) == 0)
+         {
+            char caminho[MAX_CHARS_CAMINHO + 1];
+
+            numLidos = LER_LerParametros("si", caminho, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_AbrirGrafoPersistente(&pGrafo, caminho, DestruirValor, TamanhoValor);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao abrir o grafo persistente.");
+         }
+
+       /*Testar ponto de controle e sincronizao */
+
+       else if (strcmp(ComandoTeste, PONTO_CONTROLE_CMD) == 0 ||
+                strcmp(ComandoTeste, SINCRONIZAR_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            if (strcmp(ComandoTeste, PONTO_CONTROLE_CMD) == 0)
+            {
+               CondRet = GRA_GravarPontoDeControle(pGrafo);
+            }
+            else
+            {
+               CondRet = GRA_SincronizarPersistencia(pGrafo);
+            }
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao gravar a persistncia.");
+         }
+
+       /*Testar definir confirmao em grupo */
+
+       else if (strcmp(ComandoTeste, CONFIRMACAO_CMD) == 0)
+         {
+            int registrosPorGrupo = -1, bytesParaPonto = -1;
+
+            numLidos = LER_LerParametros("iii", &registrosPorGrupo, &bytesParaPonto, &CondRetEsp);
+
+            if (numLidos != 3)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_DefinirConfirmacaoEmGrupo(pGrafo, registrosPorGrupo, bytesParaPonto);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao definir a confirmao em grupo.");
+         }
+
+       /*Simular uma queda no meio da gravao do log */
+
+       else if (strcmp(ComandoTeste, TRUNCAR_LOG_CMD) == 0)
+         {
+            char caminhoBase[MAX_CHARS_CAMINHO + 1];
+            char *caminho, *pConteudo;
+            int numBytes = -1;
+            long tamanho;
+            FILE *pArquivo;
+
+            numLidos = LER_LerParametros("si", caminhoBase, &numBytes);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            caminho = MontarCaminho(caminhoBase, ".wal");
+            pArquivo = fopen(caminho, "rb");
+            if (pArquivo == NULL)
+            {
+               free(caminho);
+               return TST_NotificarFalha("Log no encontrado.");
+            }
+            fseek(pArquivo, 0, SEEK_END);
+            tamanho = ftell(pArquivo);
+            fseek(pArquivo, 0, SEEK_SET);
+            pConteudo = (char*) malloc(tamanho + 1);
+            tamanho = (long) fread(pConteudo, 1, tamanho, pArquivo);
+            fclose(pArquivo);
+
+            if (numBytes > tamanho)
+            {
+               numBytes = (int) tamanho;
+            }
+            pArquivo = fopen(caminho, "wb");
+            fwrite(pConteudo, 1, tamanho - numBytes, pArquivo);
+            fclose(pArquivo);
+
+            free(pConteudo);
+            free(caminho);
+
+            return TST_CondRetOK;
+         }
+
+       /*Remover os arquivos de um grafo persistente */
+
+       else if (strcmp(ComandoTeste, REMOVER_PERSIST_CMD) == 0)
+         {
+            char caminhoBase[MAX_CHARS_CAMINHO + 1];
+            static const char *vtSufixos[] = { ".wal", ".chk", ".chk.tmp" };
+            int i;
+
+            numLidos = LER_LerParametros("s", caminhoBase);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            for (i = 0; i < 3; i++)
+            {
+               char *caminho = MontarCaminho(caminhoBase, vtSufixos[i]);
+               remove(caminho);
+               free(caminho);
+            }
+
+            return TST_CondRetOK;
+         }
+
+       /*Testar listar vrtices por prefixo, no intervalo e em ordem topolgica */
+
+       else if (strcmp(ComandoTeste, LISTAR_PREFIXO_CMD) == 0 ||
+                strcmp(ComandoTeste, LISTAR_INTERVALO_CMD) == 0 ||
+                strcmp(ComandoTeste, PARA_CADA_VERT_CMD) == 0 ||
+                strcmp(ComandoTeste, PARA_CADA_SUC_CMD) == 0 ||
+                strcmp(ComandoTeste, PARA_CADA_ANT_CMD) == 0 ||
+                strcmp(ComandoTeste, ORDEM_TOPOL_CMD) == 0 ||
+                strcmp(ComandoTeste, ALCANCAR_EXPR_CMD) == 0 ||
+                strcmp(ComandoTeste, CAMINHO_ENTRE_CMD) == 0 ||
+                strcmp(ComandoTeste, CAMINHO_MARCOS_CMD) == 0)
+         {
+            char inicio[MAX_CHARS_NOME + 1], fim[MAX_CHARS_NOME + 1];
+            char expressao[MAX_CHARS_SEGMENTO + 1];
+            char esperados[MAX_CHARS_LISTAGEM + 1];
+            char listados[MAX_CHARS_LISTAGEM * 2 + 2] = "";
+            GRA_tpCondRet graCondRet;
+
+            if (strcmp(ComandoTeste, LISTAR_PREFIXO_CMD) == 0)
+            {
+               numLidos = LER_LerParametros("ssi", inicio, esperados, &CondRetEsp);
+
+               if (numLidos != 3)
+               {
+                  return TST_CondRetParm;
+               }
+
+               graCondRet = GRA_ListarVerticesPorPrefixo(pGrafo, inicio, AcrescentarNome, listados);
+            }
+            else if (strcmp(ComandoTeste, PARA_CADA_VERT_CMD) == 0)
+            {
+               numLidos = LER_LerParametros("si", esperados, &CondRetEsp);
+
+               if (numLidos != 2)
+               {
+                  return TST_CondRetParm;
+               }
+
+               graCondRet = GRA_ParaCadaVertice(pGrafo, AcrescentarNome, listados);
+            }
+            else if (strcmp(ComandoTeste, ORDEM_TOPOL_CMD) == 0)
+            {
+               numLidos = LER_LerParametros("si", esperados, &CondRetEsp);
+
+               if (numLidos != 2)
+               {
+                  return TST_CondRetParm;
+               }
+
+               graCondRet = GRA_ParaCadaVerticeEmOrdemTopologica(pGrafo, AcrescentarNome, listados);
+            }
+            else if (strcmp(ComandoTeste, PARA_CADA_SUC_CMD) == 0 ||
+                     strcmp(ComandoTeste, PARA_CADA_ANT_CMD) == 0)
+            {
+               numLidos = LER_LerParametros("ssi", inicio, esperados, &CondRetEsp);
+
+               if (numLidos != 3)
+               {
+                  return TST_CondRetParm;
+               }
+
+               if (strcmp(ComandoTeste, PARA_CADA_SUC_CMD) == 0)
+               {
+                  graCondRet = GRA_ParaCadaSucessor(pGrafo, inicio, AcrescentarAresta, listados);
+               }
+               else
+               {
+                  graCondRet = GRA_ParaCadaAntecessor(pGrafo, inicio, AcrescentarNome, listados);
+               }
+            }
+            else if (strcmp(ComandoTeste, ALCANCAR_EXPR_CMD) == 0)
+            {
+               numLidos = LER_LerParametros("sssi", inicio, expressao, esperados, &CondRetEsp);
+
+               if (numLidos != 4)
+               {
+                  return TST_CondRetParm;
+               }
+
+               graCondRet = GRA_AlcancarPorExpressao(pGrafo, inicio, expressao, AcrescentarNome, listados);
+            }
+            else if (strcmp(ComandoTeste, CAMINHO_ENTRE_CMD) == 0 ||
+                     strcmp(ComandoTeste, CAMINHO_MARCOS_CMD) == 0)
+            {
+               int comprimento = -2, comprimentoEsp = -1;
+
+               numLidos = LER_LerParametros("sssii", inicio, fim, esperados, &comprimentoEsp, &CondRetEsp);
+
+               if (numLidos != 5)
+               {
+                  return TST_CondRetParm;
+               }
+
+               if (strcmp(ComandoTeste, CAMINHO_ENTRE_CMD) == 0)
+               {
+                  graCondRet = GRA_CaminhoEntre(pGrafo, inicio, fim, AcrescentarNome, listados, &comprimento);
+               }
+               else
+               {
+                  graCondRet = GRA_CaminhoPorMarcos(pGrafo, inicio, fim, AcrescentarNome, listados, &comprimento);
+               }
+
+               if (graCondRet == GRA_CondRetOK && CondRetEsp == GRA_CondRetOK)
+               {
+                  CondRet = TST_CompararInt(comprimentoEsp, comprimento, "Comprimento do caminho diferente do esperado.");
+                  if (CondRet != TST_CondRetOK)
+                  {
+                     return CondRet;
+                  }
+               }
+            }
+            else
+            {
+               numLidos = LER_LerParametros("sssi", inicio, fim, esperados, &CondRetEsp);
+
+               if (numLidos != 4)
+               {
+                  return TST_CondRetParm;
+               }
+
+               graCondRet = GRA_ListarVerticesNoIntervalo(pGrafo,
+                  strcmp(inicio, SIMBOLO_PARA_NULL) == 0 ? NULL : inicio,
+                  strcmp(fim, SIMBOLO_PARA_NULL) == 0 ? NULL : fim,
+                  AcrescentarNome, listados);
+            }
+
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao listar os vrtices.");
+            }
+
+            // Nenhum vrtice listado  representado pelo smbolo de NULL
+            if (strcmp(esperados, SIMBOLO_PARA_NULL) == 0)
+            {
+               esperados[0] = '\0';
+            }
+
+            return TST_CompararString(esperados, listados, "Vrtices listados diferentes do esperado.");
+         }
+
+       /* Testar percorrer os vrtices em paralelo */
+
+         else if (strcmp(ComandoTeste, PARA_CADA_PAR_CMD) == 0)
+         {
+            int vtContagem[GRA_MAX_TAREFAS] = { 0 };
+            int numTarefas = 0, numEsperado = 0, numVisitados = 0, i;
+            GRA_tpCondRet graCondRet;
+
+            numLidos = LER_LerParametros("iii", &numTarefas, &numEsperado, &CondRetEsp);
+
+            if (numLidos != 3)
+            {
+               return TST_CondRetParm;
+            }
+
+            graCondRet = GRA_ParaCadaVerticeParalelo(pGrafo, numTarefas, ContarPorTarefa, vtContagem);
+
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao percorrer em paralelo.");
+            }
+
+            for (i = 0; i < numTarefas; i++)
+            {
+               numVisitados += vtContagem[i];
+            }
+
+            return TST_CompararInt(numEsperado, numVisitados, "Quantidade de vrtices visitados errada.");
+         }
+
+       /* Testar iniciar e terminar percurso retomvel */
+
+         else if (strcmp(ComandoTeste, INICIAR_PERC_CMD) == 0)
+         {
+            char nomeOrigem[MAX_CHARS_NOME + 1];
+            int modo = -1;
+
+            numLidos = LER_LerParametros("sii", nomeOrigem, &modo, &CondRetEsp);
+
+            if (numLidos != 3)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_IniciarPercurso(pGrafo, nomeOrigem, (GRA_tpModoPercurso) modo,
+                         AcrescentarNome, percorridos, &pPercurso);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao iniciar o percurso.");
+         }
+
+         else if (strcmp(ComandoTeste, TERMINAR_PERC_CMD) == 0)
+         {
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_TerminarPercurso(&pPercurso);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao terminar o percurso.");
+         }
+
+       /* Testar avanar percurso retomvel */
+
+         else if (strcmp(ComandoTeste, AVANCAR_PERC_CMD) == 0)
+         {
+            char esperados[MAX_CHARS_LISTAGEM + 1];
+            int numPassos = 0, terminouEsperado = 0, terminou = -1;
+            GRA_tpCondRet graCondRet;
+
+            numLidos = LER_LerParametros("isii", &numPassos, esperados, &terminouEsperado, &CondRetEsp);
+
+            if (numLidos != 4)
+            {
+               return TST_CondRetParm;
+            }
+
+            // Cada fatia lista s os vrtices que ela visitou
+            percorridos[0] = '\0';
+            graCondRet = GRA_AvancarPercurso(pPercurso, numPassos, &terminou);
+
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao avanar o percurso.");
+            }
+
+            if (strcmp(esperados, SIMBOLO_PARA_NULL) == 0)
+            {
+               esperados[0] = '\0';
+            }
+
+            if (TST_CompararString(esperados, percorridos, "Vrtices percorridos diferentes do esperado.") != TST_CondRetOK)
+            {
+               return TST_CondRetErro;
+            }
+
+            return TST_CompararInt(terminouEsperado, terminou, "Fim do percurso errado.");
+         }
+
+       /* Testar assinar mudanas entregues em lotes */
+
+         else if (strcmp(ComandoTeste, ASSINAR_CMD) == 0)
+         {
+            int tamLote = 0;
+
+            numLidos = LER_LerParametros("ii", &tamLote, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            entregues[0] = '\0';
+            CondRet = GRA_AssinarMudancas(pGrafo, tamLote, AcrescentarLote, entregues, &pAssinatura);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao assinar as mudanas.");
+         }
+
+       /* Testar assinar mudanas em anel */
+
+         else if (strcmp(ComandoTeste, ASSINAR_ANEL_CMD) == 0)
+         {
+            int capacidade = 0;
+
+            numLidos = LER_LerParametros("ii", &capacidade, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            CondRet = GRA_AssinarMudancasEmAnel(pGrafo, capacidade, &pAssinaturaAnel);
+
+            return TST_CompararInt(CondRetEsp, CondRet, "Ocorreu um erro ao assinar as mudanas em anel.");
+         }
+
+       /* Testar entregar mudanas. Confere os lotes entregues at agora,
+          separados por ";", e os esquece */
+
+         else if (strcmp(ComandoTeste, ENTREGAR_CMD) == 0)
+         {
+            char esperados[MAX_CHARS_LISTAGEM + 1];
+            GRA_tpCondRet graCondRet;
+
+            numLidos = LER_LerParametros("si", esperados, &CondRetEsp);
+
+            if (numLidos != 2)
+            {
+               return TST_CondRetParm;
+            }
+
+            graCondRet = GRA_EntregarMudancas(pAssinatura);
+
+            if (strcmp(esperados, SIMBOLO_PARA_NULL) == 0)
+            {
+               esperados[0] = '\0';
+            }
+
+            if (TST_CompararString(esperados, entregues, "Mudanas entregues diferentes do esperado.") != TST_CondRetOK)
+            {
+               return TST_CondRetErro;
+            }
+            entregues[0] = '\0';
+
+            return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao entregar as mudanas.");
+         }
+
+       /* Testar consumir mudanas do anel */
+
+         else if (strcmp(ComandoTeste, CONSUMIR_CMD) == 0)
+         {
+            char esperados[MAX_CHARS_LISTAGEM + 1];
+            char consumidas[MAX_CHARS_LISTAGEM * 2 + 2];
+            GRA_tpMudanca vtMudancas[DIM_VT_GRAFO];
+            int maxMudancas = 0, numMudancas = 0, i;
+            GRA_tpCondRet graCondRet;
+
+            numLidos = LER_LerParametros("isi", &maxMudancas, esperados, &CondRetEsp);
+
+            if (numLidos != 3 || maxMudancas > DIM_VT_GRAFO)
+            {
+               return TST_CondRetParm;
+            }
+
+            graCondRet = GRA_ConsumirMudancas(pAssinaturaAnel, vtMudancas, maxMudancas, &numMudancas);
+
+            if (graCondRet != GRA_CondRetOK || CondRetEsp != GRA_CondRetOK)
+            {
+               return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao consumir as mudanas.");
+            }
+
+            if (strcmp(esperados, SIMBOLO_PARA_NULL) == 0)
+            {
+               esperados[0] = '\0';
+            }
+
+            consumidas[0] = '\0';
+            for (i = 0; i < numMudancas; i++)
+            {
+               AcrescentarMudanca(consumidas, &vtMudancas[i]);
+            }
+
+            return TST_CompararString(esperados, consumidas, "Mudanas consumidas diferentes do esperado.");
+         }
+
+       /* Testar cancelar as duas assinaturas */
+
+         else if (strcmp(ComandoTeste, CANCELAR_ASSIN_CMD) == 0)
+         {
+            GRA_tpCondRet graCondRet;
+
+            numLidos = LER_LerParametros("i", &CondRetEsp);
+
+            if (numLidos != 1)
+            {
+               return TST_CondRetParm;
+            }
+
+            graCondRet = GRA_CancelarAssinatura(&pAssinatura);
+            if (graCondRet == GRA_CondRetOK)
+            {
+               graCondRet = GRA_CancelarAssinatura(&pAssinaturaAnel);
+            }
+
+            return TST_CompararInt(CondRetEsp, graCondRet, "Ocorreu um erro ao cancelar as assinaturas.");
+         }
+
+       /* Deturpar o grafo */
+      #ifdef _DEBUG
+
+         else if ( strcmp( ComandoTeste , DETURPAR_CMD ) == 0 )
+         {
+            GRA_tpModosDeturpacao modoDeturpacao;
+            numLidos = LER_LerParametros("i", &modoDeturpacao) ;
+
+            if ( numLidos != 1 )
+            {
+               return TST_CondRetParm ;
+            }
+
+            GRA_Deturpar(pGrafo, modoDeturpacao);
+
+            return TST_CondRetOK ;
+
+         } /* fim ativa: Deturpar o grafo */
+
+       /* Verifica o grafo */
+
+         else if ( strcmp( ComandoTeste , VERIFICAR_CMD ) == 0 )
+         {
+            GRA_tpCondRet condRetEsperado;
+            int numFalhasEsperadas = 0, numFalhasObtidas = 0;
+            numLidos = LER_LerParametros("i", &numFalhasEsperadas) ;
+
+            if( numLidos != 1 )
+            {
+               return TST_CondRetParm ;
+            }
+            
+            GRA_Verificar(pGrafo,&numFalhasObtidas);
+
+            return TST_CompararInt(numFalhasEsperadas, numFalhasObtidas, "Encontrado um erro na verificacao");
+
+         } /* fim ativa: Verifica o grafo */
+
+       
+      #endif
+
+      return TST_CondRetNaoConhec;
+
+   }
+
+
+/***** Cdigo das funes encapsuladas no mdulo  *****/
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Destruir valor
+*
+***********************************************************************/
+
+   void DestruirValor(void *pValor)
+   {
+      free(pValor);
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Destruir valores
+*
+***********************************************************************/
+
+   void DestruirValores(void **vtValores, int numValores)
+   {
+      int i;
+
+      for (i = 0; i < numValores; i++)
+      {
+         free(vtValores[i]);
+      }
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Contar visitados
+*
+***********************************************************************/
+
+   int ContarVisitados(char *nomeVertice, void *pValor, void *pContexto)
+   {
+      (*(int*) pContexto)++;
+      return 0;
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Pertencer sempre
+*
+***********************************************************************/
+
+   int PertencerSempre(char *nomeVertice, void *pValor, void *pContexto)
+   {
+      return 1;
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Tamanho do valor
+*
+*  Os valores usados nos testes so strings.
+*
+***********************************************************************/
+
+   size_t TamanhoValor(void *pValor)
+   {
+      return strlen((char*) pValor) + 1;
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Montar caminho
+*
+***********************************************************************/
+
+   char * MontarCaminho(const char *caminhoBase, const char *sufixo)
+   {
+      char *caminho = (char*) malloc(strlen(caminhoBase) + strlen(sufixo) + 1);
+      strcpy(caminho, caminhoBase);
+      strcat(caminho, sufixo);
+      return caminho;
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Acrescentar nome
+*
+*  Acrescenta o nome  lista separada por vrgulas dada como contexto.
+*
+***********************************************************************/
+
+   int AcrescentarNome(const char *nome, void *pValor, void *pContexto)
+   {
+      char *listados = (char*) pContexto;
+
+      if (strlen(listados) + strlen(nome) + 1 > MAX_CHARS_LISTAGEM * 2)
+      {
+         return 1;
+      }
+
+      if (listados[0] != '\0')
+      {
+         strcat(listados, ",");
+      }
+      strcat(listados, nome);
+
+      return 0;
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Acrescentar aresta
+*
+*  Como AcrescentarNome, acrescenta "aresta>destino"  listagem.
+*
+***********************************************************************/
+
+   int AcrescentarAresta(const char *nomeAresta, const char *nomeDestino,
+                         void *pValorDestino, void *pContexto)
+   {
+      char *listados = (char*) pContexto;
+
+      if (strlen(listados) + strlen(nomeAresta) + strlen(nomeDestino) + 2 > MAX_CHARS_LISTAGEM * 2)
+      {
+         return 1;
+      }
+
+      if (listados[0] != '\0')
+      {
+         strcat(listados, ",");
+      }
+      strcat(listados, nomeAresta);
+      strcat(listados, ">");
+      strcat(listados, nomeDestino);
+
+      return 0;
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Contar por tarefa
+*
+*  Conta os vrtices visitados num vetor com um contador por tarefa, de
+*  forma que tarefas simultneas no escrevem na mesma posio.
+*
+***********************************************************************/
+
+   void ContarPorTarefa(const char *nome, void *pValor, int tarefa, void *pContexto)
+   {
+      ((int*) pContexto)[tarefa]++;
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Acrescentar mudana
+*
+*  Acrescenta  listagem a mudana no formato <sequncia><+|-|~><V|A>:
+*  seguido do vrtice, ou da aresta e da origem, mais ">destino" quando
+*  a aresta  inserida. Por exemplo 3+A:ab:A>B.
+*
+***********************************************************************/
+
+   void AcrescentarMudanca(char *listados, const GRA_tpMudanca *pMudanca)
+   {
+      char mudanca[3 * (MAX_CHARS_NOME + 1) + 16];
+      const char *operacao = "+V";
+
+      switch (pMudanca->tipo)
+      {
+         case GRA_MudancaDestruirVertice: operacao = "-V"; break;
+         case GRA_MudancaAlterarValor:    operacao = "~V"; break;
+         case GRA_MudancaInserirAresta:   operacao = "+A"; break;
+         case GRA_MudancaDestruirAresta:  operacao = "-A"; break;
+         default: break;
+      }
+
+      if (pMudanca->nomeAresta == NULL)
+      {
+         sprintf(mudanca, "%lu%s:%s", pMudanca->numSequencia, operacao, pMudanca->nomeVertice);
+      }
+      else if (pMudanca->nomeDestino == NULL)
+      {
+         sprintf(mudanca, "%lu%s:%s:%s", pMudanca->numSequencia, operacao,
+                 pMudanca->nomeAresta, pMudanca->nomeVertice);
+      }
+      else
+      {
+         sprintf(mudanca, "%lu%s:%s:%s>%s", pMudanca->numSequencia, operacao,
+                 pMudanca->nomeAresta, pMudanca->nomeVertice, pMudanca->nomeDestino);
+      }
+
+      if (strlen(listados) + strlen(mudanca) + 1 > MAX_CHARS_LISTAGEM * 2)
+      {
+         return;
+      }
+
+      if (listados[0] != '\0' && listados[strlen(listados) - 1] != ';')
+      {
+         strcat(listados, ",");
+      }
+      strcat(listados, mudanca);
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Acrescentar lote
+*
+*  Recebe um lote de uma assinatura sncrona e o acrescenta  listagem,
+*  separado do lote anterior por ";".
+*
+***********************************************************************/
+
+   void AcrescentarLote(const GRA_tpMudanca *vtMudancas, int numMudancas, void *pContexto)
+   {
+      char *listados = (char*) pContexto;
+      int i;
+
+      if (listados[0] != '\0' && strlen(listados) < MAX_CHARS_LISTAGEM * 2)
+      {
+         strcat(listados, ";");
+      }
+
+      for (i = 0; i < numMudancas; i++)
+      {
+         AcrescentarMudanca(listados, &vtMudancas[i]);
+      }
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Acrescentar rank
+*
+*  Acrescenta "nome=rank"  listagem, com o rank em milsimos.
+*
+***********************************************************************/
+
+   void AcrescentarRank(const char *nome, double rank, void *pContexto)
+   {
+      char *listados = (char*) pContexto;
+      char item[MAX_CHARS_NOME + 16];
+
+      sprintf(item, "%s=%d", nome, (int) (rank * 1000 + 0.5));
+
+      if (strlen(listados) + strlen(item) + 1 > MAX_CHARS_LISTAGEM * 2)
+      {
+         return;
+      }
+
+      if (listados[0] != '\0')
+      {
+         strcat(listados, ",");
+      }
+      strcat(listados, item);
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Acrescentar quantidade
+*
+*  Acrescenta "nome=quantidade"  listagem.
+*
+***********************************************************************/
+
+   void AcrescentarQuantidade(const char *nome, long quantidade, void *pContexto)
+   {
+      char *listados = (char*) pContexto;
+      char item[MAX_CHARS_NOME + 24];
+
+      sprintf(item, "%s=%ld", nome, quantidade);
+
+      if (strlen(listados) + strlen(item) + 1 > MAX_CHARS_LISTAGEM * 2)
+      {
+         return;
+      }
+
+      if (listados[0] != '\0')
+      {
+         strcat(listados, ",");
+      }
+      strcat(listados, item);
+   }
+
+
+/***********************************************************************
+*
+* Funo: TGRA -Acrescentar ncleo
+*
+***********************************************************************/
+
+   void AcrescentarNucleo(const char *nome, int nucleo, void *pContexto)
+   {
+      AcrescentarQuantidade(nome, nucleo, pContexto);
    }
 
 
@@ -0,0 +1,757 @@
+/***************************************************************************
+*  Mdulo de implementao: WAL  Registro de escrita antecipada
+*
+*  Arquivo gerado:              wal.c
+*  Letras identificadoras:      WAL
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+*  Formato de um registro no arquivo, com inteiros em little-endian:
+*
+*     u32 tamanho dos dados
+*     u8  tipo
+*     u64 LSN
+*     u32 CRC-32 do tipo, do LSN e dos dados
+*     dados: para cada campo, u32 tamanho seguido dos bytes do campo
+*
+***************************************************************************/
+
+#include   <stdio.h>
+#include   <stdlib.h>
+#include   <string.h>
+#include   <errno.h>
+#include   <fcntl.h>
+#include   <sys/stat.h>
+
+#ifdef _WIN32
+   #include   <io.h>
+   #include   <windows.h>
+#else
+   #include   <unistd.h>
+#endif
+
+#define WAL_OWN
+#include "wal.h"
+#undef WAL_OWN
+
+#define TAM_CABECALHO               17
+#define REGISTROS_POR_GRUPO_PADRAO  64
+#define TAM_MAXIMO_BUFFER           ( 64 * 1024 )
+
+/***********************************************************************
+*  Tipo de dados: WAL Descritor do registro
+***********************************************************************/
+
+typedef struct WAL_stLog {
+
+   int descritor;
+   /* Arquivo aberto para acrscimo */
+
+   unsigned char *pGrupo;
+   /* Registros acrescentados e ainda no gravados no arquivo */
+
+   size_t tamGrupo;
+   /* Bytes ocupados em pGrupo */
+
+   size_t capGrupo;
+   /* Capacidade de pGrupo */
+
+   int numPendentes;
+   /* Quantidade de registros ainda no sincronizados com o disco */
+
+   int registrosPorGrupo;
+   /* Quantidade de registros que dispara a confirmao do grupo */
+
+   long tamGravado;
+   /* Bytes j gravados no arquivo */
+
+   WAL_tpLsn proximoLsn;
+   /* LSN do prximo registro acrescentado */
+
+} tpLog;
+
+/***** Prottipos das funes encapuladas no mdulo *****/
+
+   static WAL_tpCondRet CriarDescritor(int descritor, WAL_tpLsn proximoLsn, long tamGravado,
+                                       WAL_tppLog *ppLog);
+   static int Descarregar(WAL_tppLog pLog);
+   static WAL_tpCondRet LerConteudo(int descritor, unsigned char **ppConteudo, size_t *pTamanho);
+   static WAL_tpCondRet PercorrerRegistros(const unsigned char *pConteudo, size_t tamanho,
+      WAL_tpLsn lsnMinimo, WAL_tpAplicar aplicar, void *pContexto,
+      size_t *pTamValido, WAL_tpLsn *pUltimoLsn);
+   static unsigned long CalcularCrc(unsigned long crc, const unsigned char *pDados, size_t tamanho);
+   static void EscreverInteiro(unsigned char *pDestino, WAL_tpLsn valor, int numBytes);
+   static WAL_tpLsn LerInteiro(const unsigned char *pOrigem, int numBytes);
+   static int AbrirArquivo(const char *caminho, int modo);
+   static int GravarTudo(int descritor, const unsigned char *pDados, size_t tamanho);
+   static int Sincronizar(int descritor);
+   static int Truncar(int descritor, long tamanho);
+   static void FecharArquivo(int descritor);
+
+/*****  Cdigo das funes exportadas pelo mdulo  *****/
+
+/***************************************************************************
+*  Funo: WAL Abrir
+******/
+WAL_tpCondRet WAL_Abrir(const char *caminho, WAL_tpLsn lsnMinimo,
+                        WAL_tpAplicar aplicar, void *pContexto, WAL_tppLog *ppLog)
+{
+   unsigned char *pConteudo = NULL;
+   size_t tamanho = 0, tamValido = 0;
+   WAL_tpLsn ultimoLsn = 0;
+   WAL_tpCondRet condRet;
+   int descritor;
+
+   descritor = AbrirArquivo(caminho, O_RDWR | O_CREAT | O_APPEND);
+   if (descritor < 0)
+   {
+      return WAL_CondRetErroSistema;
+   }
+
+   condRet = LerConteudo(descritor, &pConteudo, &tamanho);
+   if (condRet == WAL_CondRetOK)
+   {
+      condRet = PercorrerRegistros(pConteudo, tamanho, lsnMinimo, aplicar, pContexto,
+                                   &tamValido, &ultimoLsn);
+   }
+   free(pConteudo);
+
+   // Descarta a cauda de um grupo gravado pela metade
+   if (condRet == WAL_CondRetOK && tamValido < tamanho)
+   {
+      if (!Truncar(descritor, (long) tamValido) || !Sincronizar(descritor))
+      {
+         condRet = WAL_CondRetErroSistema;
+      }
+   }
+
+   if (condRet != WAL_CondRetOK)
+   {
+      FecharArquivo(descritor);
+      return condRet;
+   }
+
+   if (ultimoLsn < lsnMinimo)
+   {
+      ultimoLsn = lsnMinimo;
+   }
+
+   return CriarDescritor(descritor, ultimoLsn + 1, (long) tamValido, ppLog);
+}
+
+/***************************************************************************
+*  Funo: WAL Criar
+******/
+WAL_tpCondRet WAL_Criar(const char *caminho, WAL_tppLog *ppLog)
+{
+   int descritor = AbrirArquivo(caminho, O_RDWR | O_CREAT | O_TRUNC | O_APPEND);
+
+   if (descritor < 0)
+   {
+      return WAL_CondRetErroSistema;
+   }
+
+   return CriarDescritor(descritor, 1, 0, ppLog);
+}
+
+/***************************************************************************
+*  Funo: WAL Ler
+******/
+WAL_tpCondRet WAL_Ler(const char *caminho, WAL_tpAplicar aplicar, void *pContexto)
+{
+   unsigned char *pConteudo = NULL;
+   size_t tamanho = 0, tamValido = 0;
+   WAL_tpLsn ultimoLsn = 0;
+   WAL_tpCondRet condRet;
+   int descritor;
+
+   descritor = AbrirArquivo(caminho, O_RDONLY);
+   if (descritor < 0)
+   {
+      return errno == ENOENT ? WAL_CondRetNaoAchou : WAL_CondRetErroSistema;
+   }
+
+   condRet = LerConteudo(descritor, &pConteudo, &tamanho);
+   FecharArquivo(descritor);
+
+   if (condRet == WAL_CondRetOK)
+   {
+      condRet = PercorrerRegistros(pConteudo, tamanho, 0, aplicar, pContexto,
+                                   &tamValido, &ultimoLsn);
+   }
+   free(pConteudo);
+
+   return condRet;
+}
+
+/***************************************************************************
+*  Funo: WAL Acrescentar
+******/
+WAL_tpCondRet WAL_Acrescentar(WAL_tppLog pLog, unsigned char tipo, int numCampos,
+                              const void **vtCampos, const size_t *vtTamanhos)
+{
+   unsigned char *pRegistro;
+   size_t tamDados = 0, tamNecessario;
+   unsigned long crc;
+   int i;
+
+   for (i = 0; i < numCampos; i++)
+   {
+      tamDados += 4 + vtTamanhos[i];
+   }
+
+   tamNecessario = pLog->tamGrupo + TAM_CABECALHO + tamDados;
+   if (tamNecessario > pLog->capGrupo)
+   {
+      size_t capNova = pLog->capGrupo * 2;
+      unsigned char *pNovo;
+
+      while (capNova < tamNecessario)
+      {
+         capNova *= 2;
+      }
+
+      pNovo = (unsigned char*) realloc(pLog->pGrupo, capNova);
+      if (pNovo == NULL)
+      {
+         return WAL_CondRetFaltouMemoria;
+      }
+      pLog->pGrupo = pNovo;
+      pLog->capGrupo = capNova;
+   }
+
+   pRegistro = pLog->pGrupo + pLog->tamGrupo;
+   EscreverInteiro(pRegistro, tamDados, 4);
+   pRegistro[4] = tipo;
+   EscreverInteiro(pRegistro + 5, pLog->proximoLsn, 8);
+
+   pRegistro += TAM_CABECALHO;
+   for (i = 0; i < numCampos; i++)
+   {
+      EscreverInteiro(pRegistro, vtTamanhos[i], 4);
+      if (vtTamanhos[i] > 0)
+      {
+         memcpy(pRegistro + 4, vtCampos[i], vtTamanhos[i]);
+      }
+      pRegistro += 4 + vtTamanhos[i];
+   }
+
+   pRegistro = pLog->pGrupo + pLog->tamGrupo;
+   crc = CalcularCrc(0, pRegistro + 4, 9);
+   crc = CalcularCrc(crc, pRegistro + TAM_CABECALHO, tamDados);
+   EscreverInteiro(pRegistro + 13, crc, 4);
+
+   pLog->tamGrupo = tamNecessario;
+   pLog->numPendentes++;
+   pLog->proximoLsn++;
+
+   if (pLog->numPendentes >= pLog->registrosPorGrupo)
+   {
+      return WAL_Confirmar(pLog);
+   }
+
+   // Grupos grandes so gravados aos poucos, mas sincronizados s no fim
+   if (pLog->tamGrupo >= TAM_MAXIMO_BUFFER && !Descarregar(pLog))
+   {
+      return WAL_CondRetErroSistema;
+   }
+
+   return WAL_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: WAL Confirmar
+******/
+WAL_tpCondRet WAL_Confirmar(WAL_tppLog pLog)
+{
+   if (pLog->numPendentes == 0)
+   {
+      return WAL_CondRetOK;
+   }
+
+   if (!Descarregar(pLog) || !Sincronizar(pLog->descritor))
+   {
+      return WAL_CondRetErroSistema;
+   }
+
+   pLog->numPendentes = 0;
+
+   return WAL_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: WAL Esvaziar
+******/
+WAL_tpCondRet WAL_Esvaziar(WAL_tppLog pLog)
+{
+   pLog->tamGrupo = 0;
+   pLog->numPendentes = 0;
+
+   if (!Truncar(pLog->descritor, 0) || !Sincronizar(pLog->descritor))
+   {
+      return WAL_CondRetErroSistema;
+   }
+
+   pLog->tamGravado = 0;
+
+   return WAL_CondRetOK;
+}
+
+/***************************************************************************
+*  Funo: WAL Definir grupo
+******/
+void WAL_DefinirGrupo(WAL_tppLog pLog, int registrosPorGrupo)
+{
+   pLog->registrosPorGrupo = registrosPorGrupo < 1 ? 1 : registrosPorGrupo;
+}
+
+/***************************************************************************
+*  Funo: WAL Obter ltimo LSN
+******/
+WAL_tpLsn WAL_ObterUltimoLsn(WAL_tppLog pLog)
+{
+   return pLog->proximoLsn - 1;
+}
+
+/***************************************************************************
+*  Funo: WAL Obter tamanho
+******/
+long WAL_ObterTamanho(WAL_tppLog pLog)
+{
+   return pLog->tamGravado + (long) pLog->tamGrupo;
+}
+
+/***************************************************************************
+*  Funo: WAL Fechar
+******/
+WAL_tpCondRet WAL_Fechar(WAL_tppLog pLog)
+{
+   WAL_tpCondRet condRet;
+
+   if (pLog == NULL)
+   {
+      return WAL_CondRetOK;
+   }
+
+   condRet = WAL_Confirmar(pLog);
+
+   FecharArquivo(pLog->descritor);
+   free(pLog->pGrupo);
+   free(pLog);
+
+   return condRet;
+}
+
+/***************************************************************************
+*  Funo: WAL Substituir
+******/
+WAL_tpCondRet WAL_Substituir(const char *origem, const char *destino)
+{
+#ifdef _WIN32
+   if (!MoveFileExA(origem, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+   {
+      return WAL_CondRetErroSistema;
+   }
+#else
+   char *diretorio;
+   const char *pBarra;
+   int descritor = -1;
+
+   if (rename(origem, destino) != 0)
+   {
+      return WAL_CondRetErroSistema;
+   }
+
+   // A troca de nomes s  durvel depois que o diretrio for sincronizado
+   pBarra = strrchr(destino, '/');
+   if (pBarra == NULL)
+   {
+      descritor = open(".", O_RDONLY);
+   }
+   else
+   {
+      diretorio = (char*) malloc(pBarra - destino + 2);
+      if (diretorio != NULL)
+      {
+         memcpy(diretorio, destino, pBarra - destino + 1);
+         diretorio[pBarra - destino + 1] = '\0';
+         descritor = open(diretorio, O_RDONLY);
+         free(diretorio);
+      }
+   }
+
+   if (descritor >= 0)
+   {
+      fsync(descritor);
+      close(descritor);
+   }
+#endif
+
+   return WAL_CondRetOK;
+}
+
+/*****  Cdigo das funes encapsuladas no mdulo  *****/
+
+/***********************************************************************
+*
+*  Funo: WAL Criar descritor
+*
+*  Descrio:
+*    Monta o descritor de um arquivo j aberto. Fecha o arquivo se
+*    faltar memria.
+*
+***********************************************************************/
+WAL_tpCondRet CriarDescritor(int descritor, WAL_tpLsn proximoLsn, long tamGravado,
+                             WAL_tppLog *ppLog)
+{
+   tpLog *pLog = (tpLog*) malloc(sizeof(tpLog));
+
+   if (pLog != NULL)
+   {
+      pLog->capGrupo = 4096;
+      pLog->pGrupo = (unsigned char*) malloc(pLog->capGrupo);
+   }
+   if (pLog == NULL || pLog->pGrupo == NULL)
+   {
+      free(pLog);
+      FecharArquivo(descritor);
+      return WAL_CondRetFaltouMemoria;
+   }
+
+   pLog->descritor = descritor;
+   pLog->tamGrupo = 0;
+   pLog->numPendentes = 0;
+   pLog->registrosPorGrupo = REGISTROS_POR_GRUPO_PADRAO;
+   pLog->tamGravado = tamGravado;
+   pLog->proximoLsn = proximoLsn;
+
+   *ppLog = pLog;
+
+   return WAL_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Descarregar
+*
+*  Descrio:
+*    Grava no arquivo o contedo do buffer, sem sincronizar. Se a
+*    gravao falhar, desfaz a parte gravada para que o buffer possa ser
+*    gravado de novo, e retorna 0.
+*
+***********************************************************************/
+int Descarregar(WAL_tppLog pLog)
+{
+   if (pLog->tamGrupo == 0)
+   {
+      return 1;
+   }
+
+   if (!GravarTudo(pLog->descritor, pLog->pGrupo, pLog->tamGrupo))
+   {
+      Truncar(pLog->descritor, pLog->tamGravado);
+      return 0;
+   }
+
+   pLog->tamGravado += (long) pLog->tamGrupo;
+   pLog->tamGrupo = 0;
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Ler contedo
+*
+*  Descrio:
+*    L o arquivo inteiro para um bloco alocado, que deve ser liberado
+*    pelo chamador.
+*
+***********************************************************************/
+WAL_tpCondRet LerConteudo(int descritor, unsigned char **ppConteudo, size_t *pTamanho)
+{
+   struct stat estado;
+   size_t lidos = 0;
+
+   *ppConteudo = NULL;
+   *pTamanho = 0;
+
+   if (fstat(descritor, &estado) != 0)
+   {
+      return WAL_CondRetErroSistema;
+   }
+   if (estado.st_size == 0)
+   {
+      return WAL_CondRetOK;
+   }
+
+   *ppConteudo = (unsigned char*) malloc((size_t) estado.st_size);
+   if (*ppConteudo == NULL)
+   {
+      return WAL_CondRetFaltouMemoria;
+   }
+
+   while (lidos < (size_t) estado.st_size)
+   {
+#ifdef _WIN32
+      int numLidos = _read(descritor, *ppConteudo + lidos, (unsigned int) (estado.st_size - lidos));
+#else
+      ssize_t numLidos = read(descritor, *ppConteudo + lidos, (size_t) estado.st_size - lidos);
+#endif
+      if (numLidos <= 0)
+      {
+         break;
+      }
+      lidos += (size_t) numLidos;
+   }
+
+   *pTamanho = lidos;
+
+   return WAL_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Percorrer registros
+*
+*  Descrio:
+*    Entrega a aplicar os registros vlidos com LSN maior que lsnMinimo.
+*    Um registro  vlido se estiver completo, se o CRC conferir, se o
+*    LSN for maior que o do anterior e se os campos ocuparem exatamente
+*    os dados. Retorna em pTamValido o tamanho do trecho vlido inicial.
+*
+***********************************************************************/
+WAL_tpCondRet PercorrerRegistros(const unsigned char *pConteudo, size_t tamanho,
+   WAL_tpLsn lsnMinimo, WAL_tpAplicar aplicar, void *pContexto,
+   size_t *pTamValido, WAL_tpLsn *pUltimoLsn)
+{
+   const unsigned char *vtCampos[WAL_MAX_CAMPOS];
+   size_t vtTamanhos[WAL_MAX_CAMPOS];
+   size_t posicao = 0;
+
+   *pTamValido = 0;
+   *pUltimoLsn = 0;
+
+   while (tamanho - posicao >= TAM_CABECALHO)
+   {
+      const unsigned char *pRegistro = pConteudo + posicao;
+      size_t tamDados = (size_t) LerInteiro(pRegistro, 4);
+      WAL_tpLsn lsn = LerInteiro(pRegistro + 5, 8);
+      size_t usados = 0;
+      int numCampos = 0;
+
+      if (tamDados > tamanho - posicao - TAM_CABECALHO || lsn <= *pUltimoLsn)
+      {
+         break;
+      }
+      if (CalcularCrc(CalcularCrc(0, pRegistro + 4, 9), pRegistro + TAM_CABECALHO, tamDados)
+          != (unsigned long) LerInteiro(pRegistro + 13, 4))
+      {
+         break;
+      }
+
+      while (usados < tamDados && numCampos < WAL_MAX_CAMPOS && tamDados - usados >= 4)
+      {
+         size_t tamCampo = (size_t) LerInteiro(pRegistro + TAM_CABECALHO + usados, 4);
+
+         if (tamCampo > tamDados - usados - 4)
+         {
+            break;
+         }
+         vtCampos[numCampos] = pRegistro + TAM_CABECALHO + usados + 4;
+         vtTamanhos[numCampos] = tamCampo;
+         numCampos++;
+         usados += 4 + tamCampo;
+      }
+      if (usados != tamDados)
+      {
+         break;
+      }
+
+      if (lsn > lsnMinimo && aplicar != NULL &&
+          aplicar(pRegistro[4], numCampos, vtCampos, vtTamanhos, pContexto) != 0)
+      {
+         return WAL_CondRetInterrompido;
+      }
+
+      posicao += TAM_CABECALHO + tamDados;
+      *pTamValido = posicao;
+      *pUltimoLsn = lsn;
+   }
+
+   return WAL_CondRetOK;
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Calcular CRC
+*
+*  Descrio:
+*    CRC-32 (polinmio 0xEDB88320), continuando do valor crc dado.
+*    A tabela  montada no primeiro uso.
+*
+***********************************************************************/
+unsigned long CalcularCrc(unsigned long crc, const unsigned char *pDados, size_t tamanho)
+{
+   static unsigned long vtTabela[256];
+   static int tabelaMontada = 0;
+   size_t i;
+
+   if (!tabelaMontada)
+   {
+      unsigned long n;
+      int k;
+
+      for (n = 0; n < 256; n++)
+      {
+         unsigned long c = n;
+         for (k = 0; k < 8; k++)
+         {
+            c = (c & 1) ? 0xEDB88320UL ^ (c >> 1) : c >> 1;
+         }
+         vtTabela[n] = c;
+      }
+      tabelaMontada = 1;
+   }
+
+   crc = crc ^ 0xFFFFFFFFUL;
+   for (i = 0; i < tamanho; i++)
+   {
+      crc = vtTabela[(crc ^ pDados[i]) & 0xFF] ^ (crc >> 8);
+   }
+
+   return (crc ^ 0xFFFFFFFFUL) & 0xFFFFFFFFUL;
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Escrever inteiro
+*
+*  Descrio:
+*    Escreve os numBytes bytes menos significativos de valor em
+*    little-endian, independentemente da arquitetura.
+*
+***********************************************************************/
+void EscreverInteiro(unsigned char *pDestino, WAL_tpLsn valor, int numBytes)
+{
+   int i;
+
+   for (i = 0; i < numBytes; i++)
+   {
+      pDestino[i] = (unsigned char) (valor >> (8 * i));
+   }
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Ler inteiro
+*
+***********************************************************************/
+WAL_tpLsn LerInteiro(const unsigned char *pOrigem, int numBytes)
+{
+   WAL_tpLsn valor = 0;
+   int i;
+
+   for (i = numBytes - 1; i >= 0; i--)
+   {
+      valor = (valor << 8) | pOrigem[i];
+   }
+
+   return valor;
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Abrir arquivo
+*
+***********************************************************************/
+int AbrirArquivo(const char *caminho, int modo)
+{
+#ifdef _WIN32
+   return _open(caminho, modo | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+   return open(caminho, modo, 0644);
+#endif
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Gravar tudo
+*
+*  Descrio:
+*    Grava o bloco inteiro, repetindo as gravaes parciais.
+*    Retorna 0 em caso de erro.
+*
+***********************************************************************/
+int GravarTudo(int descritor, const unsigned char *pDados, size_t tamanho)
+{
+   while (tamanho > 0)
+   {
+#ifdef _WIN32
+      int gravados = _write(descritor, pDados, (unsigned int) tamanho);
+#else
+      ssize_t gravados = write(descritor, pDados, tamanho);
+      if (gravados < 0 && errno == EINTR)
+      {
+         continue;
+      }
+#endif
+      if (gravados <= 0)
+      {
+         return 0;
+      }
+      pDados += gravados;
+      tamanho -= (size_t) gravados;
+   }
+
+   return 1;
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Sincronizar
+*
+***********************************************************************/
+int Sincronizar(int descritor)
+{
+#ifdef _WIN32
+   return _commit(descritor) == 0;
+#else
+   return fsync(descritor) == 0;
+#endif
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Truncar
+*
+***********************************************************************/
+int Truncar(int descritor, long tamanho)
+{
+#ifdef _WIN32
+   return _chsize(descritor, tamanho) == 0;
+#else
+   return ftruncate(descritor, (off_t) tamanho) == 0;
+#endif
+}
+
+/***********************************************************************
+*
+*  Funo: WAL Fechar arquivo
+*
+***********************************************************************/
+void FecharArquivo(int descritor)
+{
+#ifdef _WIN32
+   _close(descritor);
+#else
+   close(descritor);
+#endif
+}
+
+/********** Fim do mdulo de implementao: WAL  Registro de escrita antecipada **********/
@@ -0,0 +1,282 @@
+#if ! defined( WAL_ )
+#define WAL_
+/***************************************************************************
+*
+*  Mdulo de definio: WAL  Registro de escrita antecipada
+*
+*  Arquivo gerado:              wal.h
+*  Letras identificadoras:      WAL
+*
+*	Autores:
+*     - rc: Robert Corra
+*
+*  Histrico de evoluo:
+*     Verso  Autor    Data        Observaes
+*     1.0     rc       19/out/26   Criao do mdulo.
+*
+*  Descrio do mdulo
+*     Mantm um arquivo de registros binrios acrescentados sempre ao
+*     final (write-ahead log). Cada registro tem um tipo, um nmero de
+*     sequncia (LSN) crescente e at WAL_MAX_CAMPOS campos de bytes, e 
+*     protegido por um CRC-32, de forma que um registro gravado pela
+*     metade numa queda  reconhecido e descartado na reabertura.
+*
+*     Os registros acrescentados ficam num buffer em memria e so
+*     gravados e sincronizados com o disco (fsync) em grupo, quando o
+*     grupo atinge a quantidade de registros definida ou quando
+*     WAL_Confirmar  chamada. Assim uma nica sincronizao, que  a
+*     operao cara, vale para o grupo inteiro. Uma queda pode perder os
+*     registros do grupo ainda no confirmado, mas nunca deixa o arquivo
+*     inconsistente.
+*
+*     O mdulo no interpreta o contedo dos registros.
+*
+***************************************************************************/
+
+#if defined( WAL_OWN )
+   #define WAL_EXT
+#else
+   #define WAL_EXT extern
+#endif
+
+#include <stddef.h>
+
+/***** Declaraes exportadas pelo mdulo *****/
+
+/* Quantidade mxima de campos de um registro */
+#define WAL_MAX_CAMPOS 4
+
+/* Tipo referncia para um registro aberto */
+typedef struct WAL_stLog * WAL_tppLog ;
+
+/* Tipo do nmero de sequncia dos registros */
+typedef unsigned long long WAL_tpLsn ;
+
+/* Funo chamada para cada registro lido na abertura */
+typedef int (*WAL_tpAplicar)(unsigned char tipo, int numCampos,
+   const unsigned char **vtCampos, const size_t *vtTamanhos, void *pContexto) ;
+
+
+/***********************************************************************
+*
+*  Tipo de dados: WAL Condies de retorno
+*
+***********************************************************************/
+
+   typedef enum {
+
+         WAL_CondRetOK ,
+               /* Concluiu corretamente */
+
+         WAL_CondRetNaoAchou ,
+               /* O arquivo no existe */
+
+         WAL_CondRetInterrompido ,
+               /* A funo de aplicao pediu a interrupo da leitura */
+
+         WAL_CondRetFaltouMemoria ,
+               /* Faltou memria */
+
+         WAL_CondRetErroSistema
+               /* O sistema operacional recusou a operao */
+
+   } WAL_tpCondRet ;
+
+
+/***********************************************************************
+*
+*  Funo: WAL Abrir
+*
+*  Descrio
+*     Abre para acrscimo o registro no caminho dado, criando-o se no
+*     existir. Os registros vlidos j gravados com LSN maior que
+*     lsnMinimo so entregues, em ordem,  funo aplicar. A leitura
+*     termina no primeiro registro incompleto ou corrompido, e o arquivo
+*      truncado nesse ponto.
+*
+*     Os prximos registros recebem LSN maiores que o maior entre o
+*     ltimo LSN lido e lsnMinimo.
+*
+*  Parmetros
+*     caminho     - caminho do arquivo.
+*     lsnMinimo   - registros com LSN at este valor no so aplicados.
+*     aplicar     - funo chamada para cada registro; se retornar
+*                   diferente de 0 a abertura  interrompida. Pode ser NULL.
+*     pContexto   - ponteiro repassado  funo aplicar.
+*     ppLog       - referncia usada para retorno do registro aberto.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetInterrompido
+*     WAL_CondRetFaltouMemoria
+*     WAL_CondRetErroSistema
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Abrir(const char *caminho, WAL_tpLsn lsnMinimo,
+                           WAL_tpAplicar aplicar, void *pContexto, WAL_tppLog *ppLog);
+
+/***********************************************************************
+*
+*  Funo: WAL Criar
+*
+*  Descrio
+*     Cria o registro no caminho dado, descartando o contedo anterior,
+*     se houver. O primeiro registro recebe LSN 1.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetFaltouMemoria
+*     WAL_CondRetErroSistema
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Criar(const char *caminho, WAL_tppLog *ppLog);
+
+/***********************************************************************
+*
+*  Funo: WAL Ler
+*
+*  Descrio
+*     Entrega  funo aplicar os registros vlidos do arquivo, sem
+*     abri-lo para acrscimo e sem alter-lo.
+*
+*  Parmetros
+*     caminho     - caminho do arquivo.
+*     aplicar     - funo chamada para cada registro.
+*     pContexto   - ponteiro repassado  funo aplicar.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetNaoAchou
+*     WAL_CondRetInterrompido
+*     WAL_CondRetFaltouMemoria
+*     WAL_CondRetErroSistema
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Ler(const char *caminho, WAL_tpAplicar aplicar, void *pContexto);
+
+/***********************************************************************
+*
+*  Funo: WAL Acrescentar
+*
+*  Descrio
+*     Acrescenta um registro ao buffer do grupo corrente. Se com ele o
+*     grupo se completar, o grupo  gravado e sincronizado.
+*
+*  Parmetros
+*     pLog        - registro aberto.
+*     tipo        - tipo do registro, definido pelo cliente.
+*     numCampos   - quantidade de campos, de 0 a WAL_MAX_CAMPOS.
+*     vtCampos    - endereos dos campos.
+*     vtTamanhos  - tamanhos dos campos em bytes.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetFaltouMemoria  - o registro no foi acrescentado.
+*     WAL_CondRetErroSistema    - o registro foi acrescentado, mas a
+*                                 gravao do grupo falhou.
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Acrescentar(WAL_tppLog pLog, unsigned char tipo, int numCampos,
+                                 const void **vtCampos, const size_t *vtTamanhos);
+
+/***********************************************************************
+*
+*  Funo: WAL Confirmar
+*
+*  Descrio
+*     Grava os registros pendentes e espera o sistema operacional
+*     confirmar que chegaram ao disco.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetErroSistema
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Confirmar(WAL_tppLog pLog);
+
+/***********************************************************************
+*
+*  Funo: WAL Esvaziar
+*
+*  Descrio
+*     Descarta todos os registros, gravados ou pendentes. Usada depois
+*     que o estado que eles descrevem foi salvo de outra forma. A
+*     numerao dos LSN continua de onde estava.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetErroSistema
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Esvaziar(WAL_tppLog pLog);
+
+/***********************************************************************
+*
+*  Funo: WAL Definir grupo
+*
+*  Descrio
+*     Define quantos registros formam um grupo de confirmao. Com 1,
+*     cada registro  sincronizado ao ser acrescentado.
+*
+***********************************************************************/
+   void WAL_DefinirGrupo(WAL_tppLog pLog, int registrosPorGrupo);
+
+/***********************************************************************
+*
+*  Funo: WAL Obter ltimo LSN
+*
+*  Descrio
+*     Retorna o LSN do ltimo registro acrescentado, confirmado ou no,
+*     ou o LSN de partida se nenhum foi acrescentado.
+*
+***********************************************************************/
+   WAL_tpLsn WAL_ObterUltimoLsn(WAL_tppLog pLog);
+
+/***********************************************************************
+*
+*  Funo: WAL Obter tamanho
+*
+*  Descrio
+*     Retorna o tamanho em bytes dos registros, gravados e pendentes.
+*
+***********************************************************************/
+   long WAL_ObterTamanho(WAL_tppLog pLog);
+
+/***********************************************************************
+*
+*  Funo: WAL Fechar
+*
+*  Descrio
+*     Confirma os registros pendentes e fecha o arquivo. O registro 
+*     liberado mesmo que a confirmao falhe.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetErroSistema
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Fechar(WAL_tppLog pLog);
+
+/***********************************************************************
+*
+*  Funo: WAL Substituir
+*
+*  Descrio
+*     Renomeia o arquivo origem para destino, substituindo destino de
+*     forma atmica: aps uma queda existe ou o destino antigo ou o
+*     novo, completo. Em POSIX o diretrio tambm  sincronizado.
+*
+*  Condies de retorno
+*     WAL_CondRetOK
+*     WAL_CondRetErroSistema
+*
+***********************************************************************/
+   WAL_tpCondRet WAL_Substituir(const char *origem, const char *destino);
+
+/***********************************************************************/
+#undef WAL_EXT
+
+/********** Fim do mdulo de definio: WAL  Registro de escrita antecipada **********/
+
+#else
+#endif